@@ -3,6 +3,7 @@
 
 
 #include <cstddef> // size_t
+#include <chrono> // std::chrono::nanoseconds
 #include <deque>
 #include <mutex>
 #include "semaphore.hpp"
@@ -13,7 +14,9 @@
 namespace advcpp
 {
 
-// Concept of T: MUST be copy-constructable, copy-assignable and default-constructable
+// Concept of T: MUST be default-constructable, and copy-constructable and copy-assignable (or move-constructable and move-assignable, if only the rvalue Enqueue variants are used)
+// Concept of ForwardIterator (EnqueueBulk): dereferences to a T (or to a type convertible to T)
+// Concept of OutputIterator (DequeueBulk): *a_output = T must be valid (e.g. std::back_inserter of a container of T)
 // Concept of DestructionPolicy: policy must be copy-constructable
 // The destruction policy is a FUNCTOR (implements operator() and get 1 param: BlockingBoundedQueue& obj), to be used as an instructions to know which action the BlockingBoundedQueue
 // object should call on itself when it is in a destruction stage
@@ -30,8 +33,33 @@ public:
 
     // Returns false if the queue is closed and no further operations can be done with it
     bool Enqueue(const T& a_item);
+    bool Enqueue(T&& a_item); // Moves the item into the queue (for move-only types)
     bool Dequeue(T& a_itemToReturnByRef);
 
+    // Non-blocking and bounded-wait variants of Enqueue
+    // Returns false if the queue is closed, or if no free slot became available (immediately / until the timeout has expired)
+    // The rvalue variants move from a_item ONLY if it was enqueued (so a move-only item can be retried)
+    bool TryEnqueue(const T& a_item);
+    bool TryEnqueue(T&& a_item);
+    bool EnqueueFor(const T& a_item, std::chrono::nanoseconds a_timeout);
+    bool EnqueueFor(T&& a_item, std::chrono::nanoseconds a_timeout);
+
+    // Non-blocking variant of Dequeue - returns false if the queue is closed or empty
+    bool TryDequeue(T& a_itemToReturnByRef);
+
+    // Bulk variants - the items of a batch are moved under a single lock of the queue
+    // EnqueueBulk blocks until all the items in [a_first, a_last) were enqueued (takes as many free slots as available at once),
+    // returns the number of enqueued items (less than the range's length only if the queue was closed)
+    // TryEnqueueBulk never blocks - enqueues the items of [a_first, a_last) that fit in the free slots, returns their number (0 if the queue is closed or full)
+    // DequeueBulk waits up to a_timeout for the first item, then takes up to a_maxItems items that are already in the queue without waiting,
+    // returns the number of dequeued items (0 if the queue is closed, or if the timeout has expired)
+    template <typename ForwardIterator>
+    size_t EnqueueBulk(ForwardIterator a_first, ForwardIterator a_last);
+    template <typename ForwardIterator>
+    size_t TryEnqueueBulk(ForwardIterator a_first, ForwardIterator a_last);
+    template <typename OutputIterator>
+    size_t DequeueBulk(OutputIterator a_output, size_t a_maxItems, std::chrono::nanoseconds a_timeout);
+
     size_t Size() const; // Returns 0 if queue is not valid
     size_t Capacity() const; // Returns 0 if queue is not valid
     bool IsEmpty() const; // Returns true if queue is not valid
@@ -43,6 +71,21 @@ private:
     bool IsClosed() const;
     void LockFurtherOperations();
     bool ShouldNotOperate() const;
+    template <typename Item>
+    bool EnqueueItem(Item&& a_item);
+    template <typename Item>
+    bool TryEnqueueItem(Item&& a_item);
+    template <typename Item>
+    bool EnqueueItemFor(Item&& a_item, std::chrono::nanoseconds a_timeout);
+    template <typename Item>
+    void PushBack(Item&& a_item); // Assumes that a free slot has been acquired already
+    void PopFront(T& a_itemToReturnByRef); // Assumes that an occupied slot has been acquired already
+    template <typename ForwardIterator>
+    ForwardIterator PushBackBulk(ForwardIterator a_first, size_t a_itemsCount); // Assumes that a_itemsCount free slots have been acquired already
+    template <typename OutputIterator>
+    void PopFrontBulk(OutputIterator a_output, size_t a_itemsCount); // Assumes that a_itemsCount occupied slots have been acquired already
+    static size_t TryDownUpTo(Semaphore& a_slots, size_t a_maxSlots); // Returns the number of acquired slots (without waiting)
+    static void UpTimes(Semaphore& a_slots, size_t a_times);
 
     // For policy uses (without locking)
     bool RemoveNext(T& a_itemToReturnByRef) noexcept; // true if succeed, else false
@@ -2,6 +2,7 @@
 #define NM_CALLABLE_FUNCTIONS_ADAPTERS
 
 
+#include <memory> // std::shared_ptr
 #include "icallable.hpp"
 
 
@@ -168,6 +169,21 @@ private:
     Arg m_arg;
 };
 
+
+/* ICallable to Task - void(void) */
+// Wraps a pre-constructed (shared) ICallable object, so it can be held by a Task (see task.hpp) - e.g. ThreadPool::SubmitWork(std::shared_ptr<ICallable>)
+// Note: Prefer submitting the callable object itself (by value) - it saves the shared object's allocation and its reference counting
+class ICallableToTaskAdapter
+{
+public:
+    explicit ICallableToTaskAdapter(std::shared_ptr<ICallable> a_callable) : m_callable(a_callable) {}
+
+    void operator()() { if(m_callable) { (*m_callable)(); } }
+
+private:
+    std::shared_ptr<ICallable> m_callable;
+};
+
 } // advcpp
 
 
@@ -0,0 +1,485 @@
+#ifndef NM_FUTURE_HXX
+#define NM_FUTURE_HXX
+
+
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr, std::unique_ptr
+#include <mutex> // std::mutex, std::unique_lock
+#include <exception> // std::exception_ptr, std::current_exception, std::rethrow_exception, std::make_exception_ptr
+#include <stdexcept> // std::runtime_error
+#include <chrono> // std::chrono::nanoseconds
+#include <vector> // std::vector
+#include <type_traits> // std::result_of, std::decay
+#include <utility> // std::move, std::forward
+#include "task.hpp"
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+namespace future_details
+{
+
+inline FutureStateBase::FutureStateBase()
+: m_mutex()
+, m_isReady(false)
+, m_readyCondition()
+, m_exception()
+, m_continuations()
+{
+}
+
+
+inline bool FutureStateBase::IsReady() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_isReady;
+}
+
+
+inline void FutureStateBase::Wait() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_readyCondition.wait(lock, [this]() { return m_isReady; });
+}
+
+
+inline bool FutureStateBase::WaitFor(std::chrono::nanoseconds a_timeout) const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_readyCondition.wait_for(lock, a_timeout, [this]() { return m_isReady; });
+}
+
+
+inline bool FutureStateBase::SetException(std::exception_ptr a_exception)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if(m_isReady)
+    {
+        return false;
+    }
+
+    m_exception = a_exception;
+    Complete(lock);
+    return true;
+}
+
+
+inline void FutureStateBase::AddContinuation(Task a_continuation)
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if(!m_isReady)
+        {
+            m_continuations.push_back(std::move(a_continuation));
+            return;
+        }
+    }
+
+    a_continuation(); // Already completed - run inline, by the adding thread
+}
+
+
+inline void FutureStateBase::RethrowIfFailed() const
+{
+    if(m_exception)
+    {
+        std::rethrow_exception(m_exception);
+    }
+}
+
+
+inline void FutureStateBase::Complete(std::unique_lock<std::mutex>& a_lock)
+{
+    m_isReady = true;
+    std::vector<Task> continuations;
+    continuations.swap(m_continuations); // No continuation can be added from now on - the state is ready
+    a_lock.unlock();
+    m_readyCondition.notify_all();
+
+    // Run the continuations inline - by the completing thread, and out of the lock (a continuation may complete other states, or even this state's waiters)
+    for(size_t i = 0; i < continuations.size(); ++i)
+    {
+        try
+        {
+            continuations[i]();
+        }
+        catch(...)
+        {
+            // A continuation reports its failure through its own state - the rest of the continuations must run anyway
+        }
+    }
+}
+
+
+template <typename T>
+template <typename Value>
+bool FutureState<T>::SetValue(Value&& a_value)
+{
+    std::unique_ptr<T> value(new T(std::forward<Value>(a_value))); // Exception prone code - out of the lock
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if(m_isReady)
+    {
+        return false;
+    }
+
+    m_value = std::move(value);
+    Complete(lock);
+    return true;
+}
+
+
+template <typename T>
+const T& FutureState<T>::Get() const
+{
+    Wait();
+    RethrowIfFailed();
+    return *m_value; // Never changes once ready
+}
+
+
+inline bool FutureState<void>::SetValue()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if(m_isReady)
+    {
+        return false;
+    }
+
+    Complete(lock);
+    return true;
+}
+
+
+inline void FutureState<void>::Get() const
+{
+    Wait();
+    RethrowIfFailed();
+}
+
+
+template <typename T>
+const std::shared_ptr<FutureState<T>>& FutureAccess::StateOf(const Future<T>& a_future)
+{
+    if(!a_future.m_state)
+    {
+        throw std::runtime_error("Failed while tried to use an invalid future");
+    }
+
+    return a_future.m_state;
+}
+
+
+template <typename T>
+Future<T> FutureAccess::MakeFuture(std::shared_ptr<FutureState<T>> a_state)
+{
+    return Future<T>(a_state);
+}
+
+
+template <typename R, typename Func, typename... Args>
+void FulfillBy(const std::shared_ptr<FutureState<void>>& a_state, VoidResultTag, Func& a_func, Args&&... a_args)
+{
+    a_func(std::forward<Args>(a_args)...);
+    a_state->SetValue();
+}
+
+
+template <typename R, typename Func, typename... Args>
+void FulfillBy(const std::shared_ptr<FutureState<R>>& a_state, ValueResultTag, Func& a_func, Args&&... a_args)
+{
+    a_state->SetValue(a_func(std::forward<Args>(a_args)...));
+}
+
+
+template <typename R, typename Func, typename... Args>
+void FulfillBy(const std::shared_ptr<FutureState<typename UnwrappedResult<R>::type>>& a_state, FutureResultTag, Func& a_func, Args&&... a_args)
+{
+    using U = typename UnwrappedResult<R>::type;
+    Future<U> inner = a_func(std::forward<Args>(a_args)...);
+    FutureAccess::StateOf(inner)->AddContinuation(Task(ResultForwarder<U>(inner, a_state)));
+}
+
+
+template <typename R, typename Func, typename... Args>
+void Fulfill(const std::shared_ptr<FutureState<typename UnwrappedResult<R>::type>>& a_state, Func& a_func, Args&&... a_args) noexcept
+{
+    try
+    {
+        FulfillBy<R>(a_state, typename ResultTagOf<R>::type(), a_func, std::forward<Args>(a_args)...);
+    }
+    catch(...)
+    {
+        a_state->SetException(std::current_exception());
+    }
+}
+
+
+template <typename Func, typename R>
+PromisedWork<Func,R>::PromisedWork(Func a_func, std::shared_ptr<FutureState<typename UnwrappedResult<R>::type>> a_state)
+: m_func(std::move(a_func))
+, m_state(a_state)
+{
+}
+
+
+template <typename Func, typename R>
+PromisedWork<Func,R>::~PromisedWork()
+{
+    if(m_state)
+    {
+        try
+        {
+            m_state->SetException(std::make_exception_ptr(std::runtime_error("Broken promise - the work was destroyed before it was executed")));
+        }
+        catch(...)
+        {
+            // Destructors never throw
+        }
+    }
+}
+
+
+template <typename Func, typename R>
+void PromisedWork<Func,R>::operator()()
+{
+    if(m_state)
+    {
+        Fulfill<R>(m_state, m_func);
+        m_state.reset();
+    }
+}
+
+
+template <typename T, typename Func, typename R>
+ThenContinuation<T,Func,R>::ThenContinuation(Future<T> a_source, Func a_func, std::shared_ptr<FutureState<typename UnwrappedResult<R>::type>> a_state)
+: m_source(a_source)
+, m_func(std::move(a_func))
+, m_state(a_state)
+{
+}
+
+
+template <typename T, typename Func, typename R>
+void ThenContinuation<T,Func,R>::operator()()
+{
+    Fulfill<R>(m_state, m_func, m_source);
+    m_source = Future<T>(); // Breaks the reference cycle: source state -> continuation -> source state
+}
+
+
+template <typename U>
+ResultForwarder<U>::ResultForwarder(Future<U> a_source, std::shared_ptr<FutureState<U>> a_target)
+: m_source(a_source)
+, m_target(a_target)
+{
+}
+
+
+template <typename U>
+void ResultForwarder<U>::operator()()
+{
+    const Future<U>& source = m_source;
+    auto getSourceResult = [&source]() { return source.Get(); }; // Rethrows the source's exception into the target
+    Fulfill<U>(m_target, getSourceResult);
+    m_source = Future<U>(); // Breaks the reference cycle: source state -> forwarder -> source state
+}
+
+
+template <typename T, typename Result>
+AllCompletion<T,Result>::AllCompletion(const std::vector<Future<T>>& a_futures)
+: m_futures(a_futures)
+, m_remained(a_futures.size())
+, m_state(new FutureState<Result>())
+{
+}
+
+
+template <typename T>
+void CollectAll(AllCompletion<T,std::vector<T>>& a_completion)
+{
+    std::vector<T> values;
+    values.reserve(a_completion.m_futures.size());
+    for(size_t i = 0; i < a_completion.m_futures.size(); ++i)
+    {
+        values.push_back(a_completion.m_futures[i].Get()); // Rethrows the first exception found
+    }
+
+    a_completion.m_state->SetValue(std::move(values));
+}
+
+
+inline void CollectAll(AllCompletion<void,void>& a_completion)
+{
+    for(size_t i = 0; i < a_completion.m_futures.size(); ++i)
+    {
+        a_completion.m_futures[i].Get(); // Rethrows the first exception found
+    }
+
+    a_completion.m_state->SetValue();
+}
+
+
+template <typename T, typename Result>
+AllCompletionNotifier<T,Result>::AllCompletionNotifier(std::shared_ptr<AllCompletion<T,Result>> a_completion)
+: m_completion(a_completion)
+{
+}
+
+
+template <typename T, typename Result>
+void AllCompletionNotifier<T,Result>::operator()()
+{
+    if(--m_completion->m_remained == 0) // The last one collects
+    {
+        try
+        {
+            CollectAll(*m_completion);
+        }
+        catch(...)
+        {
+            m_completion->m_state->SetException(std::current_exception());
+        }
+        m_completion->m_futures.clear();
+    }
+}
+
+
+inline AnyCompletionNotifier::AnyCompletionNotifier(std::shared_ptr<FutureState<size_t>> a_state, size_t a_index)
+: m_state(a_state)
+, m_index(a_index)
+{
+}
+
+
+inline void AnyCompletionNotifier::operator()()
+{
+    m_state->SetValue(m_index); // Only the first one wins
+}
+
+
+template <typename T, typename Result>
+Future<Result> WhenAllOf(const std::vector<Future<T>>& a_futures)
+{
+    std::shared_ptr<AllCompletion<T,Result>> completion(new AllCompletion<T,Result>(a_futures));
+    Future<Result> all = FutureAccess::MakeFuture(completion->m_state);
+    if(a_futures.empty())
+    {
+        CollectAll(*completion);
+        return all;
+    }
+
+    for(size_t i = 0; i < a_futures.size(); ++i)
+    {
+        FutureAccess::StateOf(a_futures[i])->AddContinuation(Task(AllCompletionNotifier<T,Result>(completion)));
+    }
+
+    return all;
+}
+
+} // future_details
+
+
+template <typename T>
+Future<T>::Future(std::shared_ptr<future_details::FutureState<T>> a_state)
+: m_state(a_state)
+{
+}
+
+
+template <typename T>
+bool Future<T>::IsValid() const noexcept
+{
+    return m_state != nullptr;
+}
+
+
+template <typename T>
+bool Future<T>::IsReady() const
+{
+    return future_details::FutureAccess::StateOf(*this)->IsReady();
+}
+
+
+template <typename T>
+void Future<T>::Wait() const
+{
+    future_details::FutureAccess::StateOf(*this)->Wait();
+}
+
+
+template <typename T>
+bool Future<T>::WaitFor(std::chrono::nanoseconds a_timeout) const
+{
+    return future_details::FutureAccess::StateOf(*this)->WaitFor(a_timeout);
+}
+
+
+template <typename T>
+typename future_details::FutureState<T>::ResultType Future<T>::Get() const
+{
+    return future_details::FutureAccess::StateOf(*this)->Get();
+}
+
+
+template <typename T>
+template <typename Func>
+Future<typename future_details::UnwrappedResult<typename std::result_of<typename std::decay<Func>::type(Future<T>)>::type>::type> Future<T>::Then(Func&& a_continuation) const
+{
+    using Continuation = typename std::decay<Func>::type;
+    using R = typename std::result_of<Continuation(Future<T>)>::type;
+    using U = typename future_details::UnwrappedResult<R>::type;
+
+    const std::shared_ptr<future_details::FutureState<T>>& sourceState = future_details::FutureAccess::StateOf(*this);
+    std::shared_ptr<future_details::FutureState<U>> state(new future_details::FutureState<U>());
+    sourceState->AddContinuation(Task(future_details::ThenContinuation<T,Continuation,R>(*this, std::forward<Func>(a_continuation), state)));
+
+    return future_details::FutureAccess::MakeFuture(state);
+}
+
+
+template <typename T>
+Future<std::vector<T>> WhenAll(const std::vector<Future<T>>& a_futures)
+{
+    return future_details::WhenAllOf<T,std::vector<T>>(a_futures);
+}
+
+
+inline Future<void> WhenAll(const std::vector<Future<void>>& a_futures)
+{
+    return future_details::WhenAllOf<void,void>(a_futures);
+}
+
+
+template <typename T>
+Future<T> MakeFailedFuture(std::exception_ptr a_exception)
+{
+    std::shared_ptr<future_details::FutureState<T>> state(new future_details::FutureState<T>());
+    state->SetException(a_exception);
+
+    return future_details::FutureAccess::MakeFuture(state);
+}
+
+
+template <typename T>
+Future<size_t> WhenAny(const std::vector<Future<T>>& a_futures)
+{
+    if(a_futures.empty())
+    {
+        throw std::runtime_error("Failed while tried to wait for any of an empty futures collection");
+    }
+
+    std::shared_ptr<future_details::FutureState<size_t>> state(new future_details::FutureState<size_t>());
+    for(size_t i = 0; i < a_futures.size(); ++i)
+    {
+        future_details::FutureAccess::StateOf(a_futures[i])->AddContinuation(Task(future_details::AnyCompletionNotifier(state, i)));
+    }
+
+    return future_details::FutureAccess::MakeFuture(state);
+}
+
+} // advcpp
+
+
+#endif // NM_FUTURE_HXX
@@ -6,32 +6,44 @@
 #include <memory> // std::shared_ptr, std::make_shared
 #include <stdexcept> // std::runtime_error
 #include <mutex> // std::mutex, std::lock_guard
-#include <algorithm> // std::for_each
-#include "blocking_bounded_queue.hpp"
+#include <algorithm> // std::min
+#include <chrono> // std::chrono::nanoseconds, std::chrono::milliseconds, std::chrono::steady_clock
+#include <vector> // std::vector
+#include <pthread.h> // pthread_t
+#include <utility> // std::move, std::forward
+#include <type_traits> // std::result_of, std::decay
 #include "thread.hpp"
 #include "thread_group.hpp"
 #include "thread_destruction_policies.hpp"
 #include "icallable.hpp"
+#include "task.hpp"
+#include "future.hpp"
+#include "callable_functions_adapters.hpp"
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
 #include "atomic_value.hpp"
 #include "two_way_multi_sync_handler.hpp"
 #include "works_scheduler.hpp"
-#include "suicide_mission.hpp"
-#include "works_enqueuer.hpp"
+#include "latch.hpp"
+#include "workers_activity.hpp"
+#include "thread_pool_submission_policies.hpp"
+#include "thread_pool_metrics_policies.hpp"
 
 
 namespace advcpp
 {
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::ThreadPool(DestructionPolicy a_destructionPolicy, size_t a_worksQueueSize, size_t a_workersNumber)
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::ThreadPool(DestructionPolicy a_destructionPolicy, size_t a_worksQueueSize, size_t a_workersNumber)
 : m_worksQueue(new QueueType(a_worksQueueSize, QueueTypeDestructionPolicy()))
 , m_twoWayMultiSyncHandler(new TwoWayMultiSyncHandler())
 , m_workersLock(new std::mutex())
-, m_mainWorksScheduler(new WorksScheduler<QueueTypeDestructionPolicy,QueueType>(m_worksQueue, m_twoWayMultiSyncHandler, m_workersLock))
-, m_workers(m_mainWorksScheduler, a_workersNumber, CancelPolicy())
-, m_enqueueWorkThreads()
+, m_inFlightWorks(new Latch())
+, m_workersActivity(new WorkersActivity())
+, m_submissionPolicy()
+, m_metricsPolicy()
+, m_mainWorksScheduler(m_submissionPolicy.CreateWorksScheduler(m_worksQueue, m_twoWayMultiSyncHandler, m_workersLock, m_inFlightWorks, m_workersActivity))
+, m_workers(m_mainWorksScheduler, a_workersNumber, JoinPolicy())
 , m_operationsLock()
 , m_isStopRequired(false)
 , m_destructionPolicy(a_destructionPolicy)
@@ -39,161 +51,309 @@ ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::ThreadPool(D
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::~ThreadPool()
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::~ThreadPool()
 {
     m_destructionPolicy(*this);
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::SubmitWork(Work a_work)
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::SubmitWork(Work a_work)
 {
-    if(HasStopped())
+    EnqueueWork(a_work, [this](Work& a_instrumentedWork)
     {
-        throw std::runtime_error("Failed while tried to submit new work (because of previous Shutdown call)");
-    }
+        m_submissionPolicy(m_worksQueue, std::move(a_instrumentedWork));
+        return true;
+    });
+}
 
-    InsertWorkToQueueAsync(a_work);
+
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+bool ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::TrySubmit(Work&& a_work)
+{
+    return EnqueueWork(a_work, [this](Work& a_instrumentedWork)
+    {
+        return m_worksQueue->TryEnqueue(std::move(a_instrumentedWork));
+    });
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::AddWorkers(size_t a_workers)
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+bool ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::SubmitFor(Work&& a_work, std::chrono::nanoseconds a_timeout)
 {
-    if(HasStopped())
+    return EnqueueWork(a_work, [this, a_timeout](Work& a_instrumentedWork)
     {
-        throw std::runtime_error("Failed while tried to add new workers (because of previous Shutdown call)");
-    }
+        return m_worksQueue->EnqueueFor(std::move(a_instrumentedWork), a_timeout);
+    });
+}
+
+
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::SubmitWork(Work a_work, Priority a_priority)
+{
+    EnqueueWork(a_work, [this, a_priority](Work& a_instrumentedWork)
+    {
+        return m_worksQueue->Enqueue(std::move(a_instrumentedWork), a_priority); // False only if the works queue was closed
+    });
+}
 
+
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+bool ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::TrySubmit(Work&& a_work, Priority a_priority)
+{
+    return EnqueueWork(a_work, [this, a_priority](Work& a_instrumentedWork)
+    {
+        return m_worksQueue->TryEnqueue(std::move(a_instrumentedWork), a_priority);
+    });
+}
+
+
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+template <typename Func>
+Future<typename future_details::UnwrappedResult<typename std::result_of<typename std::decay<Func>::type()>::type>::type> ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::Submit(Func&& a_func)
+{
+    using Callable = typename std::decay<Func>::type;
+    using R = typename std::result_of<Callable()>::type;
+    using U = typename future_details::UnwrappedResult<R>::type;
+
+    std::shared_ptr<future_details::FutureState<U>> state(new future_details::FutureState<U>());
+    SubmitWork(Work(future_details::PromisedWork<Callable,R>(std::forward<Func>(a_func), state)));
+
+    return future_details::FutureAccess::MakeFuture(state);
+}
+
+
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::SubmitWork(std::shared_ptr<ICallable> a_work)
+{
+    SubmitWork(Work(ICallableToTaskAdapter(a_work)));
+}
+
+
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+bool ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::TrySubmit(std::shared_ptr<ICallable> a_work)
+{
+    return TrySubmit(Work(ICallableToTaskAdapter(a_work)));
+}
+
+
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+bool ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::SubmitFor(std::shared_ptr<ICallable> a_work, std::chrono::nanoseconds a_timeout)
+{
+    return SubmitFor(Work(ICallableToTaskAdapter(a_work)), a_timeout);
+}
+
+
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::AddWorkers(size_t a_workers)
+{
     // Lock the other pool's operations
     std::lock_guard<std::mutex> guard(m_operationsLock);
+    if(HasStopped()) // Under the lock - a shutdown that stops all the workers would miss the new ones otherwise
+    {
+        throw std::runtime_error("Failed while tried to add new workers (because of previous Shutdown call)");
+    }
 
     m_workers.Add(a_workers);
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::RemoveWorkers(size_t a_workers)
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::RemoveWorkers(size_t a_workers)
 {
+    // Lock the other pool's operations
+    std::lock_guard<std::mutex> guard(m_operationsLock);
     if(HasStopped())
     {
         throw std::runtime_error("Failed while tried to remove existing workers (because of previous Shutdown call)");
     }
 
-    // Lock the other pool's operations
-    std::lock_guard<std::mutex> guard(m_operationsLock);
-
     size_t workersToRemove = std::min(a_workers, m_workers.Size());
-    StopWorkers(workersToRemove); // Stops all workers (m_workers.Size()) if a_workers > m_workers.Size()
-    m_workers.Remove(workersToRemove);
+    std::vector<pthread_t> stoppedWorkers = StopWorkers(workersToRemove); // Stops all workers (m_workers.Size()) if a_workers > m_workers.Size()
+    m_workers.JoinAndRemove(stoppedWorkers); // The stopped workers have signalled back already, and are only returning from their task (a short blocking join)
+}
+
+
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::Shutdown()
+{
+    Stop();
+    if(m_workers.Size() > 0) // Nobody would execute the pending works otherwise
+    {
+        m_inFlightWorks->Wait(); // Woken up by the worker that completes the last in-flight work
+    }
+    StopAllWorkers();
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::Shutdown()
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+size_t ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::Shutdown(std::chrono::steady_clock::time_point a_deadline)
 {
     Stop();
-    SoftShutdown();
-    m_workers.Remove(m_workers.Size());
+    if(m_workers.Size() > 0) // Nobody would execute the pending works otherwise
+    {
+        m_inFlightWorks->WaitUntil(a_deadline);
+    }
+    StopAllWorkers();
+
+    return m_inFlightWorks->Count(); // The stopped workers have completed their current works - the remained works were never executed
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::ShutdownImmediate()
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::ShutdownImmediate()
 {
     Stop();
-    ForceShutdown();
-    m_workers.Remove(m_workers.Size());
+    StopAllWorkers();
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-size_t ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::WorkersCount()
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+size_t ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::WorkersCount()
 {
     return m_workers.Size();
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-size_t ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::PendingWorksCount() const
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+size_t ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::PendingWorksCount() const
 {
-    return m_worksQueue->Size();
+    size_t busyWorkers = m_workersActivity->BusyWorkers(); // First - a work that starts meanwhile is still counted as pending
+    size_t inFlightWorks = m_inFlightWorks->Count(); // Never includes the empty wake up works of StopWorkers (they are not submitted) - unlike the works queue's size
+
+    return inFlightWorks > busyWorkers ? inFlightWorks - busyWorkers : 0;
+}
+
+
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+size_t ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::PendingWorksCount(Priority a_priority) const
+{
+    return m_worksQueue->LaneSize(a_priority);
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::InsertWorkToQueueAsync(Work a_workToInsert)
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+size_t ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::BusyWorkersCount() const
 {
-    Work worksEnqueuer(new WorksEnqueuer<QueueTypeDestructionPolicy,QueueType>(m_worksQueue, a_workToInsert));
-    std::shared_ptr<Thread<DetachPolicy>> workEnqueueTask(new Thread<DetachPolicy>(worksEnqueuer, DetachPolicy()));
-    workEnqueueTask->Detach();
-    m_enqueueWorkThreads.push_back(workEnqueueTask);
+    return m_workersActivity->BusyWorkers();
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-bool ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::HasDoneEnqueueAllWorksAsync() const
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+size_t ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::CompletedWorksCount() const
 {
-    bool hasDoneAll = true;
-    std::for_each(m_enqueueWorkThreads.begin(), m_enqueueWorkThreads.end(), [&hasDoneAll](std::shared_ptr<Thread<DetachPolicy>> m_enqueueWorkTask)
+    return m_workersActivity->CompletedWorks();
+}
+
+
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+ThreadPoolMetricsSnapshot ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::Snapshot()
+{
+    ThreadPoolMetricsSnapshot snapshot;
+    snapshot.m_workers = WorkersCount();
+    snapshot.m_pendingWorks = PendingWorksCount();
+    m_metricsPolicy.Fill(snapshot);
+    if(snapshot.m_isEnabled)
     {
-        hasDoneAll = hasDoneAll && m_enqueueWorkTask->HasDone();
-    });
+        snapshot.m_stolenWorks = m_submissionPolicy.StolenWorksCount();
+    }
 
-    return hasDoneAll;
+    return snapshot;
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::Stop()
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::Stop()
 {
     m_isStopRequired.True();
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-bool ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::HasStopped() const
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+bool ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::HasStopped() const
 {
     return m_isStopRequired.Check();
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::SoftShutdown()
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::CountUpInFlightWork()
 {
-    while(!HasDoneEnqueueAllWorksAsync()); // Polling - to make sure that all the WorksEnqueuers have done enqueue the submitted the works successfully
-    while(!m_worksQueue->IsEmpty() && m_workers.Size() > 0); // Pooling - to make sure that the workers have consumed all the works, and there are ready to be stopped (and make sure that there are workers to consume the works... must make sure to not wait for nothing)
-    StopWorkers(m_workers.Size()); // Stop all workers
+    m_inFlightWorks->CountUp(); // Before the stop check - a Shutdown that has not seen this work yet would wait for it
+    if(HasStopped())
+    {
+        m_inFlightWorks->CountDown();
+        throw std::runtime_error("Failed while tried to submit new work (because of previous Shutdown call)");
+    }
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::ForceShutdown()
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+template <typename Enqueue>
+bool ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::EnqueueWork(Work& a_work, Enqueue a_enqueue)
 {
-    StopWorkers(m_workers.Size()); // Stop all workers
+    CountUpInFlightWork();
+    typename MetricsPolicy::Stamp submitted = m_metricsPolicy.Now();
+    typename MetricsPolicy::Instrumented instrumented = m_metricsPolicy.Instrument(a_work, submitted);
+    bool hasSubmitted = false;
+    try
+    {
+        hasSubmitted = a_enqueue(a_work);
+    }
+    catch(...)
+    {
+        m_inFlightWorks->CountDown();
+        throw;
+    }
+
+    if(!hasSubmitted) // a_work was not moved
+    {
+        m_metricsPolicy.Restore(a_work, instrumented);
+        m_inFlightWorks->CountDown();
+        return false;
+    }
+
+    m_metricsPolicy.EnqueueCompleted(submitted);
+    return true;
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::StopWorkers(size_t a_workersToStop)
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::StopAllWorkers()
+{
+    // Lock the other pool's operations - the pool has stopped already, so no worker is added or removed after this point
+    std::lock_guard<std::mutex> guard(m_operationsLock);
+    StopWorkers(m_workers.Size());
+    m_workers.Join(); // All the workers have signalled back - they are only returning from their task
+    m_workers.Remove(m_workers.Size()); // Cleans the joined workers
+}
+
+
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+std::vector<pthread_t> ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::StopWorkers(size_t a_workersToStop)
 {
     m_twoWayMultiSyncHandler->SetWantedSignalsBack(a_workersToStop);
     m_twoWayMultiSyncHandler->Notify(a_workersToStop); // Notify N workers
 
-    Work suicideMission(new SuicideMission()); // Using the suicide mission (that throws) to make sure that N workers are working on something, and NOT waiting on the Dequeue, so they are cancelable
+    const std::chrono::milliseconds retryInterval(10);
     for(size_t i = 0; i < a_workersToStop; ++i)
     {
-        InsertWorkToQueueAsync(suicideMission);
+        Work wakeUpWork; // An empty work - wakes up a worker that is blocked on the Dequeue, so it checks its stop notification (never executed, never counted)
+        // Retries only while some notified worker has not accepted its notification yet (it might be blocked on the Dequeue),
+        // that way a full queue (whose workers stop without consuming) would never block the caller
+        while(m_twoWayMultiSyncHandler->NotificationsCount() > 0 && !m_worksQueue->EnqueueFor(std::move(wakeUpWork), retryInterval));
     }
 
     m_twoWayMultiSyncHandler->WaitForAllSignalsBack(); // A blocking wait (no polling is required)
-    m_twoWayMultiSyncHandler->ResetNotifications();
+    m_twoWayMultiSyncHandler->ResetAllNotifications();
+
+    return m_twoWayMultiSyncHandler->TakeAcceptingThreads();
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::ConditionalShutdown() noexcept
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::ConditionalShutdown() noexcept
 {
     if(!HasStopped())
     {
@@ -202,8 +362,8 @@ void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::Conditi
 }
 
 
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType>
-void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::ConditionalShutdownImmidiate() noexcept
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::ConditionalShutdownImmidiate() noexcept
 {
     if(!HasStopped())
     {
@@ -214,4 +374,4 @@ void ThreadPool<DestructionPolicy,QueueTypeDestructionPolicy,QueueType>::Conditi
 } // advcpp
 
 
-#endif // NMM_THREAD_POOL_HXX
\ No newline at end of file
+#endif // NMM_THREAD_POOL_HXX
@@ -0,0 +1,273 @@
+#ifndef NM_THREAD_POOL_AUTOSCALER_HXX
+#define NM_THREAD_POOL_AUTOSCALER_HXX
+
+
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr, std::make_shared
+#include <mutex> // std::mutex, std::lock_guard, std::unique_lock
+#include <condition_variable> // std::condition_variable
+#include <chrono> // std::chrono::nanoseconds, std::chrono::milliseconds, std::chrono::steady_clock
+#include <thread> // std::thread::hardware_concurrency
+#include <algorithm> // std::min, std::max
+#include <stdexcept> // std::runtime_error
+#include "icallable.hpp"
+#include "thread.hpp"
+#include "thread_destruction_policies.hpp"
+#include "thread_budget.hpp"
+
+
+namespace advcpp
+{
+
+inline AutoscalerConfig::AutoscalerConfig()
+: m_minWorkers(1)
+, m_maxWorkers(std::max(std::thread::hardware_concurrency(), 1u))
+, m_sampleInterval(std::chrono::milliseconds(100))
+, m_maxQueueWait(std::chrono::milliseconds(10))
+, m_growBusyRatio(0.9)
+, m_shrinkBusyRatio(0.25)
+, m_samplesToGrow(2)
+, m_samplesToShrink(10) // Shrinks slower than grows - an idle moment between bursts should not release the workers
+{
+}
+
+
+template <typename Pool>
+ThreadPoolAutoscaler<Pool>::ThreadPoolAutoscaler(Pool& a_pool, const AutoscalerConfig& a_config, std::shared_ptr<ThreadBudget> a_budget)
+: m_pool(a_pool)
+, m_config(a_config)
+, m_budget(a_budget ? a_budget : std::make_shared<ThreadBudget>(a_config.m_maxWorkers))
+, m_acquiredThreads(ResizeIntoRange())
+, m_growVotes(0)
+, m_shrinkVotes(0)
+, m_lastCompletedWorks(a_pool.CompletedWorksCount())
+, m_lastSampleTime(std::chrono::steady_clock::now())
+, m_hasPoolStopped(false)
+, m_stats()
+, m_sampleLock()
+, m_stopLock()
+, m_stopCondition()
+, m_isStopRequired(false)
+, m_hasStopped(false)
+, m_samplingThread(std::shared_ptr<ICallable>(new SamplingLoop(this)), JoinPolicy()) // Last - all the members are ready before the first sample
+{
+    m_stats.m_workers = m_acquiredThreads;
+}
+
+
+template <typename Pool>
+ThreadPoolAutoscaler<Pool>::~ThreadPoolAutoscaler()
+{
+    Stop();
+    m_budget->Release(m_acquiredThreads);
+}
+
+
+template <typename Pool>
+void ThreadPoolAutoscaler<Pool>::Sample()
+{
+    std::lock_guard<std::mutex> guard(m_sampleLock);
+    if(m_hasPoolStopped)
+    {
+        return;
+    }
+
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    size_t completedWorks = m_pool.CompletedWorksCount();
+    size_t pendingWorks = m_pool.PendingWorksCount();
+    size_t workers = m_pool.WorkersCount();
+    double busyRatio = workers ? std::min(1.0, static_cast<double>(m_pool.BusyWorkersCount()) / workers) : (pendingWorks ? 1.0 : 0.0);
+    std::chrono::nanoseconds queueWait = EstimateQueueWait(pendingWorks, completedWorks - m_lastCompletedWorks, now - m_lastSampleTime);
+    m_lastCompletedWorks = completedWorks;
+    m_lastSampleTime = now;
+
+    // Hysteresis - a decision is taken only after enough consecutive samples agree on it
+    if(pendingWorks && (queueWait > m_config.m_maxQueueWait || busyRatio >= m_config.m_growBusyRatio))
+    {
+        ++m_growVotes;
+        m_shrinkVotes = 0;
+    }
+    else if(!pendingWorks && busyRatio <= m_config.m_shrinkBusyRatio)
+    {
+        ++m_shrinkVotes;
+        m_growVotes = 0;
+    }
+    else
+    {
+        m_growVotes = 0;
+        m_shrinkVotes = 0;
+    }
+
+    if(m_growVotes >= m_config.m_samplesToGrow)
+    {
+        m_growVotes = 0;
+        Grow(workers);
+    }
+    else if(m_shrinkVotes >= m_config.m_samplesToShrink)
+    {
+        m_shrinkVotes = 0;
+        Shrink(workers);
+    }
+
+    ++m_stats.m_samples;
+    m_stats.m_workers = m_pool.WorkersCount();
+    m_stats.m_busyRatio = busyRatio;
+    m_stats.m_queueWait = queueWait;
+}
+
+
+template <typename Pool>
+void ThreadPoolAutoscaler<Pool>::Stop()
+{
+    if(!m_hasStopped.SetIf(false, true))
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(m_stopLock);
+        m_isStopRequired = true;
+    }
+    m_stopCondition.notify_one();
+    m_samplingThread.Join();
+}
+
+
+template <typename Pool>
+AutoscalerStats ThreadPoolAutoscaler<Pool>::Stats() const
+{
+    std::lock_guard<std::mutex> guard(m_sampleLock);
+    return m_stats;
+}
+
+
+template <typename Pool>
+void ThreadPoolAutoscaler<Pool>::SamplingLoop::operator()()
+{
+    m_autoscaler->RunSampling();
+}
+
+
+template <typename Pool>
+size_t ThreadPoolAutoscaler<Pool>::ResizeIntoRange()
+{
+    if(m_config.m_minWorkers > m_config.m_maxWorkers || m_config.m_shrinkBusyRatio >= m_config.m_growBusyRatio || m_config.m_sampleInterval <= std::chrono::nanoseconds(0))
+    {
+        throw std::runtime_error("Invalid autoscaler config");
+    }
+
+    size_t workers = m_pool.WorkersCount();
+    size_t wantedWorkers = std::min(std::max(workers, m_config.m_minWorkers), m_config.m_maxWorkers);
+    if(!m_budget->TryAcquire(wantedWorkers))
+    {
+        throw std::runtime_error("The thread budget has not enough threads for the pool's workers");
+    }
+
+    try
+    {
+        if(workers < wantedWorkers)
+        {
+            m_pool.AddWorkers(wantedWorkers - workers);
+        }
+        else if(workers > wantedWorkers)
+        {
+            m_pool.RemoveWorkers(workers - wantedWorkers);
+        }
+    }
+    catch(...)
+    {
+        m_budget->Release(wantedWorkers);
+        throw;
+    }
+
+    return wantedWorkers;
+}
+
+
+template <typename Pool>
+void ThreadPoolAutoscaler<Pool>::RunSampling()
+{
+    std::unique_lock<std::mutex> lock(m_stopLock);
+    while(!m_stopCondition.wait_for(lock, m_config.m_sampleInterval, [this]() { return m_isStopRequired; }))
+    {
+        lock.unlock();
+        Sample();
+        lock.lock();
+    }
+}
+
+
+template <typename Pool>
+void ThreadPoolAutoscaler<Pool>::Grow(size_t a_workers)
+{
+    if(a_workers >= m_config.m_maxWorkers)
+    {
+        return;
+    }
+
+    if(!m_budget->TryAcquire())
+    {
+        ++m_stats.m_deniedGrows; // Other pools use the whole budget
+        return;
+    }
+
+    try
+    {
+        m_pool.AddWorkers(1);
+    }
+    catch(const std::runtime_error&)
+    {
+        m_budget->Release();
+        m_hasPoolStopped = true; // The pool has shut down - never scale it again
+        return;
+    }
+
+    ++m_acquiredThreads;
+    ++m_stats.m_grows;
+}
+
+
+template <typename Pool>
+void ThreadPoolAutoscaler<Pool>::Shrink(size_t a_workers)
+{
+    if(a_workers <= m_config.m_minWorkers)
+    {
+        return;
+    }
+
+    try
+    {
+        m_pool.RemoveWorkers(1);
+    }
+    catch(const std::runtime_error&)
+    {
+        m_hasPoolStopped = true; // The pool has shut down - never scale it again
+        return;
+    }
+
+    m_budget->Release();
+    --m_acquiredThreads;
+    ++m_stats.m_shrinks;
+}
+
+
+template <typename Pool>
+std::chrono::nanoseconds ThreadPoolAutoscaler<Pool>::EstimateQueueWait(size_t a_pendingWorks, size_t a_completedWorks, std::chrono::nanoseconds a_elapsed)
+{
+    if(!a_pendingWorks)
+    {
+        return std::chrono::nanoseconds(0);
+    }
+
+    if(!a_completedWorks) // No progress at all - the pending works have waited (at least) the whole interval
+    {
+        return a_elapsed;
+    }
+
+    return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(static_cast<double>(a_elapsed.count()) * a_pendingWorks / a_completedWorks));
+}
+
+} // advcpp
+
+
+#endif // NM_THREAD_POOL_AUTOSCALER_HXX
@@ -8,15 +8,15 @@
 namespace advcpp
 {
 
-template <typename QueueTypeDestructionPolicy, typename QueueType>
-void AssertingPolicy<QueueTypeDestructionPolicy,QueueType>::operator()(ThreadPool<AssertingPolicy, QueueTypeDestructionPolicy, QueueType>& a_pool) noexcept
+template <typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void AssertingPolicy<QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::operator()(ThreadPool<AssertingPolicy, QueueTypeDestructionPolicy, QueueType, SubmissionPolicy, MetricsPolicy>& a_pool) noexcept
 {
     assert(a_pool.HasStopped());
 }
 
 
-template <typename QueueTypeDestructionPolicy, typename QueueType>
-void ShutdownPolicy<QueueTypeDestructionPolicy,QueueType>::operator()(ThreadPool<ShutdownPolicy, QueueTypeDestructionPolicy, QueueType>& a_pool) noexcept
+template <typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ShutdownPolicy<QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::operator()(ThreadPool<ShutdownPolicy, QueueTypeDestructionPolicy, QueueType, SubmissionPolicy, MetricsPolicy>& a_pool) noexcept
 {
     try
     {
@@ -28,8 +28,8 @@ void ShutdownPolicy<QueueTypeDestructionPolicy,QueueType>::operator()(ThreadPool
 }
 
 
-template <typename QueueTypeDestructionPolicy, typename QueueType>
-void ShutdownImmediatePolicy<QueueTypeDestructionPolicy,QueueType>::operator()(ThreadPool<ShutdownImmediatePolicy, QueueTypeDestructionPolicy, QueueType>& a_pool) noexcept
+template <typename QueueTypeDestructionPolicy, typename QueueType, typename SubmissionPolicy, typename MetricsPolicy>
+void ShutdownImmediatePolicy<QueueTypeDestructionPolicy,QueueType,SubmissionPolicy,MetricsPolicy>::operator()(ThreadPool<ShutdownImmediatePolicy, QueueTypeDestructionPolicy, QueueType, SubmissionPolicy, MetricsPolicy>& a_pool) noexcept
 {
     try
     {
@@ -5,17 +5,22 @@
 #include <memory> // std::shared_ptr
 #include <mutex> // std::mutex, std::lock_guard
 #include "icallable.hpp"
+#include "task.hpp"
+#include "latch.hpp"
 #include "two_way_multi_sync_handler.hpp"
+#include "workers_activity.hpp"
 
 
 namespace advcpp
 {
 
 template <typename QueueTypeDestructionPolicy, typename QueueType>
-WorksScheduler<QueueTypeDestructionPolicy,QueueType>::WorksScheduler(std::shared_ptr<QueueType> a_worksQueue, std::shared_ptr<TwoWayMultiSyncHandler> a_twoWayMultiSyncHandler, std::shared_ptr<std::mutex> a_workersLock)
+WorksScheduler<QueueTypeDestructionPolicy,QueueType>::WorksScheduler(std::shared_ptr<QueueType> a_worksQueue, std::shared_ptr<TwoWayMultiSyncHandler> a_twoWayMultiSyncHandler, std::shared_ptr<std::mutex> a_workersLock, std::shared_ptr<Latch> a_inFlightWorks, std::shared_ptr<WorkersActivity> a_workersActivity)
 : m_worksQueue(a_worksQueue)
 , m_twoWayMultiSyncHandler(a_twoWayMultiSyncHandler)
 , m_workersLock(a_workersLock)
+, m_inFlightWorks(a_inFlightWorks)
+, m_workersActivity(a_workersActivity)
 {
 }
 
@@ -31,14 +36,14 @@ void WorksScheduler<QueueTypeDestructionPolicy,QueueType>::operator()()
             std::lock_guard<std::mutex> guard(*m_workersLock);
             if(m_twoWayMultiSyncHandler->NotificationsCount() > 0)
             {
-                m_twoWayMultiSyncHandler->AcceptNotification();
+                m_twoWayMultiSyncHandler->OneNotificationAccept();
                 break;
             }
 
             // Continue this iteration regularly
         }
 
-        std::shared_ptr<ICallable> work;
+        Task work;
         if(!m_worksQueue->Dequeue(work)) // Checking if the queue is not valid
         {
             break;
@@ -51,19 +56,25 @@ void WorksScheduler<QueueTypeDestructionPolicy,QueueType>::operator()()
 
 
 template <typename QueueTypeDestructionPolicy, typename QueueType>
-void WorksScheduler<QueueTypeDestructionPolicy,QueueType>::SafeExecute(std::shared_ptr<ICallable> a_work) const
+void WorksScheduler<QueueTypeDestructionPolicy,QueueType>::SafeExecute(Task& a_work) const
 {
+    if(!a_work) // Wake up works are empty
+    {
+        return;
+    }
+
+    m_workersActivity->WorkStarted();
     try
     {
-        if(a_work)
-        {
-            (*a_work)();
-        }
+        a_work();
     }
     catch(...)
     {
         // For exception safety execution
     }
+    m_workersActivity->WorkCompleted();
+
+    m_inFlightWorks->CountDown(); // The work has completed - lets a draining Shutdown know about it
 }
 
 } // advcpp
@@ -0,0 +1,42 @@
+#ifndef NM_LATCH_HPP
+#define NM_LATCH_HPP
+
+
+#include <cstddef> // size_t
+#include <mutex> // std::mutex
+#include <condition_variable> // std::condition_variable
+#include <chrono> // std::chrono::steady_clock
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+// A countdown latch that can be re-armed by CountUp (like a wait group) - Wait blocks (without polling) until the count reaches 0
+// CountUp and CountDown are lock-free, the lock is taken only by a CountDown that reaches 0 while someone waits
+class Latch
+{
+public:
+    explicit Latch(size_t a_count = 0);
+    Latch(const Latch& a_other) = delete;
+    Latch& operator=(const Latch& a_other) = delete;
+    ~Latch() = default;
+
+    void CountUp(size_t a_count = 1);
+    void CountDown(size_t a_count = 1); // Throws std::runtime_error if a_count is bigger than the current count
+    size_t Count() const;
+
+    void Wait();
+    bool WaitUntil(std::chrono::steady_clock::time_point a_deadline); // Returns false if the count has not reached 0 until the deadline
+
+private:
+    AtomicValue<size_t> m_count;
+    AtomicValue<size_t> m_waiters;
+    std::mutex m_mutex;
+    std::condition_variable m_reachedZero;
+};
+
+} // advcpp
+
+
+#endif // NM_LATCH_HPP
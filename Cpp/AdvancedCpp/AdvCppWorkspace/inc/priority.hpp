@@ -0,0 +1,24 @@
+#ifndef NM_PRIORITY_HPP
+#define NM_PRIORITY_HPP
+
+
+#include <cstddef> // size_t
+
+
+namespace advcpp
+{
+
+// The priority lanes of a PriorityBoundedQueue (and of ThreadPool::SubmitWork), from the most urgent one
+enum class Priority : unsigned int
+{
+    HIGH = 0,
+    NORMAL = 1,
+    LOW = 2
+};
+
+const size_t PRIORITIES_COUNT = 3;
+
+} // advcpp
+
+
+#endif // NM_PRIORITY_HPP
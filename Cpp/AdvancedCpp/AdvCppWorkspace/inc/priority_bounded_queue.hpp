@@ -0,0 +1,100 @@
+#ifndef NM_PRIORITY_BOUNDED_QUEUE_HPP
+#define NM_PRIORITY_BOUNDED_QUEUE_HPP
+
+
+#include <cstddef> // size_t
+#include <chrono> // std::chrono::nanoseconds
+#include <deque> // std::deque
+#include <array> // std::array
+#include <mutex> // std::mutex
+#include <condition_variable> // std::condition_variable
+#include "priority.hpp"
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+// A blocking queue of PRIORITIES_COUNT bounded lanes (each lane holds up to a_laneCapacity items), that shares its consumers between the lanes
+// by a weighted round-robin: each round serves every non-empty lane up to its weight (more urgent lanes first), so a flood in one lane
+// never starves the other lanes, and never fills their free slots (default weights: HIGH 8, NORMAL 4, LOW 1 - large weight ratios approximate a strict priority)
+// The priority-less Enqueue variants insert to the NORMAL lane - so it can be used as a ThreadPool's QueueType
+// Concept of T: MUST be default-constructable, and move-constructable and move-assignable (or copy-constructable and copy-assignable)
+// Concept of DestructionPolicy: policy must be copy-constructable
+// The destruction policy is a FUNCTOR (implements operator() and get 1 param: PriorityBoundedQueue& obj), to be used as an instructions to know which action the queue
+// object should call on itself when it is in a destruction stage (the policies of blocking_bounded_queue_destruction_policies.hpp can be used)
+template <typename T, typename DestructionPolicy>
+class PriorityBoundedQueue
+{
+    friend DestructionPolicy;
+public:
+    using LaneWeights = std::array<size_t, PRIORITIES_COUNT>; // Indexed by Priority, every weight must be greater than 0
+
+    PriorityBoundedQueue(size_t a_laneCapacity, DestructionPolicy a_destructionPolicy, const LaneWeights& a_laneWeights = DefaultLaneWeights());
+    PriorityBoundedQueue(const PriorityBoundedQueue& a_other) = delete;
+    PriorityBoundedQueue& operator=(const PriorityBoundedQueue& a_other) = delete;
+    ~PriorityBoundedQueue();
+
+    // Returns false if the queue is closed and no further operations can be done with it
+    bool Enqueue(const T& a_item);
+    bool Enqueue(T&& a_item);
+    bool Enqueue(const T& a_item, Priority a_priority);
+    bool Enqueue(T&& a_item, Priority a_priority);
+    bool Dequeue(T& a_itemToReturnByRef); // Takes the next item by the weighted round-robin
+
+    // Non-blocking and bounded-wait variants - return false if the queue is closed, or if no free slot (item) became available
+    // The rvalue variants move from a_item ONLY if it was enqueued (so a move-only item can be retried)
+    bool TryEnqueue(const T& a_item);
+    bool TryEnqueue(T&& a_item);
+    bool TryEnqueue(T&& a_item, Priority a_priority);
+    bool EnqueueFor(const T& a_item, std::chrono::nanoseconds a_timeout);
+    bool EnqueueFor(T&& a_item, std::chrono::nanoseconds a_timeout);
+    bool EnqueueFor(T&& a_item, Priority a_priority, std::chrono::nanoseconds a_timeout);
+    bool TryDequeue(T& a_itemToReturnByRef);
+
+    size_t Size() const;
+    size_t LaneSize(Priority a_priority) const; // The depth of a single lane - shows which lane is backing up
+    size_t Capacity() const;
+    size_t LaneCapacity() const;
+    bool IsEmpty() const;
+
+    static LaneWeights DefaultLaneWeights();
+
+private:
+    static size_t LaneOf(Priority a_priority); // Throws std::invalid_argument for an unknown priority
+    template <typename Item>
+    bool EnqueueItem(Item&& a_item, Priority a_priority, std::chrono::nanoseconds a_timeout);
+    bool DequeueItem(T& a_itemToReturnByRef, std::chrono::nanoseconds a_timeout);
+    template <typename Predicate>
+    bool WaitFor(std::unique_lock<std::mutex>& a_lock, std::condition_variable& a_condition, std::chrono::nanoseconds a_timeout, Predicate a_predicate); // Counts the waiter (for a safe destruction)
+    size_t NextLane(); // Assumes that m_mutex is locked, and that some lane is not empty
+    void PopFront(size_t a_lane, T& a_itemToReturnByRef); // Assumes that m_mutex is locked, and that the lane is not empty
+
+    // For policy uses (without locking)
+    bool RemoveNext(T& a_itemToReturnByRef) noexcept; // true if succeed, else false
+    bool Empty() const noexcept;
+    size_t GetSize() const noexcept;
+
+private:
+    std::array<std::deque<T>, PRIORITIES_COUNT> m_lanes;
+    std::array<AtomicValue<size_t>, PRIORITIES_COUNT> m_laneSizes;
+    AtomicValue<size_t> m_size;
+    size_t m_laneCapacity;
+    LaneWeights m_laneWeights;
+    LaneWeights m_laneCredits; // The remained turns of each lane in the current round
+    mutable std::mutex m_mutex;
+    std::array<std::condition_variable, PRIORITIES_COUNT> m_laneNotFull;
+    std::condition_variable m_notEmpty;
+    std::condition_variable m_noWaiters;
+    size_t m_waiters; // Guarded by m_mutex
+    bool m_isClosed; // Guarded by m_mutex
+    DestructionPolicy m_destructionPolicy;
+};
+
+} // advcpp
+
+
+#include "inl/priority_bounded_queue.hxx"
+
+
+#endif // NM_PRIORITY_BOUNDED_QUEUE_HPP
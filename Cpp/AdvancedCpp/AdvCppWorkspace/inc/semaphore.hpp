@@ -3,6 +3,7 @@
 
 
 #include <cstddef> // size_t
+#include <chrono> // std::chrono::nanoseconds
 #include <semaphore.h>
 
 
@@ -28,6 +29,10 @@ public:
     void Down(); // Wait
     void Up(); // Post
     bool TryDown(); // TryWait
+    bool TimedDown(std::chrono::nanoseconds a_timeout); // TimedWait - returns false if the timeout has expired before the semaphore could be decremented
+
+private:
+    static const long NANOSECONDS_IN_SECOND = 1000000000;
 
 private:
     mutable sem_t m_semaphore;
@@ -36,4 +41,4 @@ private:
 } // advcpp
 
 
-#endif // NM_SEMAPHORE_HPP
\ No newline at end of file
+#endif // NM_SEMAPHORE_HPP
@@ -6,16 +6,27 @@
 #include <memory> // std::shared_ptr
 #include <thread> // std::thread::hardware_concurrency()
 #include <mutex> // std::mutex
+#include <chrono> // std::chrono::nanoseconds, std::chrono::steady_clock
+#include <type_traits> // std::result_of, std::decay
 #include <vector> // std::vector
+#include <pthread.h> // pthread_t
 #include "thread.hpp"
 #include "thread_destruction_policies.hpp"
 #include "thread_group.hpp"
 #include "icallable.hpp"
+#include "task.hpp"
+#include "future.hpp"
+#include "priority.hpp"
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
 #include "atomic_value.hpp"
+#include "latch.hpp"
+#include "workers_activity.hpp"
 #include "works_scheduler.hpp"
 #include "two_way_multi_sync_handler.hpp"
+#include "thread_pool_submission_policies.hpp"
+#include "thread_pool_metrics_policies.hpp"
+#include "callable_functions_adapters.hpp"
 
 
 namespace advcpp
@@ -25,42 +36,73 @@ namespace advcpp
 // The destruction policy is a FUNCTOR (implements operator() and get 1 param: Thread& obj), to be used as an instructions to know which action the Thread
 // object should call on itself when it is in a destruction stage
 // --------------------------------------------------------------------------------------------------------------------------------------------------------------------
-// Concept of QueueTypeDestructionPolicy: must be a destruction policy of the given Queue type, and must be a destruction policy of type T = std::shared_ptr<ICallable>
+// Concept of QueueTypeDestructionPolicy: must be a destruction policy of the given Queue type, and must be a destruction policy of type T = Task
 // --------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Concept of QueueType: QueueType must implement Enqueue, Dequeue, IsEmpty and Size methods (Suggestion: these methods should be multithreaded-safe!),
-// and its T MUST be std::shared_ptr of type ICallable (QueueType< T = std::shared_ptr<ICallable> >),
-// and it must implement a C'tor of: {size_t, QueueTypeDestructionPolicy<std::shared_ptr<ICallable>>}
-template <typename DestructionPolicy, typename QueueTypeDestructionPolicy = ClearPolicy<std::shared_ptr<ICallable>>, typename QueueType = BlockingBoundedQueue<std::shared_ptr<ICallable>, QueueTypeDestructionPolicy>>
+// and its T MUST be Task (QueueType< T = Task >),
+// and it must implement a C'tor of: {size_t, QueueTypeDestructionPolicy<Task>},
+// and it must implement TryEnqueue and EnqueueFor methods (to support TrySubmit and SubmitFor),
+// and its Enqueue, TryEnqueue and EnqueueFor methods must accept a moved (rvalue) Task - Task is move-only
+// (BlockingBoundedQueue, LockFreeBoundedQueue and PriorityBoundedQueue satisfy this concept),
+// and to support the prioritized SubmitWork and PendingWorksCount - it must implement Enqueue(Task&&, Priority) and LaneSize(Priority) (PriorityBoundedQueue)
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Concept of SubmissionPolicy: see thread_pool_submission_policies.hpp (DirectSubmissionPolicy - enqueues from the caller's thread [default],
+// AsyncSubmissionPolicy - enqueues from a new detached thread per submitted work, WorkStealingPolicy - per-worker deques with stealing)
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Concept of MetricsPolicy: see thread_pool_metrics_policies.hpp (NoMetricsPolicy - collects nothing, at no cost [default],
+// HdrMetricsPolicy - counters and latency histograms, dumped by Snapshot)
+template <typename DestructionPolicy, typename QueueTypeDestructionPolicy = ClearPolicy<Task>, typename QueueType = BlockingBoundedQueue<Task, QueueTypeDestructionPolicy>, typename SubmissionPolicy = DirectSubmissionPolicy<QueueTypeDestructionPolicy, QueueType>, typename MetricsPolicy = NoMetricsPolicy>
 class ThreadPool
 {
     friend DestructionPolicy;
 public:
-    using Work = std::shared_ptr<ICallable>;
+    using Work = Task; // Held by value in the works queue - a plain lambda or functor can be submitted as a work (see task.hpp)
 
     ThreadPool(DestructionPolicy a_destructionPolicy, size_t a_worksQueueSize, size_t a_workersNumber = std::thread::hardware_concurrency());
     ThreadPool(const ThreadPool& a_other) = delete;
     ThreadPool& operator=(const ThreadPool& a_other) = delete;
     ~ThreadPool();
 
+    // Both are serialized with each other and with the workers stopping of a shutdown - throw std::runtime_error once the pool has stopped
     void AddWorkers(size_t a_workers);
     void RemoveWorkers(size_t a_workers);
 
-    void SubmitWork(Work a_work);
-
-    void Shutdown(); // Executes all pending works, but user cannot add new works
+    void SubmitWork(Work a_work); // Inserts the work according to the SubmissionPolicy
+    bool TrySubmit(Work&& a_work); // Never blocks - returns false (a_work is not moved) if the works queue is full
+    bool SubmitFor(Work&& a_work, std::chrono::nanoseconds a_timeout); // Returns false (a_work is not moved) if the works queue stayed full until the timeout has expired
+    void SubmitWork(Work a_work, Priority a_priority); // Inserts the work directly to the a_priority lane of the shared works queue (bypasses the SubmissionPolicy)
+    bool TrySubmit(Work&& a_work, Priority a_priority); // Like SubmitWork(Work, Priority), but never blocks - returns false (a_work is not moved) if the a_priority lane is full
+
+    // Inserts a_func as a work (like SubmitWork), and returns a future of its result - Future<R> (Future<U> if R is Future<U>)
+    // Continuations that are attached to the returned future (see Future::Then) run on the worker that completes it
+    // Concept of Func: Func must be move-constructable (or copy-constructable), and must be callable as R(void)
+    template <typename Func>
+    Future<typename future_details::UnwrappedResult<typename std::result_of<typename std::decay<Func>::type()>::type>::type> Submit(Func&& a_func);
+
+    // Backward compatibility - a shared ICallable work is wrapped by ICallableToTaskAdapter
+    void SubmitWork(std::shared_ptr<ICallable> a_work);
+    bool TrySubmit(std::shared_ptr<ICallable> a_work);
+    bool SubmitFor(std::shared_ptr<ICallable> a_work, std::chrono::nanoseconds a_timeout);
+
+    void Shutdown(); // Executes all pending works, but user cannot add new works (blocks without polling until the last submitted work has completed)
+    size_t Shutdown(std::chrono::steady_clock::time_point a_deadline); // Like Shutdown, but stops waiting for the pending works at a_deadline - returns how many works were left pending (never executed)
     void ShutdownImmediate(); // Does not accept new works, does not execute any pending work, but complete works that were already started
 
     size_t WorkersCount();
-    size_t PendingWorksCount() const;
+    size_t PendingWorksCount() const; // The submitted works that have not started yet (queued, or still being enqueued)
+    size_t PendingWorksCount(Priority a_priority) const; // The depth of a single lane of the works queue
+    size_t BusyWorkersCount() const; // The workers that execute a work right now
+    size_t CompletedWorksCount() const; // Since the pool was created - sample it twice to get a throughput
+    ThreadPoolMetricsSnapshot Snapshot(); // The workers and pending works, and whatever the MetricsPolicy collects - e.g. for a periodic log line
 
 private:
-    void InsertWorkToQueueAsync(Work a_workToInsert);
-    bool HasDoneEnqueueAllWorksAsync() const;
     void Stop();
     bool HasStopped() const;
-    void SoftShutdown();
-    void ForceShutdown();
-    void StopWorkers(size_t a_workersToStop);
+    void CountUpInFlightWork(); // Throws std::runtime_error (without counting up) if the pool has stopped
+    template <typename Enqueue>
+    bool EnqueueWork(Work& a_work, Enqueue a_enqueue); // Counts and instruments a_work around a_enqueue (bool(Work&)) - a_work is given back if it was not enqueued
+    void StopAllWorkers();
+    std::vector<pthread_t> StopWorkers(size_t a_workersToStop); // Cooperative - a stopped worker completes its current work, then accepts the stop notification and returns (returns the stopped workers)
 
     // For policy uses:
     void ConditionalShutdown() noexcept;
@@ -70,9 +112,12 @@ private: // Order is important!
     std::shared_ptr<QueueType> m_worksQueue;
     std::shared_ptr<TwoWayMultiSyncHandler> m_twoWayMultiSyncHandler;
     std::shared_ptr<std::mutex> m_workersLock;
-    Work m_mainWorksScheduler;
-    ThreadGroup<CancelPolicy> m_workers;
-    std::vector<std::shared_ptr<Thread<DetachPolicy>>> m_enqueueWorkThreads;
+    std::shared_ptr<Latch> m_inFlightWorks; // Submitted works that have not completed yet (counted up on submission, counted down by the workers)
+    std::shared_ptr<WorkersActivity> m_workersActivity;
+    SubmissionPolicy m_submissionPolicy;
+    MetricsPolicy m_metricsPolicy;
+    std::shared_ptr<ICallable> m_mainWorksScheduler;
+    ThreadGroup<JoinPolicy> m_workers; // The workers always stop cooperatively - never canceled
     std::mutex m_operationsLock;
     AtomicFlag m_isStopRequired;
     DestructionPolicy m_destructionPolicy;
@@ -0,0 +1,110 @@
+#ifndef NM_THREAD_POOL_AUTOSCALER_HPP
+#define NM_THREAD_POOL_AUTOSCALER_HPP
+
+
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr
+#include <mutex> // std::mutex
+#include <condition_variable> // std::condition_variable
+#include <chrono> // std::chrono::nanoseconds, std::chrono::steady_clock
+#include "icallable.hpp"
+#include "thread.hpp"
+#include "thread_destruction_policies.hpp"
+#include "thread_budget.hpp"
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+struct AutoscalerConfig
+{
+    AutoscalerConfig(); // 1 to std::thread::hardware_concurrency() workers, sampled every 100ms
+
+    size_t m_minWorkers;
+    size_t m_maxWorkers;
+    std::chrono::nanoseconds m_sampleInterval;
+    std::chrono::nanoseconds m_maxQueueWait; // Grow while the estimated queue wait is longer
+    double m_growBusyRatio; // Grow while pending works wait and at least this part of the workers is busy
+    double m_shrinkBusyRatio; // Shrink while no work is pending and at most this part of the workers is busy
+    size_t m_samplesToGrow; // Hysteresis - the consecutive samples that must agree before a worker is added
+    size_t m_samplesToShrink; // Hysteresis - the consecutive samples that must agree before a worker is removed
+};
+
+
+// The decisions of an autoscaler so far, and the measurements of its last sample
+struct AutoscalerStats
+{
+    size_t m_workers;
+    size_t m_samples;
+    size_t m_grows;
+    size_t m_shrinks;
+    size_t m_deniedGrows; // Grows that were denied by the thread budget
+    double m_busyRatio;
+    std::chrono::nanoseconds m_queueWait; // Estimated by Little's law: the pending works divided by the throughput since the previous sample
+};
+
+
+// Grows and shrinks the workers of a ThreadPool (one worker at a time, between the configured min and max) by sampling its queue wait and busy ratio
+// on a sampling thread of its own. Every worker of the pool is acquired from a_budget - several autoscalers that share a budget never run more workers together than its capacity
+// The pool must outlive the autoscaler - Stop it (or destroy it) before the pool shuts down
+// Concept of Pool: Pool must implement AddWorkers, RemoveWorkers, WorkersCount, PendingWorksCount, BusyWorkersCount and CompletedWorksCount (ThreadPool)
+template <typename Pool>
+class ThreadPoolAutoscaler
+{
+public:
+    // Resizes the pool into [min, max] - throws std::runtime_error if the config is invalid or if a_budget has not enough threads for the initial workers
+    // A null a_budget means a private budget of m_maxWorkers threads
+    ThreadPoolAutoscaler(Pool& a_pool, const AutoscalerConfig& a_config, std::shared_ptr<ThreadBudget> a_budget = std::shared_ptr<ThreadBudget>());
+    ThreadPoolAutoscaler(const ThreadPoolAutoscaler& a_other) = delete;
+    ThreadPoolAutoscaler& operator=(const ThreadPoolAutoscaler& a_other) = delete;
+    ~ThreadPoolAutoscaler(); // Stops the sampling and releases the acquired threads back to the budget
+
+    void Sample(); // A single sampling and scaling step - the sampling thread calls it every m_sampleInterval
+    void Stop(); // Stops the sampling thread, the workers are left as they are
+    AutoscalerStats Stats() const;
+
+private:
+    class SamplingLoop : public ICallable
+    {
+    public:
+        explicit SamplingLoop(ThreadPoolAutoscaler* a_autoscaler) : m_autoscaler(a_autoscaler) {}
+
+        virtual void operator()() override;
+
+    private:
+        ThreadPoolAutoscaler* m_autoscaler;
+    };
+
+    size_t ResizeIntoRange(); // Validates the config and resizes the pool into [min, max] - returns the threads that were acquired from the budget
+    void RunSampling();
+    void Grow(size_t a_workers); // Assumes that m_sampleLock is locked
+    void Shrink(size_t a_workers); // Assumes that m_sampleLock is locked
+    static std::chrono::nanoseconds EstimateQueueWait(size_t a_pendingWorks, size_t a_completedWorks, std::chrono::nanoseconds a_elapsed);
+
+private: // Order is important!
+    Pool& m_pool;
+    AutoscalerConfig m_config;
+    std::shared_ptr<ThreadBudget> m_budget;
+    size_t m_acquiredThreads;
+    size_t m_growVotes;
+    size_t m_shrinkVotes;
+    size_t m_lastCompletedWorks;
+    std::chrono::steady_clock::time_point m_lastSampleTime;
+    bool m_hasPoolStopped;
+    AutoscalerStats m_stats;
+    mutable std::mutex m_sampleLock;
+    std::mutex m_stopLock;
+    std::condition_variable m_stopCondition;
+    bool m_isStopRequired; // Guarded by m_stopLock
+    AtomicFlag m_hasStopped;
+    Thread<JoinPolicy> m_samplingThread;
+};
+
+} // advcpp
+
+
+#include "inl/thread_pool_autoscaler.hxx"
+
+
+#endif // NM_THREAD_POOL_AUTOSCALER_HPP
@@ -3,6 +3,9 @@
 
 
 #include <cstddef> // size_t
+#include <vector> // std::vector
+#include <mutex> // std::mutex
+#include <pthread.h> // pthread_t
 #include "atomic_value.hpp"
 #include "barrier.hpp"
 
@@ -25,14 +28,17 @@ public:
     void ResetAllNotifications();
 
     // Second direction:
-    void OneNotificationAccept();
+    void OneNotificationAccept(); // Records the calling thread - see TakeAcceptingThreads
     void SignalBack();
     bool WaitForAllSignalsBack(); // Blocking wait, without polling
     void SetWantedSignalsBack(size_t a_signalsToWaitFor);
+    std::vector<pthread_t> TakeAcceptingThreads(); // The threads that have accepted a notification since the previous call (e.g. to join exactly them)
 
 private:
     AtomicValue<size_t> m_firstDirectionNotifications;
     Barrier m_secondDirectionSignals;
+    std::mutex m_acceptingThreadsLock;
+    std::vector<pthread_t> m_acceptingThreads;
 };
 
 } // advcpp
@@ -0,0 +1,75 @@
+#ifndef NM_WORK_STEALING_REGISTRY_HPP
+#define NM_WORK_STEALING_REGISTRY_HPP
+
+
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr
+#include <vector> // std::vector
+#include <mutex> // std::mutex
+#include <random> // std::minstd_rand
+#include "task.hpp"
+#include "work_stealing_deque.hpp"
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+// Holds the local works deques of a work-stealing ThreadPool's workers (one deque per running worker)
+// A worker registers itself when it starts (adopting a deque that was left by a removed worker, if any), so works submitted from its thread
+// are pushed to its own deque. The deques of removed workers stay stealable until they are adopted.
+class WorkStealingRegistry
+{
+public:
+    using Work = Task;
+    using WorksDeque = WorkStealingDeque<Work>;
+
+    explicit WorkStealingRegistry(size_t a_dequeCapacity = DEFAULT_DEQUE_CAPACITY);
+    WorkStealingRegistry(const WorkStealingRegistry& a_other) = delete;
+    WorkStealingRegistry& operator=(const WorkStealingRegistry& a_other) = delete;
+    ~WorkStealingRegistry() = default;
+
+    // Worker side:
+    std::shared_ptr<WorksDeque> Register(); // Binds the calling thread to a deque of this registry
+    void Unregister(); // Releases the calling thread's deque (its remained works can still be stolen)
+    bool Steal(Work& a_stolenWork, std::minstd_rand& a_randomGenerator); // Tries the other deques, starting from a random victim
+
+    void EnterIdle();
+    void ExitIdle();
+    size_t IdleWorkersCount() const;
+
+    // Submitter side:
+    bool PushLocal(Work&& a_work); // Returns false (a_work is not moved) if the calling thread is not a worker of this registry, or its deque is full
+
+    size_t PendingWorksCount() const; // Works that are held in all the deques
+    size_t StolenWorksCount() const; // Since the registry was created
+
+private:
+    struct WorkerDeque
+    {
+        explicit WorkerDeque(size_t a_capacity) : m_works(new WorksDeque(a_capacity)), m_hasOwner(true) {}
+
+        std::shared_ptr<WorksDeque> m_works;
+        bool m_hasOwner; // Guarded by m_registrationLock
+    };
+    using WorkerDeques = std::vector<std::shared_ptr<WorkerDeque>>;
+
+    std::shared_ptr<const WorkerDeques> Snapshot() const;
+
+private:
+    static const size_t DEFAULT_DEQUE_CAPACITY = 1024;
+    static thread_local WorkStealingRegistry* s_currentRegistry;
+    static thread_local WorksDeque* s_currentDeque;
+
+private:
+    size_t m_dequeCapacity;
+    std::shared_ptr<const WorkerDeques> m_deques; // Copy-on-write - replaced (under m_registrationLock) only when a new deque is created
+    std::mutex m_registrationLock;
+    AtomicValue<size_t> m_idleWorkers;
+    AtomicValue<size_t> m_stolenWorks;
+};
+
+} // advcpp
+
+
+#endif // NM_WORK_STEALING_REGISTRY_HPP
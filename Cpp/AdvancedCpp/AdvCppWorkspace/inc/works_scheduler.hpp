@@ -5,24 +5,27 @@
 #include <memory> // std::shared_ptr
 #include <mutex> // std::mutex
 #include "icallable.hpp"
+#include "task.hpp"
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
 #include "two_way_multi_sync_handler.hpp"
+#include "latch.hpp"
+#include "workers_activity.hpp"
 
 
 namespace advcpp
 {
 
-// Concept of QueueTypeDestructionPolicy: must be a destruction policy of the given Queue type, and must be a destruction policy of type T = std::shared_ptr<ICallable>
+// Concept of QueueTypeDestructionPolicy: must be a destruction policy of the given Queue type, and must be a destruction policy of type T = Task
 // --------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Concept of QueueType: QueueType must implement Enqueue, Dequeue, IsEmpty and Size methods (Suggestion: these methods should be multithreaded-safe!),
-// and its T MUST be std::shared_ptr of type ICallable (QueueType< T = std::shared_ptr<ICallable> >),
-// and it must implement a C'tor of: {size_t, QueueTypeDestructionPolicy<std::shared_ptr<ICallable>>}
-template <typename QueueTypeDestructionPolicy = ClearPolicy<std::shared_ptr<ICallable>>, typename QueueType = BlockingBoundedQueue<std::shared_ptr<ICallable>, QueueTypeDestructionPolicy>>
+// and its T MUST be Task (QueueType< T = Task >),
+// and it must implement a C'tor of: {size_t, QueueTypeDestructionPolicy<Task>}
+template <typename QueueTypeDestructionPolicy = ClearPolicy<Task>, typename QueueType = BlockingBoundedQueue<Task, QueueTypeDestructionPolicy>>
 class WorksScheduler : public ICallable
 {
 public:
-    WorksScheduler(std::shared_ptr<QueueType> a_worksQueue, std::shared_ptr<TwoWayMultiSyncHandler> a_twoWayMultiSyncHandler, std::shared_ptr<std::mutex> a_workersLock);
+    WorksScheduler(std::shared_ptr<QueueType> a_worksQueue, std::shared_ptr<TwoWayMultiSyncHandler> a_twoWayMultiSyncHandler, std::shared_ptr<std::mutex> a_workersLock, std::shared_ptr<Latch> a_inFlightWorks, std::shared_ptr<WorkersActivity> a_workersActivity);
     WorksScheduler(const WorksScheduler& a_other) = delete;
     WorksScheduler& operator=(const WorksScheduler& a_other) = delete;
     ~WorksScheduler() = default;
@@ -30,12 +33,14 @@ public:
     virtual void operator()() override;
 
 private:
-    void SafeExecute(std::shared_ptr<ICallable> a_work) const;
+    void SafeExecute(Task& a_work) const; // Wake up works are empty - they are neither executed nor counted down
 
 private:
     std::shared_ptr<QueueType> m_worksQueue;
     std::shared_ptr<TwoWayMultiSyncHandler> m_twoWayMultiSyncHandler;
     std::shared_ptr<std::mutex> m_workersLock;
+    std::shared_ptr<Latch> m_inFlightWorks; // Counts down once per executed work (the pool counts up once per submitted work)
+    std::shared_ptr<WorkersActivity> m_workersActivity;
 };
 
 } // advcpp
@@ -44,4 +49,4 @@ private:
 #include "inl/works_scheduler.hxx"
 
 
-#endif // NM_SCHEDULING_WORK_HPP
\ No newline at end of file
+#endif // NM_SCHEDULING_WORK_HPP
@@ -3,6 +3,8 @@
 
 
 #include <memory> // std::shared_ptr
+#include <vector> // std::vector
+#include <utility> // std::pair
 #include "software_agent.hpp"
 #include "location.hpp"
 #include "idecoder.hpp"
@@ -21,8 +23,8 @@ class BidirectionsControllerAgent : public SoftwareAgent, public ISubscriber, pu
 {
     BidirectionsControllerAgent(std::shared_ptr<IEncoder> a_encoder, std::shared_ptr<IDecoder> a_decoder, const std::string& a_configurations, std::shared_ptr<ILogger> a_logger, const std::string& a_remoteDeviceID, const Location& a_location);
 
-    virtual void Notify(Event a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue) override;
-    virtual void Publish(infra::TCPSocket::BytesBufferProxy a_bytesBuffer, std::shared_ptr<advcpp::BlockingBoundedQueue<Event, advcpp::NoOperationPolicy<Event>>> a_publishedEventsQueue) override;
+    virtual void Notify(Event a_event, std::vector<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>& a_handledBuffers) override;
+    virtual bool Publish(infra::TCPSocket::BytesBufferProxy a_bytesBuffer, std::shared_ptr<advcpp::BlockingBoundedQueue<Event, advcpp::NoOperationPolicy<Event>>> a_publishedEventsQueue) override;
 
 private:
     // Note: cannot aggregate or composit a controller agent and a sensor agent, because of the use of the inner ID of the controller agent's base class to reach to the related socket in the table
@@ -11,6 +11,8 @@ namespace advcpp
 // Policies to be triggered when a BlockingBoundedQueue is destructed.
 // All the Policies MUST NOT throw exceptions (must be nothrow (noexcept))!
 // Policies that wants to remove single item or check conditions, should only use private method (Policies declaired as friends of BlockingBoundedQueue)
+// Each policy can be used by any queue type that exposes the same private policy-use methods (RemoveNext, Empty, GetSize), e.g. LockFreeBoundedQueue
+// Concept of QueueType: QueueType<T, ThePolicy> (BlockingBoundedQueue, LockFreeBoundedQueue or PriorityBoundedQueue)
 
 
 // AssertPolicy: Asserts that the queue is empty on a destruction
@@ -19,7 +21,8 @@ template<typename T>
 class AssertPolicy
 {
 public:
-    void operator()(BlockingBoundedQueue<T,AssertPolicy<T>>& a_queue) noexcept;
+    template <typename QueueType>
+    void operator()(QueueType& a_queue) noexcept;
 };
 
 
@@ -29,7 +32,8 @@ template<typename T>
 class NoOperationPolicy
 {
 public:
-    void operator()(BlockingBoundedQueue<T,NoOperationPolicy<T>>& a_queue) noexcept;
+    template <typename QueueType>
+    void operator()(QueueType& a_queue) noexcept;
 };
 
 
@@ -39,7 +43,8 @@ template<typename T>
 class ClearPolicy
 {
 public:
-    void operator()(BlockingBoundedQueue<T,ClearPolicy<T>>& a_queue) noexcept;
+    template <typename QueueType>
+    void operator()(QueueType& a_queue) noexcept;
 };
 
 
@@ -53,7 +58,8 @@ class SavePolicy
 public:
     SavePolicy(std::shared_ptr<C> a_containerPtr) : m_containerPtr(a_containerPtr) {}
 
-    void operator()(BlockingBoundedQueue<T,SavePolicy<T,C>>& a_queue) noexcept;
+    template <typename QueueType>
+    void operator()(QueueType& a_queue) noexcept;
 
 private:
     std::shared_ptr<C> m_containerPtr;
@@ -69,7 +75,8 @@ class CallbackPolicy
 public:
     CallbackPolicy(Func a_func) : m_func(a_func) {}
 
-    void operator()(BlockingBoundedQueue<T,CallbackPolicy<T,Func>>& a_queue) noexcept;
+    template <typename QueueType>
+    void operator()(QueueType& a_queue) noexcept;
 
 private:
     Func m_func;
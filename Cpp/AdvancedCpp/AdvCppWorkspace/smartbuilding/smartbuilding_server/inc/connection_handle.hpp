@@ -0,0 +1,21 @@
+#ifndef NM_CONNECTION_HANDLE_HPP
+#define NM_CONNECTION_HANDLE_HPP
+
+
+#include <stdint.h> // uint64_t
+
+
+namespace smartbuilding
+{
+
+// A compact handle of a connected remote device, assigned by RemoteDevicesSocketsManager when the device connects - the sending path finds
+// the device's socket by it (an index into a flat slots array), instead of hashing the device's ID for every outgoing buffer
+// [The slot's index in the low 32 bits, the slot's generation in the high 32 bits - a handle of a disconnected device never reaches the device that reuses its slot]
+using ConnectionHandle = uint64_t;
+
+const ConnectionHandle INVALID_CONNECTION_HANDLE = ~static_cast<ConnectionHandle>(0); // A device that is not connected
+
+} // smartbuilding
+
+
+#endif // NM_CONNECTION_HANDLE_HPP
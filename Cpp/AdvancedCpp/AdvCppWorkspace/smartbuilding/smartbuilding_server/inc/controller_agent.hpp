@@ -3,6 +3,8 @@
 
 
 #include <memory> // std::shared_ptr
+#include <vector> // std::vector
+#include <utility> // std::pair
 #include "software_agent.hpp"
 #include "location.hpp"
 #include "event.hpp"
@@ -22,7 +24,7 @@ class ControllerAgent : public SoftwareAgent, public ISubscriber
 public:
     ControllerAgent(std::shared_ptr<IEncoder> a_encoder, const std::string& a_configurations, std::shared_ptr<ILogger> a_logger, const std::string& a_remoteDeviceID, const Location& a_location);
 
-    virtual void Notify(Event a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue) override;
+    virtual void Notify(Event a_event, std::vector<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>& a_handledBuffers) override;
 
 private:
     std::shared_ptr<IEncoder> m_encoder;
@@ -0,0 +1,69 @@
+#ifndef NM_ENCODING_CACHE_HPP
+#define NM_ENCODING_CACHE_HPP
+
+
+#include <cstddef> // size_t
+#include <atomic> // std::atomic
+#include <mutex> // std::mutex
+#include <unordered_map> // std::unordered_map
+#include "tcp_socket.hpp"
+#include "event.hpp"
+#include "iencoder.hpp"
+
+
+namespace smartbuilding
+{
+
+// The encoded buffers of a single event, keyed by the encoders' IEncoder::SharingKey - lives for the event's fan-out only,
+// so the event is encoded once per sharing key, and the reference counted buffer is shared by all its recipients
+// The dispatcher installs the event's cache on the invoker's thread (by a Scope) while a batch of subscribers is notified,
+// and the agents encode through EncodingCache::Encode [Thread safety: shared by the invokers of all the event's batches]
+class EncodingCache
+{
+public:
+    struct Statistics // Process-wide, since the process has started
+    {
+        size_t m_hitsCount;
+        size_t m_missesCount;
+    };
+
+    // Makes a cache the current cache of the calling thread, until the scope ends
+    class Scope
+    {
+    public:
+        explicit Scope(EncodingCache& a_cache);
+        Scope(const Scope& a_other) = delete;
+        Scope& operator=(const Scope& a_other) = delete;
+        ~Scope();
+
+    private:
+        EncodingCache* m_previousCache;
+    };
+
+    explicit EncodingCache(Event::EventID a_eventID);
+    EncodingCache(const EncodingCache& a_other) = delete;
+    EncodingCache& operator=(const EncodingCache& a_other) = delete;
+    ~EncodingCache() = default;
+
+    // Encodes a_event by a_encoder - through the calling thread's current cache if it is a_event's cache, else directly (not counted), throws what Encode throws
+    static infra::TCPSocket::BytesBufferProxy Encode(IEncoder& a_encoder, const Event& a_event);
+    static Statistics ProcessStatistics();
+
+private:
+    infra::TCPSocket::BytesBufferProxy FindOrEncode(IEncoder& a_encoder, const Event& a_event);
+
+private:
+    static thread_local EncodingCache* s_currentCache;
+    static std::atomic<size_t> s_hitsCount;
+    static std::atomic<size_t> s_missesCount;
+
+private:
+    Event::EventID m_eventID;
+    std::mutex m_lock;
+    std::unordered_map<const void*, infra::TCPSocket::BytesBufferProxy> m_encodedBuffers; // By IEncoder::SharingKey
+};
+
+} // smartbuilding
+
+
+#endif // NM_ENCODING_CACHE_HPP
@@ -3,14 +3,19 @@
 
 
 #include <cstddef> // size_t
-#include <memory> // std::shared_ptr
-#include <list> // std::list
+#include <stdint.h> // uint64_t
+#include <memory> // std::shared_ptr, std::atomic_load, std::atomic_store
+#include <vector> // std::vector
+#include <deque> // std::deque
 #include <unordered_map> // std::unordered_map
 #include <set> // std::set
+#include <mutex> // std::mutex
+#include <utility> // std::move
 #include "isubscriber.hpp"
 #include "isubscribable.hpp"
 #include "subscription_location.hpp"
 #include "event.hpp"
+#include "location.hpp"
 
 
 namespace smartbuilding
@@ -20,12 +25,18 @@ namespace smartbuilding
 // Used as the internal Smart Building System's controllers database
 // This DB is initialized completely at initialization part of the system, and should not be modified at the runtime
 // Note: each pre-configured EventType (through the config file) - would be added to the DB as a key, so the system should be as extensible as possible
+// Multithreaded safe (read-copy-update) - the routing workers fetch the subscribers from an immutable snapshot of the subscriptions table (loaded atomically), without
+// any lock that is shared with the writers, while a subscribe / unsubscribe (through the hub's requests workers) copies the event type's index, updates it and publishes
+// a new snapshot - a snapshot is released when its last reader has finished with it
+// Note 2: the subscriptions of each event type are indexed by their location (all floors and all rooms / a room on all floors / a floor on all rooms / a room on a floor),
+// so fetching the subscribers of an event visits only the four buckets of its location - O(matching subscribers), and not O(subscribers of the event type)
+// Note 3: the fetched subscribers of each (event type, floor, room) are cached by the event type's snapshot - so a subscribe / unsubscribe of that event type starts a new cache
 class EventsSubscriptionOrganizer : public ISubscribable
 {
 public:
     using SubscribersContainer = std::set<std::shared_ptr<ISubscriber>>;
 
-    EventsSubscriptionOrganizer() = default;
+    EventsSubscriptionOrganizer();
     EventsSubscriptionOrganizer(const EventsSubscriptionOrganizer& a_other) = delete;
     EventsSubscriptionOrganizer& operator=(const EventsSubscriptionOrganizer& a_other) = delete;
     ~EventsSubscriptionOrganizer() = default;
@@ -38,16 +49,42 @@ public:
     bool FetchRelevantSubscribers(const Event::EventType& a_type, const Event::EventLocation& a_location, SubscribersContainer& a_relevantSubscribersContainer) noexcept;
 
 private:
-    using SubscribersToIntrestedLocationsPair = std::pair<std::shared_ptr<ISubscriber>, SubscriptionLocation>;
+    using LocationKey = uint64_t; // The floor in the high 32 bits, the room in the low 32 bits
+    using SubscribersBucket = std::vector<std::shared_ptr<ISubscriber>>; // A subscriber is in a bucket once per subscription
+
+    struct EventTypeIndex
+    {
+        std::unordered_map<std::shared_ptr<ISubscriber>, std::deque<SubscriptionLocation>> m_subscriptions; // The subscriptions' locations of each subscriber (in order) - to unindex them on unsubscribe
+        SubscribersBucket m_allFloorsAllRooms;
+        std::unordered_map<Location::RoomNumber, SubscribersBucket> m_allFloorsByRoom;
+        std::unordered_map<Location::FloorNumber, SubscribersBucket> m_allRoomsByFloor;
+        std::unordered_map<LocationKey, SubscribersBucket> m_byFloorAndRoom;
+    };
+
+    // An immutable version of an event type's index - shared by all the snapshots of the table until the event type is modified
+    struct EventTypeSnapshot
+    {
+        explicit EventTypeSnapshot(EventTypeIndex&& a_index) : m_index(std::move(a_index)), m_cacheLock(), m_resolvedSubscribersCache() {}
+
+        const EventTypeIndex m_index;
+        mutable std::mutex m_cacheLock; // Guards only the cache (held by the readers for a lookup / an insertion of a pointer)
+        mutable std::unordered_map<LocationKey, std::shared_ptr<const SubscribersContainer>> m_resolvedSubscribersCache;
+    };
+
+    using SubscriptionsTable = std::unordered_map<Event::EventType, std::shared_ptr<const EventTypeSnapshot>>;
+
+private:
+    static LocationKey ToLocationKey(Location::FloorNumber a_floor, Location::RoomNumber a_room) { return (static_cast<LocationKey>(a_floor) << 32) | a_room; }
+    std::vector<SubscribersBucket*> FindBucketsOf(EventTypeIndex& a_index, const SubscriptionLocation& a_location) const; // Creates the missing buckets
+    void ResolveSubscribers(const EventTypeIndex& a_index, const Event::EventLocation& a_location, SubscribersContainer& a_resolvedSubscribers) const;
+    void PublishEventType(const Event::EventType& a_type, EventTypeIndex&& a_index); // Must be called under m_writersLock
 
 private:
-    void CreateEventEntry(const Event::EventType& a_type);
-    void RemoveSubscriberFromEventList(std::list<SubscribersToIntrestedLocationsPair>& a_list, std::shared_ptr<ISubscriber> a_toRemove);
-    bool IsIntrestedLocationBySubscriber(const Event::EventLocation& a_eventLocation, const SubscriptionLocation& a_intrestedLocation) const noexcept;
-    bool HasNumberSpecified(const std::vector<unsigned int>& a_allNumber, unsigned int a_number) const noexcept;
+    static const size_t MAX_CACHED_LOCATIONS_PER_EVENT_TYPE = 4096; // Bounds the cache if the events arrive from (too) many locations
 
 private:
-    std::unordered_map<Event::EventType, std::list<SubscribersToIntrestedLocationsPair>> m_eventsSubscribersTable;
+    std::shared_ptr<const SubscriptionsTable> m_eventsSubscribersTable; // The current snapshot - accessed only by std::atomic_load / std::atomic_store
+    std::mutex m_writersLock; // Serializes the writers only (a read-copy-update of a writer must not lose a concurrent update)
 };
 
 } // smartbuilding
@@ -2,33 +2,116 @@
 #define NM_FILE_LOGGER_HPP
 
 
+#include <cstddef> // size_t
 #include <string> // std::string
 #include <vector> // std::vector
+#include <chrono> // std::chrono::milliseconds, std::chrono::nanoseconds
+#include <atomic> // std::atomic
+#include <mutex> // std::mutex
+#include <condition_variable> // std::condition_variable
 #include "ilogger.hpp"
+#include "icallable.hpp"
+#include "lock_free_bounded_queue.hpp"
+#include "blocking_bounded_queue_destruction_policies.hpp"
+#include "thread.hpp"
+#include "thread_destruction_policies.hpp"
 
 
 namespace smartbuilding
 {
 
+// What Log does when the staging buffer is full (the writer is behind the producers)
+enum LogOverflowPolicy
+{
+    DROP_RECORDS, // The record is dropped (counted by DroppedRecordsCount)
+    BLOCK_PRODUCERS, // The producer waits for a free slot - no record is lost, but a producer might wait for the disk
+    COUNT_DROPPED_RECORDS // Like DROP_RECORDS, and the writer appends a warning record with the count of the records that were dropped since the previous one
+};
+
+
+struct FileLoggerConfig
+{
+    FileLoggerConfig(); // 4096 staged records, written every 100ms or every 256 staged records, COUNT_DROPPED_RECORDS
+
+    size_t m_stagingCapacity; // Records (rounded up to a power of 2)
+    std::chrono::milliseconds m_flushInterval; // The longest time that a record waits in the staging buffer
+    size_t m_flushBatchSize; // The writer is woken up earlier when this amount of records is staged
+    LogOverflowPolicy m_overflowPolicy;
+};
+
+
+// An asynchronous file logger - Log formats the record on the caller's thread, and stages it in a lock-free ring buffer (without waiting for the disk),
+// and a single writing thread appends the staged records to the file in batches (a single write per batch) [Thread safety: Log and Flush can be called from any thread]
+// The file is opened once, in append mode
 class FileLogger : public ILogger
 {
 public:
-    explicit FileLogger(const std::string& a_logFileName);
-    FileLogger(const FileLogger& a_other) = default;
-    FileLogger& operator=(const FileLogger& a_other) = default;
-    ~FileLogger() = default;
+    // Throws std::runtime_error if the file cannot be opened, or if the config is invalid (0 staging capacity / batch size)
+    explicit FileLogger(const std::string& a_logFileName, const FileLoggerConfig& a_config = FileLoggerConfig());
+    FileLogger(const FileLogger& a_other) = delete;
+    FileLogger& operator=(const FileLogger& a_other) = delete;
+    ~FileLogger(); // Writes all the staged records, then closes the file
 
     virtual void Log(const std::string& a_message, LogLevel a_logLevel) override; // Throws if LogLevel is not valid
 
-private:
-    std::string MapLogLevelToString(LogLevel a_logLevel) const;
+    // Waits until the records that were staged before the call are written - returns false if a_timeout has expired first (e.g. a stuck disk on shutdown)
+    bool Flush(std::chrono::nanoseconds a_timeout = std::chrono::seconds(1));
+    size_t DroppedRecordsCount() const { return m_droppedRecordsCount.load(std::memory_order_relaxed); }
 
 private:
+    static const size_t RECORD_PREFIX_CAPACITY = 48; // The timestamp and the log level
+
+    class WritingLoop : public advcpp::ICallable
+    {
+    public:
+        explicit WritingLoop(FileLogger* a_logger) : m_logger(a_logger) {}
+
+        virtual void operator()() override;
+
+    private:
+        FileLogger* m_logger;
+    };
+
+    // The opened log file - closed by its destruction, so it does not leak if the construction of a later member throws
+    class LogFile
+    {
+    public:
+        explicit LogFile(const std::string& a_logFileName); // Throws std::runtime_error if the file cannot be opened
+        LogFile(const LogFile& a_other) = delete;
+        LogFile& operator=(const LogFile& a_other) = delete;
+        ~LogFile();
+
+        int ID() const { return m_fileID; }
+
+    private:
+        int m_fileID;
+    };
+
+    const std::string& MapLogLevelToString(LogLevel a_logLevel) const;
+    static const FileLoggerConfig& ValidateConfig(const FileLoggerConfig& a_config);
+    void RunWriting();
+    void WriteStagedRecords(); // Called only by the writing thread
+    void WriteAll(const std::string& a_bytes);
+
+private: // Order is important!
     std::vector<std::string> m_logLevelToStringMap;
     std::string m_logFileName;
+    FileLoggerConfig m_config;
+    LogFile m_file;
+    advcpp::LockFreeBoundedQueue<std::string, advcpp::NoOperationPolicy<std::string>> m_stagedRecords;
+    std::atomic<size_t> m_stagedRecordsCount; // Since the logger was created - counted before a record is staged, so it is never behind m_writtenRecordsCount
+    std::atomic<size_t> m_writtenRecordsCount; // Since the logger was created
+    std::atomic<size_t> m_droppedRecordsCount;
+    size_t m_reportedDroppedRecordsCount; // Used only by the writing thread
+    std::string m_batch; // Used only by the writing thread
+    std::mutex m_writingLock;
+    std::condition_variable m_writingCondition; // Wakes up the writer (stop / flush / a full batch), and notifies the flushers
+    bool m_isStopRequired; // Guarded by m_writingLock
+    bool m_isFlushRequired; // Guarded by m_writingLock
+    advcpp::Thread<advcpp::JoinPolicy> m_writingThread;
 };
 
 } // smartbuilding
 
 
-#endif // NM_FILE_LOGGER_HPP
\ No newline at end of file
+#endif // NM_FILE_LOGGER_HPP
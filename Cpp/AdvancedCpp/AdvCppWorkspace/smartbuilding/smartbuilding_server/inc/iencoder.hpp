@@ -15,6 +15,11 @@ class IEncoder
 public:
     virtual ~IEncoder() = default;
     virtual infra::TCPSocket::BytesBufferProxy Encode(Event a_event) = 0;
+
+    // During a fan-out of an event, the encoders of the same sharing key share a single encoded buffer (see EncodingCache) - so they MUST encode an event to the same bytes
+    // By default, each encoder is its own key (never shares). An encoder opts in by returning a key of its module (e.g. the address of a static object of its .so),
+    // that it shares only with the encoders that encode exactly as it does (e.g. not with the encoders whose bytes depend on their device's configuration)
+    virtual const void* SharingKey() const { return this; }
 };
 
 } // smartbuilding
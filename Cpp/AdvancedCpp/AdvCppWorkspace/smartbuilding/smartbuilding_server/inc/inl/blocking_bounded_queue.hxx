@@ -3,9 +3,12 @@
 
 
 #include <cstddef> // size_t
+#include <chrono> // std::chrono::nanoseconds
 #include <memory> // std::shared_ptr, std::make_shared
 #include <deque>
 #include <mutex>
+#include <iterator> // std::distance
+#include <utility> // std::move, std::forward, std::move_if_noexcept
 #include <stdexcept> // std::runtime_error
 #include "semaphore.hpp"
 #include "barrier.hpp"
@@ -50,6 +53,21 @@ BlockingBoundedQueue<T,DestructionPolicy>::~BlockingBoundedQueue()
 
 template <typename T, typename DestructionPolicy>
 bool BlockingBoundedQueue<T,DestructionPolicy>::Enqueue(const T& a_item)
+{
+    return EnqueueItem(a_item);
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool BlockingBoundedQueue<T,DestructionPolicy>::Enqueue(T&& a_item)
+{
+    return EnqueueItem(std::move(a_item));
+}
+
+
+template <typename T, typename DestructionPolicy>
+template <typename Item>
+bool BlockingBoundedQueue<T,DestructionPolicy>::EnqueueItem(Item&& a_item)
 {
     if(IsClosed())
     {
@@ -66,21 +84,90 @@ bool BlockingBoundedQueue<T,DestructionPolicy>::Enqueue(const T& a_item)
         return false;
     }
 
+    PushBack(std::forward<Item>(a_item));
+
+    return true;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool BlockingBoundedQueue<T,DestructionPolicy>::TryEnqueue(const T& a_item)
+{
+    return TryEnqueueItem(a_item);
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool BlockingBoundedQueue<T,DestructionPolicy>::TryEnqueue(T&& a_item)
+{
+    return TryEnqueueItem(std::move(a_item));
+}
+
+
+template <typename T, typename DestructionPolicy>
+template <typename Item>
+bool BlockingBoundedQueue<T,DestructionPolicy>::TryEnqueueItem(Item&& a_item)
+{
+    if(IsClosed())
     {
-        std::lock_guard<std::mutex> lock(m_mutex); // RAII
-        try
-        {
-            m_queue.push_back(a_item); // Exception prone code - copy-constructor may fail
-            ++m_size;
-        }
-        catch(...) // Exception safety: keeping the correct class' invariants
-        {
-            m_freeSlots.Up(); // +1
+        return false;
+    }
 
-            throw; // rethrow
-        }
+    if(!m_freeSlots.TryDown()) // The queue is full - not waiting at all
+    {
+        return false;
+    }
+
+    if(IsClosed()) // Double check lock (not counted as a waiter - no need to wait on the barrier)
+    {
+        return false;
     }
-    m_occupiedSlots.Up(); // +1
+
+    PushBack(std::forward<Item>(a_item));
+
+    return true;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool BlockingBoundedQueue<T,DestructionPolicy>::EnqueueFor(const T& a_item, std::chrono::nanoseconds a_timeout)
+{
+    return EnqueueItemFor(a_item, a_timeout);
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool BlockingBoundedQueue<T,DestructionPolicy>::EnqueueFor(T&& a_item, std::chrono::nanoseconds a_timeout)
+{
+    return EnqueueItemFor(std::move(a_item), a_timeout);
+}
+
+
+template <typename T, typename DestructionPolicy>
+template <typename Item>
+bool BlockingBoundedQueue<T,DestructionPolicy>::EnqueueItemFor(Item&& a_item, std::chrono::nanoseconds a_timeout)
+{
+    if(IsClosed())
+    {
+        return false;
+    }
+
+    ++m_enqueueWaiters;
+    bool hasAcquiredFreeSlot = m_freeSlots.TimedDown(a_timeout); // -1 (only if succeed)
+    --m_enqueueWaiters;
+
+    if(IsClosed()) // Double check lock
+    {
+        m_enqueueWaitersBarrier.Wait();
+        return false;
+    }
+
+    if(!hasAcquiredFreeSlot) // Timeout has expired
+    {
+        return false;
+    }
+
+    PushBack(std::forward<Item>(a_item));
 
     return true;
 }
@@ -104,24 +191,119 @@ bool BlockingBoundedQueue<T,DestructionPolicy>::Dequeue(T& a_itemToReturnByRef)
         return false;
     }
 
+    PopFront(a_itemToReturnByRef);
+
+    return true;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool BlockingBoundedQueue<T,DestructionPolicy>::TryDequeue(T& a_itemToReturnByRef)
+{
+    if(IsClosed())
     {
-        std::lock_guard<std::mutex> lock(m_mutex); // RAII
-        try
+        return false;
+    }
+
+    if(!m_occupiedSlots.TryDown()) // The queue is empty - not waiting at all
+    {
+        return false;
+    }
+
+    if(IsClosed()) // Double check lock (not counted as a waiter - no need to wait on the barrier)
+    {
+        return false;
+    }
+
+    PopFront(a_itemToReturnByRef);
+
+    return true;
+}
+
+
+template <typename T, typename DestructionPolicy>
+template <typename ForwardIterator>
+size_t BlockingBoundedQueue<T,DestructionPolicy>::EnqueueBulk(ForwardIterator a_first, ForwardIterator a_last)
+{
+    size_t remainedItems = size_t(std::distance(a_first, a_last));
+    size_t enqueuedItems = 0;
+
+    while(remainedItems > 0)
+    {
+        if(IsClosed())
         {
-            a_itemToReturnByRef = m_queue.front(); // Exception prone code - copy-assignment may fail
-            m_queue.pop_front();
-            --m_size;
+            return enqueuedItems;
         }
-        catch(...) // Exception safety: keeping the correct class' invariants
-        {
-            m_occupiedSlots.Up(); // +1
 
-            throw; // rethrow
+        ++m_enqueueWaiters;
+        m_freeSlots.Down(); // -1 (the first slot of this batch)
+        --m_enqueueWaiters;
+
+        if(IsClosed()) // Double check lock
+        {
+            m_enqueueWaitersBarrier.Wait();
+            return enqueuedItems;
         }
+
+        size_t batchSize = 1 + TryDownUpTo(m_freeSlots, remainedItems - 1);
+        a_first = PushBackBulk(a_first, batchSize);
+        enqueuedItems += batchSize;
+        remainedItems -= batchSize;
     }
-    m_freeSlots.Up(); // +1
 
-    return true;
+    return enqueuedItems;
+}
+
+
+template <typename T, typename DestructionPolicy>
+template <typename ForwardIterator>
+size_t BlockingBoundedQueue<T,DestructionPolicy>::TryEnqueueBulk(ForwardIterator a_first, ForwardIterator a_last)
+{
+    if(IsClosed())
+    {
+        return 0;
+    }
+
+    size_t batchSize = TryDownUpTo(m_freeSlots, size_t(std::distance(a_first, a_last))); // The queue is full - not waiting at all
+    if(batchSize == 0 || IsClosed()) // Double check lock (not counted as a waiter - no need to wait on the barrier)
+    {
+        return 0;
+    }
+
+    PushBackBulk(a_first, batchSize);
+
+    return batchSize;
+}
+
+
+template <typename T, typename DestructionPolicy>
+template <typename OutputIterator>
+size_t BlockingBoundedQueue<T,DestructionPolicy>::DequeueBulk(OutputIterator a_output, size_t a_maxItems, std::chrono::nanoseconds a_timeout)
+{
+    if(IsClosed() || !a_maxItems)
+    {
+        return 0;
+    }
+
+    ++m_dequeueWaiters;
+    bool hasAcquiredOccupiedSlot = m_occupiedSlots.TimedDown(a_timeout); // -1 (only if succeed)
+    --m_dequeueWaiters;
+
+    if(IsClosed()) // Double check lock
+    {
+        m_dequeueWaitersBarrier.Wait();
+        return 0;
+    }
+
+    if(!hasAcquiredOccupiedSlot) // Timeout has expired
+    {
+        return 0;
+    }
+
+    size_t batchSize = 1 + TryDownUpTo(m_occupiedSlots, a_maxItems - 1);
+    PopFrontBulk(a_output, batchSize);
+
+    return batchSize;
 }
 
 
@@ -213,12 +395,136 @@ bool BlockingBoundedQueue<T,DestructionPolicy>::IsClosed() const
 }
 
 
+template <typename T, typename DestructionPolicy>
+template <typename Item>
+void BlockingBoundedQueue<T,DestructionPolicy>::PushBack(Item&& a_item)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex); // RAII
+        try
+        {
+            m_queue.push_back(std::forward<Item>(a_item)); // Exception prone code - copy-constructor may fail
+            ++m_size;
+        }
+        catch(...) // Exception safety: keeping the correct class' invariants
+        {
+            m_freeSlots.Up(); // +1
+
+            throw; // rethrow
+        }
+    }
+    m_occupiedSlots.Up(); // +1
+}
+
+
+template <typename T, typename DestructionPolicy>
+void BlockingBoundedQueue<T,DestructionPolicy>::PopFront(T& a_itemToReturnByRef)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex); // RAII
+        try
+        {
+            a_itemToReturnByRef = std::move_if_noexcept(m_queue.front()); // Exception prone code - copy-assignment may fail (a move that might throw is not used - the front item stays intact)
+            m_queue.pop_front();
+            --m_size;
+        }
+        catch(...) // Exception safety: keeping the correct class' invariants
+        {
+            m_occupiedSlots.Up(); // +1
+
+            throw; // rethrow
+        }
+    }
+    m_freeSlots.Up(); // +1
+}
+
+
+template <typename T, typename DestructionPolicy>
+template <typename ForwardIterator>
+ForwardIterator BlockingBoundedQueue<T,DestructionPolicy>::PushBackBulk(ForwardIterator a_first, size_t a_itemsCount)
+{
+    size_t pushedItems = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex); // RAII - one lock for the whole batch
+        try
+        {
+            for(; pushedItems < a_itemsCount; ++pushedItems, ++a_first)
+            {
+                m_queue.push_back(*a_first); // Exception prone code - copy-constructor may fail
+                ++m_size;
+            }
+        }
+        catch(...) // Exception safety: keeping the correct class' invariants (the already pushed items stay in the queue)
+        {
+            UpTimes(m_freeSlots, a_itemsCount - pushedItems);
+            UpTimes(m_occupiedSlots, pushedItems);
+
+            throw; // rethrow
+        }
+    }
+    UpTimes(m_occupiedSlots, a_itemsCount);
+
+    return a_first;
+}
+
+
+template <typename T, typename DestructionPolicy>
+template <typename OutputIterator>
+void BlockingBoundedQueue<T,DestructionPolicy>::PopFrontBulk(OutputIterator a_output, size_t a_itemsCount)
+{
+    size_t poppedItems = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex); // RAII - one lock for the whole batch
+        try
+        {
+            for(; poppedItems < a_itemsCount; ++poppedItems, ++a_output)
+            {
+                *a_output = std::move_if_noexcept(m_queue.front()); // Exception prone code - copy-assignment may fail (a move that might throw is not used - the front item stays intact)
+                m_queue.pop_front();
+                --m_size;
+            }
+        }
+        catch(...) // Exception safety: keeping the correct class' invariants (the already popped items were delivered)
+        {
+            UpTimes(m_occupiedSlots, a_itemsCount - poppedItems);
+            UpTimes(m_freeSlots, poppedItems);
+
+            throw; // rethrow
+        }
+    }
+    UpTimes(m_freeSlots, a_itemsCount);
+}
+
+
+template <typename T, typename DestructionPolicy>
+size_t BlockingBoundedQueue<T,DestructionPolicy>::TryDownUpTo(Semaphore& a_slots, size_t a_maxSlots)
+{
+    size_t acquiredSlots = 0;
+    while(acquiredSlots < a_maxSlots && a_slots.TryDown())
+    {
+        ++acquiredSlots;
+    }
+
+    return acquiredSlots;
+}
+
+
+template <typename T, typename DestructionPolicy>
+void BlockingBoundedQueue<T,DestructionPolicy>::UpTimes(Semaphore& a_slots, size_t a_times)
+{
+    for(size_t i = 0; i < a_times; ++i)
+    {
+        a_slots.Up(); // +1
+    }
+}
+
+
 template <typename T, typename DestructionPolicy>
 bool BlockingBoundedQueue<T,DestructionPolicy>::RemoveNext(T& a_itemToReturnByRef) noexcept
 {
     try // Exception safety
     {
-        a_itemToReturnByRef = m_queue.front();
+        a_itemToReturnByRef = std::move_if_noexcept(m_queue.front());
         m_queue.pop_front();
         --m_size;
     }
@@ -5,6 +5,7 @@
 
 #include <cstddef> // size_t
 #include <cassert> // assert
+#include <utility> // std::move
 #include "blocking_bounded_queue.hpp"
 
 
@@ -12,21 +13,24 @@ namespace advcpp
 {
 
 template<typename T>
-void AssertPolicy<T>::operator()(BlockingBoundedQueue<T,AssertPolicy<T>>& a_queue) noexcept
+template <typename QueueType>
+void AssertPolicy<T>::operator()(QueueType& a_queue) noexcept
 {
     assert(a_queue.Empty());
 }
 
 
 template<typename T>
-void NoOperationPolicy<T>::operator()(BlockingBoundedQueue<T,NoOperationPolicy<T>>& a_queue) noexcept
+template <typename QueueType>
+void NoOperationPolicy<T>::operator()(QueueType& a_queue) noexcept
 {
     (void)a_queue; // Do nothing (not using a_queue at all)
 }
 
 
 template<typename T>
-void ClearPolicy<T>::operator()(BlockingBoundedQueue<T,ClearPolicy<T>>& a_queue) noexcept
+template <typename QueueType>
+void ClearPolicy<T>::operator()(QueueType& a_queue) noexcept
 {
     size_t itemsToPop = a_queue.GetSize();
     for(size_t i = 0; i < itemsToPop; ++i)
@@ -44,7 +48,8 @@ void ClearPolicy<T>::operator()(BlockingBoundedQueue<T,ClearPolicy<T>>& a_queue)
 
 
 template<typename T, typename C>
-void SavePolicy<T,C>::operator()(BlockingBoundedQueue<T,SavePolicy<T,C>>& a_queue) noexcept
+template <typename QueueType>
+void SavePolicy<T,C>::operator()(QueueType& a_queue) noexcept
 {
     size_t itemsToPop = a_queue.GetSize();
     for(size_t i = 0; i < itemsToPop; ++i)
@@ -54,7 +59,7 @@ void SavePolicy<T,C>::operator()(BlockingBoundedQueue<T,SavePolicy<T,C>>& a_queu
             T poppedItem;
             if(a_queue.RemoveNext(poppedItem)) // If succeed
             {
-                m_containerPtr->push_back(poppedItem);
+                m_containerPtr->push_back(std::move(poppedItem));
             }
         }
         catch(...)
@@ -65,7 +70,8 @@ void SavePolicy<T,C>::operator()(BlockingBoundedQueue<T,SavePolicy<T,C>>& a_queu
 
 
 template<typename T, typename Func>
-void CallbackPolicy<T,Func>::operator()(BlockingBoundedQueue<T,CallbackPolicy<T,Func>>& a_queue) noexcept
+template <typename QueueType>
+void CallbackPolicy<T,Func>::operator()(QueueType& a_queue) noexcept
 {
     size_t itemsToPop = a_queue.GetSize();
     for(size_t i = 0; i < itemsToPop; ++i)
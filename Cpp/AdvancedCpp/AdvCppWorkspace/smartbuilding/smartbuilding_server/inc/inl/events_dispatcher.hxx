@@ -2,47 +2,123 @@
 #define NM_EVENTS_DISPATCHER_HXX
 
 #include "events_dispatcher.hpp"
-#include <algorithm> // std::for_each
+#include <cstddef> // size_t
 #include <type_traits> // std::is_same
-#include <memory> // std::shared_ptr
+#include <memory> // std::shared_ptr, std::make_shared
+#include <vector> // std::vector
+#include <utility> // std::move
+#include <atomic> // std::memory_order_relaxed
+#include <stdexcept> // std::invalid_argument
+#include <exception> // std::current_exception
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
+#include "icallable.hpp"
 #include "isubscriber.hpp"
 #include "invoker_work.hpp"
+#include "encoding_cache.hpp"
+#include "future.hpp"
+#include "thread_budget.hpp"
+#include "thread_pool_autoscaler.hpp"
 
 
 namespace smartbuilding
 {
 
-inline EventsDispatcher::EventsDispatcher()
-: m_invokers(advcpp::ShutdownPolicy<>(), WORKERS_QUEUE_SIZE)
+inline EventsDispatcher::EventsDispatcher(std::shared_ptr<advcpp::ThreadBudget> a_threadsBudget, size_t a_subscribersPerBatch)
+: m_invokers(advcpp::ShutdownPolicy<>(), WORKERS_QUEUE_SIZE, MIN_WORKERS)
+, m_invokersScaler(m_invokers, advcpp::AutoscalerConfig(), a_threadsBudget)
+, m_subscribersPerBatch(a_subscribersPerBatch)
+, m_eventsCount(0)
+, m_batchesCount(0)
+, m_subscribersCount(0)
+, m_largestBatchSize(0)
+, m_droppedBatchesCount(0)
+, m_droppedSubscribersCount(0)
 {
+    if(a_subscribersPerBatch == 0)
+    {
+        throw std::invalid_argument("Error: subscribers per batch cannot be 0");
+    }
 }
 
 
 inline EventsDispatcher::~EventsDispatcher()
 {
+    m_invokersScaler.Stop(); // Before the workers are stopped - the autoscaler must not resize a shutting down pool
     m_invokers.Shutdown();
 }
 
 
 template <typename C>
-void EventsDispatcher::Invoke(C a_subscribersCollection, const Event& a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue) noexcept
+advcpp::Future<void> EventsDispatcher::Invoke(const C& a_subscribersCollection, const Event& a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue, std::shared_ptr<advcpp::ICallable> a_handledBuffersSender)
 {
     static_assert(std::is_same<typename C::value_type, std::shared_ptr<ISubscriber>>::value, "C::value_type (Container's value_type) must be of type: std::shared_ptr<ISubscriber>");
 
-    std::for_each(a_subscribersCollection.begin(), a_subscribersCollection.end(), [&](std::shared_ptr<ISubscriber> a_subscriber)
+    ++m_eventsCount;
+    std::shared_ptr<EncodingCache> encodingCache = std::make_shared<EncodingCache>(a_event.ID()); // Released by the event's last batch
+    std::vector<advcpp::Future<void>> notifiedBatches;
+    std::vector<std::shared_ptr<ISubscriber>> batch;
+    batch.reserve(m_subscribersPerBatch);
+    typename C::const_iterator subscriberItr = a_subscribersCollection.begin();
+    typename C::const_iterator endItr = a_subscribersCollection.end();
+    while(subscriberItr != endItr)
     {
+        batch.push_back(*subscriberItr);
+        ++subscriberItr;
+        if(batch.size() < m_subscribersPerBatch && subscriberItr != endItr)
+        {
+            continue;
+        }
+
+        size_t batchSize = batch.size();
         try
         {
-            std::shared_ptr<InvokerWork> invokeTask(new InvokerWork(a_subscriber, a_event, a_handledBuffersQueue));
-            m_invokers.SubmitWork(invokeTask);
+            notifiedBatches.push_back(m_invokers.Submit(InvokerWork(std::move(batch), a_event, encodingCache, a_handledBuffersQueue, a_handledBuffersSender))); // By value - no shared work object
+            RecordBatch(batchSize);
         }
         catch(...)
         {
-            // For exception safety
+            notifiedBatches.push_back(advcpp::MakeFailedFuture<void>(std::current_exception())); // The event's future fails - the rest of its batches are still notified
+            RecordDroppedBatch(batchSize);
         }
-    });
+
+        batch.clear(); // Valid (empty) after it was moved from
+        batch.reserve(m_subscribersPerBatch);
+    }
+
+    return advcpp::WhenAll(notifiedBatches);
+}
+
+
+inline EventsDispatcher::FanOutStatistics EventsDispatcher::Statistics() const
+{
+    FanOutStatistics statistics;
+    statistics.m_eventsCount = m_eventsCount.load(std::memory_order_relaxed);
+    statistics.m_batchesCount = m_batchesCount.load(std::memory_order_relaxed);
+    statistics.m_subscribersCount = m_subscribersCount.load(std::memory_order_relaxed);
+    statistics.m_largestBatchSize = m_largestBatchSize.load(std::memory_order_relaxed);
+    statistics.m_droppedBatchesCount = m_droppedBatchesCount.load(std::memory_order_relaxed);
+    statistics.m_droppedSubscribersCount = m_droppedSubscribersCount.load(std::memory_order_relaxed);
+
+    return statistics;
+}
+
+
+inline void EventsDispatcher::RecordBatch(size_t a_batchSize)
+{
+    m_batchesCount.fetch_add(1, std::memory_order_relaxed);
+    m_subscribersCount.fetch_add(a_batchSize, std::memory_order_relaxed);
+
+    size_t largestBatchSize = m_largestBatchSize.load(std::memory_order_relaxed);
+    while(a_batchSize > largestBatchSize && !m_largestBatchSize.compare_exchange_weak(largestBatchSize, a_batchSize, std::memory_order_relaxed))
+    {
+    }
+}
+
+inline void EventsDispatcher::RecordDroppedBatch(size_t a_batchSize)
+{
+    m_droppedBatchesCount.fetch_add(1, std::memory_order_relaxed);
+    m_droppedSubscribersCount.fetch_add(a_batchSize, std::memory_order_relaxed);
 }
 
 } // smartbuilding
@@ -0,0 +1,20 @@
+#ifndef NM_SO_MODULES_CACHE_HXX
+#define NM_SO_MODULES_CACHE_HXX
+
+
+#include <string> // std::string
+
+
+namespace smartbuilding
+{
+
+template <typename FunctionPtrType>
+FunctionPtrType SoModulesCache::Fetch(const std::string& a_module, const std::string& a_function)
+{
+    return reinterpret_cast<FunctionPtrType>(FetchSymbol(a_module, a_function));
+}
+
+} // smartbuilding
+
+
+#endif // NM_SO_MODULES_CACHE_HXX
@@ -0,0 +1,172 @@
+#ifndef NM_TASK_HXX
+#define NM_TASK_HXX
+
+
+#include <new> // placement new
+#include <type_traits> // std::decay, std::integral_constant
+#include <utility> // std::move, std::forward
+#include <stdexcept> // std::runtime_error
+
+
+namespace advcpp
+{
+
+template <typename Func>
+const Task::Operations Task::InlineOperations<Func>::s_operations = { &Task::InlineOperations<Func>::Invoke, &Task::InlineOperations<Func>::MoveTo, &Task::InlineOperations<Func>::Destroy, true };
+
+
+template <typename Func>
+const Task::Operations Task::HeapOperations<Func>::s_operations = { &Task::HeapOperations<Func>::Invoke, &Task::HeapOperations<Func>::MoveTo, &Task::HeapOperations<Func>::Destroy, false };
+
+
+inline Task::Task() noexcept
+: m_buffer()
+, m_operations(nullptr)
+{
+}
+
+
+template <typename Func, typename>
+Task::Task(Func&& a_func)
+: m_buffer()
+, m_operations(nullptr)
+{
+    using Callable = typename std::decay<Func>::type;
+    Construct(std::forward<Func>(a_func), FitsInline<Callable>());
+}
+
+
+inline Task::Task(Task&& a_other) noexcept
+: m_buffer()
+, m_operations(a_other.m_operations)
+{
+    if(m_operations)
+    {
+        m_operations->m_moveTo(a_other.m_buffer, m_buffer);
+        a_other.m_operations = nullptr;
+    }
+}
+
+
+inline Task& Task::operator=(Task&& a_other) noexcept
+{
+    if(this != &a_other)
+    {
+        Reset();
+        if(a_other.m_operations)
+        {
+            a_other.m_operations->m_moveTo(a_other.m_buffer, m_buffer);
+            m_operations = a_other.m_operations;
+            a_other.m_operations = nullptr;
+        }
+    }
+
+    return *this;
+}
+
+
+inline Task::~Task()
+{
+    Reset();
+}
+
+
+inline void Task::operator()()
+{
+    if(!m_operations)
+    {
+        throw std::runtime_error("Failed while tried to execute an empty task");
+    }
+
+    m_operations->m_invoke(m_buffer);
+}
+
+
+inline Task::operator bool() const noexcept
+{
+    return m_operations != nullptr;
+}
+
+
+inline bool Task::IsInline() const noexcept
+{
+    return m_operations && m_operations->m_isInline;
+}
+
+
+template <typename Func>
+void Task::Construct(Func&& a_func, std::true_type)
+{
+    using Callable = typename std::decay<Func>::type;
+    new (&m_buffer) Callable(std::forward<Func>(a_func)); // Exception prone code - before the operations are set, so nothing is destroyed on a failure
+    m_operations = &InlineOperations<Callable>::s_operations;
+}
+
+
+template <typename Func>
+void Task::Construct(Func&& a_func, std::false_type)
+{
+    using Callable = typename std::decay<Func>::type;
+    Callable* heapCallable = new Callable(std::forward<Func>(a_func)); // Exception prone code - before the operations are set, so nothing is destroyed on a failure
+    new (&m_buffer) Callable*(heapCallable);
+    m_operations = &HeapOperations<Callable>::s_operations;
+}
+
+
+inline void Task::Reset() noexcept
+{
+    if(m_operations)
+    {
+        m_operations->m_destroy(m_buffer);
+        m_operations = nullptr;
+    }
+}
+
+
+template <typename Func>
+void Task::InlineOperations<Func>::Invoke(Buffer& a_buffer)
+{
+    (*reinterpret_cast<Func*>(&a_buffer))();
+}
+
+
+template <typename Func>
+void Task::InlineOperations<Func>::MoveTo(Buffer& a_from, Buffer& a_to) noexcept
+{
+    Func* from = reinterpret_cast<Func*>(&a_from);
+    new (&a_to) Func(std::move(*from)); // Can't throw (a FitsInline requirement)
+    from->~Func();
+}
+
+
+template <typename Func>
+void Task::InlineOperations<Func>::Destroy(Buffer& a_buffer) noexcept
+{
+    reinterpret_cast<Func*>(&a_buffer)->~Func();
+}
+
+
+template <typename Func>
+void Task::HeapOperations<Func>::Invoke(Buffer& a_buffer)
+{
+    (**reinterpret_cast<Func**>(&a_buffer))();
+}
+
+
+template <typename Func>
+void Task::HeapOperations<Func>::MoveTo(Buffer& a_from, Buffer& a_to) noexcept
+{
+    new (&a_to) Func*(*reinterpret_cast<Func**>(&a_from)); // Only the pointer moves - the callable object itself stays in place
+}
+
+
+template <typename Func>
+void Task::HeapOperations<Func>::Destroy(Buffer& a_buffer) noexcept
+{
+    delete *reinterpret_cast<Func**>(&a_buffer);
+}
+
+} // advcpp
+
+
+#endif // NM_TASK_HXX
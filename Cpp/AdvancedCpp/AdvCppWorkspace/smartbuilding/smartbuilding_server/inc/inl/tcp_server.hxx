@@ -5,32 +5,52 @@
 #include <cstddef> // size_t
 #include <list> // std::list
 #include <memory> // std::shared_ptr
-#include <utility> // std::pair, std::make_pair
+#include <utility> // std::pair, std::make_pair, std::move
 #include <unistd.h> // close
+#include <sys/eventfd.h> // eventfd, eventfd_read, eventfd_write
 #include <vector> // std::vector
+#include <deque> // std::deque
+#include <mutex> // std::mutex, std::lock_guard
+#include <atomic> // std::memory_order_acquire, std::memory_order_release
 #include <string> // std::string, std::to_string
 #include <stdexcept> // std::runtime_error
 #include <algorithm> // std::for_each
-#include <sys/select.h> /* select, fd_set and its MACROS */
+#include <sys/uio.h> // struct iovec
 #include "tcp_server_socket.hpp"
+#include "outbound_queue.hpp"
+#include "tcp_server_reactor_policies.hpp"
+#include "tcp_server_framing_policies.hpp"
 
 
 namespace infra
 {
 
-template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler>
-TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler>::TCPServer(ClientMessageHandler a_onClientMessage, ErrorHandler a_onError, NewClientConnectionHandler a_onNewClientConnection, CloseClientConnectionHandler a_onCloseClientConnection, unsigned int a_listeningPort, unsigned int a_maxWaitingConnections)
-: m_serverSocket(a_listeningPort)
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::TCPServer(ClientMessageHandler a_onClientMessage, ErrorHandler a_onError, NewClientConnectionHandler a_onNewClientConnection, CloseClientConnectionHandler a_onCloseClientConnection, unsigned int a_listeningPort, unsigned int a_maxWaitingConnections, bool a_isPortSharingRequired, size_t a_outputHighWaterMark)
+: m_serverSocket(a_listeningPort, ReactorPolicy::IS_EDGE_TRIGGERED, a_isPortSharingRequired) // The accepted clients inherit the non blocking mode of the listening socket
 , m_connectedClientsTable()
+, m_clientsInputBuffers()
+, m_framing()
 , m_onClientMessage(a_onClientMessage)
 , m_onError(a_onError)
 , m_onNewClientConnection(a_onNewClientConnection)
 , m_onCloseClientConnection(a_onCloseClientConnection)
-, m_socketsSignalsIndicator()
+, m_reactor()
+, m_readySockets()
 , m_maxWaitingConnections(a_maxWaitingConnections)
-, m_maxAmountOfConnectedClientsAtTheSameTime(MAX_CONNECTED_CLIENTS_AT_THE_SAME_TIME_TO_SERVER)
+, m_maxAmountOfConnectedClientsAtTheSameTime(m_reactor.MaxSockets())
 , m_currentConnectedClientsCount(0)
+, m_isAcceptingPaused(false)
 , m_isStopServerFromRunningRequired(false)
+, m_isStopRequested(false)
+, m_wakeupID(-1)
+, m_postedResponsesLock()
+, m_postedResponses()
+, m_outputHighWaterMark(a_outputHighWaterMark)
+, m_outboundQueuesScheduler()
+, m_scheduledOutboundQueues()
+, m_outboundQueuesLock()
+, m_outboundQueues()
 {
     if(a_listeningPort < MIN_PORT_VALUE || a_listeningPort > MAX_PORT_VALUE)
     {
@@ -41,37 +61,81 @@ TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClie
         throw std::runtime_error("Error: maximum amount of waiting connections cannot be 0");
     }
 
-    InitializeFDSet();
-    m_serverSocket.Listen(a_maxWaitingConnections);
+    m_wakeupID = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if(m_wakeupID < 0)
+    {
+        throw std::runtime_error("Error: failed to create the wakeup event of the server");
+    }
+
+    try
+    {
+        m_outboundQueuesScheduler = std::make_shared<OutboundQueuesScheduler>(m_wakeupID);
+        m_reactor.Add(m_wakeupID);
+        m_reactor.Add(m_serverSocket.InnerSocketID());
+        m_serverSocket.Listen(a_maxWaitingConnections);
+    }
+    catch(...)
+    {
+        close(m_wakeupID); // The destructor is not called for a partially constructed object
+        throw;
+    }
+}
+
+
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::~TCPServer()
+{
+    for(auto& flowState : m_clientsFlowStates)
+    {
+        flowState.second.m_output->Close(); // No post can signal the wakeup event after it is closed
+    }
+    m_outboundQueuesScheduler->TakeScheduled(m_scheduledOutboundQueues); // The scheduled queues refer to the scheduler
+
+    close(m_wakeupID);
+}
+
+
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::PostResponse(std::pair<tcpserver_details::ClientID,std::shared_ptr<TCPSocket>> a_client, const tcpserver_details::Response& a_response)
+{
+    PostedResponse postedResponse = {a_client.first, a_client.second, a_response};
+    {
+        std::lock_guard<std::mutex> guard(m_postedResponsesLock);
+        m_postedResponses.push_back(std::move(postedResponse));
+    }
+
+    eventfd_write(m_wakeupID, 1); // Wakes up the reactor's wait
 }
 
 
-template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler>
-void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler>::InitializeFDSet()
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+std::shared_ptr<OutboundQueue> TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::OutboundQueueOf(std::pair<tcpserver_details::ClientID,std::shared_ptr<TCPSocket>> a_client) const
 {
-    FD_ZERO(&m_socketsSignalsIndicator);
-    FD_SET(m_serverSocket.InnerSocketID(), &m_socketsSignalsIndicator);
+    std::lock_guard<std::mutex> guard(m_outboundQueuesLock);
+    auto outputItr = m_outboundQueues.find(a_client.first);
+    if(outputItr == m_outboundQueues.end() || !outputItr->second->IsQueueOf(a_client.second)) // The client has disconnected (its ID might belong to a new client already)
+    {
+        return nullptr;
+    }
+
+    return outputItr->second;
 }
 
 
-template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler>
-void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler>::Run()
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::Run()
 {
-    fd_set tempSocketsSignalsIndicator;
     tcpserver_details::StatusCode status;
-    int socketsSignalsCount = 0;
+    std::vector<ReadySocket> readyClients;
 
     while(true)
     {
-        if(m_isStopServerFromRunningRequired)
+        if(m_isStopServerFromRunningRequired || m_isStopRequested.load(std::memory_order_acquire))
         {
             break;
         }
 
-        // First: saving the "master" fd_set, because the select is deleting the given fd_set's content
-        tempSocketsSignalsIndicator = m_socketsSignalsIndicator;
-
-        socketsSignalsCount = select(FILE_DESCRIPTORS_LIMIT, &tempSocketsSignalsIndicator, NULL, NULL, NULL);
+        int socketsSignalsCount = m_reactor.Wait(m_readySockets);
         if(socketsSignalsCount < 0)
         {
             m_isStopServerFromRunningRequired = m_onError(tcpserver_details::SERVER_INTERNAL_ERROR, MapServerErrorsToMessages(tcpserver_details::SERVER_INTERNAL_ERROR));
@@ -79,10 +143,31 @@ void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,Clos
             {
                 break; /* The main server loop will stop and the Run function will finish */
             }
+
+            continue;
+        }
+
+        // Handling new connections (checking the server's listening socket) first - the ready clients are handled after it:
+        readyClients.clear();
+        bool hasNewConnections = false;
+        bool hasPostedResponses = false;
+        for(size_t i = 0; i < m_readySockets.size(); ++i)
+        {
+            if(m_readySockets[i].m_socketID == m_serverSocket.InnerSocketID())
+            {
+                hasNewConnections = true;
+            }
+            else if(m_readySockets[i].m_socketID == m_wakeupID)
+            {
+                hasPostedResponses = true;
+            }
+            else
+            {
+                readyClients.push_back(m_readySockets[i]);
+            }
         }
 
-        // Handling new connections (checking the server's listening socket):
-        if(FD_ISSET(m_serverSocket.InnerSocketID(), &tempSocketsSignalsIndicator))
+        if(hasNewConnections)
         {
             status = AcceptNewClients();
             if(status != tcpserver_details::SUCCESS)
@@ -93,15 +178,18 @@ void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,Clos
                     break; // The main server loop will stop and the Run function will finish
                 }
             }
-
-            --socketsSignalsCount; // After handling the listening socket
         }
 
-        if(socketsSignalsCount > 0) // Check if only the listening socket had a notification -> if true: can continue to be blocked by the OS using the select (so end current loop)
+        if(!readyClients.empty() || hasPostedResponses) // Check if only the listening socket had a notification -> if true: can continue to be blocked by the reactor (so end current loop)
         {
             try
             {
-                HandleExistingClientsRequests(tempSocketsSignalsIndicator, socketsSignalsCount);
+                if(hasPostedResponses)
+                {
+                    HandlePostedResponses();
+                    HandlePostedOutput();
+                }
+                HandleExistingClientsRequests(readyClients);
             }
             catch(const std::bad_alloc& baex)
             {
@@ -124,8 +212,16 @@ void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,Clos
 }
 
 
-template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler>
-std::string TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler>::MapServerErrorsToMessages(tcpserver_details::StatusCode a_statusCode) const
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::Stop()
+{
+    m_isStopRequested.store(true, std::memory_order_release);
+    eventfd_write(m_wakeupID, 1); // Wakes up the reactor's wait - Run checks the stop request before its next wait
+}
+
+
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+std::string TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::MapServerErrorsToMessages(tcpserver_details::StatusCode a_statusCode) const
 {
     if(a_statusCode == tcpserver_details::MEMORY_ALLOCATION_FAILED)
     {
@@ -146,19 +242,50 @@ std::string TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandl
 }
 
 
-template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler>
-typename tcpserver_details::StatusCode TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler>::AcceptNewClients()
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+typename tcpserver_details::StatusCode TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::AcceptNewClients()
+{
+    bool hasAccepted = false;
+    tcpserver_details::StatusCode status;
+
+    // An edge-triggered reactor reports the waiting connections only once - so all of them are accepted now
+    // (if the clients limit is reached - the rest are accepted on the next new connection)
+    do
+    {
+        status = AcceptNewClient(hasAccepted);
+    }
+    while(ReactorPolicy::IS_EDGE_TRIGGERED && hasAccepted && status == tcpserver_details::SUCCESS);
+
+    return status;
+}
+
+
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+typename tcpserver_details::StatusCode TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::AcceptNewClient(bool& a_hasAccepted)
 {
     HandlingClientResult result;
+    a_hasAccepted = false;
 
-    if(m_currentConnectedClientsCount == m_maxAmountOfConnectedClientsAtTheSameTime)
+    if(m_currentConnectedClientsCount >= m_maxAmountOfConnectedClientsAtTheSameTime) // Cannot add more clients for now
     {
-        return tcpserver_details::SUCCESS; /* Cannot add more clients for now */
+        try
+        {
+            PauseAccepting(); // An edge-triggered reactor would never report the waiting connections again otherwise
+        }
+        catch(const std::exception& ex)
+        {
+            return tcpserver_details::SERVER_INTERNAL_ERROR;
+        }
+
+        return tcpserver_details::SUCCESS;
     }
 
     try
     {
-        m_serverSocket.Accept();
+        if(!m_serverSocket.Accept()) // Non blocking listening socket - no more waiting connections
+        {
+            return tcpserver_details::SUCCESS;
+        }
     }
     catch(const std::exception& ex)
     {
@@ -171,24 +298,38 @@ typename tcpserver_details::StatusCode TCPServer<ClientMessageHandler,ErrorHandl
     {
         std::shared_ptr<TCPSocket> m_newClientSocket = m_serverSocket.GetLastAcceptedClientSocket();
         m_connectedClientsTable.insert({newClientID, m_newClientSocket});
+        m_clientsInputBuffers[newClientID] = InputBuffer();
+        ClientFlowState& flowState = m_clientsFlowStates[newClientID];
+        flowState.m_output = std::make_shared<OutboundQueue>(newClientID, m_newClientSocket, m_outboundQueuesScheduler, m_outputHighWaterMark);
+        {
+            std::lock_guard<std::mutex> guard(m_outboundQueuesLock);
+            m_outboundQueues[newClientID] = flowState.m_output;
+        }
+
+        // Set the reactor to notify on the new client's messages
+        m_reactor.Add(newClientID);
     }
     catch(const std::bad_alloc& baex)
     {
         // To keep class' invariants (no throw and does nothing if 0 elements have removed)
         m_connectedClientsTable.erase(newClientID);
+        m_clientsInputBuffers.erase(newClientID);
+        m_clientsFlowStates.erase(newClientID);
+        EraseOutboundQueueOf(newClientID);
         return tcpserver_details::MEMORY_ALLOCATION_FAILED;
     }
     catch(const std::exception& ex)
     {
         // To keep class' invariants (no throw and does nothing if 0 elements have removed)
         m_connectedClientsTable.erase(newClientID);
+        m_clientsInputBuffers.erase(newClientID);
+        m_clientsFlowStates.erase(newClientID);
+        EraseOutboundQueueOf(newClientID);
         return tcpserver_details::SERVER_INTERNAL_ERROR;
     }
 
-    // Set the new client to notify the sockets signals indicator
-    FD_SET(newClientID, &m_socketsSignalsIndicator);
-
     ++m_currentConnectedClientsCount;
+    a_hasAccepted = true;
 
     // Semi initialization of the response object
     tcpserver_details::Response response;
@@ -206,19 +347,46 @@ typename tcpserver_details::StatusCode TCPServer<ClientMessageHandler,ErrorHandl
 }
 
 
-template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler>
-typename TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler>::HandlingClientResult TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler>::HandleResponse(tcpserver_details::Response& a_response)
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::PauseAccepting()
+{
+    if(!m_isAcceptingPaused)
+    {
+        m_reactor.Modify(m_serverSocket.InnerSocketID(), false, false);
+        m_isAcceptingPaused = true;
+    }
+}
+
+
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::ResumeAccepting()
+{
+    if(!m_isAcceptingPaused)
+    {
+        return;
+    }
+
+    try
+    {
+        m_reactor.Modify(m_serverSocket.InnerSocketID(), true, false);
+        m_isAcceptingPaused = false;
+    }
+    catch(const std::exception& ex)
+    {
+        // Stays paused - retried when the next client disconnects
+    }
+}
+
+
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+typename TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::HandlingClientResult TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::HandleResponse(tcpserver_details::Response& a_response)
 {
     if(a_response.m_status == tcpserver_details::SEND_MESSAGE)
     {
         size_t clientsCountToSendMessagesFor = a_response.m_clients.size();
         for(size_t i = 0; i < clientsCountToSendMessagesFor; ++i)
         {
-            try
-            {
-                SendMessageTo(a_response.m_clients[i], a_response.m_message);
-            }
-            catch(...)
+            if(SendMessageTo(a_response.m_clients[i], a_response.m_message) == CLIENT_ERROR)
             {
                 // Handling problematic client
                 DisconnectAndRemoveClientFromServer(a_response.m_clients[i]);
@@ -230,93 +398,322 @@ typename TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,
         return CLIENT_FINISH; // Disconnect the client
     }
 
-    // DO_NOTHING or done with SEND_MESSAGE:
+    // DO_NOTHING, DEFER_RESPONSE (its response is posted later) or done with SEND_MESSAGE:
     return CLIENT_KEEP;
 }
 
 
-template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler>
-size_t TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler>::SendMessageTo(tcpserver_details::ClientID a_clientID, tcpserver_details::Message a_message)
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+typename TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::HandlingClientResult TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::SendMessageTo(tcpserver_details::ClientID a_clientID, const tcpserver_details::Message& a_message)
 {
-    // Sync SendMessageTo version:
-    // m_serverSocket.SetClientIDToSendMessageTo(a_clientID);
-    // return m_serverSocket.Send(a_message);
+    auto flowStateItr = m_clientsFlowStates.find(a_clientID);
+    if(flowStateItr == m_clientsFlowStates.end()) // Not connected (anymore) - nothing to send
+    {
+        return CLIENT_KEEP;
+    }
+
+    // The messages are sent in order - a new message waits behind the messages that were not sent yet
+    bool isOutputIdle = flowStateItr->second.m_pendingOutput.empty();
+    flowStateItr->second.m_pendingOutput.push_back(a_message); // Shares the message's bytes (no copy)
+    flowStateItr->second.m_output->AddQueuedBytes(a_message.Size());
+    if(!isOutputIdle)
+    {
+        RefreshWatchingOf(a_clientID, flowStateItr->second); // Might pause the reading from the client
+        return CLIENT_KEEP;
+    }
 
-    // Async SendMessageTo version:
-    return m_connectedClientsTable[a_clientID]->Send(a_message);
+    return FlushOutputOf(a_clientID);
 }
 
 
-template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler>
-void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler>::DisconnectAndRemoveClientFromServer(tcpserver_details::ClientID a_clientID)
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+typename TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::HandlingClientResult TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::FlushOutputOf(tcpserver_details::ClientID a_clientID)
 {
-    m_onCloseClientConnection(a_clientID);
+    ClientFlowState& flowState = m_clientsFlowStates[a_clientID];
+    std::shared_ptr<TCPSocket>& clientSocket = m_connectedClientsTable[a_clientID];
+    std::deque<tcpserver_details::Message>& pendingOutput = flowState.m_pendingOutput;
+    struct iovec parts[MAX_COALESCED_MESSAGES];
+    try
+    {
+        while(true)
+        {
+            while(!pendingOutput.empty() && flowState.m_sentBytesOfFirstMessage == pendingOutput.front().Size()) // The sent (or empty) messages
+            {
+                pendingOutput.pop_front();
+                flowState.m_sentBytesOfFirstMessage = 0;
+            }
+            if(pendingOutput.empty())
+            {
+                break;
+            }
+
+            // A single send of the first MAX_COALESCED_MESSAGES messages (the first one from its unsent bytes)
+            size_t partsCount = 0;
+            size_t bytesToSend = 0;
+            for(auto messageItr = pendingOutput.begin(); messageItr != pendingOutput.end() && partsCount < MAX_COALESCED_MESSAGES; ++messageItr, ++partsCount)
+            {
+                parts[partsCount] = messageItr->ToIOVec();
+                bytesToSend += parts[partsCount].iov_len;
+            }
+            parts[0].iov_base = static_cast<unsigned char*>(parts[0].iov_base) + flowState.m_sentBytesOfFirstMessage;
+            parts[0].iov_len -= flowState.m_sentBytesOfFirstMessage;
+            bytesToSend -= flowState.m_sentBytesOfFirstMessage;
+
+            size_t sentBytes = clientSocket->Send(parts, partsCount);
+            if(sentBytes == 0) // The socket's send buffer is full - the rest is sent when the client becomes writable
+            {
+                break;
+            }
+            flowState.m_output->RemoveSentBytes(sentBytes);
 
-    m_connectedClientsTable.erase(a_clientID); // The std::shared_ptr destruction would close the FD of the TCPSocket, if there are no additional references to that TCPSocket
-    FD_CLR(a_clientID, &m_socketsSignalsIndicator);
-    close(a_clientID);
-    --m_currentConnectedClientsCount;
+            size_t sentBytesOfMessages = flowState.m_sentBytesOfFirstMessage + sentBytes;
+            while(!pendingOutput.empty() && sentBytesOfMessages >= pendingOutput.front().Size())
+            {
+                sentBytesOfMessages -= pendingOutput.front().Size();
+                pendingOutput.pop_front();
+            }
+            flowState.m_sentBytesOfFirstMessage = sentBytesOfMessages;
+
+            if(sentBytes < bytesToSend) // The socket's send buffer has filled up
+            {
+                break;
+            }
+        }
+
+        RefreshWatchingOf(a_clientID, flowState);
+    }
+    catch(...)
+    {
+        // Handling problematic client
+        return CLIENT_ERROR;
+    }
+
+    return CLIENT_KEEP;
+}
+
+
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::DeferResponseOf(tcpserver_details::ClientID a_clientID, bool a_isReadingPauseRequired)
+{
+    ClientFlowState& flowState = m_clientsFlowStates[a_clientID];
+    ++flowState.m_deferredMessagesCount;
+    flowState.m_isReadingPaused = flowState.m_isReadingPaused || a_isReadingPauseRequired;
+    RefreshWatchingOf(a_clientID, flowState); // Might pause the reading from the client
+}
+
+
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::RefreshWatchingOf(tcpserver_details::ClientID a_clientID, ClientFlowState& a_flowState)
+{
+    bool isReadingRequired = !a_flowState.m_isReadingPaused && a_flowState.m_deferredMessagesCount < MAX_DEFERRED_MESSAGES_PER_CLIENT && a_flowState.m_pendingOutput.size() < MAX_PENDING_OUTPUT_MESSAGES;
+    bool isWritingRequired = !a_flowState.m_pendingOutput.empty();
+    if(isReadingRequired == a_flowState.m_isReadingWatched && isWritingRequired == a_flowState.m_isWritingWatched)
+    {
+        return; // No need to call the reactor
+    }
+
+    m_reactor.Modify(a_clientID, isReadingRequired, isWritingRequired);
+    a_flowState.m_isReadingWatched = isReadingRequired;
+    a_flowState.m_isWritingWatched = isWritingRequired;
 }
 
 
-template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler>
-void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler>::HandleExistingClientsRequests(fd_set a_tempSocketsSignalsIndicator, int a_clientsSocketSignalsCount)
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::HandlePostedResponses()
 {
-    // Using 'break' statement - cannot use std::for_each here...
-    auto itr = m_connectedClientsTable.begin();
-    auto endItr = m_connectedClientsTable.end();
+    eventfd_t postsCount = 0;
+    eventfd_read(m_wakeupID, &postsCount); // Resets the wakeup event - a later post signals it again
+
+    std::vector<PostedResponse> postedResponses;
+    {
+        std::lock_guard<std::mutex> guard(m_postedResponsesLock);
+        postedResponses.swap(m_postedResponses);
+    }
+
+    for(size_t i = 0; i < postedResponses.size(); ++i)
+    {
+        tcpserver_details::ClientID clientID = postedResponses[i].m_clientID;
+        auto clientItr = m_connectedClientsTable.find(clientID);
+        if(clientItr == m_connectedClientsTable.end() || clientItr->second != postedResponses[i].m_client) // The client has disconnected (its ID might belong to a new client already)
+        {
+            continue;
+        }
+
+        ClientFlowState& flowState = m_clientsFlowStates[clientID];
+        tcpserver_details::ResponseStatus status = postedResponses[i].m_response.m_status;
+        if(status == tcpserver_details::DEFER_RESPONSE || status == tcpserver_details::DEFER_RESPONSE_AND_PAUSE_READING) // The message is still deferred - only the reading might be paused
+        {
+            flowState.m_isReadingPaused = flowState.m_isReadingPaused || (status == tcpserver_details::DEFER_RESPONSE_AND_PAUSE_READING && flowState.m_deferredMessagesCount > 0);
+            RefreshWatchingOf(clientID, flowState);
+            continue;
+        }
+
+        if(flowState.m_deferredMessagesCount > 0)
+        {
+            --flowState.m_deferredMessagesCount;
+        }
+        if(flowState.m_deferredMessagesCount == 0)
+        {
+            flowState.m_isReadingPaused = false;
+        }
+        RefreshWatchingOf(clientID, flowState); // Might resume the reading from the client
+
+        if(HandleResponse(postedResponses[i].m_response) == CLIENT_FINISH)
+        {
+            DisconnectAndRemoveClientFromServer(clientID);
+        }
+    }
+}
 
-    for(; itr != endItr; ++itr)
+
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::HandlePostedOutput()
+{
+    m_outboundQueuesScheduler->TakeScheduled(m_scheduledOutboundQueues);
+    for(size_t i = 0; i < m_scheduledOutboundQueues.size(); ++i)
     {
-        tcpserver_details::ClientID clientID = (*itr).first;
+        std::shared_ptr<OutboundQueue>& output = m_scheduledOutboundQueues[i];
+        tcpserver_details::ClientID clientID = output->ClientID();
+        auto flowStateItr = m_clientsFlowStates.find(clientID);
+        if(flowStateItr == m_clientsFlowStates.end() || flowStateItr->second.m_output != output) // The client has disconnected (its queue was closed)
+        {
+            continue;
+        }
+
+        ClientFlowState& flowState = flowStateItr->second;
+        bool isOutputIdle = flowState.m_pendingOutput.empty();
+        output->TakePosted(flowState.m_pendingOutput);
+        if(!isOutputIdle) // Already waits for the client's writability
+        {
+            RefreshWatchingOf(clientID, flowState); // Might pause the reading from the client
+            continue;
+        }
+
+        if(FlushOutputOf(clientID) == CLIENT_ERROR)
+        {
+            // Handling problematic client
+            DisconnectAndRemoveClientFromServer(clientID);
+        }
+    }
+    m_scheduledOutboundQueues.clear(); // Releases the queues of the clients that have disconnected
+}
+
+
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::EraseOutboundQueueOf(tcpserver_details::ClientID a_clientID)
+{
+    std::lock_guard<std::mutex> guard(m_outboundQueuesLock);
+    auto outputItr = m_outboundQueues.find(a_clientID);
+    if(outputItr != m_outboundQueues.end())
+    {
+        outputItr->second->Close();
+        m_outboundQueues.erase(outputItr);
+    }
+}
+
+
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::DisconnectAndRemoveClientFromServer(tcpserver_details::ClientID a_clientID)
+{
+    m_onCloseClientConnection(a_clientID);
+
+    m_reactor.Remove(a_clientID); // Before the FD is closed (and might be reused by a new connection)
+    m_clientsInputBuffers.erase(a_clientID); // A partially received frame is dropped with its connection
+    m_clientsFlowStates.erase(a_clientID); // So are the messages that were not sent yet
+    EraseOutboundQueueOf(a_clientID); // And the messages that were posted to the client
+    auto clientItr = m_connectedClientsTable.find(a_clientID);
+    if(clientItr != m_connectedClientsTable.end())
+    {
+        clientItr->second->Close(); // Exactly once, and now - the other references to the TCPSocket (e.g. of deferred requests) are left with a detached socket
+        m_connectedClientsTable.erase(clientItr);
+        --m_currentConnectedClientsCount; // Only for a registered client
+        ResumeAccepting();
+    }
+}
+
+
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+void TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::HandleExistingClientsRequests(const std::vector<ReadySocket>& a_readyClients)
+{
+    // Only the ready clients are visited - O(ready clients), and not O(connected clients)
+    std::vector<tcpserver_details::Message> newFrames;
+    size_t readyClientsCount = a_readyClients.size();
+    for(size_t i = 0; i < readyClientsCount; ++i)
+    {
+        tcpserver_details::ClientID clientID = a_readyClients[i].m_socketID;
         bool isServerShouldStopAfterHandlingAllClients = false;
 
-        if(FD_ISSET(clientID, &a_tempSocketsSignalsIndicator))
+        auto clientItr = m_connectedClientsTable.find(clientID);
+        if(clientItr == m_connectedClientsTable.end()) // Already disconnected while handling a previous client's response
         {
-            // Handle the client's request
-            tcpserver_details::Message newMessage;
-            HandlingClientResult result = HandleSingleClientRequest(clientID, newMessage);
-            if(result == CLIENT_FINISH || result == CLIENT_ERROR)
-            {
-                DisconnectAndRemoveClientFromServer(clientID);
-            }
-            else // CLIENT_KEEP - message has successfully received for the client
-            {
-                tcpserver_details::Response response;
-                response.m_clients.push_back(clientID); // Current client id is the default value of the response
+            continue;
+        }
+        std::shared_ptr<TCPSocket> clientSocket = clientItr->second;
 
-                isServerShouldStopAfterHandlingAllClients = m_onClientMessage(newMessage, std::make_pair((*itr).first, (*itr).second), response);
-                if(isServerShouldStopAfterHandlingAllClients)
-                {
-                    m_isStopServerFromRunningRequired = true;
-                }
+        if(a_readyClients[i].m_isWritable && FlushOutputOf(clientID) == CLIENT_ERROR)
+        {
+            DisconnectAndRemoveClientFromServer(clientID);
+            continue;
+        }
+        if(!a_readyClients[i].m_isReadable && !a_readyClients[i].m_hasPeerClosed) // Only the output was ready
+        {
+            continue;
+        }
 
-                // Handle application's response
-                result = HandleResponse(response);
-                if(result == CLIENT_FINISH)
-                {
-                    DisconnectAndRemoveClientFromServer(clientID);
-                }
+        // Handle the client's requests - all the frames that were completed by the received bytes
+        newFrames.clear();
+        HandlingClientResult result = HandleSingleClientRequest(clientID, newFrames, a_readyClients[i].m_hasPeerClosed);
+        if(result == CLIENT_FINISH || result == CLIENT_ERROR)
+        {
+            DisconnectAndRemoveClientFromServer(clientID);
+            continue;
+        }
+
+        for(size_t frame = 0; frame < newFrames.size() && result == CLIENT_KEEP; ++frame) // CLIENT_KEEP - the frames have successfully received for the client
+        {
+            tcpserver_details::Response response;
+            response.m_clients.push_back(clientID); // Current client id is the default value of the response
 
-                // Finished to handle the response from the application
+            isServerShouldStopAfterHandlingAllClients = m_onClientMessage(newFrames[frame], std::make_pair(clientID, clientSocket), response);
+            if(isServerShouldStopAfterHandlingAllClients)
+            {
+                m_isStopServerFromRunningRequired = true;
             }
 
-            --a_clientsSocketSignalsCount;
-            if(a_clientsSocketSignalsCount == 0) // Finished to handle all pending clients
+            // Handle application's response
+            if(response.m_status == tcpserver_details::DEFER_RESPONSE || response.m_status == tcpserver_details::DEFER_RESPONSE_AND_PAUSE_READING)
             {
-                break;
+                DeferResponseOf(clientID, response.m_status == tcpserver_details::DEFER_RESPONSE_AND_PAUSE_READING);
+            }
+            result = HandleResponse(response);
+            if(result == CLIENT_FINISH)
+            {
+                DisconnectAndRemoveClientFromServer(clientID); // The rest of the client's frames are dropped
+            }
+            else if(m_connectedClientsTable.count(clientID) == 0) // Disconnected by a failure to send it the response
+            {
+                result = CLIENT_FINISH;
             }
+
+            // Finished to handle the response from the application
+        }
+
+        if(result == CLIENT_KEEP && a_readyClients[i].m_hasPeerClosed) // The client's last frames were handled - now close its connection
+        {
+            DisconnectAndRemoveClientFromServer(clientID);
         }
     }
 }
 
 
-template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler>
-typename TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler>::HandlingClientResult TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler>::HandleSingleClientRequest(tcpserver_details::ClientID a_clientID, tcpserver_details::Message& a_message)
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+typename TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::HandlingClientResult TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::HandleSingleClientRequest(tcpserver_details::ClientID a_clientID, std::vector<tcpserver_details::Message>& a_frames, bool a_hasPeerClosed)
 {
+    InputBuffer& clientInput = m_clientsInputBuffers[a_clientID];
+    size_t receivedBytes = 0;
     try
     {
-        a_message = ReceiveMessageFrom(a_clientID);
+        receivedBytes = ReceiveBytesFrom(a_clientID, clientInput);
     }
     catch(...)
     {
@@ -324,29 +721,54 @@ typename TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,
         return CLIENT_ERROR;
     }
 
-    if(a_message.Size() == 0)
+    if(receivedBytes == 0)
     {
+        // A non blocking socket receives nothing also when there is nothing to read (a spurious notification) - only a closed peer finishes it
+        if(ReactorPolicy::IS_EDGE_TRIGGERED && !a_hasPeerClosed)
+        {
+            return CLIENT_KEEP;
+        }
+
         return CLIENT_FINISH; // The connection has finished by the client (an empty message had received)
     }
 
-    return CLIENT_KEEP; // The message had received successfully
+    tcpserver_details::Message newFrame;
+    FrameStatus frameStatus = m_framing.ExtractFrame(clientInput, newFrame);
+    while(frameStatus == FRAME_COMPLETE)
+    {
+        a_frames.push_back(std::move(newFrame));
+        frameStatus = m_framing.ExtractFrame(clientInput, newFrame);
+    }
+
+    if(frameStatus == FRAME_MALFORMED)
+    {
+        return CLIENT_ERROR; // The client's stream cannot be framed any more (its complete frames are dropped too)
+    }
+
+    return CLIENT_KEEP; // The bytes had received successfully (maybe without a complete frame yet)
 }
 
 
-template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler>
-typename tcpserver_details::Message TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler>::ReceiveMessageFrom(tcpserver_details::ClientID a_clientID)
+template<typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy, typename FramingPolicy>
+size_t TCPServer<ClientMessageHandler,ErrorHandler,NewClientConnectionHandler,CloseClientConnectionHandler,ReactorPolicy,FramingPolicy>::ReceiveBytesFrom(tcpserver_details::ClientID a_clientID, InputBuffer& a_input)
 {
     m_serverSocket.SetClientIDToReceiveMessageFrom(a_clientID);
 
-    tcpserver_details::Message completeMessage, newBuffer;
-    newBuffer = m_serverSocket.Receive(MESSAGES_BUFFER_SIZE);
-    while(newBuffer.Size() != 0) // A loop to receive the whole new message (the loop would stop when the newBuffer size is equal to 0, so the completeMessage is completed already in the previous iteration)
+    size_t receivedBytes = 0;
+    tcpserver_details::Message newBuffer = m_serverSocket.Receive(MESSAGES_BUFFER_SIZE);
+    while(newBuffer.Size() != 0)
     {
-        completeMessage += newBuffer;
-        newBuffer = m_serverSocket.Receive(MESSAGES_BUFFER_SIZE);
+        a_input.Append(newBuffer.ToBytes(), newBuffer.Size());
+        receivedBytes += newBuffer.Size();
+        if(!ReactorPolicy::IS_EDGE_TRIGGERED) // A level-triggered reactor reports the client again if more bytes are left - a blocking socket must not be read again now
+        {
+            break;
+        }
+
+        newBuffer = m_serverSocket.Receive(MESSAGES_BUFFER_SIZE); // An edge-triggered reactor reports the client only once - drain it
     }
 
-    return completeMessage; // Could be empty message if the first receive attempt returned an empty message
+    return receivedBytes;
 }
 
 
@@ -0,0 +1,38 @@
+#ifndef NM_TCP_SERVER_FRAMING_POLICIES_HXX
+#define NM_TCP_SERVER_FRAMING_POLICIES_HXX
+
+
+#include "tcp_socket.hpp"
+
+
+namespace infra
+{
+
+template <unsigned char SELECTOR_BYTE, typename SelectedFramingPolicy, typename OtherFramingPolicy>
+FrameStatus FirstByteSelectedFramingPolicy<SELECTOR_BYTE,SelectedFramingPolicy,OtherFramingPolicy>::ExtractFrame(InputBuffer& a_input, TCPSocket::BytesBufferProxy& a_frame) const
+{
+    if(a_input.FramingState() == NOT_SELECTED_YET)
+    {
+        if(a_input.Size() == 0)
+        {
+            return FRAME_INCOMPLETE;
+        }
+
+        if(a_input.Data()[0] == SELECTOR_BYTE)
+        {
+            a_input.Consume(1);
+            a_input.SetFramingState(SELECTED_FRAMING);
+        }
+        else
+        {
+            a_input.SetFramingState(OTHER_FRAMING);
+        }
+    }
+
+    return a_input.FramingState() == SELECTED_FRAMING ? m_selectedFraming.ExtractFrame(a_input, a_frame) : m_otherFraming.ExtractFrame(a_input, a_frame);
+}
+
+} // infra
+
+
+#endif // NM_TCP_SERVER_FRAMING_POLICIES_HXX
@@ -4,9 +4,11 @@
 
 #include <cstddef> // size_t
 #include <list>
+#include <vector> // std::vector
 #include <memory> // std::shared_ptr
+#include <pthread.h> // pthread_t
 #include <stdexcept> // std::runtime_error
-#include <algorithm> // std::for_each
+#include <algorithm> // std::for_each, std::find_if
 #include "thread.hpp"
 #include "icallable.hpp"
 
@@ -97,6 +99,34 @@ void ThreadGroup<DestructionPolicy>::Remove(size_t a_threadsToRemove)
 }
 
 
+template <typename DestructionPolicy>
+void ThreadGroup<DestructionPolicy>::JoinAndRemove(const std::vector<pthread_t>& a_threadsIDs)
+{
+    for(pthread_t threadID : a_threadsIDs)
+    {
+        auto itr = std::find_if(m_threadsGroup.begin(), m_threadsGroup.end(), [threadID](const std::shared_ptr<Thread<DestructionPolicy>>& a_thread)
+        {
+            return a_thread->IsThread(threadID);
+        });
+        if(itr == m_threadsGroup.end()) // Cleaned as a done thread already
+        {
+            continue;
+        }
+
+        try
+        {
+            (*itr)->Join();
+        }
+        catch(...)
+        {
+            // Do nothing - the thread is removed anyway
+        }
+        m_threadsGroup.erase(itr);
+        --m_size;
+    }
+}
+
+
 template <typename DestructionPolicy>
 size_t ThreadGroup<DestructionPolicy>::Size()
 {
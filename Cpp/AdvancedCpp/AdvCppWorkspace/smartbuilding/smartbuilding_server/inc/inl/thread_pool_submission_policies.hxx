@@ -0,0 +1,123 @@
+#ifndef NM_THREAD_POOL_SUBMISSION_POLICIES_HXX
+#define NM_THREAD_POOL_SUBMISSION_POLICIES_HXX
+
+
+#include <memory> // std::shared_ptr
+#include <mutex> // std::mutex, std::lock_guard
+#include <algorithm> // std::remove_if
+#include <utility> // std::move
+#include "icallable.hpp"
+#include "task.hpp"
+#include "thread.hpp"
+#include "thread_destruction_policies.hpp"
+#include "works_enqueuer.hpp"
+#include "two_way_multi_sync_handler.hpp"
+#include "latch.hpp"
+#include "workers_activity.hpp"
+#include "works_scheduler.hpp"
+#include "work_stealing_registry.hpp"
+#include "work_stealing_scheduler.hpp"
+
+
+namespace advcpp
+{
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+void DirectSubmissionPolicy<QueueTypeDestructionPolicy,QueueType>::operator()(std::shared_ptr<QueueType> a_worksQueue, Task a_work)
+{
+    a_worksQueue->Enqueue(std::move(a_work));
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+std::shared_ptr<ICallable> DirectSubmissionPolicy<QueueTypeDestructionPolicy,QueueType>::CreateWorksScheduler(std::shared_ptr<QueueType> a_worksQueue, std::shared_ptr<TwoWayMultiSyncHandler> a_twoWayMultiSyncHandler, std::shared_ptr<std::mutex> a_workersLock, std::shared_ptr<Latch> a_inFlightWorks, std::shared_ptr<WorkersActivity> a_workersActivity)
+{
+    return std::shared_ptr<ICallable>(new WorksScheduler<QueueTypeDestructionPolicy,QueueType>(a_worksQueue, a_twoWayMultiSyncHandler, a_workersLock, a_inFlightWorks, a_workersActivity));
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+size_t DirectSubmissionPolicy<QueueTypeDestructionPolicy,QueueType>::StolenWorksCount() const
+{
+    return 0;
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+void AsyncSubmissionPolicy<QueueTypeDestructionPolicy,QueueType>::operator()(std::shared_ptr<QueueType> a_worksQueue, Task a_work)
+{
+    std::shared_ptr<ICallable> worksEnqueuer(new WorksEnqueuer<QueueTypeDestructionPolicy,QueueType>(a_worksQueue, std::move(a_work)));
+    std::shared_ptr<Thread<DetachPolicy>> workEnqueueTask(new Thread<DetachPolicy>(worksEnqueuer, DetachPolicy()));
+    workEnqueueTask->Detach();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    CleanDoneEnqueueThreads(); // Keeps the threads container bounded by the number of the currently pending enqueue operations
+    m_enqueueWorkThreads.push_back(workEnqueueTask);
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+std::shared_ptr<ICallable> AsyncSubmissionPolicy<QueueTypeDestructionPolicy,QueueType>::CreateWorksScheduler(std::shared_ptr<QueueType> a_worksQueue, std::shared_ptr<TwoWayMultiSyncHandler> a_twoWayMultiSyncHandler, std::shared_ptr<std::mutex> a_workersLock, std::shared_ptr<Latch> a_inFlightWorks, std::shared_ptr<WorkersActivity> a_workersActivity)
+{
+    return std::shared_ptr<ICallable>(new WorksScheduler<QueueTypeDestructionPolicy,QueueType>(a_worksQueue, a_twoWayMultiSyncHandler, a_workersLock, a_inFlightWorks, a_workersActivity));
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+size_t AsyncSubmissionPolicy<QueueTypeDestructionPolicy,QueueType>::StolenWorksCount() const
+{
+    return 0;
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+void AsyncSubmissionPolicy<QueueTypeDestructionPolicy,QueueType>::CleanDoneEnqueueThreads()
+{
+    m_enqueueWorkThreads.erase(std::remove_if(m_enqueueWorkThreads.begin(), m_enqueueWorkThreads.end(), [](std::shared_ptr<Thread<DetachPolicy>> a_enqueueWorkTask)
+    {
+        return a_enqueueWorkTask->HasDone();
+    }), m_enqueueWorkThreads.end());
+}
+
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+WorkStealingPolicy<QueueTypeDestructionPolicy,QueueType>::WorkStealingPolicy()
+: m_registry(new WorkStealingRegistry())
+{
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+void WorkStealingPolicy<QueueTypeDestructionPolicy,QueueType>::operator()(std::shared_ptr<QueueType> a_worksQueue, Task a_work)
+{
+    if(!m_registry->PushLocal(std::move(a_work))) // Not submitted from a worker of this pool (or the worker's deque is full) - a_work was not moved
+    {
+        a_worksQueue->Enqueue(std::move(a_work));
+        return;
+    }
+
+    if(m_registry->IdleWorkersCount() > 0) // Blocked idle workers wait on the works queue - wake one of them to steal the new work
+    {
+        a_worksQueue->TryEnqueue(Task()); // An empty task
+    }
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+std::shared_ptr<ICallable> WorkStealingPolicy<QueueTypeDestructionPolicy,QueueType>::CreateWorksScheduler(std::shared_ptr<QueueType> a_worksQueue, std::shared_ptr<TwoWayMultiSyncHandler> a_twoWayMultiSyncHandler, std::shared_ptr<std::mutex> a_workersLock, std::shared_ptr<Latch> a_inFlightWorks, std::shared_ptr<WorkersActivity> a_workersActivity)
+{
+    return std::shared_ptr<ICallable>(new WorkStealingScheduler<QueueTypeDestructionPolicy,QueueType>(a_worksQueue, a_twoWayMultiSyncHandler, a_workersLock, a_inFlightWorks, a_workersActivity, m_registry));
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+size_t WorkStealingPolicy<QueueTypeDestructionPolicy,QueueType>::StolenWorksCount() const
+{
+    return m_registry->StolenWorksCount();
+}
+
+} // advcpp
+
+
+#endif // NM_THREAD_POOL_SUBMISSION_POLICIES_HXX
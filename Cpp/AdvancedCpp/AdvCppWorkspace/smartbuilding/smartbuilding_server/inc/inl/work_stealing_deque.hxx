@@ -0,0 +1,191 @@
+#ifndef NM_WORK_STEALING_DEQUE_HXX
+#define NM_WORK_STEALING_DEQUE_HXX
+
+
+#include <cstddef> // size_t
+#include <new> // placement new
+#include <utility> // std::move, std::forward
+#include <stdexcept> // std::runtime_error
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(size_t a_capacity)
+: m_capacity(RoundUpToPowerOfTwo(a_capacity))
+, m_indexMask(m_capacity - 1)
+, m_slots(m_capacity)
+, m_top(0)
+, m_bottom(0)
+{
+    if(!a_capacity)
+    {
+        throw std::runtime_error("Capacity cannot be zero");
+    }
+}
+
+
+template <typename T>
+WorkStealingDeque<T>::~WorkStealingDeque()
+{
+    for(long position = m_top.Get(); position < m_bottom.Get(); ++position)
+    {
+        ItemOf(SlotAt(position))->~T();
+    }
+}
+
+
+template <typename T>
+bool WorkStealingDeque<T>::Push(const T& a_item)
+{
+    return PushItem(a_item);
+}
+
+
+template <typename T>
+bool WorkStealingDeque<T>::Push(T&& a_item)
+{
+    return PushItem(std::move(a_item));
+}
+
+
+template <typename T>
+template <typename Item>
+bool WorkStealingDeque<T>::PushItem(Item&& a_item)
+{
+    long bottom = m_bottom.Get();
+    long top = m_top.Get(); // Might be stale - top only grows, so the free space is never over-estimated
+    Slot& slot = SlotAt(bottom);
+    if(bottom - top >= long(m_capacity) || slot.m_isOccupied.Check()) // A stealer that has claimed the slot's previous item might still move it out
+    {
+        return false;
+    }
+
+    new (&slot.m_item) T(std::forward<Item>(a_item)); // Exception prone code - before the deque is touched
+    slot.m_isOccupied.True();
+    m_bottom.Set(bottom + 1); // Publish the item to the stealers
+
+    return true;
+}
+
+
+template <typename T>
+bool WorkStealingDeque<T>::Pop(T& a_itemToReturnByRef)
+{
+    long bottom = m_bottom.Get() - 1;
+    m_bottom.Set(bottom); // Reserve the bottom item before looking at the top (full barrier)
+    long top = m_top.Get();
+
+    if(top > bottom) // Empty
+    {
+        m_bottom.Set(bottom + 1);
+        return false;
+    }
+
+    if(top == bottom) // The last item - race against the stealers on the top
+    {
+        bool hasWon = m_top.SetIf(top, top + 1);
+        m_bottom.Set(bottom + 1);
+        if(!hasWon)
+        {
+            return false;
+        }
+    }
+
+    TakeItemAt(bottom, a_itemToReturnByRef);
+
+    return true;
+}
+
+
+template <typename T>
+bool WorkStealingDeque<T>::Steal(T& a_itemToReturnByRef)
+{
+    long top = m_top.Get();
+    long bottom = m_bottom.Get();
+    if(top >= bottom) // Empty
+    {
+        return false;
+    }
+
+    if(!m_top.SetIf(top, top + 1)) // The owner or another stealer has taken it first - its item is never touched
+    {
+        return false;
+    }
+
+    TakeItemAt(top, a_itemToReturnByRef);
+
+    return true;
+}
+
+
+template <typename T>
+void WorkStealingDeque<T>::TakeItemAt(long a_position, T& a_itemToReturnByRef)
+{
+    Slot& slot = SlotAt(a_position);
+    T* item = ItemOf(slot);
+    try
+    {
+        a_itemToReturnByRef = std::move(*item);
+    }
+    catch(...)
+    {
+        item->~T(); // The item is lost - but its slot is never leaked
+        slot.m_isOccupied.False();
+        throw;
+    }
+
+    item->~T();
+    slot.m_isOccupied.False(); // Last - the owner may construct the next item in the slot
+}
+
+
+template <typename T>
+size_t WorkStealingDeque<T>::Size() const
+{
+    long top = m_top.Get();
+    long bottom = m_bottom.Get();
+
+    return bottom > top ? size_t(bottom - top) : 0; // bottom might be below top while the owner pops the last item
+}
+
+
+template <typename T>
+size_t WorkStealingDeque<T>::Capacity() const
+{
+    return m_capacity;
+}
+
+
+template <typename T>
+size_t WorkStealingDeque<T>::RoundUpToPowerOfTwo(size_t a_value)
+{
+    size_t powerOfTwo = 1;
+    while(powerOfTwo < a_value)
+    {
+        powerOfTwo <<= 1;
+    }
+
+    return powerOfTwo;
+}
+
+
+template <typename T>
+typename WorkStealingDeque<T>::Slot& WorkStealingDeque<T>::SlotAt(long a_position)
+{
+    return m_slots[a_position & m_indexMask];
+}
+
+
+template <typename T>
+T* WorkStealingDeque<T>::ItemOf(Slot& a_slot)
+{
+    return reinterpret_cast<T*>(&a_slot.m_item);
+}
+
+} // advcpp
+
+
+#endif // NM_WORK_STEALING_DEQUE_HXX
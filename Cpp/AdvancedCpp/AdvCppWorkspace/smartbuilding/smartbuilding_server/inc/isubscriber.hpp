@@ -2,21 +2,23 @@
 #define NM_ISUBSCRIBER_HPP
 
 
-#include <memory> // std::shared_ptr
+#include <vector> // std::vector
+#include <utility> // std::pair
 #include "tcp_socket.hpp"
 #include "event.hpp"
-#include "blocking_bounded_queue.hpp"
-#include "blocking_bounded_queue_destruction_policies.hpp"
+#include "connection_handle.hpp"
 
 
 namespace smartbuilding
 {
 
+// Notify appends the subscriber's handled buffers to a_handledBuffers, each one addressed by the ConnectionHandle of its remote device
+// Note: a_handledBuffers is staged by the calling invoker (never shared with other threads) - appending to it never blocks
 class ISubscriber
 {
 public:
     virtual ~ISubscriber() = default;
-    virtual void Notify(Event a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue) = 0;
+    virtual void Notify(Event a_event, std::vector<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>& a_handledBuffers) = 0;
 };
 
 } // smartbuilding
@@ -0,0 +1,73 @@
+#ifndef NM_LATENCY_HISTOGRAM_HPP
+#define NM_LATENCY_HISTOGRAM_HPP
+
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <array> // std::array
+#include <vector> // std::vector
+#include <chrono> // std::chrono::nanoseconds
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+// The recorded values of a LatencyHistogram at some moment - can be merged with other snapshots (e.g. of other workers)
+class HistogramSnapshot
+{
+public:
+    HistogramSnapshot(); // An empty snapshot
+
+    void Merge(const HistogramSnapshot& a_other);
+
+    size_t Count() const;
+    std::chrono::nanoseconds Max() const;
+    std::chrono::nanoseconds Mean() const;
+    std::chrono::nanoseconds Percentile(double a_percentile) const; // a_percentile in [0, 100] - the highest value of its bucket (up to 12.5% above the recorded value)
+
+private:
+    friend class LatencyHistogram;
+
+    std::vector<size_t> m_buckets;
+    size_t m_count;
+    uint64_t m_sum;
+    uint64_t m_max;
+};
+
+
+// An HDR-style (log-linear) histogram of nanosecond latencies: values below 16ns are exact, bigger values fall into 8 buckets per power of 2
+// (at most 12.5% relative error), so all the 64-bit range is covered by a fixed number of buckets
+// Record is lock-free (a few atomic increments) - Snapshot may see a record partially, but never a torn counter
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+    LatencyHistogram(const LatencyHistogram& a_other) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram& a_other) = delete;
+    ~LatencyHistogram() = default;
+
+    void Record(std::chrono::nanoseconds a_latency); // A negative latency is recorded as 0
+    HistogramSnapshot Snapshot() const;
+
+private:
+    static const size_t SUB_BUCKET_BITS = 3;
+    static const size_t SUB_BUCKETS_COUNT = 1 << SUB_BUCKET_BITS;
+    static const size_t EXACT_VALUES_COUNT = 2 * SUB_BUCKETS_COUNT;
+    static const size_t BUCKETS_COUNT = EXACT_VALUES_COUNT + (64 - SUB_BUCKET_BITS - 1) * SUB_BUCKETS_COUNT;
+
+    friend class HistogramSnapshot;
+    static size_t BucketOf(uint64_t a_value);
+    static uint64_t HighestValueOf(size_t a_bucket);
+
+private:
+    std::array<AtomicValue<size_t>, BUCKETS_COUNT> m_buckets;
+    AtomicValue<size_t> m_count;
+    AtomicValue<uint64_t> m_sum;
+    AtomicValue<uint64_t> m_max;
+};
+
+} // advcpp
+
+
+#endif // NM_LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,115 @@
+#ifndef NM_LOCK_FREE_BOUNDED_QUEUE_HPP
+#define NM_LOCK_FREE_BOUNDED_QUEUE_HPP
+
+
+#include <cstddef> // size_t
+#include <chrono> // std::chrono::nanoseconds, std::chrono::steady_clock
+#include <vector> // std::vector
+#include <mutex> // std::mutex
+#include <condition_variable> // std::condition_variable
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+// A bounded multi-producer/multi-consumer ring buffer, an alternative QueueType to BlockingBoundedQueue (same Enqueue/Dequeue/destruction policy contract)
+// Each slot holds a sequence number, so producers and consumers claim slots with a single CAS on the enqueue/dequeue positions, without any lock.
+// A blocked Enqueue/Dequeue spins, then yields, and only then parks on a condition variable (the other side notifies only if someone is parked)
+// Concept of T: MUST be default-constructable and move-assignable, and its move-assignment MUST NOT throw
+// (and copy-constructable, if the copying Enqueue variants are used)
+// Concept of DestructionPolicy: policy must be copy-constructable
+// The destruction policy is a FUNCTOR (implements operator() and get 1 param: LockFreeBoundedQueue& obj), to be used as an instructions to know which action the LockFreeBoundedQueue
+// object should call on itself when it is in a destruction stage (the BlockingBoundedQueue destruction policies can be used as well)
+// Note: The capacity is rounded up to the next power of two
+template <typename T, typename DestructionPolicy>
+class LockFreeBoundedQueue
+{
+    friend DestructionPolicy;
+public:
+    LockFreeBoundedQueue(size_t a_initialCapacity, DestructionPolicy a_destructionPolicy); // DestructionPolicy is a lightweight object (can get it by value (copy))
+    LockFreeBoundedQueue(const LockFreeBoundedQueue& a_other) = delete;
+    LockFreeBoundedQueue& operator=(const LockFreeBoundedQueue& a_other) = delete;
+    ~LockFreeBoundedQueue();
+
+    // Returns false if the queue is closed and no further operations can be done with it
+    bool Enqueue(const T& a_item);
+    bool Enqueue(T&& a_item); // Moves the item into the queue (for move-only types)
+    bool Dequeue(T& a_itemToReturnByRef);
+
+    // Non-blocking and bounded-wait variants of Enqueue
+    // Returns false if the queue is closed, or if no free slot became available (immediately / until the timeout has expired)
+    // The rvalue variants move from a_item ONLY if it was enqueued (so a move-only item can be retried)
+    bool TryEnqueue(const T& a_item);
+    bool TryEnqueue(T&& a_item);
+    bool EnqueueFor(const T& a_item, std::chrono::nanoseconds a_timeout);
+    bool EnqueueFor(T&& a_item, std::chrono::nanoseconds a_timeout);
+
+    // Non-blocking variant of Dequeue - returns false if the queue is closed or empty
+    bool TryDequeue(T& a_itemToReturnByRef);
+
+    size_t Size() const; // Returns 0 if queue is not valid
+    size_t Capacity() const; // Returns 0 if queue is not valid
+    bool IsEmpty() const; // Returns true if queue is not valid
+    bool IsFull() const; // Returns false if queue is not valid
+
+private:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    struct Slot
+    {
+        AtomicValue<size_t> m_sequence;
+        T m_item;
+    };
+
+    void ReleaseAllBlockedWaiters();
+    void Close();
+    bool IsClosed() const;
+
+    bool PushOrWait(T& a_item, const TimePoint* a_deadline); // No deadline (nullptr) - waits until the item is pushed or the queue is closed
+    bool PopOrWait(T& a_itemToReturnByRef);
+    bool TryPush(T& a_item); // Lock-free, moves from a_item only if it was pushed - returns false if the queue is full
+    bool TryPop(T& a_itemToReturnByRef); // Lock-free, returns false if the queue is empty
+    void WakeParkedProducer();
+    void WakeParkedConsumer();
+    static size_t RoundUpToPowerOfTwo(size_t a_value);
+
+    // For policy uses (without locking)
+    bool RemoveNext(T& a_itemToReturnByRef) noexcept; // true if succeed, else false
+    bool Empty() const noexcept;
+    size_t GetSize() const noexcept;
+
+private:
+    static const size_t SPIN_ITERATIONS = 64;
+    static const size_t YIELD_ITERATIONS = 16;
+    static const size_t CACHE_LINE_SIZE = 64;
+
+private:
+    size_t m_capacity;
+    size_t m_indexMask;
+    std::vector<Slot> m_slots;
+    // Paddings - producers and consumers do not invalidate each other's position cache line (C++11 new doesn't support over-aligned types)
+    char m_enqueuePositionPadding[CACHE_LINE_SIZE];
+    AtomicValue<size_t> m_enqueuePosition;
+    char m_dequeuePositionPadding[CACHE_LINE_SIZE];
+    AtomicValue<size_t> m_dequeuePosition;
+    char m_parkedWaitersPadding[CACHE_LINE_SIZE];
+    AtomicValue<size_t> m_parkedProducers;
+    AtomicValue<size_t> m_parkedConsumers;
+    std::mutex m_notFullMutex;
+    std::condition_variable m_notFull;
+    std::mutex m_notEmptyMutex;
+    std::condition_variable m_notEmpty;
+    DestructionPolicy m_destructionPolicy;
+    AtomicValue<size_t> m_enqueueWaiters;
+    AtomicValue<size_t> m_dequeueWaiters;
+    AtomicFlag m_isValid;
+};
+
+} // advcpp
+
+
+#include "inl/lock_free_bounded_queue.hxx"
+
+
+#endif // NM_LOCK_FREE_BOUNDED_QUEUE_HPP
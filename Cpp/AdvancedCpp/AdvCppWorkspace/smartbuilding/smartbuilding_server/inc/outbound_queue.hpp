@@ -0,0 +1,87 @@
+#ifndef NM_OUTBOUND_QUEUE_HPP
+#define NM_OUTBOUND_QUEUE_HPP
+
+
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr, std::weak_ptr, std::enable_shared_from_this
+#include <vector> // std::vector
+#include <deque> // std::deque
+#include <mutex> // std::mutex
+#include <atomic> // std::atomic
+#include "tcp_socket.hpp"
+
+
+namespace infra
+{
+
+class OutboundQueue;
+
+
+// Collects a server's outbound queues that have new posted messages, and wakes up the server's reactor by its wakeup event (an eventfd that is owned by the server)
+// [Thread safety: Schedule can be called from any thread, TakeScheduled is called by the server's thread]
+class OutboundQueuesScheduler
+{
+public:
+    explicit OutboundQueuesScheduler(int a_wakeupID) : m_wakeupID(a_wakeupID), m_lock(), m_scheduledQueues() {}
+    OutboundQueuesScheduler(const OutboundQueuesScheduler& a_other) = delete;
+    OutboundQueuesScheduler& operator=(const OutboundQueuesScheduler& a_other) = delete;
+    ~OutboundQueuesScheduler() = default;
+
+    void Schedule(std::shared_ptr<OutboundQueue> a_queue);
+    void TakeScheduled(std::vector<std::shared_ptr<OutboundQueue>>& a_queues); // a_queues is replaced by the scheduled queues
+
+private:
+    int m_wakeupID;
+    std::mutex m_lock;
+    std::vector<std::shared_ptr<OutboundQueue>> m_scheduledQueues;
+};
+
+
+// The outbound queue of a single connection of a TCPServer - any thread posts messages to it, and only the server's thread sends them (in order, coalesced into a single
+// vectored send per writability of the connection), so the messages of different threads are never interleaved on the socket, and a full socket never blocks a poster
+// Backpressure: QueuedBytes (posted or queued by the server, and not sent yet) is readable by any thread, and Post refuses messages while the connection is above its
+// high-water mark - the producers of a slow connection stop producing for it, instead of growing its queue without a bound
+// Drop policy: a refused post is dropped (never retried by the queue), and so are the posted messages that were not taken when the connection closes -
+// both are counted by DroppedMessagesCount
+class OutboundQueue : public std::enable_shared_from_this<OutboundQueue>
+{
+public:
+    using Message = TCPSocket::BytesBufferProxy;
+
+    OutboundQueue(int a_clientID, std::shared_ptr<TCPSocket> a_client, std::shared_ptr<OutboundQueuesScheduler> a_scheduler, size_t a_highWaterMark);
+    OutboundQueue(const OutboundQueue& a_other) = delete;
+    OutboundQueue& operator=(const OutboundQueue& a_other) = delete;
+    ~OutboundQueue() = default;
+
+    // Thread safety: can be called from any thread
+    bool Post(const Message& a_message); // Returns false (the message is dropped) if the connection has closed, or if it is above its high-water mark
+    size_t QueuedBytes() const { return m_queuedBytes.load(std::memory_order_relaxed); }
+    size_t HighWaterMark() const { return m_highWaterMark; }
+    bool IsAboveHighWaterMark() const { return QueuedBytes() >= m_highWaterMark; }
+    size_t DroppedMessagesCount() const { return m_droppedMessagesCount.load(std::memory_order_relaxed); } // Since the queue was created
+    int ClientID() const { return m_clientID; }
+
+    // Used only by the server's thread:
+    bool IsQueueOf(const std::shared_ptr<TCPSocket>& a_client) const; // The client's ID might belong to a new connection already
+    void TakePosted(std::deque<Message>& a_output); // Appends the posted messages to a_output (in order)
+    void AddQueuedBytes(size_t a_bytes) { m_queuedBytes.fetch_add(a_bytes, std::memory_order_relaxed); } // The server's own messages (responses) that wait in its output
+    void RemoveSentBytes(size_t a_bytes) { m_queuedBytes.fetch_sub(a_bytes, std::memory_order_relaxed); }
+    void Close(); // The connection has closed - the posted messages are dropped, and the next posts are refused (the bytes in the server's output are still removed by it)
+
+private:
+    int m_clientID;
+    std::weak_ptr<TCPSocket> m_client; // Not owned - only identifies the connection (also after its socket was destroyed, the identity of a std::weak_ptr is never reused)
+    std::shared_ptr<OutboundQueuesScheduler> m_scheduler;
+    size_t m_highWaterMark;
+    std::atomic<size_t> m_queuedBytes;
+    std::atomic<size_t> m_droppedMessagesCount;
+    std::mutex m_lock;
+    std::vector<Message> m_postedMessages; // Guarded by m_lock
+    bool m_isScheduled; // Guarded by m_lock - the server's thread was notified already (one wakeup per batch of posts)
+    bool m_isClosed; // Guarded by m_lock
+};
+
+} // infra
+
+
+#endif // NM_OUTBOUND_QUEUE_HPP
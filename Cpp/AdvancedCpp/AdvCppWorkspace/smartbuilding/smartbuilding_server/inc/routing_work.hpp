@@ -2,39 +2,73 @@
 #define NM_ROUTING_WORK_HPP
 
 
+#include <cstddef> // size_t
 #include <string> // std::string
 #include <memory> // std::shared_ptr
 #include <utility> // std::pair
+#include <vector> // std::vector
+#include <iterator> // std::back_inserter
+#include <chrono> // std::chrono::nanoseconds
 #include "icallable.hpp"
 #include "tcp_socket.hpp"
 #include "event.hpp"
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
+#include "future.hpp"
 #include "events_router.hpp"
 
 
 namespace smartbuilding
 {
 
-class RoutingWork : public advcpp::ICallable
+// The routing stage of the publish -> route -> encode -> send chain: submitted to the routing workers once per publish,
+// drains (without waiting) every published event that is already in the queue, and routes them in bursts of up to MAX_BATCH_SIZE
+// Returns a future that is ready when all the subscribers of the routed events were notified (their handled buffers were flushed to the handled buffers queue,
+// and a_handledBuffersSender was triggered after each flush)
+// Submitted BY VALUE to the routing workers (small enough to be held inside the pool's Task - no allocation per work)
+class RoutingWork
 {
 public:
-    RoutingWork(std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueueToFill, std::shared_ptr<EventsRouter> a_eventsRouter, const Event& a_eventToRoute)
-    : m_handledBuffersQueueToFill(a_handledBuffersQueueToFill)
+    RoutingWork(std::shared_ptr<advcpp::BlockingBoundedQueue<Event, advcpp::NoOperationPolicy<Event>>> a_publishedEventsQueue, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueueToFill, std::shared_ptr<advcpp::ICallable> a_handledBuffersSender, std::shared_ptr<EventsRouter> a_eventsRouter)
+    : m_publishedEventsQueue(a_publishedEventsQueue)
+    , m_handledBuffersQueueToFill(a_handledBuffersQueueToFill)
+    , m_handledBuffersSender(a_handledBuffersSender)
     , m_eventsRouter(a_eventsRouter)
-    , m_eventToRoute(a_eventToRoute)
     {
     }
 
-    virtual void operator()() override
+    advcpp::Future<void> operator()()
     {
-        m_eventsRouter->RouteEvent(m_eventToRoute, m_handledBuffersQueueToFill);
+        std::vector<advcpp::Future<void>> routedEvents;
+        std::vector<Event> eventsToRoute;
+        eventsToRoute.reserve(MAX_BATCH_SIZE);
+        while(m_publishedEventsQueue->DequeueBulk(std::back_inserter(eventsToRoute), MAX_BATCH_SIZE, std::chrono::nanoseconds(0)) > 0) // Never waits - an empty queue means an earlier routing work took the events
+        {
+            for(size_t i = 0; i < eventsToRoute.size(); ++i)
+            {
+                try
+                {
+                    routedEvents.push_back(m_eventsRouter->RouteEvent(eventsToRoute[i], m_handledBuffersQueueToFill, m_handledBuffersSender));
+                }
+                catch(...)
+                {
+                    // A failure of one event should not drop the rest of the batch
+                }
+            }
+            eventsToRoute.clear();
+        }
+
+        return advcpp::WhenAll(routedEvents);
     }
 
 private:
-    std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> m_handledBuffersQueueToFill;
+    static const size_t MAX_BATCH_SIZE = 32; // The published events are dequeued in bursts of up to MAX_BATCH_SIZE events (one lock of the queue per burst)
+
+private:
+    std::shared_ptr<advcpp::BlockingBoundedQueue<Event, advcpp::NoOperationPolicy<Event>>> m_publishedEventsQueue;
+    std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>> m_handledBuffersQueueToFill;
+    std::shared_ptr<advcpp::ICallable> m_handledBuffersSender;
     std::shared_ptr<EventsRouter> m_eventsRouter;
-    Event m_eventToRoute;
 };
 
 } // smartbuilding
@@ -5,7 +5,7 @@
 #include <string> // std::string
 #include <memory> // std::shared_ptr
 #include <unordered_map>
-#include "safe_logger_decorator.hpp"
+#include "ilogger.hpp"
 
 
 namespace smartbuilding
@@ -19,10 +19,11 @@ public:
     SafeLoggersManager& operator=(const SafeLoggersManager& a_other) = delete;
     ~SafeLoggersManager() = default;
 
-    std::shared_ptr<SafeLoggerDecorator> GetLogger(const std::string& a_logFileName); // Returns a default.log logger if a_logFileName is empty
+    // Returns a default.log logger if a_logFileName is empty - the loggers are asynchronous FileLoggers (thread safe by themselves, without a SafeLoggerDecorator)
+    std::shared_ptr<ILogger> GetLogger(const std::string& a_logFileName);
 
 private:
-    std::unordered_map<std::string, std::shared_ptr<SafeLoggerDecorator>> m_loggersTable;
+    std::unordered_map<std::string, std::shared_ptr<ILogger>> m_loggersTable;
 };
 
 } // smartbuilding
@@ -3,9 +3,6 @@
 
 
 #include <memory> // std::unique_ptr
-#include <vector> // std::vector
-#include <string> // std::string
-#include <sstream> // std::stringstream, std::getline
 #include "tcp_socket.hpp" // BytesBufferProxy
 #include "smartbuilding_request.hpp"
 
@@ -17,41 +14,50 @@ namespace smartbuilding
 *
 * Protocol's buffer design documentation:
 *
-* Each new field should be saperated by & sign. (Spaces in this example should be ignored)
-* Note: this protocol should be updated when a new SmartBuildingRequest type is going to be added to the system's requests supported list!
+* The first byte of a buffer selects its format - the BINARY_FORMAT_MAGIC byte selects the binary format, any other byte is a request type of the text format.
+* Note: this protocol should be updated when a new request type is going to be added to the system's requests supported list!
 *
-* A base buffer example:
-* [ RequestType & DeviceID (if needed: & AdditionalData)]
-* RequestType: char (for the valid chars table - check the supported requests details below)
-* DeviceID: string
+* Request types (the same chars in both formats):
+* 'C' - Connect, 'D' - Disconnect, 'S' - Subscribe, 'U' - Unsubscribe, 'E' - Event
 *
+* Warning: before sending a disconnect request, the remote devices MUST make sure to send unsubscribe requests, to unsubscribe itself from ALL the pre-subscribed events!
 *
-* Supported requests buffers designs (Spaces in this example should be ignored):
 *
-* Connect request:
-* ['C' & DeviceID]
+* Binary format (version 1) - fixed header, then length-prefixed fields (a varint is an unsigned LEB128 number: 7 bits per byte, the high bit marks a following byte):
+* [ BINARY_FORMAT_MAGIC (1 byte) | Version (1 byte) | RequestType (1 byte) | DeviceID length (varint) | DeviceID | AdditionalData ]
 *
+* Connect request:     no additional data
+* Disconnect request:  no additional data
+* Subscribe request:   [ Rooms count (varint) | Rooms (varints) | Floors count (varint) | Floors (varints) | EventType length (varint) | EventType ]
+*                      (a count of 0 indicates all the rooms / floors)
+* Unsubscribe request: [ EventType length (varint) | EventType ]
+* Event request:       [ EventDataBuffer ] - all the rest of the buffer
 *
-* Warning: before sending a disconnect request, the remote devices MUST make sure to send unsubscribe requests, to unsubscribe itself from ALL the pre-subscribed events!
-* Disconnect request:
-* ['D' & DeviceID]
 *
+* Connection framing (by the hub) - the first byte of a connection selects the framing of all its buffers:
+*
+* Binary format connection: the preamble is a single BINARY_FORMAT_MAGIC byte, sent once - right after the connection was opened, and before its first buffer
+* (the preamble is not part of any buffer - so each buffer still starts by its own BINARY_FORMAT_MAGIC byte). Then, each buffer is sent with
+* a 4 bytes length prefix (big endian, not including itself, up to 16MB) - so several buffers can be sent together:
+* [ BINARY_FORMAT_MAGIC (preamble, once) | Length | Buffer | Length | Buffer | ... ]
+* Example - a connect request of device "d1": B5 | 00 00 00 06 | B5 01 'C' 02 'd' '1'
 *
-* Subscribe request:
-* ['S' & DeviceID & Room/s & Floor/s & EventType]
-* Rooms: a COMMA separeted list of rooms to subscribe for (to indicate all rooms: put 0 without any additional commas)
-* Floors: a COMMA separeted list of floors to subscribe for (to indicate all floors: put 0 without any additional commas)
-* EventType: string
+* Text format connection: a connection that starts by any other byte - each buffer ends by a new line ('\n', not part of the buffer, up to 64KB):
+* [ Buffer '\n' Buffer '\n' ... ]
+* Example - a connect request of device "d1": C&d1\n
 *
 *
-* Unsubscribe request:
-* ['U' & DeviceID & EventType]
-* EventType: string
+* Text format (accepted for old devices) - each new field should be saperated by & sign. (Spaces in this example should be ignored)
+* [ RequestType & DeviceID (if needed: & AdditionalData) ]
 *
+* Connect request:     ['C' & DeviceID]
+* Disconnect request:  ['D' & DeviceID]
+* Subscribe request:   ['S' & DeviceID & Room/s & Floor/s & EventType]
+*                      Rooms / Floors: a COMMA separeted list of decimals (to indicate all rooms / floors: put 0 without any additional commas)
+* Unsubscribe request: ['U' & DeviceID & EventType]
+* Event request:       ['E' & DeviceID & EventDataBuffer]
 *
-* Event request:
-* ['E' & DeviceID & EventDataBuffer]
-* EventDataBuffer: BytesBufferProxy (should include ALL the data that the IPublisher device should get to create a new Event object [example: event type, location (room + floor), timestamp, and data payload])
+* EventDataBuffer: should include ALL the data that the IPublisher device should get to create a new Event object [example: event type, location (room + floor), timestamp, and data payload]
 *
 **/
 
@@ -60,6 +66,10 @@ namespace smartbuilding
 // Provides a double check lock initialization to support multithreading (multithreaded safety)
 class SmartBuildingNetworkProtocol
 {
+public:
+    static const unsigned char BINARY_FORMAT_MAGIC = 0xB5; // Not a printable char - cannot start a text format buffer
+    static const unsigned char BINARY_FORMAT_VERSION = 1;
+
 public:
     // An heap allocation initialization, returns nullptr if SmartBuildingNetworkProtocol had already initialized in the system
     static std::unique_ptr<SmartBuildingNetworkProtocol> GetNetworkProtocol();
@@ -68,9 +78,9 @@ public:
     SmartBuildingNetworkProtocol& operator=(const SmartBuildingNetworkProtocol& a_other) = delete;
     ~SmartBuildingNetworkProtocol() = default;
 
-    // Main protocol's parsing method:
-    // [Returns nullptr if the buffer is empty or if the buffer is not matching the protocol]
-    std::shared_ptr<SmartBuildingRequest> Parse(infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const;
+    // Main protocol's parsing method - fills a_request by views into a_bytesBuffer (without allocations), so a_request is valid only while a_bytesBuffer is alive:
+    // [Returns false if the buffer is empty or if the buffer is not matching the protocol]
+    bool Parse(const infra::TCPSocket::BytesBufferProxy& a_bytesBuffer, SmartBuildingRequest& a_request) const;
 
     // TODO: Add a support to pack HW device's supplied data object into a complete Protocol's Buffer, ready for easy networking send operation
 
@@ -78,22 +88,9 @@ private:
     SmartBuildingNetworkProtocol() = default;
 
 private:
-    bool IsRequestType(char a_type, infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const;
-    bool HasAllIndication(const std::vector<unsigned int>& a_sequence) const;
-    std::shared_ptr<SmartBuildingRequest> ParseConnectRequest(infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const;
-    std::shared_ptr<SmartBuildingRequest> ParseDisconnectRequest(infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const;
-    std::shared_ptr<SmartBuildingRequest> ParseSubscribeRequest(infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const;
-    std::shared_ptr<SmartBuildingRequest> ParseUnsubscribeRequest(infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const;
-    std::shared_ptr<SmartBuildingRequest> ParseEventRequest(infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const;
-
-    template<typename NextType>
-    NextType ExtractNext(std::stringstream& a_ss, char a_delimiter = '\n') const // If NextType CANNOT be initialize be passing a std::string to its constructor - this template function should be SPECIALIZED TO FIT THE NEEDS!
-    {
-        std::string subStringContainer;
-        std::getline(a_ss, subStringContainer, a_delimiter);
-
-        return NextType(subStringContainer);
-    }
+    bool ParseBinary(const infra::TCPSocket::BytesBufferProxy& a_bytesBuffer, SmartBuildingRequest& a_request) const;
+    bool ParseText(const infra::TCPSocket::BytesBufferProxy& a_bytesBuffer, SmartBuildingRequest& a_request) const;
+    bool ToRequestType(unsigned char a_typeIndicator, RequestType& a_type) const;
 };
 
 } // smartbuilding
@@ -2,26 +2,84 @@
 #define NM_SMARTBUILDING_REQUEST_HPP
 
 
+#include <cstddef> // size_t
 #include <string> // std::string
+#include <vector> // std::vector
+#include "tcp_socket.hpp"
+#include "subscription_location.hpp"
 
 
 namespace smartbuilding
 {
 
-// An abstract base class for all the Smart Building System's network requests
-class SmartBuildingRequest
+// A non owning view of bytes inside a received buffer (like std::string_view) - valid while the received buffer is alive
+class BytesView
 {
 public:
-    virtual ~SmartBuildingRequest() = default;
-    virtual std::string RequestType() const = 0;
+    BytesView() : m_bytes(nullptr), m_size(0) {}
+    BytesView(const unsigned char* a_bytes, size_t a_size) : m_bytes(a_bytes), m_size(a_size) {}
+
+    const unsigned char* Data() const { return m_bytes; }
+    size_t Size() const { return m_size; }
+    std::string ToString() const { return std::string(reinterpret_cast<const char*>(m_bytes), m_size); }
+
+private:
+    const unsigned char* m_bytes;
+    size_t m_size;
+};
+
+
+// A view of a list of rooms / floors inside a received buffer - its numbers are decoded only when they are needed
+// (comma separated decimals in the text format, varints in the binary format)
+class NumbersListView
+{
+public:
+    enum Encoding { TEXT_DECIMALS, BINARY_VARINTS };
+
+    NumbersListView() : m_bytes(), m_encoding(TEXT_DECIMALS), m_isAll(false) {}
+    NumbersListView(BytesView a_bytes, Encoding a_encoding, bool a_isAll) : m_bytes(a_bytes), m_encoding(a_encoding), m_isAll(a_isAll) {}
+
+    bool IsAll() const { return m_isAll; } // The protocol's indication for all the rooms / floors
+    std::vector<unsigned int> ToVector() const; // The list MUST have been validated by the protocol (as it is by SmartBuildingNetworkProtocol::Parse)
 
-    std::string RequestSenderID() const { return m_requestSenderID; }
+    // Reads a single number of the list, and moves a_cursor after it - returns false if the bytes are not a valid number
+    static bool ReadVarint(const unsigned char*& a_cursor, const unsigned char* a_end, unsigned int& a_number);
+    static bool ReadDecimal(const unsigned char*& a_cursor, const unsigned char* a_end, unsigned int& a_number);
+
+private:
+    BytesView m_bytes;
+    Encoding m_encoding;
+    bool m_isAll;
+};
+
+
+enum RequestType { CONNECT_REQUEST, DISCONNECT_REQUEST, SUBSCRIBE_REQUEST, UNSUBSCRIBE_REQUEST, EVENT_REQUEST };
+
+
+// A parsed Smart Building System's network request - its fields are views into the received buffer, so parsing does not allocate or copy
+// [The fields that are not part of the request's type are empty]
+class SmartBuildingRequest
+{
+    friend class SmartBuildingNetworkProtocol; // Fills the request's fields
+public:
+    SmartBuildingRequest() : m_type(CONNECT_REQUEST), m_requestSenderID(), m_eventType(), m_rooms(), m_floors(), m_eventDataBuffer() {}
+    SmartBuildingRequest(const SmartBuildingRequest& a_other) = default;
+    SmartBuildingRequest& operator=(const SmartBuildingRequest& a_other) = default;
+    ~SmartBuildingRequest() = default;
 
-protected:
-    SmartBuildingRequest(const std::string& a_requestSenderID) : m_requestSenderID(a_requestSenderID) {}
+    RequestType Type() const { return m_type; }
+    BytesView RequestSenderID() const { return m_requestSenderID; }
+    BytesView EventType() const { return m_eventType; } // Subscribe / Unsubscribe requests
+    SubscriptionLocation SubscriptionLoc() const { return SubscriptionLocation(m_floors.IsAll(), m_floors.ToVector(), m_rooms.IsAll(), m_rooms.ToVector()); } // Subscribe requests
+    const infra::TCPSocket::BytesBufferProxy& EventDataBuffer() const { return m_eventDataBuffer; } // Event requests - a slice of the received buffer (shares its bytes)
 
 private:
-    std::string m_requestSenderID;
+    RequestType m_type;
+    BytesView m_requestSenderID;
+    BytesView m_eventType;
+    NumbersListView m_rooms;
+    NumbersListView m_floors;
+    infra::TCPSocket::BytesBufferProxy m_eventDataBuffer;
 };
 
 } // smartbuilding
@@ -4,8 +4,12 @@
 
 #include <memory> // std::shared_ptr
 #include <string> // std::string
+#include <atomic> // std::atomic
+#include <mutex> // std::mutex
 #include "ilogger.hpp"
 #include "location.hpp"
+#include "connection_handle.hpp"
+#include "outbound_queue.hpp"
 
 
 namespace smartbuilding
@@ -20,6 +24,10 @@ public:
     std::string Configurations() const;
     std::string RemoteDeviceID() const;
     Location Loc() const;
+    ConnectionHandle Connection() const; // INVALID_CONNECTION_HANDLE while the remote device is not connected
+    bool IsConnectionCongested() const; // The remote device's connection is above its high-water mark - the buffers to the device would be refused
+    void SetConnection(ConnectionHandle a_handle, std::shared_ptr<const infra::OutboundQueue> a_output); // Set by the hub when the remote device connects / disconnects
+    void ClearConnection(ConnectionHandle a_handle); // Only if a_handle is still the connection - set by the hub when the connection has closed (the remote device might have connected again meanwhile)
 
 protected:
     // Protected c'tor - to provide the correct using of this class as an abstract base class
@@ -32,6 +40,9 @@ private:
     std::shared_ptr<ILogger> m_logger;
     std::string m_remoteDeviceID;
     Location m_location;
+    std::mutex m_connectionLock; // Serializes the setters - the readers do not lock
+    std::atomic<ConnectionHandle> m_connection; // Read by the sending path of any worker
+    std::shared_ptr<const infra::OutboundQueue> m_connectionOutput; // Accessed by std::atomic_load / std::atomic_store only
 };
 
 } // smartbuilding
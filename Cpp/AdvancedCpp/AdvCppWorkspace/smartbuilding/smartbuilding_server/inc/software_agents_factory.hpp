@@ -2,6 +2,7 @@
 #define NM_SOFTWARE_AGENTS_FACTORY_HPP
 
 
+#include <cstddef> // size_t
 #include <string> // std::string
 #include <memory> // std::shared_ptr
 #include "software_agent.hpp"
@@ -13,6 +14,8 @@
 namespace smartbuilding
 {
 
+// Each agent's MakeAgent is fetched once per .so module (SoModulesCache), and the agents are made in parallel by a temporary thread pool
+// [The loggers are fetched and the agents are added to the agents collection by the calling thread - in the configurations file's order]
 class SoftwareAgentsFactory
 {
 public:
@@ -26,6 +29,8 @@ public:
 private:
     typedef SoftwareAgent* (*AgentFactory)(const std::string& a_deviceID, const std::string& a_deviceType, unsigned int a_room, unsigned int a_floor, const std::string& a_configurations, std::shared_ptr<ILogger> a_logger);
 
+    static const size_t AGENTS_PER_WORK = 64; // Amortizes a work's submission over many agents
+
 private:
     std::shared_ptr<SoftwareAgentsManager> m_agentsCollection;
     std::shared_ptr<SafeLoggersManager> m_loggersManager;
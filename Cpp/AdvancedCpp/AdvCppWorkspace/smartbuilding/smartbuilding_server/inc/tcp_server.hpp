@@ -7,10 +7,16 @@
 #include <string> // std::string
 #include <list> // std::list
 #include <vector> // std::vector
+#include <deque> // std::deque
+#include <utility> // std::pair
+#include <mutex> // std::mutex
+#include <atomic> // std::atomic
 #include <unordered_map> // std::unordered_map
-#include <sys/select.h> // fd_set
 #include "tcp_server_socket.hpp"
 #include "tcp_socket.hpp"
+#include "outbound_queue.hpp"
+#include "tcp_server_reactor_policies.hpp"
+#include "tcp_server_framing_policies.hpp"
 
 
 namespace infra
@@ -21,7 +27,7 @@ namespace tcpserver_details
     using Message = TCPListeningSocket::BytesBufferProxy;
     using ClientID = int;
     enum StatusCode { SUCCESS, MEMORY_ALLOCATION_FAILED, ACCEPTING_CLIENT_FAILED, SERVER_INTERNAL_ERROR };
-    enum ResponseStatus { DO_NOTHING, SEND_MESSAGE, DISCONNECT_CLIENT };
+    enum ResponseStatus { DO_NOTHING, SEND_MESSAGE, DISCONNECT_CLIENT, DEFER_RESPONSE, DEFER_RESPONSE_AND_PAUSE_READING };
     struct Response
     {
         ResponseStatus m_status; // The operation that the server should do, if an operation not specified (or wrong value) - the server will use DO_NOTHING command
@@ -36,45 +42,103 @@ namespace tcpserver_details
 // Note 3: the ClientMessageHandler and ErrorHandler functors should return a boolean value - true if the server should stop its running, or false if the server should continue its running, the others should return nothing (void)
 
 // Concept of ClientMessageHandler: should be a functor that implements: operator()(Message&, std::pair<ClientID,std::shared_ptr<TCPSocket>>, Response&) while Message is the received buffer, and ClientID and its related TCPSocket as pair - is the client that sent that message, and a REFERENCE to a semi filled Response object to send back, while response is:
-//                                 - The response status to tell the server which operation it should do: RESPONSE_DO_NOTHING, RESPONSE_SEND_MESSAGE, RESPONSE_DISCONNECT_CLIENT (with the specified ID of the response object) [if is default value or other input - the server will use DO_NOTHING]
+//                                 - The response status to tell the server which operation it should do: RESPONSE_DO_NOTHING, RESPONSE_SEND_MESSAGE, RESPONSE_DISCONNECT_CLIENT (with the specified ID of the response object) [if is default value or other input - the server will use DO_NOTHING],
+//                                   or DEFER_RESPONSE - the message is handled asynchronously (off the server's thread), and its real response is posted later by PostResponse,
+//                                   or DEFER_RESPONSE_AND_PAUSE_READING - like DEFER_RESPONSE, and the server stops reading from the client until all its deferred messages are completed
+//                                   (the frames that were already received are still handled)
 //                                 - The clients ID to send the response message to (by default: adding the client ID of the client that the server received the message from)
 //                                 - The response message to send to the selected clients
 // Concept of ErrorHandler: should be a functor that implements: operator()(StatusCode, const std::string&) - while StatusCode is the error that occurred, and std::string is the related error message
 // Concept of NewClientConnectionHandler: should be a functor that implements: operator()(std::pair<ClientID,std::shared_ptr<TCPSocket>>, Response&)- while clientID and its related TCPSocket is the information about the new connected client, and a REFERENCE to a Response object (like above)
 // Concept of CloseClientConnectionHandler: should be a functor that implements: operator()(ClientID) - while ClientID is the client that the connection has closed with
-template <typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler>
+// Concept of ReactorPolicy: see tcp_server_reactor_policies.hpp (SelectReactorPolicy - select, up to ~1020 clients [default],
+//                           EpollReactorPolicy - edge-triggered epoll with non blocking sockets, limited only by RLIMIT_NOFILE)
+// Concept of FramingPolicy: see tcp_server_framing_policies.hpp (RawFramingPolicy - whatever was received together is a message [default],
+//                           LengthPrefixedFramingPolicy / DelimiterFramingPolicy - each connection's bytes are reassembled, and every complete frame is a message,
+//                           FirstByteSelectedFramingPolicy - each connection is framed by one of two policies, by its first byte)
+// Note 4: the ClientMessageHandler is called once per complete frame - zero, one or many times per readiness of a client
+// Note 5: backpressure - the server stops reading from a client while it has MAX_DEFERRED_MESSAGES_PER_CLIENT deferred messages, or MAX_PENDING_OUTPUT_MESSAGES
+//         messages that were not sent yet (a full send buffer of a non blocking socket), and the responses are queued per client - a slow client never blocks the server
+// Note 6: each client has an OutboundQueue (see OutboundQueueOf) - other threads post messages to the client by it, and the server sends them with its own responses,
+//         coalesced into a single vectored send (up to MAX_COALESCED_MESSAGES messages) whenever the client is writable
+template <typename ClientMessageHandler, typename ErrorHandler, typename NewClientConnectionHandler, typename CloseClientConnectionHandler, typename ReactorPolicy = SelectReactorPolicy, typename FramingPolicy = RawFramingPolicy>
 class TCPServer
 {
 public:
 // Warning - an exception would be thrown from the c'tor in the following cases:
 // If a_serverPort is not between 1025 to 64K
 // If a_maxWaitingConnections is equal to 0
+// a_isPortSharingRequired - binds the listening socket with SO_REUSEPORT, so several servers (e.g. one per core) can listen on the same port, each with its own clients
 // The server initialization can fail because of various internal errors, if at least one of them occurs: an exception would be thrown (and will NOT trigger the OnError handle functor)
-    TCPServer(ClientMessageHandler a_onClientMessage, ErrorHandler a_onError, NewClientConnectionHandler a_onNewClientConnection, CloseClientConnectionHandler a_onCloseClientConnection, unsigned int a_listeningPort, unsigned int a_maxWaitingConnections);
+// a_outputHighWaterMark - the bytes that can wait in a client's OutboundQueue before the posts to it are refused
+    TCPServer(ClientMessageHandler a_onClientMessage, ErrorHandler a_onError, NewClientConnectionHandler a_onNewClientConnection, CloseClientConnectionHandler a_onCloseClientConnection, unsigned int a_listeningPort, unsigned int a_maxWaitingConnections, bool a_isPortSharingRequired = false, size_t a_outputHighWaterMark = DEFAULT_OUTPUT_HIGH_WATER_MARK);
     TCPServer(const TCPServer& a_other) = delete;
     TCPServer& operator=(const TCPServer& a_other) = delete;
-    ~TCPServer() = default; // Each TCPSocket is closing its own wrapped file descriptor (SocketID)
+    ~TCPServer(); // Each TCPSocket is closing its own wrapped file descriptor (SocketID), the server closes its clients' outbound queues and its wakeup event
 
     void Run();
+    void Stop(); // Run returns after its current iteration [Thread safety: can be called from any thread, also before Run]
+
+    // Completes a deferred message of a_client (the same client info that was given to the ClientMessageHandler) by its real response [Thread safety: can be called from any thread]
+    // The response is handled by the server's thread - it is dropped if the client has disconnected meanwhile
+    // A posted DEFER_RESPONSE_AND_PAUSE_READING does not complete the message - it only stops the reading from the client until all its deferred messages are completed
+    void PostResponse(std::pair<tcpserver_details::ClientID,std::shared_ptr<TCPSocket>> a_client, const tcpserver_details::Response& a_response);
+
+    // The outbound queue of a_client (the same client info that was given to the handlers), to post messages to the client from any thread - returns nullptr if the client
+    // has disconnected [Thread safety: can be called from any thread]
+    std::shared_ptr<OutboundQueue> OutboundQueueOf(std::pair<tcpserver_details::ClientID,std::shared_ptr<TCPSocket>> a_client) const;
+
+public:
+    static const size_t DEFAULT_OUTPUT_HIGH_WATER_MARK = 256 * 1024;
 
 private:
     enum HandlingClientResult { CLIENT_FINISH, CLIENT_KEEP, CLIENT_ERROR };
 
+    // The output and the backpressure of a single client - used only by the server's thread
+    struct ClientFlowState
+    {
+        ClientFlowState() : m_output(), m_pendingOutput(), m_sentBytesOfFirstMessage(0), m_deferredMessagesCount(0), m_isReadingPaused(false), m_isReadingWatched(true), m_isWritingWatched(false) {}
+
+        std::shared_ptr<OutboundQueue> m_output; // The messages that other threads posted to the client, and the count of its unsent bytes
+        std::deque<tcpserver_details::Message> m_pendingOutput; // The messages that were not sent yet (in order) - the responses, and the messages that were taken from m_output
+        size_t m_sentBytesOfFirstMessage;
+        size_t m_deferredMessagesCount;
+        bool m_isReadingPaused; // By DEFER_RESPONSE_AND_PAUSE_READING - until the deferred messages are completed
+        bool m_isReadingWatched;
+        bool m_isWritingWatched;
+    };
+
+    struct PostedResponse
+    {
+        tcpserver_details::ClientID m_clientID;
+        std::shared_ptr<TCPSocket> m_client; // Identifies the connection - its ClientID might be reused by a new connection
+        tcpserver_details::Response m_response;
+    };
+
 private:
-    void InitializeFDSet();
     std::string MapServerErrorsToMessages(tcpserver_details::StatusCode a_statusCode) const;
     tcpserver_details::StatusCode AcceptNewClients();
+    tcpserver_details::StatusCode AcceptNewClient(bool& a_hasAccepted);
+    void PauseAccepting(); // At the clients limit - the waiting connections stay in the listening queue until a client disconnects, throws std::runtime_error on failure
+    void ResumeAccepting(); // A client has disconnected - re-arms the listening socket (its waiting connections are reported again), never throws
     HandlingClientResult HandleResponse(tcpserver_details::Response& a_response);
-    size_t SendMessageTo(tcpserver_details::ClientID a_clientID, tcpserver_details::Message a_message);
+    HandlingClientResult SendMessageTo(tcpserver_details::ClientID a_clientID, const tcpserver_details::Message& a_message); // Queues the message, and sends as much as possible now
+    HandlingClientResult FlushOutputOf(tcpserver_details::ClientID a_clientID);
+    void DeferResponseOf(tcpserver_details::ClientID a_clientID, bool a_isReadingPauseRequired);
+    void RefreshWatchingOf(tcpserver_details::ClientID a_clientID, ClientFlowState& a_flowState); // Pauses / resumes reading and writing by the client's state
+    void HandlePostedResponses();
+    void HandlePostedOutput(); // Moves the messages of the scheduled outbound queues to their clients' pending output, and sends them
+    void EraseOutboundQueueOf(tcpserver_details::ClientID a_clientID); // Closes the client's outbound queue
     void DisconnectAndRemoveClientFromServer(tcpserver_details::ClientID a_clientID);
-    void HandleExistingClientsRequests(fd_set a_tempSocketsSignalsIndicator, int a_clientsSocketSignalsCount);
-    HandlingClientResult HandleSingleClientRequest(tcpserver_details::ClientID a_clientID, tcpserver_details::Message& a_message);
-    tcpserver_details::Message ReceiveMessageFrom(tcpserver_details::ClientID a_clientID);
+    void HandleExistingClientsRequests(const std::vector<ReadySocket>& a_readyClients);
+    HandlingClientResult HandleSingleClientRequest(tcpserver_details::ClientID a_clientID, std::vector<tcpserver_details::Message>& a_frames, bool a_hasPeerClosed);
+    size_t ReceiveBytesFrom(tcpserver_details::ClientID a_clientID, InputBuffer& a_input); // Returns the amount of received bytes
 
 private:
     static const size_t MESSAGES_BUFFER_SIZE = 4096;
-    static const unsigned int MAX_CONNECTED_CLIENTS_AT_THE_SAME_TIME_TO_SERVER = 1020;
-    static const unsigned int FILE_DESCRIPTORS_LIMIT = 1024;
+    static const size_t MAX_DEFERRED_MESSAGES_PER_CLIENT = 64;
+    static const size_t MAX_PENDING_OUTPUT_MESSAGES = 256;
+    static const size_t MAX_COALESCED_MESSAGES = 64; // Per vectored send (IOV_MAX is 1024)
     static const unsigned int MIN_BUFFER_SIZE = 1024;
     static const unsigned int MIN_PORT_VALUE = 1025;
     static const unsigned int MAX_PORT_VALUE = 64000;
@@ -82,15 +146,29 @@ private:
 private:
     TCPServerSocket m_serverSocket;
     std::unordered_map<tcpserver_details::ClientID,std::shared_ptr<TCPSocket>> m_connectedClientsTable;
+    std::unordered_map<tcpserver_details::ClientID,InputBuffer> m_clientsInputBuffers; // The received bytes of each client that were not framed yet
+    std::unordered_map<tcpserver_details::ClientID,ClientFlowState> m_clientsFlowStates;
+    FramingPolicy m_framing;
     ClientMessageHandler m_onClientMessage;
     ErrorHandler m_onError;
     NewClientConnectionHandler m_onNewClientConnection;
     CloseClientConnectionHandler m_onCloseClientConnection;
-    fd_set m_socketsSignalsIndicator;
+    ReactorPolicy m_reactor;
+    std::vector<ReadySocket> m_readySockets;
     unsigned int m_maxWaitingConnections;
-    unsigned int m_maxAmountOfConnectedClientsAtTheSameTime;
-    unsigned int m_currentConnectedClientsCount;
+    size_t m_maxAmountOfConnectedClientsAtTheSameTime;
+    size_t m_currentConnectedClientsCount;
+    bool m_isAcceptingPaused;
     bool m_isStopServerFromRunningRequired;
+    std::atomic<bool> m_isStopRequested; // Set by Stop - from any thread
+    int m_wakeupID; // An eventfd that is watched by the reactor - signaled by PostResponse, and by the clients' outbound queues
+    std::mutex m_postedResponsesLock;
+    std::vector<PostedResponse> m_postedResponses;
+    size_t m_outputHighWaterMark;
+    std::shared_ptr<OutboundQueuesScheduler> m_outboundQueuesScheduler;
+    std::vector<std::shared_ptr<OutboundQueue>> m_scheduledOutboundQueues; // Used only by the server's thread (kept to reuse its capacity)
+    mutable std::mutex m_outboundQueuesLock;
+    std::unordered_map<tcpserver_details::ClientID,std::shared_ptr<OutboundQueue>> m_outboundQueues; // For OutboundQueueOf - written only by the server's thread
 };
 
 } // infra
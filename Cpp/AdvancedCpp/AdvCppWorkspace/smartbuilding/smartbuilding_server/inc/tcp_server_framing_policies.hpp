@@ -0,0 +1,116 @@
+#ifndef NM_TCP_SERVER_FRAMING_POLICIES_HPP
+#define NM_TCP_SERVER_FRAMING_POLICIES_HPP
+
+
+#include <cstddef> // size_t
+#include <vector> // std::vector
+#include "tcp_socket.hpp"
+
+
+namespace infra
+{
+
+// A growable buffer of the bytes that were received from a connection, but were not framed yet
+// Consumed bytes are only skipped - the buffer is compacted when most of it was consumed, so framing many small frames is linear
+class InputBuffer
+{
+public:
+    InputBuffer();
+    InputBuffer(const InputBuffer& a_other) = default;
+    InputBuffer& operator=(const InputBuffer& a_other) = default;
+    ~InputBuffer() = default;
+
+    void Append(const unsigned char* a_bytes, size_t a_bytesCount);
+    void Consume(size_t a_bytesCount); // a_bytesCount MUST NOT exceed Size()
+
+    const unsigned char* Data() const; // The first unconsumed byte
+    size_t Size() const; // The unconsumed bytes
+
+    // The connection's state of a framing policy (e.g. the framing that was selected for it) - 0 for a new connection
+    int FramingState() const;
+    void SetFramingState(int a_framingState);
+
+private:
+    std::vector<unsigned char> m_bytes;
+    size_t m_consumedBytes;
+    int m_framingState;
+};
+
+
+enum FrameStatus { FRAME_COMPLETE, FRAME_INCOMPLETE, FRAME_MALFORMED };
+
+
+// Policies that define how TCPServer splits the bytes of a connection into messages (frames) - each frame is delivered to the ClientMessageHandler.
+// Each policy implements:
+// FrameStatus ExtractFrame(InputBuffer& a_input, TCPSocket::BytesBufferProxy& a_frame) const - if a_input starts with a complete frame: consumes it,
+//                                  fills a_frame by its payload and returns FRAME_COMPLETE, else returns FRAME_INCOMPLETE (more bytes are needed),
+//                                  or FRAME_MALFORMED (the connection cannot be framed any more - it is closed)
+// Concept of FramingPolicy: policy must be default-constructable, and keep its per connection state (if any) by the InputBuffer's FramingState
+
+
+// RawFramingPolicy: All the bytes that were received together are a single message - coalesced or split TCP segments are NOT reassembled [default]
+class RawFramingPolicy
+{
+public:
+    FrameStatus ExtractFrame(InputBuffer& a_input, TCPSocket::BytesBufferProxy& a_frame) const;
+};
+
+
+// LengthPrefixedFramingPolicy: Each frame is a 4 bytes length (big endian, not including itself) followed by the payload
+class LengthPrefixedFramingPolicy
+{
+public:
+    explicit LengthPrefixedFramingPolicy(size_t a_maxFrameSize = DEFAULT_MAX_FRAME_SIZE); // A longer frame is malformed
+
+    FrameStatus ExtractFrame(InputBuffer& a_input, TCPSocket::BytesBufferProxy& a_frame) const;
+
+private:
+    static const size_t LENGTH_PREFIX_SIZE = 4;
+    static const size_t DEFAULT_MAX_FRAME_SIZE = 16 * 1024 * 1024;
+
+private:
+    size_t m_maxFrameSize;
+};
+
+
+// DelimiterFramingPolicy: Each frame ends with a delimiter byte (that is not part of the payload) - fits textual protocols only
+class DelimiterFramingPolicy
+{
+public:
+    explicit DelimiterFramingPolicy(unsigned char a_delimiter = '\n', size_t a_maxFrameSize = DEFAULT_MAX_FRAME_SIZE); // A longer frame is malformed
+
+    FrameStatus ExtractFrame(InputBuffer& a_input, TCPSocket::BytesBufferProxy& a_frame) const;
+
+private:
+    static const size_t DEFAULT_MAX_FRAME_SIZE = 64 * 1024;
+
+private:
+    unsigned char m_delimiter;
+    size_t m_maxFrameSize;
+};
+
+
+// FirstByteSelectedFramingPolicy: The first byte of each connection selects its framing - if it is SELECTOR_BYTE, it is consumed (it is not part of
+// any frame) and the connection is framed by SelectedFramingPolicy, else the connection is framed by OtherFramingPolicy (from its first byte)
+// Lets the devices of a new framing share the server with the devices that do not know about it
+template <unsigned char SELECTOR_BYTE, typename SelectedFramingPolicy, typename OtherFramingPolicy>
+class FirstByteSelectedFramingPolicy
+{
+public:
+    FrameStatus ExtractFrame(InputBuffer& a_input, TCPSocket::BytesBufferProxy& a_frame) const;
+
+private:
+    enum FramingSelection { NOT_SELECTED_YET = 0, SELECTED_FRAMING, OTHER_FRAMING };
+
+private:
+    SelectedFramingPolicy m_selectedFraming;
+    OtherFramingPolicy m_otherFraming;
+};
+
+} // infra
+
+
+#include "inl/tcp_server_framing_policies.hxx"
+
+
+#endif // NM_TCP_SERVER_FRAMING_POLICIES_HPP
@@ -0,0 +1,99 @@
+#ifndef NM_TCP_SERVER_REACTOR_POLICIES_HPP
+#define NM_TCP_SERVER_REACTOR_POLICIES_HPP
+
+
+#include <cstddef> // size_t
+#include <vector> // std::vector
+#include <sys/select.h> // fd_set
+#include <sys/epoll.h> // struct epoll_event
+
+
+namespace infra
+{
+
+// A socket that has something to read (new data, a new connection, or a closed connection), or that can be written to again
+struct ReadySocket
+{
+    int m_socketID;
+    bool m_hasPeerClosed; // The peer has closed its side - the remained data should be read, and then the connection should be closed (reported only by edge-triggered reactors)
+    bool m_isReadable;
+    bool m_isWritable; // Reported only for sockets that are watched for writing
+};
+
+
+// Policies that define how TCPServer waits for its sockets (the listening socket and the connected clients).
+// Each policy implements:
+// static const bool IS_EDGE_TRIGGERED - true if a ready socket is reported only once per new data, so all the sockets must be non blocking,
+//                                       and the server must drain each ready socket (read / accept until there is nothing left)
+// void Add(int a_socketID) - starts watching a socket for reading, throws std::runtime_error on failure
+// void Modify(int a_socketID, bool a_isReadingRequired, bool a_isWritingRequired) - changes what a watched socket is watched for
+//                                       (not reading - pauses a client, writing - waits until a full send buffer has space), throws std::runtime_error on failure
+// void Remove(int a_socketID) - stops watching a socket (before it is closed), never throws
+// int Wait(std::vector<ReadySocket>& a_readySockets) - blocks until at least one socket is ready, and fills a_readySockets by the ready sockets,
+//                                                      returns their count, or a negative value on failure (like select and epoll_wait)
+// size_t MaxSockets() const - the maximum amount of sockets that can be watched at the same time
+// Concept of ReactorPolicy: policy must be default-constructable
+
+
+// SelectReactorPolicy: Waits by select - each wait copies the whole watched set, and finds the ready sockets by scanning all of it,
+// so it costs O(watched sockets), and the sockets' IDs are limited by FD_SETSIZE (1024) [default]
+class SelectReactorPolicy
+{
+public:
+    static const bool IS_EDGE_TRIGGERED = false;
+
+public:
+    SelectReactorPolicy();
+    SelectReactorPolicy(const SelectReactorPolicy& a_other) = delete;
+    SelectReactorPolicy& operator=(const SelectReactorPolicy& a_other) = delete;
+    ~SelectReactorPolicy() = default;
+
+    void Add(int a_socketID);
+    void Modify(int a_socketID, bool a_isReadingRequired, bool a_isWritingRequired);
+    void Remove(int a_socketID);
+    int Wait(std::vector<ReadySocket>& a_readySockets);
+    size_t MaxSockets() const;
+
+private:
+    static const size_t RESERVED_FILE_DESCRIPTORS = 5; // stdin, stdout, stderr, the listening socket and the server's wakeup
+
+private:
+    fd_set m_watchedSockets; // Watched for reading
+    fd_set m_watchedForWritingSockets;
+    fd_set m_registeredSockets; // Watched for anything - m_maxSocketID is the highest of them
+    int m_maxSocketID; // -1 if no socket is watched
+};
+
+
+// EpollReactorPolicy: Waits by an edge-triggered epoll - each wait returns only the ready sockets, so it costs O(ready sockets),
+// and the connections are limited only by the process' open files limit (RLIMIT_NOFILE)
+class EpollReactorPolicy
+{
+public:
+    static const bool IS_EDGE_TRIGGERED = true;
+
+public:
+    EpollReactorPolicy(); // Throws std::runtime_error if the epoll instance cannot be created
+    EpollReactorPolicy(const EpollReactorPolicy& a_other) = delete;
+    EpollReactorPolicy& operator=(const EpollReactorPolicy& a_other) = delete;
+    ~EpollReactorPolicy(); // Closes the epoll instance (the watched sockets are NOT closed)
+
+    void Add(int a_socketID);
+    void Modify(int a_socketID, bool a_isReadingRequired, bool a_isWritingRequired);
+    void Remove(int a_socketID);
+    int Wait(std::vector<ReadySocket>& a_readySockets);
+    size_t MaxSockets() const;
+
+private:
+    static const size_t INITIAL_EVENTS_CAPACITY = 64;
+    static const size_t RESERVED_FILE_DESCRIPTORS = 32; // The standard streams, the listening, epoll and wakeup sockets, the log files and the loaded modules
+
+private:
+    int m_epollID;
+    std::vector<struct epoll_event> m_events; // Grows when a single wait fills it
+};
+
+} // infra
+
+
+#endif // NM_TCP_SERVER_REACTOR_POLICIES_HPP
@@ -11,7 +11,7 @@ namespace infra
 class TCPServerSocket : public TCPListeningSocket
 {
 public:
-    TCPServerSocket(unsigned int a_listeningPortNumber, bool a_isNoBlockingRequired = false); // The tcp server socket will listen to any Ip Address by default
+    TCPServerSocket(unsigned int a_listeningPortNumber, bool a_isNoBlockingRequired = false, bool a_isPortSharingRequired = false); // The tcp server socket will listen to any Ip Address by default
     TCPServerSocket(const TCPServerSocket& a_other) = delete;
     TCPServerSocket& operator=(const TCPServerSocket& a_other) = delete;
     virtual ~TCPServerSocket() = default;
@@ -8,6 +8,8 @@
 #include <netinet/in.h> // struct sockaddr_in
 #include <string.h> // memset
 #include <utility> // std::pair, std::make_pair
+#include <sys/uio.h> // struct iovec
+#include "bytes_buffer_pool.hpp"
 
 
 namespace infra
@@ -35,29 +37,39 @@ protected:
     };
 
 public:
+    // An immutable view of reference counted bytes - copies and slices share the same pooled block (O(1), without copying the bytes),
+    // so a single received payload can be passed to many threads and subscribers [Thread safety: different proxies of the same bytes can be used concurrently]
     class BytesBufferProxy // For RAII
     {
-        friend std::ostream& operator<<(std::ostream& a_os, const BytesBufferProxy& a_bufferProxy) { return a_os << a_bufferProxy.m_bufferOfBytes; }
+        friend class TCPSocket; // Receives directly into a new pooled block
+        friend std::ostream& operator<<(std::ostream& a_os, const BytesBufferProxy& a_bufferProxy) { return a_os.write(reinterpret_cast<const char*>(a_bufferProxy.m_bufferOfBytes), a_bufferProxy.m_bufferSize); }
     public:
         BytesBufferProxy();
-        BytesBufferProxy(const unsigned char*  a_bufferOfBytes, size_t a_bufferSize);
-        BytesBufferProxy(const BytesBufferProxy& a_other);
-        BytesBufferProxy& operator=(const BytesBufferProxy& a_other);
+        BytesBufferProxy(const unsigned char*  a_bufferOfBytes, size_t a_bufferSize); // Copies the bytes (once) into a pooled block
+        BytesBufferProxy(const BytesBufferProxy& a_other); // Shares the bytes of a_other
+        BytesBufferProxy& operator=(const BytesBufferProxy& a_other); // Shares the bytes of a_other
         BytesBufferProxy(BytesBufferProxy&& a_rvalue) noexcept; // Move copy c'tor (better performance)
         BytesBufferProxy& operator=(BytesBufferProxy&& a_rvalue) noexcept; // Move copy-assignment (better performance)
         ~BytesBufferProxy();
 
-        BytesBufferProxy& operator+=(const BytesBufferProxy& a_other);
+        BytesBufferProxy& operator+=(const BytesBufferProxy& a_other); // Copies both buffers into a new block (the other proxies of the old bytes are not affected)
         BytesBufferProxy operator+(const BytesBufferProxy& a_other) const;
 
+        BytesBufferProxy Slice(size_t a_offset, size_t a_length) const; // Shares a part of the bytes, throws std::out_of_range if it exceeds the buffer
         const unsigned char* ToBytes() const { return m_bufferOfBytes; };
         size_t Size() const { return m_bufferSize; }
+        struct iovec ToIOVec() const; // A view for writev / sendmsg - valid while this proxy (or another proxy of the same bytes) is alive
 
     private:
-        unsigned char* m_bufferOfBytes;
+        explicit BytesBufferProxy(size_t a_capacity); // Uninitialized bytes of a_capacity size - to be filled only before the proxy is shared
+        unsigned char* WritableBytes() { return m_block->Bytes(); }
+        void Shrink(size_t a_bufferSize); // The bytes that were actually filled
+
+    private:
+        BytesBlock* m_block; // nullptr if the buffer is empty
+        const unsigned char* m_bufferOfBytes;
         size_t m_bufferSize;
     };
-
     TCPSocket(const std::string& a_ipAddress, unsigned int a_portNumber); // Validation of an IP addresses is a user responsability!
     TCPSocket(SocketID a_fileDescriptorSocket); // Validation of a valid file descriptor number is a user responsability! To be able to use Connect() method of the new TCPSocket wrapper, make sure that the created TCPSocket of FD, is a FD of a tcp socket!
     TCPSocket(const TCPSocket& a_other) = delete;
@@ -66,18 +78,24 @@ public:
 
     std::pair<std::string,unsigned int> GetIpAndPortData() const { return m_socketAddressData.GetIpAndPort(); }
     void Connect(); // Throws on failure
-    virtual size_t Send(const unsigned char* a_message, size_t a_messageSize, bool a_provideFullMessageSending = true); // Retuns the number of sent bytes, Throws on failure
+    virtual size_t Send(const unsigned char* a_message, size_t a_messageSize, bool a_provideFullMessageSending = true); // Retuns the number of sent bytes (0 if a non blocking socket's buffer is full, and full sending is not required), Throws on failure
     virtual size_t Send(const BytesBufferProxy& a_message, bool a_provideFullMessageSending = true); // Returns the number of sent bytes, Throws on failure
-    virtual BytesBufferProxy Receive(size_t a_bytesToReceive); // Returns the received buffer, Throws on failure
+    virtual size_t Send(const struct iovec* a_parts, size_t a_partsCount); // A single vectored send of a_parts (in order), without waiting - Returns the number of sent bytes (0 if a non blocking socket's buffer is full), Throws on failure
+    virtual BytesBufferProxy Receive(size_t a_bytesToReceive); // Returns the received buffer (a pooled block, without copying), Throws on failure
+    void Close(); // Closes the file descriptor now - the socket is left detached, and its destruction does not close the same descriptor number again (it might belong to a new socket already)
 
 protected:
     SocketAddressData& GetSelfSocketAddressData() { return m_socketAddressData; }
     SocketID GetSelfSocketID() const { return m_socketID; }
     virtual SocketID GetSocketIDToSendTheMessageTo() const { return m_socketID; }
+    static size_t ReceiveInto(SocketID a_socketID, size_t a_bytesToReceive, BytesBufferProxy& a_receivedBuffer); // Returns the recv result (size_t(-1) on failure), a_receivedBuffer gets the received bytes (empty on failure)
 
 private:
     static SocketAddressData CreateSocketAddressDataFromFileDescriptorSocket(SocketID a_fileDescriptorSocket);
 
+private:
+    static const SocketID DETACHED_SOCKET_ID = -1;
+
 private:
     SocketAddressData m_socketAddressData;
     SocketID m_socketID;
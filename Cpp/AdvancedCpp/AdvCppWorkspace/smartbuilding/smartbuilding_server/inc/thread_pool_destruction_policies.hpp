@@ -5,8 +5,11 @@
 #include <memory> // std::shared_ptr
 #include "thread_pool.hpp"
 #include "icallable.hpp"
+#include "task.hpp"
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
+#include "thread_pool_submission_policies.hpp"
+#include "thread_pool_metrics_policies.hpp"
 
 
 namespace advcpp
@@ -14,34 +17,38 @@ namespace advcpp
 // Policies to be triggered when a BlockingBoundedQueue is destructed.
 // All the Policies MUST NOT throw exceptions (must be nothrow (noexcept))!
 // --------------------------------------------------------------------------------------------------------------------------------------------------------------------
-// Concept of QueueTypeDestructionPolicy: must be a destruction policy of the given Queue type, and must be a destruction policy of type T = std::shared_ptr<ICallable>
+// Concept of QueueTypeDestructionPolicy: must be a destruction policy of the given Queue type, and must be a destruction policy of type T = Task
 // --------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Concept of QueueType: QueueType must implement Enqueue and Dequeue methods (Suggestion: these methods should be multithreaded-safe!),
-// and its T MUST be std::shared_ptr of type ICallable (QueueType< T = std::shared_ptr<ICallable> >),
-// and it must implement a C'tor of: {size_t, QueueTypeDestructionPolicy<std::shared_ptr<ICallable>>}
+// and its T MUST be Task (QueueType< T = Task >),
+// and it must implement a C'tor of: {size_t, QueueTypeDestructionPolicy<Task>}
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Concept of SubmissionPolicy: must be the same submission policy of the destructed ThreadPool (see thread_pool_submission_policies.hpp)
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Concept of MetricsPolicy: must be the same metrics policy of the destructed ThreadPool (see thread_pool_metrics_policies.hpp)
 
 
-template <typename QueueTypeDestructionPolicy = ClearPolicy<std::shared_ptr<ICallable>>, typename QueueType = BlockingBoundedQueue<std::shared_ptr<ICallable>, QueueTypeDestructionPolicy>>
+template <typename QueueTypeDestructionPolicy = ClearPolicy<Task>, typename QueueType = BlockingBoundedQueue<Task, QueueTypeDestructionPolicy>, typename SubmissionPolicy = DirectSubmissionPolicy<QueueTypeDestructionPolicy, QueueType>, typename MetricsPolicy = NoMetricsPolicy>
 class AssertingPolicy
 {
 public:
-    void operator()(ThreadPool<AssertingPolicy, QueueTypeDestructionPolicy, QueueType>& a_pool) noexcept;
+    void operator()(ThreadPool<AssertingPolicy, QueueTypeDestructionPolicy, QueueType, SubmissionPolicy, MetricsPolicy>& a_pool) noexcept;
 };
 
 
-template <typename QueueTypeDestructionPolicy = ClearPolicy<std::shared_ptr<ICallable>>, typename QueueType = BlockingBoundedQueue<std::shared_ptr<ICallable>, QueueTypeDestructionPolicy>>
+template <typename QueueTypeDestructionPolicy = ClearPolicy<Task>, typename QueueType = BlockingBoundedQueue<Task, QueueTypeDestructionPolicy>, typename SubmissionPolicy = DirectSubmissionPolicy<QueueTypeDestructionPolicy, QueueType>, typename MetricsPolicy = NoMetricsPolicy>
 class ShutdownPolicy
 {
 public:
-    void operator()(ThreadPool<ShutdownPolicy, QueueTypeDestructionPolicy, QueueType>& a_pool) noexcept;
+    void operator()(ThreadPool<ShutdownPolicy, QueueTypeDestructionPolicy, QueueType, SubmissionPolicy, MetricsPolicy>& a_pool) noexcept;
 };
 
 
-template <typename QueueTypeDestructionPolicy = ClearPolicy<std::shared_ptr<ICallable>>, typename QueueType = BlockingBoundedQueue<std::shared_ptr<ICallable>, QueueTypeDestructionPolicy>>
+template <typename QueueTypeDestructionPolicy = ClearPolicy<Task>, typename QueueType = BlockingBoundedQueue<Task, QueueTypeDestructionPolicy>, typename SubmissionPolicy = DirectSubmissionPolicy<QueueTypeDestructionPolicy, QueueType>, typename MetricsPolicy = NoMetricsPolicy>
 class ShutdownImmediatePolicy
 {
 public:
-    void operator()(ThreadPool<ShutdownImmediatePolicy, QueueTypeDestructionPolicy, QueueType>& a_pool) noexcept;
+    void operator()(ThreadPool<ShutdownImmediatePolicy, QueueTypeDestructionPolicy, QueueType, SubmissionPolicy, MetricsPolicy>& a_pool) noexcept;
 };
 
 } // advcpp
@@ -0,0 +1,49 @@
+#ifndef NM_TIMESTAMP_HPP
+#define NM_TIMESTAMP_HPP
+
+
+#include <string> // std::string
+#include <stdint.h> // uint64_t
+#include "date_time.hpp"
+
+
+namespace smartbuilding
+{
+
+// A point in (wall clock) time, kept as raw nanoseconds since the epoch - cheap to take and to copy, so it is stored as is (in an Event, in a log record),
+// and it is converted to a broken-down local DateTime / text only when it is serialized
+class Timestamp
+{
+public:
+    using Nanoseconds = uint64_t;
+
+    Timestamp() : m_nanoseconds(0) {}
+    explicit Timestamp(Nanoseconds a_nanosecondsSinceEpoch) : m_nanoseconds(a_nanosecondsSinceEpoch) {}
+    Timestamp(const Timestamp& a_other) = default;
+    Timestamp& operator=(const Timestamp& a_other) = default;
+    ~Timestamp() = default;
+
+    // CLOCK_REALTIME_COARSE - read from the vDSO without a system call, at the resolution of the kernel's tick (a few ms)
+    static Timestamp Now();
+    static Timestamp FromDateTime(const DateTime& a_dateTime); // A local time, in seconds resolution (for devices that still report a DateTime)
+
+    Nanoseconds SinceEpoch() const { return m_nanoseconds; }
+    DateTime ToDateTime() const; // Local time
+
+    // "H:M:S.uuuuuu|D.M.Y" in local time (DateTime's format, with microseconds) - the text of the current second is cached per thread,
+    // so only the sub-second digits are rendered while the second has not changed
+    std::string ToString() const;
+    void AppendTo(std::string& a_text) const; // Appends ToString's text, without a temporary string
+
+    bool operator==(const Timestamp& a_other) const { return m_nanoseconds == a_other.m_nanoseconds; }
+    bool operator!=(const Timestamp& a_other) const { return m_nanoseconds != a_other.m_nanoseconds; }
+    bool operator<(const Timestamp& a_other) const { return m_nanoseconds < a_other.m_nanoseconds; }
+
+private:
+    Nanoseconds m_nanoseconds;
+};
+
+} // smartbuilding
+
+
+#endif // NM_TIMESTAMP_HPP
@@ -0,0 +1,35 @@
+#ifndef NM_WORKERS_ACTIVITY_HPP
+#define NM_WORKERS_ACTIVITY_HPP
+
+
+#include <cstddef> // size_t
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+// The activity counters of a ThreadPool's workers - updated by the workers around each executed work, sampled by observers (e.g. ThreadPoolAutoscaler)
+class WorkersActivity
+{
+public:
+    WorkersActivity();
+    WorkersActivity(const WorkersActivity& a_other) = delete;
+    WorkersActivity& operator=(const WorkersActivity& a_other) = delete;
+    ~WorkersActivity() = default;
+
+    void WorkStarted();
+    void WorkCompleted();
+
+    size_t BusyWorkers() const; // The workers that execute a work right now
+    size_t CompletedWorks() const; // Since the pool was created - only the difference between two samples is meaningful
+
+private:
+    AtomicValue<size_t> m_busyWorkers;
+    AtomicValue<size_t> m_completedWorks;
+};
+
+} // advcpp
+
+
+#endif // NM_WORKERS_ACTIVITY_HPP
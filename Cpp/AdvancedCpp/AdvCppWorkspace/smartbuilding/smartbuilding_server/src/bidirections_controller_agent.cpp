@@ -1,6 +1,9 @@
 #include "bidirections_controller_agent.hpp"
 #include <memory> // std::shared_ptr
+#include <vector> // std::vector
+#include <utility> // std::pair, std::make_pair, std::move
 #include "software_agent.hpp"
+#include "encoding_cache.hpp"
 #include "location.hpp"
 #include "idecoder.hpp"
 #include "iencoder.hpp"
@@ -18,17 +21,22 @@ smartbuilding::BidirectionsControllerAgent::BidirectionsControllerAgent(std::sha
 }
 
 
-void smartbuilding::BidirectionsControllerAgent::Notify(Event a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue)
+void smartbuilding::BidirectionsControllerAgent::Notify(Event a_event, std::vector<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>& a_handledBuffers)
 {
-    infra::TCPSocket::BytesBufferProxy bytesBufferToHandle = m_encoder->Encode(a_event);
-    a_handledBuffersQueue->Enqueue(std::make_pair(RemoteDeviceID(), bytesBufferToHandle));
+    if(IsConnectionCongested()) // Backpressure - the device does not drain its connection, so the event is not encoded for it
+    {
+        return;
+    }
+
+    infra::TCPSocket::BytesBufferProxy bytesBufferToHandle = EncodingCache::Encode(*m_encoder, a_event); // Shared with the other recipients of the event whose encoders have the same sharing key
+    a_handledBuffers.push_back(std::make_pair(Connection(), bytesBufferToHandle));
     // Use the logger
 }
 
 
-void smartbuilding::BidirectionsControllerAgent::Publish(infra::TCPSocket::BytesBufferProxy a_bytesBuffer, std::shared_ptr<advcpp::BlockingBoundedQueue<Event, advcpp::NoOperationPolicy<Event>>> a_publishedEventsQueue)
+bool smartbuilding::BidirectionsControllerAgent::Publish(infra::TCPSocket::BytesBufferProxy a_bytesBuffer, std::shared_ptr<advcpp::BlockingBoundedQueue<Event, advcpp::NoOperationPolicy<Event>>> a_publishedEventsQueue)
 {
     Event eventToPublish = m_decoder->Decode(a_bytesBuffer);
-    a_publishedEventsQueue->Enqueue(eventToPublish);
     // Use the logger
+    return a_publishedEventsQueue->TryEnqueue(std::move(eventToPublish));
 }
@@ -0,0 +1,93 @@
+#include "bytes_buffer_pool.hpp"
+#include <cstddef> // size_t
+#include <new> // operator new, operator delete, placement new
+#include <mutex> // std::mutex, std::lock_guard
+
+
+infra::BytesBufferPool& infra::BytesBufferPool::Instance()
+{
+    static BytesBufferPool* pool = new BytesBufferPool(); // Leaked on purpose - see the header
+
+    return *pool;
+}
+
+
+infra::BytesBufferPool::BytesBufferPool()
+: m_freeLists()
+{
+}
+
+
+infra::BytesBlock* infra::BytesBufferPool::Acquire(size_t a_capacity)
+{
+    size_t sizeClass = 0;
+    size_t classCapacity = MIN_CLASS_CAPACITY;
+    while(sizeClass < SIZE_CLASSES_COUNT && classCapacity < a_capacity)
+    {
+        ++sizeClass;
+        classCapacity *= 2;
+    }
+
+    if(sizeClass < SIZE_CLASSES_COUNT)
+    {
+        FreeList& freeList = m_freeLists[sizeClass];
+        std::lock_guard<std::mutex> guard(freeList.m_lock);
+        if(freeList.m_head)
+        {
+            BytesBlock* block = freeList.m_head;
+            freeList.m_head = block->m_next;
+            --freeList.m_blocksCount;
+
+            block->m_referencesCount.store(1, std::memory_order_relaxed);
+            return block;
+        }
+    }
+    else // Too big to be pooled - allocated by its exact size
+    {
+        sizeClass = NO_SIZE_CLASS;
+        classCapacity = a_capacity;
+    }
+
+    BytesBlock* block = new(::operator new(sizeof(BytesBlock) + classCapacity)) BytesBlock;
+    block->m_referencesCount.store(1, std::memory_order_relaxed);
+    block->m_capacity = classCapacity;
+    block->m_sizeClass = sizeClass;
+    block->m_next = nullptr;
+
+    return block;
+}
+
+
+void infra::BytesBufferPool::AddReference(BytesBlock* a_block) noexcept
+{
+    a_block->m_referencesCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void infra::BytesBufferPool::Release(BytesBlock* a_block) noexcept
+{
+    if(a_block->m_referencesCount.fetch_sub(1, std::memory_order_acq_rel) == 1) // The last reference - no other thread can touch the bytes now
+    {
+        Instance().Recycle(a_block);
+    }
+}
+
+
+void infra::BytesBufferPool::Recycle(BytesBlock* a_block) noexcept
+{
+    if(a_block->m_sizeClass != NO_SIZE_CLASS)
+    {
+        FreeList& freeList = m_freeLists[a_block->m_sizeClass];
+        std::lock_guard<std::mutex> guard(freeList.m_lock);
+        if(freeList.m_blocksCount < MAX_POOLED_BLOCKS_PER_CLASS)
+        {
+            a_block->m_next = freeList.m_head;
+            freeList.m_head = a_block;
+            ++freeList.m_blocksCount;
+            return;
+        }
+    }
+
+    a_block->~BytesBlock();
+    ::operator delete(a_block);
+}
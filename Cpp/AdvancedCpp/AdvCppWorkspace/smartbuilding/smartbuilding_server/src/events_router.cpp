@@ -1,23 +1,27 @@
 #include "events_router.hpp"
+#include <cstddef> // size_t
 #include <stdexcept> // std::runtime_error
 #include <memory> // std::shared_ptr
 #include "events_subscription_organizer.hpp"
+#include "icallable.hpp"
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
 #include "events_dispatcher.hpp"
+#include "future.hpp"
+#include "thread_budget.hpp"
 
 
 namespace smartbuilding
 {
 
-EventsRouter::EventsRouter(std::shared_ptr<EventsSubscriptionOrganizer> a_subscribersOrganizer)
-: m_subscribersOrganizer(a_subscribersOrganizer)
-, m_eventsNotifier()
+EventsRouter::EventsRouter(std::shared_ptr<EventsSubscriptionOrganizer> a_subscribersOrganizer, std::shared_ptr<advcpp::ThreadBudget> a_threadsBudget, size_t a_subscribersPerBatch)
+: m_eventsNotifier(a_threadsBudget, a_subscribersPerBatch)
+, m_subscribersOrganizer(a_subscribersOrganizer)
 {
 }
 
 
-void EventsRouter::RouteEvent(Event a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue)
+advcpp::Future<void> EventsRouter::RouteEvent(Event a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue, std::shared_ptr<advcpp::ICallable> a_handledBuffersSender)
 {
     EventsSubscriptionOrganizer::SubscribersContainer subscribersToAlert;
     bool isValidCollection = m_subscribersOrganizer->FetchRelevantSubscribers(a_event.Type(), a_event.Location(), subscribersToAlert);
@@ -26,13 +30,13 @@ void EventsRouter::RouteEvent(Event a_event, std::shared_ptr<advcpp::BlockingBou
         throw std::runtime_error("An unknown internal error has occurred");
     }
 
-    Alert(subscribersToAlert, a_event, a_handledBuffersQueue);
+    return Alert(subscribersToAlert, a_event, a_handledBuffersQueue, a_handledBuffersSender);
 }
 
 
-void EventsRouter::Alert(EventsSubscriptionOrganizer::SubscribersContainer& a_subscribersToAlert, const Event& a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue)
+advcpp::Future<void> EventsRouter::Alert(EventsSubscriptionOrganizer::SubscribersContainer& a_subscribersToAlert, const Event& a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue, std::shared_ptr<advcpp::ICallable> a_handledBuffersSender)
 {
-    m_eventsNotifier.Invoke(a_subscribersToAlert, a_event, a_handledBuffersQueue);
+    return m_eventsNotifier.Invoke(a_subscribersToAlert, a_event, a_handledBuffersQueue, a_handledBuffersSender);
 }
 
 } // smartbuilding
@@ -1,20 +1,31 @@
 #include "events_subscription_organizer.hpp"
-#include <memory> // std::shared_ptr
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr, std::make_shared, std::atomic_load, std::atomic_store
 #include <stdexcept> // std::runtime_error, std::invalid_argument
-#include <list>
-#include <unordered_map>
-#include <set>
-#include <utility> // std::make_pair
-#include <algorithm> // std::for_each, std::find
+#include <vector> // std::vector
+#include <deque> // std::deque
+#include <unordered_map> // std::unordered_map
+#include <set> // std::set
+#include <mutex> // std::mutex, std::lock_guard
+#include <utility> // std::make_pair, std::move
+#include <algorithm> // std::find
 #include "isubscriber.hpp"
 #include "isubscribable.hpp"
 #include "event.hpp"
+#include "location.hpp"
 #include "subscription_location.hpp"
 
 
 namespace smartbuilding
 {
 
+EventsSubscriptionOrganizer::EventsSubscriptionOrganizer()
+: m_eventsSubscribersTable(std::make_shared<const SubscriptionsTable>())
+, m_writersLock()
+{
+}
+
+
 void EventsSubscriptionOrganizer::Subscribe(std::shared_ptr<ISubscriber> a_toSubscribe, const Event::EventType& a_type, const SubscriptionLocation& a_intrestedLocation)
 {
     if(!a_toSubscribe)
@@ -22,12 +33,19 @@ void EventsSubscriptionOrganizer::Subscribe(std::shared_ptr<ISubscriber> a_toSub
         throw std::runtime_error("Null pointer error");
     }
 
-    if(m_eventsSubscribersTable.find(a_type) == m_eventsSubscribersTable.end()) // Event not found
+    std::lock_guard<std::mutex> guard(m_writersLock);
+    std::shared_ptr<const SubscriptionsTable> currentTable = std::atomic_load(&m_eventsSubscribersTable);
+    auto eventTypeItr = currentTable->find(a_type);
+
+    EventTypeIndex eventTypeIndex = eventTypeItr != currentTable->end() ? eventTypeItr->second->m_index : EventTypeIndex(); // A new event type gets an empty index
+    std::vector<SubscribersBucket*> buckets = FindBucketsOf(eventTypeIndex, a_intrestedLocation);
+    eventTypeIndex.m_subscriptions[a_toSubscribe].push_back(a_intrestedLocation);
+    for(size_t i = 0; i < buckets.size(); ++i)
     {
-        CreateEventEntry(a_type);
+        buckets[i]->push_back(a_toSubscribe);
     }
 
-    m_eventsSubscribersTable[a_type].push_back(std::make_pair(a_toSubscribe, a_intrestedLocation));
+    PublishEventType(a_type, std::move(eventTypeIndex));
 }
 
 
@@ -38,32 +56,80 @@ void EventsSubscriptionOrganizer::Unsubscribe(std::shared_ptr<ISubscriber> a_toU
         throw std::runtime_error("Null pointer error");
     }
 
-    if(m_eventsSubscribersTable.find(a_type) == m_eventsSubscribersTable.end()) // Event not found
+    std::lock_guard<std::mutex> guard(m_writersLock);
+    std::shared_ptr<const SubscriptionsTable> currentTable = std::atomic_load(&m_eventsSubscribersTable);
+    auto eventTypeItr = currentTable->find(a_type);
+    if(eventTypeItr == currentTable->end()) // Event not found
     {
         throw std::invalid_argument("Event type not found error");
     }
+    if(eventTypeItr->second->m_index.m_subscriptions.count(a_toUnsubscribe) == 0) // Not subscribed to this event - nothing to publish
+    {
+        return;
+    }
+
+    EventTypeIndex eventTypeIndex = eventTypeItr->second->m_index;
+    auto subscriptionItr = eventTypeIndex.m_subscriptions.find(a_toUnsubscribe);
 
-    RemoveSubscriberFromEventList(m_eventsSubscribersTable[a_type], a_toUnsubscribe);
+    // Remove a single subscription (the earliest one) of the subscriber from this event
+    std::vector<SubscribersBucket*> buckets = FindBucketsOf(eventTypeIndex, subscriptionItr->second.front());
+    for(size_t i = 0; i < buckets.size(); ++i)
+    {
+        SubscribersBucket::iterator subscriberItr = std::find(buckets[i]->begin(), buckets[i]->end(), a_toUnsubscribe);
+        if(subscriberItr != buckets[i]->end())
+        {
+            *subscriberItr = buckets[i]->back(); // The bucket's order is not important
+            buckets[i]->pop_back();
+        }
+    }
+    subscriptionItr->second.pop_front();
+    if(subscriptionItr->second.empty())
+    {
+        eventTypeIndex.m_subscriptions.erase(subscriptionItr);
+    }
+
+    PublishEventType(a_type, std::move(eventTypeIndex));
 }
 
 
 bool EventsSubscriptionOrganizer::FetchRelevantSubscribers(const Event::EventType& a_type, const Event::EventLocation& a_location, SubscribersContainer& a_relevantSubscribersContainer) noexcept
 {
-    if(m_eventsSubscribersTable.find(a_type) == m_eventsSubscribersTable.end()) // Event not found
+    std::shared_ptr<const SubscriptionsTable> currentTable = std::atomic_load(&m_eventsSubscribersTable); // Never waits for the writers
+    auto eventTypeItr = currentTable->find(a_type);
+    if(eventTypeItr == currentTable->end()) // Event not found
     {
         return true;
     }
 
     try
     {
-        std::list<SubscribersToIntrestedLocationsPair>& relatedSubscribersCollection = m_eventsSubscribersTable[a_type];
-        std::for_each(relatedSubscribersCollection.begin(), relatedSubscribersCollection.end(), [&](const SubscribersToIntrestedLocationsPair& a_subscriberToIntrestedLocations)
+        const EventTypeSnapshot& eventTypeSnapshot = *eventTypeItr->second;
+        LocationKey locationKey = ToLocationKey(a_location.Floor(), a_location.Room());
+        std::shared_ptr<const SubscribersContainer> resolvedSubscribers;
         {
-            if(IsIntrestedLocationBySubscriber(a_location, a_subscriberToIntrestedLocations.second))
+            std::lock_guard<std::mutex> guard(eventTypeSnapshot.m_cacheLock);
+            auto cachedItr = eventTypeSnapshot.m_resolvedSubscribersCache.find(locationKey);
+            if(cachedItr != eventTypeSnapshot.m_resolvedSubscribersCache.end())
             {
-                a_relevantSubscribersContainer.insert(a_subscriberToIntrestedLocations.first);
+                resolvedSubscribers = cachedItr->second;
             }
-        });
+        }
+
+        if(!resolvedSubscribers) // Resolved outside of the cache's lock - concurrent readers of the same location might resolve it twice, with the same result
+        {
+            std::shared_ptr<SubscribersContainer> newResolvedSubscribers = std::make_shared<SubscribersContainer>();
+            ResolveSubscribers(eventTypeSnapshot.m_index, a_location, *newResolvedSubscribers);
+            resolvedSubscribers = newResolvedSubscribers;
+
+            std::lock_guard<std::mutex> guard(eventTypeSnapshot.m_cacheLock);
+            if(eventTypeSnapshot.m_resolvedSubscribersCache.size() >= MAX_CACHED_LOCATIONS_PER_EVENT_TYPE)
+            {
+                eventTypeSnapshot.m_resolvedSubscribersCache.clear();
+            }
+            eventTypeSnapshot.m_resolvedSubscribersCache[locationKey] = resolvedSubscribers;
+        }
+
+        a_relevantSubscribersContainer.insert(resolvedSubscribers->begin(), resolvedSubscribers->end());
     }
     catch(const std::exception& ex)
     {
@@ -75,74 +141,74 @@ bool EventsSubscriptionOrganizer::FetchRelevantSubscribers(const Event::EventTyp
 }
 
 
-void EventsSubscriptionOrganizer::CreateEventEntry(const Event::EventType& a_type)
+void EventsSubscriptionOrganizer::PublishEventType(const Event::EventType& a_type, EventTypeIndex&& a_index)
 {
-    m_eventsSubscribersTable[a_type] = std::list<SubscribersToIntrestedLocationsPair>();
+    // The other event types' snapshots are shared with the current table - only the modified event type is copied
+    std::shared_ptr<SubscriptionsTable> newTable = std::make_shared<SubscriptionsTable>(*std::atomic_load(&m_eventsSubscribersTable));
+    (*newTable)[a_type] = std::make_shared<const EventTypeSnapshot>(std::move(a_index));
+
+    std::atomic_store(&m_eventsSubscribersTable, std::shared_ptr<const SubscriptionsTable>(newTable)); // The readers of the previous snapshot keep it alive until they finish
 }
 
 
-void EventsSubscriptionOrganizer::RemoveSubscriberFromEventList(std::list<SubscribersToIntrestedLocationsPair>& a_list, std::shared_ptr<ISubscriber> a_toRemove)
+std::vector<EventsSubscriptionOrganizer::SubscribersBucket*> EventsSubscriptionOrganizer::FindBucketsOf(EventTypeIndex& a_index, const SubscriptionLocation& a_location) const
 {
-    auto itr = a_list.begin();
-    auto endItr = a_list.end();
-
-    for(; itr != endItr; ++itr)
+    std::vector<SubscribersBucket*> buckets;
+    if(a_location.IsAllFloors() && a_location.IsAllRooms())
     {
-        SubscribersToIntrestedLocationsPair currentPair = *itr;
-        if(currentPair.first == a_toRemove)
-        {
-            // Remove the SubscribersToLocationsPair from this event
-            a_list.erase(itr);
-            break;
-        }
+        buckets.push_back(&a_index.m_allFloorsAllRooms);
     }
-}
-
-
-bool EventsSubscriptionOrganizer::IsIntrestedLocationBySubscriber(const Event::EventLocation& a_eventLocation, const SubscriptionLocation& a_intrestedLocation) const noexcept
-{
-    if(a_intrestedLocation.IsAllFloors())
+    else if(a_location.IsAllFloors())
     {
-        if(a_intrestedLocation.IsAllRooms())
+        for(size_t room = 0; room < a_location.SpecifiedRooms().size(); ++room)
         {
-            return true;
+            buckets.push_back(&a_index.m_allFloorsByRoom[a_location.SpecifiedRooms()[room]]);
         }
-        else
+    }
+    else if(a_location.IsAllRooms())
+    {
+        for(size_t floor = 0; floor < a_location.SpecifiedFloors().size(); ++floor)
         {
-            return HasNumberSpecified(a_intrestedLocation.SpecifiedRooms(), a_eventLocation.Room());
+            buckets.push_back(&a_index.m_allRoomsByFloor[a_location.SpecifiedFloors()[floor]]);
         }
     }
     else
     {
-        if(HasNumberSpecified(a_intrestedLocation.SpecifiedFloors(), a_eventLocation.Floor()))
+        for(size_t floor = 0; floor < a_location.SpecifiedFloors().size(); ++floor)
         {
-            if(a_intrestedLocation.IsAllRooms())
-            {
-                return true;
-            }
-            else
+            for(size_t room = 0; room < a_location.SpecifiedRooms().size(); ++room)
             {
-                return HasNumberSpecified(a_intrestedLocation.SpecifiedRooms(), a_eventLocation.Room());
+                buckets.push_back(&a_index.m_byFloorAndRoom[ToLocationKey(a_location.SpecifiedFloors()[floor], a_location.SpecifiedRooms()[room])]);
             }
         }
-        else
-        {
-            return false;
-        }
     }
+
+    return buckets;
 }
 
 
-bool EventsSubscriptionOrganizer::HasNumberSpecified(const std::vector<unsigned int>& a_allNumber, unsigned int a_number) const noexcept
+void EventsSubscriptionOrganizer::ResolveSubscribers(const EventTypeIndex& a_index, const Event::EventLocation& a_location, SubscribersContainer& a_resolvedSubscribers) const
 {
-    auto end = a_allNumber.end();
-    if(std::find(a_allNumber.begin(), end, a_number) == end)
+    // The four buckets that might hold a subscriber of a_location:
+    a_resolvedSubscribers.insert(a_index.m_allFloorsAllRooms.begin(), a_index.m_allFloorsAllRooms.end());
+
+    auto allFloorsItr = a_index.m_allFloorsByRoom.find(a_location.Room());
+    if(allFloorsItr != a_index.m_allFloorsByRoom.end())
     {
-        // The number has NOT specified by the subscriber
-        return false;
+        a_resolvedSubscribers.insert(allFloorsItr->second.begin(), allFloorsItr->second.end());
     }
 
-    return true;
+    auto allRoomsItr = a_index.m_allRoomsByFloor.find(a_location.Floor());
+    if(allRoomsItr != a_index.m_allRoomsByFloor.end())
+    {
+        a_resolvedSubscribers.insert(allRoomsItr->second.begin(), allRoomsItr->second.end());
+    }
+
+    auto specifiedItr = a_index.m_byFloorAndRoom.find(ToLocationKey(a_location.Floor(), a_location.Room()));
+    if(specifiedItr != a_index.m_byFloorAndRoom.end())
+    {
+        a_resolvedSubscribers.insert(specifiedItr->second.begin(), specifiedItr->second.end());
+    }
 }
 
 } // smartbuilding
@@ -1,12 +1,42 @@
 #include "file_logger.hpp"
-#include <string> // std::string
-#include <fstream> // ofstream
-#include "date_time.hpp"
+#include <cstddef> // size_t
+#include <string> // std::string, std::to_string
+#include <memory> // std::shared_ptr
+#include <chrono> // std::chrono::milliseconds, std::chrono::nanoseconds, std::chrono::steady_clock
+#include <mutex> // std::mutex, std::lock_guard, std::unique_lock
+#include <stdexcept> // std::runtime_error
+#include <utility> // std::move
+#include <fcntl.h> // open, O_WRONLY, O_CREAT, O_APPEND, O_CLOEXEC
+#include <unistd.h> // write, close
+#include <errno.h> // errno, EINTR
+#include "timestamp.hpp"
 
 
-smartbuilding::FileLogger::FileLogger(const std::string& a_logFileName)
+smartbuilding::FileLoggerConfig::FileLoggerConfig()
+: m_stagingCapacity(4096)
+, m_flushInterval(std::chrono::milliseconds(100))
+, m_flushBatchSize(256)
+, m_overflowPolicy(COUNT_DROPPED_RECORDS)
+{
+}
+
+
+smartbuilding::FileLogger::FileLogger(const std::string& a_logFileName, const FileLoggerConfig& a_config)
 : m_logLevelToStringMap(LogLevel::LAST_INDICATOR)
 , m_logFileName(a_logFileName)
+, m_config(ValidateConfig(a_config)) // Before the file is opened and the writer is started
+, m_file(a_logFileName)
+, m_stagedRecords(a_config.m_stagingCapacity, advcpp::NoOperationPolicy<std::string>())
+, m_stagedRecordsCount(0)
+, m_writtenRecordsCount(0)
+, m_droppedRecordsCount(0)
+, m_reportedDroppedRecordsCount(0)
+, m_batch()
+, m_writingLock()
+, m_writingCondition()
+, m_isStopRequired(false)
+, m_isFlushRequired(false)
+, m_writingThread(std::shared_ptr<advcpp::ICallable>(new WritingLoop(this)), advcpp::JoinPolicy()) // Last - all the members are ready before the first write
 {
     m_logLevelToStringMap[LogLevel::ERROR] = "[Error] ";
     m_logLevelToStringMap[LogLevel::WARNING] = "[Warning] ";
@@ -14,17 +44,172 @@ smartbuilding::FileLogger::FileLogger(const std::string& a_logFileName)
 }
 
 
+smartbuilding::FileLogger::~FileLogger()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_writingLock);
+        m_isStopRequired = true;
+    }
+    m_writingCondition.notify_all();
+    m_writingThread.Join(); // The writer writes the rest of the staged records before it exits (the file is closed by m_file's destruction)
+}
+
+
 void smartbuilding::FileLogger::Log(const std::string &a_message, LogLevel a_logLevel)
 {
-    // Open the file resource only on demand (and not keeping it open when no using it [the file])
-    std::ofstream log(m_logFileName);
-    DateTime timeNowSnapshot = DateTime::Now();
+    std::string record; // Formatted by the producer - the writer only copies bytes
+    record.reserve(RECORD_PREFIX_CAPACITY + a_message.size());
+    Timestamp::Now().AppendTo(record);
+    record += MapLogLevelToString(a_logLevel);
+    record += a_message;
+    record += '\n';
+
+    size_t stagedRecordsCount = m_stagedRecordsCount.fetch_add(1, std::memory_order_release) + 1; // Before the record is visible to the writer - it never writes uncounted records
+    bool isStaged = m_config.m_overflowPolicy == BLOCK_PRODUCERS ? m_stagedRecords.Enqueue(std::move(record)) : m_stagedRecords.TryEnqueue(std::move(record));
+    if(!isStaged)
+    {
+        m_stagedRecordsCount.fetch_sub(1, std::memory_order_relaxed);
+        m_droppedRecordsCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
 
-    log << timeNowSnapshot.ToString() + MapLogLevelToString(a_logLevel) + a_message;
+    size_t writtenRecordsCount = m_writtenRecordsCount.load(std::memory_order_relaxed);
+    if(stagedRecordsCount > writtenRecordsCount && stagedRecordsCount - writtenRecordsCount >= m_config.m_flushBatchSize) // Both counters move meanwhile - the guard keeps the difference from wrapping around
+    {
+        m_writingCondition.notify_one(); // Without the lock - a missed wake up is bounded by the flush interval
+    }
 }
 
 
-std::string smartbuilding::FileLogger::MapLogLevelToString(LogLevel a_logLevel) const
+bool smartbuilding::FileLogger::Flush(std::chrono::nanoseconds a_timeout)
+{
+    size_t recordsToWrite = m_stagedRecordsCount.load(std::memory_order_acquire);
+
+    std::unique_lock<std::mutex> lock(m_writingLock);
+    m_isFlushRequired = true;
+    m_writingCondition.notify_all();
+
+    return m_writingCondition.wait_for(lock, a_timeout, [this, recordsToWrite]()
+    {
+        size_t writtenRecordsCount = m_writtenRecordsCount.load(std::memory_order_acquire);
+        return writtenRecordsCount >= recordsToWrite || writtenRecordsCount >= m_stagedRecordsCount.load(std::memory_order_acquire); // A record that was counted and then dropped is never written
+    });
+}
+
+
+const std::string& smartbuilding::FileLogger::MapLogLevelToString(LogLevel a_logLevel) const
 {
     return m_logLevelToStringMap.at(a_logLevel); // Would throw if LogLevel is not valid
 }
+
+
+const smartbuilding::FileLoggerConfig& smartbuilding::FileLogger::ValidateConfig(const FileLoggerConfig& a_config)
+{
+    if(a_config.m_stagingCapacity == 0 || a_config.m_flushBatchSize == 0)
+    {
+        throw std::runtime_error("Error: invalid file logger config");
+    }
+
+    return a_config;
+}
+
+
+smartbuilding::FileLogger::LogFile::LogFile(const std::string& a_logFileName)
+: m_fileID(open(a_logFileName.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644))
+{
+    if(m_fileID < 0)
+    {
+        throw std::runtime_error("Error: failed to open the log file " + a_logFileName);
+    }
+}
+
+
+smartbuilding::FileLogger::LogFile::~LogFile()
+{
+    close(m_fileID);
+}
+
+
+void smartbuilding::FileLogger::WritingLoop::operator()()
+{
+    m_logger->RunWriting();
+}
+
+
+void smartbuilding::FileLogger::RunWriting()
+{
+    std::unique_lock<std::mutex> lock(m_writingLock);
+    while(true)
+    {
+        m_writingCondition.wait_for(lock, m_config.m_flushInterval, [this]()
+        {
+            size_t writtenRecordsCount = m_writtenRecordsCount.load(std::memory_order_relaxed); // Only the writer moves it - loaded first, so the staged count is not behind it
+            return m_isStopRequired || m_isFlushRequired || m_stagedRecordsCount.load(std::memory_order_relaxed) - writtenRecordsCount >= m_config.m_flushBatchSize;
+        });
+        bool isStopRequired = m_isStopRequired;
+        m_isFlushRequired = false;
+
+        lock.unlock(); // The producers and the flushers are not blocked by the disk
+        WriteStagedRecords();
+        lock.lock();
+
+        m_writingCondition.notify_all(); // The flushers check their records
+        if(isStopRequired)
+        {
+            break;
+        }
+    }
+}
+
+
+void smartbuilding::FileLogger::WriteStagedRecords()
+{
+    const size_t MAX_BATCH_BYTES = 64 * 1024;
+    std::string record;
+    size_t batchedRecordsCount = 0;
+    bool hasDequeued = m_stagedRecords.TryDequeue(record);
+    while(hasDequeued || !m_batch.empty())
+    {
+        if(hasDequeued)
+        {
+            m_batch += record;
+            ++batchedRecordsCount;
+        }
+
+        if(!hasDequeued || m_batch.size() >= MAX_BATCH_BYTES)
+        {
+            WriteAll(m_batch);
+            m_batch.clear();
+            m_writtenRecordsCount.fetch_add(batchedRecordsCount, std::memory_order_release);
+            batchedRecordsCount = 0;
+        }
+
+        hasDequeued = hasDequeued && m_stagedRecords.TryDequeue(record);
+    }
+
+    size_t droppedRecordsCount = m_droppedRecordsCount.load(std::memory_order_relaxed);
+    if(m_config.m_overflowPolicy == COUNT_DROPPED_RECORDS && droppedRecordsCount != m_reportedDroppedRecordsCount)
+    {
+        WriteAll(Timestamp::Now().ToString() + MapLogLevelToString(LogLevel::WARNING) + std::to_string(droppedRecordsCount - m_reportedDroppedRecordsCount) + " log records were dropped (the log is behind)\n");
+        m_reportedDroppedRecordsCount = droppedRecordsCount;
+    }
+}
+
+
+void smartbuilding::FileLogger::WriteAll(const std::string& a_bytes)
+{
+    size_t writtenBytes = 0;
+    while(writtenBytes < a_bytes.size())
+    {
+        ssize_t result = write(m_file.ID(), a_bytes.data() + writtenBytes, a_bytes.size() - writtenBytes);
+        if(result < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            return; // Nowhere to report a failure of the log itself - the batch is lost
+        }
+        writtenBytes += static_cast<size_t>(result);
+    }
+}
@@ -1,13 +1,27 @@
 #include "hub.hpp"
+#include <cstddef> // size_t
 #include <memory> // std::shared_ptr, std::make_shared
-#include <utility> // std::pair
+#include <utility> // std::pair, std::make_pair, std::move
+#include <string> // std::string
+#include <mutex> // std::mutex, std::lock_guard
+#include <thread> // std::thread::hardware_concurrency
+#include <vector> // std::vector
+#include <pthread.h> // pthread_setaffinity_np, pthread_self
+#include <sched.h> // cpu_set_t, CPU_ZERO, CPU_SET
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
 #include "ipublisher.hpp"
-#include "thread.hpp"
-#include "thread_destruction_policies.hpp"
 #include "thread_pool.hpp"
 #include "thread_pool_destruction_policies.hpp"
+#include "thread_pool_autoscaler.hpp"
+#include "thread_budget.hpp"
+#include "task.hpp"
+#include "priority.hpp"
+#include "priority_bounded_queue.hpp"
+#include "future.hpp"
+#include "thread.hpp"
+#include "thread_destruction_policies.hpp"
+#include "icallable.hpp"
 #include "tcp_server.hpp"
 #include "event.hpp"
 #include "smartbuilding_network_protocol.hpp"
@@ -18,95 +32,412 @@
 #include "software_agents_factory.hpp"
 #include "safe_loggers_manager.hpp"
 #include "remote_devices_sockets_manager.hpp"
+#include "connection_handle.hpp"
 #include "iconfig_reader.hpp"
-#include "smartbuilding_request.hpp"
-#include "smartbuilding_connect_request.hpp"
-#include "smartbuilding_disconnect_request.hpp"
-#include "smartbuilding_subscribe_request.hpp"
-#include "smartbuilding_unsubscribe_request.hpp"
-#include "smartbuilding_event_request.hpp"
-#include "published_events_transmit_work.hpp"
-#include "handled_buffers_transmit_work.hpp"
+#include "routing_work.hpp"
+#include "sending_work.hpp"
+#include "events_dispatcher.hpp"
+#include "encoding_cache.hpp"
+#include "ilogger.hpp"
 
 
 namespace smartbuilding
 {
 
-Hub::Hub(std::unique_ptr<SmartBuildingNetworkProtocol> a_networkProtocolParser, std::shared_ptr<IConfigReader> a_configFileReader, const std::string& a_configFileName, unsigned int a_serverPort, unsigned int a_maxWaitingClientsAtSameTime)
+const unsigned int Hub::QUEUE_SIZE; // Bound to references (e.g. by std::make_shared) - so they must be defined
+const unsigned int Hub::MIN_WORKERS;
+const unsigned int Hub::MIN_THREADS_BUDGET;
+
+
+static void PinCallingThreadToCore(unsigned int a_core)
+{
+    unsigned int coresCount = std::thread::hardware_concurrency();
+    if(coresCount == 0) // Unknown - leave the thread to the scheduler
+    {
+        return;
+    }
+
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    CPU_SET(a_core % coresCount, &cores);
+    pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores); // Best effort - an unpinned reactor still works
+}
+
+
+Hub::Hub(std::unique_ptr<SmartBuildingNetworkProtocol> a_networkProtocolParser, std::shared_ptr<IConfigReader> a_configFileReader, const std::string& a_configFileName, unsigned int a_serverPort, unsigned int a_maxWaitingClientsAtSameTime, unsigned int a_reactorsCount)
 : m_networkProtocolParser(std::move(a_networkProtocolParser))
+, m_threadsBudget(std::make_shared<advcpp::ThreadBudget>(std::thread::hardware_concurrency() > MIN_THREADS_BUDGET ? std::thread::hardware_concurrency() : MIN_THREADS_BUDGET))
 , m_subscribersOrganizer(std::make_shared<EventsSubscriptionOrganizer>())
-, m_router(std::make_shared<EventsRouter>(m_subscribersOrganizer))
+, m_router(std::make_shared<EventsRouter>(m_subscribersOrganizer, m_threadsBudget))
 , m_agentsManager(std::make_shared<SoftwareAgentsManager>())
 , m_loggersManager(std::make_shared<SafeLoggersManager>())
 , m_socketsManager(std::make_shared<RemoteDevicesSocketsManager>())
-, m_routingWorkers(std::make_shared<advcpp::ThreadPool<advcpp::ShutdownPolicy<>>>(advcpp::ShutdownPolicy<>(), QUEUE_SIZE))
-, m_sendingWorkers(std::make_shared<advcpp::ThreadPool<advcpp::ShutdownPolicy<>>>(advcpp::ShutdownPolicy<>(), QUEUE_SIZE))
-, m_publishedEventsQueue(std::make_shared<advcpp::BlockingBoundedQueue<Event, advcpp::NoOperationPolicy<Event>>>(QUEUE_SIZE))
-, m_handledBuffersQueue(std::make_shared<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>>(QUEUE_SIZE))
-, m_publishedEventsTransmitter(std::make_shared<advcpp::Thread<advcpp::DetachPolicy>>(std::make_shared<PublishedEventsTransmitWork>(m_publishedEventsQueue, m_handledBuffersQueue, m_routingWorkers, m_router), advcpp::DetachPolicy()))
-, m_handledBuffersTransmitter(std::make_shared<advcpp::Thread<advcpp::DetachPolicy>>(std::make_shared<HandledBuffersTransmitWork>(m_handledBuffersQueue, m_sendingWorkers, m_socketsManager), advcpp::DetachPolicy()))
-, m_tcpServerDriver(OnClientMessageHandler(this), OnErrorHandler(), OnNewClientConnectionHandler(), OnCloseClientConnectionHandler(), a_serverPort, a_maxWaitingClientsAtSameTime)
+, m_requestsWorkers(std::make_shared<RequestsWorkers>(advcpp::ShutdownPolicy<advcpp::ClearPolicy<advcpp::Task>,RequestsWorksQueue>(), QUEUE_SIZE, MIN_WORKERS))
+, m_starvedRequestsWorksLock()
+, m_starvedRequestsWorks()
+, m_parkedRequestsWorksLock()
+, m_parkedRequestsWorks()
+, m_routingWorkers(std::make_shared<advcpp::ThreadPool<advcpp::ShutdownPolicy<>>>(advcpp::ShutdownPolicy<>(), QUEUE_SIZE, MIN_WORKERS))
+, m_sendingWorkers(std::make_shared<advcpp::ThreadPool<advcpp::ShutdownPolicy<>>>(advcpp::ShutdownPolicy<>(), QUEUE_SIZE, MIN_WORKERS))
+, m_requestsWorkersScaler(*m_requestsWorkers, advcpp::AutoscalerConfig(), m_threadsBudget)
+, m_routingWorkersScaler(*m_routingWorkers, advcpp::AutoscalerConfig(), m_threadsBudget)
+, m_sendingWorkersScaler(*m_sendingWorkers, advcpp::AutoscalerConfig(), m_threadsBudget)
+, m_publishedEventsQueue(std::make_shared<advcpp::BlockingBoundedQueue<Event, advcpp::NoOperationPolicy<Event>>>(QUEUE_SIZE, advcpp::NoOperationPolicy<Event>()))
+, m_handledBuffersQueue(std::make_shared<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>>(QUEUE_SIZE, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>()))
+, m_handledBuffersSender(std::make_shared<SendingWorkTrigger>(m_sendingWorkers, SendingWork(m_handledBuffersQueue, m_socketsManager)))
+, m_tcpServerDrivers()
 {
+    bool isPortSharingRequired = a_reactorsCount > 1; // A single reactor keeps the port exclusive
+    do
+    {
+        std::shared_ptr<ConnectionsRequestsTable> connectionsRequests = std::make_shared<ConnectionsRequestsTable>();
+        m_tcpServerDrivers.emplace_back(new HubServer(OnClientMessageHandler(this, m_tcpServerDrivers.size(), connectionsRequests), OnErrorHandler(), OnNewClientConnectionHandler(), OnCloseClientConnectionHandler(this, connectionsRequests), a_serverPort, a_maxWaitingClientsAtSameTime, isPortSharingRequired));
+    }
+    while(m_tcpServerDrivers.size() < a_reactorsCount);
+
     SoftwareAgentsFactory agentsFactory(m_agentsManager, m_loggersManager, a_configFileReader);
     agentsFactory.CreateAgents(a_configFileName);
-
-    m_publishedEventsTransmitter->Detach();
-    m_handledBuffersTransmitter->Detach();
 }
 
 
 Hub::~Hub()
 {
+    m_requestsWorkersScaler.Stop(); // Before the workers are stopped - the autoscalers must not resize a shutting down pool
+    m_routingWorkersScaler.Stop();
+    m_sendingWorkersScaler.Stop();
+    m_requestsWorkers->Shutdown(); // First - the handled requests might publish events to the routing workers
     m_routingWorkers->Shutdown();
+    m_router.reset(); // Shuts down the dispatcher's invokers - their flushes still trigger the sending workers
     m_sendingWorkers->Shutdown();
-    m_publishedEventsTransmitter->Cancel();
-    m_handledBuffersTransmitter->Cancel();
 }
 
 
 void Hub::Start()
 {
-    m_tcpServerDriver.Run();
+    std::vector<std::unique_ptr<advcpp::Thread<advcpp::JoinPolicy>>> reactorsThreads; // Joined by their destruction - after the calling thread's reactor has stopped
+    try
+    {
+        for(size_t i = 1; i < m_tcpServerDrivers.size(); ++i)
+        {
+            reactorsThreads.emplace_back(new advcpp::Thread<advcpp::JoinPolicy>(std::make_shared<ReactorRunner>(*m_tcpServerDrivers[i], i), advcpp::JoinPolicy()));
+        }
+
+        if(m_tcpServerDrivers.size() > 1)
+        {
+            PinCallingThreadToCore(0);
+        }
+        m_tcpServerDrivers[0]->Run();
+    }
+    catch(...)
+    {
+        StopOtherReactors(); // Before the started reactors are joined
+        throw;
+    }
+
+    StopOtherReactors();
+    LogTransmissionStatistics();
+}
+
+
+void Hub::StopOtherReactors()
+{
+    for(size_t i = 1; i < m_tcpServerDrivers.size(); ++i)
+    {
+        m_tcpServerDrivers[i]->Stop();
+    }
+}
+
+
+void Hub::LogTransmissionStatistics()
+{
+    EventsDispatcher::FanOutStatistics fanOut = m_router->DispatchStatistics();
+    EncodingCache::Statistics encoding = EncodingCache::ProcessStatistics();
+    std::shared_ptr<ILogger> hubLogger = m_loggersManager->GetLogger("");
+
+    hubLogger->Log("Fan-out: " + std::to_string(fanOut.m_eventsCount) + " events, " + std::to_string(fanOut.m_batchesCount) + " batches of "
+                    + std::to_string(fanOut.m_subscribersCount) + " subscribers (largest batch: " + std::to_string(fanOut.m_largestBatchSize) + "), dropped "
+                    + std::to_string(fanOut.m_droppedBatchesCount) + " batches of " + std::to_string(fanOut.m_droppedSubscribersCount) + " subscribers", ILogger::INFO);
+    hubLogger->Log("Encoding cache: " + std::to_string(encoding.m_hitsCount) + " hits, " + std::to_string(encoding.m_missesCount) + " misses (encodings)", ILogger::INFO);
+}
+
+
+void Hub::ReactorRunner::operator()()
+{
+    PinCallingThreadToCore(m_core);
+    m_reactor.Run();
+}
+
+
+void Hub::TransmitPublishedEvents()
+{
+    // publish -> route -> encode (by the subscribers' agents, on the dispatcher's invokers) -> send:
+    // the sending stage is triggered by the invokers after every flush of handled buffers - so it drains them while the event is still notified, no blocking loop
+    // If it fails - the routing works queue is full, so the works in it run after the events were published, and route them
+    m_routingWorkers->TrySubmit(TransmittingWork(this));
+}
+
+
+void Hub::TransmittingWork::operator()()
+{
+    RoutingWork(m_thisHub->m_publishedEventsQueue, m_thisHub->m_handledBuffersQueue, m_thisHub->m_handledBuffersSender, m_thisHub->m_router)(); // Its future fails only if some event has failed - the rest were routed anyway
+    try
+    {
+        m_thisHub->ResumePublishingRequestsWorks();
+    }
+    catch(...)
+    {
+        // The requests workers have stopped (the hub is shutting down) - the parked requests are dropped
+    }
 }
 
 
 bool Hub::OnClientMessageHandler::operator()(infra::tcpserver_details::Message& a_receivedMessage, std::pair<infra::tcpserver_details::ClientID, std::shared_ptr<infra::TCPSocket>> a_clientInfo, infra::tcpserver_details::Response& a_response)
 {
-    std::shared_ptr<SmartBuildingRequest> newRequestToHandle = m_thisHub->m_networkProtocolParser->Parse(a_receivedMessage);
-    if(!newRequestToHandle)
+    ConnectionRequests::PendingRequest newRequestToHandle = {a_receivedMessage, SmartBuildingRequest(), a_clientInfo}; // The request views the message's bytes - no allocation per request
+    if(!m_thisHub->m_networkProtocolParser->Parse(newRequestToHandle.m_message, newRequestToHandle.m_request))
     {
         a_response.m_status = infra::tcpserver_details::DO_NOTHING; // By default - do not operate in the server - almost complete handling would occur here
         return false; // Wrong buffer content (server should always continue its running)
     }
 
-    if(newRequestToHandle->RequestType() == "Connect")
+    std::shared_ptr<ConnectionRequests>& connectionRequests = (*m_connectionsRequests)[a_clientInfo.first];
+    if(!connectionRequests)
     {
-        HandleNewConnectRequest(std::static_pointer_cast<SmartBuildingConnectRequest>(newRequestToHandle), a_response, a_clientInfo.second);
+        connectionRequests = std::make_shared<ConnectionRequests>();
     }
-    else if(newRequestToHandle->RequestType() == "Disconnect")
+
+    a_response.m_status = infra::tcpserver_details::DEFER_RESPONSE; // Posted by the requests work
+    advcpp::Priority priority = PriorityOf(newRequestToHandle.m_request); // Of the request that schedules its connection's work
+    if(connectionRequests->Push(std::move(newRequestToHandle)))
     {
-        HandleNewDisconnectRequest(std::static_pointer_cast<SmartBuildingDisconnectRequest>(newRequestToHandle), a_response);
+        RequestsWork requestsWork(m_thisHub, m_reactorIndex, connectionRequests);
+        if(!m_thisHub->m_requestsWorkers->TrySubmit(RequestsWork(requestsWork), priority))
+        {
+            a_response.m_status = infra::tcpserver_details::DEFER_RESPONSE_AND_PAUSE_READING; // The request stays queued - no more requests are read from the connection meanwhile
+            m_thisHub->DeferRequestsWork(std::move(requestsWork), priority);
+        }
     }
-    else if(newRequestToHandle->RequestType() == "Subscribe")
+
+    return false; // Server should always continue its running
+}
+
+
+void Hub::DetachDevice(const std::string& a_deviceID, ConnectionHandle a_connection)
+{
+    std::shared_ptr<SoftwareAgent> deviceAgent = m_agentsManager->FindByID(a_deviceID);
+    if(deviceAgent)
     {
-        HandleNewSubscribeRequest(std::static_pointer_cast<SmartBuildingSubscribeRequest>(newRequestToHandle), a_response);
+        deviceAgent->ClearConnection(a_connection); // First - the agent stops addressing the released connection
     }
-    else if(newRequestToHandle->RequestType() == "Unsubscribe")
+    m_socketsManager->Remove(a_deviceID, a_connection);
+}
+
+
+advcpp::Priority Hub::PriorityOf(const SmartBuildingRequest& a_request)
+{
+    return a_request.Type() == EVENT_REQUEST ? advcpp::Priority::NORMAL : advcpp::Priority::HIGH;
+}
+
+
+void Hub::DeferRequestsWork(RequestsWork&& a_starvedWork, advcpp::Priority a_priority)
+{
     {
-        HandleNewUnsubscribeRequest(std::static_pointer_cast<SmartBuildingUnsubscribeRequest>(newRequestToHandle), a_response);
+        std::lock_guard<std::mutex> guard(m_starvedRequestsWorksLock);
+        m_starvedRequestsWorks.push_back(std::move(a_starvedWork));
     }
-    else if(newRequestToHandle->RequestType() == "Event")
+
+    // If even this fails - the lane is full now, so the works in it run after the starved work was queued, and one of them takes it over
+    m_requestsWorkers->TrySubmit(RequestsWork(this), a_priority);
+}
+
+
+void Hub::ParkPublishingRequestsWork(RequestsWork&& a_blockedWork)
+{
     {
-        HandleNewEventRequest(std::static_pointer_cast<SmartBuildingEventRequest>(newRequestToHandle), a_response);
+        std::lock_guard<std::mutex> guard(m_parkedRequestsWorksLock);
+        m_parkedRequestsWorks.push_back(std::move(a_blockedWork));
     }
 
-    return false; // Server should always continue its running
+    TransmitPublishedEvents(); // After the work was parked - so a drain of the queue always follows it, and resumes it
 }
 
 
-void Hub::OnClientMessageHandler::HandleNewConnectRequest(std::shared_ptr<SmartBuildingConnectRequest> a_connectRequest, infra::tcpserver_details::Response& a_response, std::shared_ptr<infra::TCPSocket> a_deviceSocket)
+void Hub::ResumePublishingRequestsWorks()
 {
-    std::string deviceID = a_connectRequest->RequestSenderID();
+    std::vector<RequestsWork> parkedWorks;
+    {
+        std::lock_guard<std::mutex> guard(m_parkedRequestsWorksLock);
+        parkedWorks.swap(m_parkedRequestsWorks);
+    }
+
+    for(size_t i = 0; i < parkedWorks.size(); ++i)
+    {
+        if(!m_requestsWorkers->TrySubmit(RequestsWork(parkedWorks[i]), advcpp::Priority::NORMAL)) // Parked by an event request
+        {
+            DeferRequestsWork(std::move(parkedWorks[i]), advcpp::Priority::NORMAL);
+        }
+    }
+}
+
+
+bool Hub::TakeStarvedRequestsWork(RequestsWork& a_work)
+{
+    std::lock_guard<std::mutex> guard(m_starvedRequestsWorksLock);
+    if(m_starvedRequestsWorks.empty())
+    {
+        return false;
+    }
+
+    a_work = std::move(m_starvedRequestsWorks.front());
+    m_starvedRequestsWorks.pop_front();
+
+    return true;
+}
+
+
+void Hub::OnCloseClientConnectionHandler::operator()(infra::tcpserver_details::ClientID a_clientID)
+{
+    ConnectionsRequestsTable::iterator connectionRequestsItr = m_connectionsRequests->find(a_clientID);
+    if(connectionRequestsItr == m_connectionsRequests->end()) // The connection has not sent any request
+    {
+        return;
+    }
+
+    std::vector<ConnectionRequests::AttachedDevice> attachedDevices;
+    connectionRequestsItr->second->Close(attachedDevices); // A connect request in progress detaches its device by itself
+    for(size_t i = 0; i < attachedDevices.size(); ++i)
+    {
+        m_thisHub->DetachDevice(attachedDevices[i].first, attachedDevices[i].second);
+    }
+
+    m_connectionsRequests->erase(connectionRequestsItr); // A requests work in progress keeps its connection's requests - their responses are dropped by the reactor
+}
+
+
+bool Hub::ConnectionRequests::Push(PendingRequest&& a_request)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_requests.push_back(std::move(a_request));
+    bool isSchedulingRequired = !m_isScheduled;
+    m_isScheduled = true;
+
+    return isSchedulingRequired;
+}
+
+
+bool Hub::ConnectionRequests::Pop(PendingRequest& a_request)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if(m_requests.empty())
+    {
+        m_isScheduled = false;
+        return false;
+    }
+
+    a_request = std::move(m_requests.front());
+    m_requests.pop_front();
+
+    return true;
+}
+
+
+void Hub::ConnectionRequests::Restore(PendingRequest&& a_request)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_requests.push_front(std::move(a_request));
+}
+
+
+bool Hub::ConnectionRequests::AttachDevice(const std::string& a_deviceID, ConnectionHandle a_connection)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if(m_isClosed)
+    {
+        return false;
+    }
+
+    m_attachedDevices.push_back(std::make_pair(a_deviceID, a_connection));
+
+    return true;
+}
+
+
+void Hub::ConnectionRequests::Close(std::vector<AttachedDevice>& a_attachedDevices)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_isClosed = true;
+    a_attachedDevices.swap(m_attachedDevices);
+}
+
+
+void Hub::RequestsWork::operator()()
+{
+    HandlePendingRequests();
+    while(m_thisHub->TakeStarvedRequestsWork(*this)) // This worker has freed up - it takes over a starved connection
+    {
+        HandlePendingRequests();
+    }
+}
+
+
+void Hub::RequestsWork::HandlePendingRequests()
+{
+    if(!m_connectionRequests)
+    {
+        return;
+    }
+
+    ConnectionRequests::PendingRequest requestToHandle;
+    while(m_connectionRequests->Pop(requestToHandle))
+    {
+        infra::tcpserver_details::Response response;
+        response.m_status = infra::tcpserver_details::DO_NOTHING;
+        response.m_clients.push_back(requestToHandle.m_clientInfo.first);
+        bool isPublishingBlocked = false;
+
+        try
+        {
+            switch(requestToHandle.m_request.Type())
+            {
+            case CONNECT_REQUEST:
+                HandleNewConnectRequest(requestToHandle.m_request, response, requestToHandle.m_clientInfo);
+                break;
+            case DISCONNECT_REQUEST:
+                HandleNewDisconnectRequest(requestToHandle.m_request, response);
+                break;
+            case SUBSCRIBE_REQUEST:
+                HandleNewSubscribeRequest(requestToHandle.m_request, response);
+                break;
+            case UNSUBSCRIBE_REQUEST:
+                HandleNewUnsubscribeRequest(requestToHandle.m_request, response);
+                break;
+            case EVENT_REQUEST:
+                isPublishingBlocked = !HandleNewEventRequest(requestToHandle.m_request, response);
+                break;
+            }
+        }
+        catch(...)
+        {
+            response.m_status = infra::tcpserver_details::DO_NOTHING; // A failure of one request should not drop the rest of the connection's requests
+        }
+
+        if(isPublishingBlocked) // The request stays deferred - its connection is paused and parked, and this worker is free for the other connections
+        {
+            response.m_status = infra::tcpserver_details::DEFER_RESPONSE_AND_PAUSE_READING;
+            m_thisHub->m_tcpServerDrivers[m_reactorIndex]->PostResponse(requestToHandle.m_clientInfo, response);
+            m_connectionRequests->Restore(std::move(requestToHandle));
+            m_thisHub->ParkPublishingRequestsWork(RequestsWork(*this));
+            return;
+        }
+
+        m_thisHub->m_tcpServerDrivers[m_reactorIndex]->PostResponse(requestToHandle.m_clientInfo, response); // Also completes a DO_NOTHING response - it releases the connection's reading
+    }
+}
+
+
+void Hub::RequestsWork::HandleNewConnectRequest(const SmartBuildingRequest& a_connectRequest, infra::tcpserver_details::Response& a_response, std::pair<infra::tcpserver_details::ClientID,std::shared_ptr<infra::TCPSocket>> a_deviceClientInfo)
+{
+    std::string deviceID = a_connectRequest.RequestSenderID().ToString();
     std::string responseMessage;
 
     if(!IsExistInSystem(deviceID))
@@ -115,8 +446,29 @@ void Hub::OnClientMessageHandler::HandleNewConnectRequest(std::shared_ptr<SmartB
     }
     else
     {
-        m_thisHub->m_socketsManager->Insert(deviceID, a_deviceSocket);
-        responseMessage = "{ response: connected successfully }";
+        std::shared_ptr<infra::OutboundQueue> deviceOutput = m_thisHub->m_tcpServerDrivers[m_reactorIndex]->OutboundQueueOf(a_deviceClientInfo); // Owned by the connection's reactor
+        ConnectionHandle connection = deviceOutput ? m_thisHub->m_socketsManager->Insert(deviceID, deviceOutput) : INVALID_CONNECTION_HANDLE;
+        if(!deviceOutput)
+        {
+            responseMessage = "{ response: device is not connected error }"; // The connection has closed meanwhile (the response is dropped with it)
+        }
+        else if(connection == INVALID_CONNECTION_HANDLE)
+        {
+            responseMessage = "{ response: too many connected devices error }";
+        }
+        else
+        {
+            m_thisHub->m_agentsManager->FindByID(deviceID)->SetConnection(connection, deviceOutput); // Won't be nullptr (checked before)
+            if(m_connectionRequests->AttachDevice(deviceID, connection)) // Detached by the connection's close handler
+            {
+                responseMessage = "{ response: connected successfully }";
+            }
+            else // The connection has closed meanwhile - its close handler did not know the device yet
+            {
+                m_thisHub->DetachDevice(deviceID, connection);
+                responseMessage = "{ response: device is not connected error }";
+            }
+        }
     }
 
     // Response:
@@ -125,9 +477,9 @@ void Hub::OnClientMessageHandler::HandleNewConnectRequest(std::shared_ptr<SmartB
 }
 
 
-void Hub::OnClientMessageHandler::HandleNewDisconnectRequest(std::shared_ptr<SmartBuildingDisconnectRequest> a_disconnectRequest, infra::tcpserver_details::Response& a_response)
+void Hub::RequestsWork::HandleNewDisconnectRequest(const SmartBuildingRequest& a_disconnectRequest, infra::tcpserver_details::Response& a_response)
 {
-    std::string deviceID = a_disconnectRequest->RequestSenderID();
+    std::string deviceID = a_disconnectRequest.RequestSenderID().ToString();
     std::string responseMessage;
 
     if(!IsExistInSystem(deviceID))
@@ -142,6 +494,7 @@ void Hub::OnClientMessageHandler::HandleNewDisconnectRequest(std::shared_ptr<Sma
         }
         else
         {
+            m_thisHub->m_agentsManager->FindByID(deviceID)->SetConnection(INVALID_CONNECTION_HANDLE, nullptr); // First - the agent stops addressing the released connection
             m_thisHub->m_socketsManager->Remove(deviceID);
             responseMessage = "{ response: disconnected successfully }";
         }
@@ -154,9 +507,9 @@ void Hub::OnClientMessageHandler::HandleNewDisconnectRequest(std::shared_ptr<Sma
 
 
 // TODO: DRY - extract most of the code of subscribe and unsubscribe to a separated method, and execute the needed operation after choosing between subscribe/unsubscribe
-void Hub::OnClientMessageHandler::HandleNewSubscribeRequest(std::shared_ptr<SmartBuildingSubscribeRequest> a_subscribeRequest, infra::tcpserver_details::Response& a_response)
+void Hub::RequestsWork::HandleNewSubscribeRequest(const SmartBuildingRequest& a_subscribeRequest, infra::tcpserver_details::Response& a_response)
 {
-    std::string deviceID = a_subscribeRequest->RequestSenderID();
+    std::string deviceID = a_subscribeRequest.RequestSenderID().ToString();
     std::string responseMessage;
 
     if(!IsExistInSystem(deviceID))
@@ -179,7 +532,7 @@ void Hub::OnClientMessageHandler::HandleNewSubscribeRequest(std::shared_ptr<Smar
             }
             else // If is indeed a subscriber
             {
-                m_thisHub->m_subscribersOrganizer->Subscribe(deviceAsSubscriber, a_subscribeRequest->InterestedEventType(), a_subscribeRequest->SubscriptionLoc());
+                m_thisHub->m_subscribersOrganizer->Subscribe(deviceAsSubscriber, a_subscribeRequest.EventType().ToString(), a_subscribeRequest.SubscriptionLoc());
                 responseMessage = "{ response: subscribed successfully }";
             }
         }
@@ -191,9 +544,9 @@ void Hub::OnClientMessageHandler::HandleNewSubscribeRequest(std::shared_ptr<Smar
 }
 
 
-void Hub::OnClientMessageHandler::HandleNewUnsubscribeRequest(std::shared_ptr<SmartBuildingUnsubscribeRequest> a_unsubscribeRequest, infra::tcpserver_details::Response& a_response)
+void Hub::RequestsWork::HandleNewUnsubscribeRequest(const SmartBuildingRequest& a_unsubscribeRequest, infra::tcpserver_details::Response& a_response)
 {
-    std::string deviceID = a_unsubscribeRequest->RequestSenderID();
+    std::string deviceID = a_unsubscribeRequest.RequestSenderID().ToString();
     std::string responseMessage;
 
     if(!IsExistInSystem(deviceID))
@@ -216,7 +569,7 @@ void Hub::OnClientMessageHandler::HandleNewUnsubscribeRequest(std::shared_ptr<Sm
             }
             else // If is indeed a subscriber
             {
-                m_thisHub->m_subscribersOrganizer->Unsubscribe(deviceAsSubscriber, a_unsubscribeRequest->SubscribedEventType());
+                m_thisHub->m_subscribersOrganizer->Unsubscribe(deviceAsSubscriber, a_unsubscribeRequest.EventType().ToString());
                 responseMessage = "{ response: unsubscribed successfully }";
             }
         }
@@ -228,9 +581,9 @@ void Hub::OnClientMessageHandler::HandleNewUnsubscribeRequest(std::shared_ptr<Sm
 }
 
 
-void Hub::OnClientMessageHandler::HandleNewEventRequest(std::shared_ptr<SmartBuildingEventRequest> a_eventRequest, infra::tcpserver_details::Response& a_response)
+bool Hub::RequestsWork::HandleNewEventRequest(const SmartBuildingRequest& a_eventRequest, infra::tcpserver_details::Response& a_response)
 {
-    std::string deviceID = a_eventRequest->RequestSenderID();
+    std::string deviceID = a_eventRequest.RequestSenderID().ToString();
     std::string responseMessage;
 
     if(!IsExistInSystem(deviceID))
@@ -253,7 +606,11 @@ void Hub::OnClientMessageHandler::HandleNewEventRequest(std::shared_ptr<SmartBui
             }
             else // If is indeed a publisher
             {
-                deviceAsPublisher->Publish(a_eventRequest->EventDataBuffer(), m_thisHub->m_publishedEventsQueue);
+                if(!deviceAsPublisher->Publish(a_eventRequest.EventDataBuffer(), m_thisHub->m_publishedEventsQueue))
+                {
+                    return false;
+                }
+                m_thisHub->TransmitPublishedEvents(); // Every publish is followed by a routing work - no published event is left in the queue
                 responseMessage = "{ response: published event successfully }";
             }
         }
@@ -262,16 +619,18 @@ void Hub::OnClientMessageHandler::HandleNewEventRequest(std::shared_ptr<SmartBui
     // Response:
     a_response.m_status = infra::tcpserver_details::SEND_MESSAGE;
     a_response.m_message = infra::tcpserver_details::Message(reinterpret_cast<const unsigned char*>(responseMessage.c_str()), responseMessage.size());
+
+    return true;
 }
 
 
-bool Hub::OnClientMessageHandler::IsExistInSystem(const std::string& a_deviceID)
+bool Hub::RequestsWork::IsExistInSystem(const std::string& a_deviceID)
 {
     return m_thisHub->m_agentsManager->FindByID(a_deviceID) != nullptr;
 }
 
 
-bool Hub::OnClientMessageHandler::IsConnected(const std::string& a_deviceID)
+bool Hub::RequestsWork::IsConnected(const std::string& a_deviceID)
 {
     return m_thisHub->m_socketsManager->Find(a_deviceID) != nullptr;
 }
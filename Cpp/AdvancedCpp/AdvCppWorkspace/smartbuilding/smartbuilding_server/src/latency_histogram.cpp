@@ -0,0 +1,150 @@
+#include "latency_histogram.hpp"
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <vector> // std::vector
+#include <chrono> // std::chrono::nanoseconds
+#include <algorithm> // std::min
+#include "atomic_value.hpp"
+
+
+advcpp::HistogramSnapshot::HistogramSnapshot()
+: m_buckets()
+, m_count(0)
+, m_sum(0)
+, m_max(0)
+{
+}
+
+
+void advcpp::HistogramSnapshot::Merge(const HistogramSnapshot& a_other)
+{
+    if(m_buckets.size() < a_other.m_buckets.size())
+    {
+        m_buckets.resize(a_other.m_buckets.size(), 0);
+    }
+
+    for(size_t i = 0; i < a_other.m_buckets.size(); ++i)
+    {
+        m_buckets[i] += a_other.m_buckets[i];
+    }
+    m_count += a_other.m_count;
+    m_sum += a_other.m_sum;
+    m_max = std::max(m_max, a_other.m_max);
+}
+
+
+size_t advcpp::HistogramSnapshot::Count() const
+{
+    return m_count;
+}
+
+
+std::chrono::nanoseconds advcpp::HistogramSnapshot::Max() const
+{
+    return std::chrono::nanoseconds(m_max);
+}
+
+
+std::chrono::nanoseconds advcpp::HistogramSnapshot::Mean() const
+{
+    return std::chrono::nanoseconds(m_count ? m_sum / m_count : 0);
+}
+
+
+std::chrono::nanoseconds advcpp::HistogramSnapshot::Percentile(double a_percentile) const
+{
+    size_t bucketsTotal = 0;
+    for(size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        bucketsTotal += m_buckets[i];
+    }
+    if(!bucketsTotal)
+    {
+        return std::chrono::nanoseconds(0);
+    }
+
+    // The rank of the wanted value (1-based), the buckets are counted separately from m_count - a snapshot may see a record partially
+    double wantedRank = a_percentile / 100.0 * bucketsTotal;
+    size_t rank = std::max(static_cast<size_t>(wantedRank + 0.5), static_cast<size_t>(1));
+    size_t seen = 0;
+    for(size_t i = 0; i < m_buckets.size(); ++i)
+    {
+        seen += m_buckets[i];
+        if(seen >= rank)
+        {
+            return std::chrono::nanoseconds(std::min(LatencyHistogram::HighestValueOf(i), m_max));
+        }
+    }
+
+    return std::chrono::nanoseconds(m_max);
+}
+
+
+advcpp::LatencyHistogram::LatencyHistogram()
+: m_buckets()
+, m_count(0)
+, m_sum(0)
+, m_max(0)
+{
+}
+
+
+void advcpp::LatencyHistogram::Record(std::chrono::nanoseconds a_latency)
+{
+    uint64_t value = a_latency.count() > 0 ? static_cast<uint64_t>(a_latency.count()) : 0;
+
+    ++m_buckets[BucketOf(value)];
+    ++m_count;
+    m_sum += value;
+
+    uint64_t currentMax = m_max.Get();
+    while(value > currentMax && !m_max.SetIf(currentMax, value))
+    {
+        currentMax = m_max.Get();
+    }
+}
+
+
+advcpp::HistogramSnapshot advcpp::LatencyHistogram::Snapshot() const
+{
+    HistogramSnapshot snapshot;
+    snapshot.m_buckets.reserve(BUCKETS_COUNT);
+    for(size_t i = 0; i < BUCKETS_COUNT; ++i)
+    {
+        snapshot.m_buckets.push_back(m_buckets[i].Get());
+    }
+    snapshot.m_count = m_count.Get();
+    snapshot.m_sum = m_sum.Get();
+    snapshot.m_max = m_max.Get();
+
+    return snapshot;
+}
+
+
+size_t advcpp::LatencyHistogram::BucketOf(uint64_t a_value)
+{
+    if(a_value < EXACT_VALUES_COUNT)
+    {
+        return static_cast<size_t>(a_value);
+    }
+
+    size_t exponent = 63 - __builtin_clzll(a_value); // The highest set bit - at least SUB_BUCKET_BITS + 1
+    size_t subBucket = static_cast<size_t>(a_value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS_COUNT - 1);
+
+    return EXACT_VALUES_COUNT + (exponent - SUB_BUCKET_BITS - 1) * SUB_BUCKETS_COUNT + subBucket;
+}
+
+
+uint64_t advcpp::LatencyHistogram::HighestValueOf(size_t a_bucket)
+{
+    if(a_bucket < EXACT_VALUES_COUNT)
+    {
+        return a_bucket;
+    }
+
+    size_t exponent = (a_bucket - EXACT_VALUES_COUNT) / SUB_BUCKETS_COUNT + SUB_BUCKET_BITS + 1;
+    uint64_t subBucket = (a_bucket - EXACT_VALUES_COUNT) % SUB_BUCKETS_COUNT;
+    uint64_t bucketWidth = static_cast<uint64_t>(1) << (exponent - SUB_BUCKET_BITS);
+
+    return ((SUB_BUCKETS_COUNT + subBucket) << (exponent - SUB_BUCKET_BITS)) + bucketWidth - 1;
+}
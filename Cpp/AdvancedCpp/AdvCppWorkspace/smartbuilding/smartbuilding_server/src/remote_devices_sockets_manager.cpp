@@ -1,28 +1,143 @@
 #include "remote_devices_sockets_manager.hpp"
+#include <cstddef> // size_t
 #include <string> // std::string
-#include <memory> // std::shared_ptr
+#include <memory> // std::shared_ptr, std::atomic_load, std::atomic_store
 #include <unordered_map>
-#include "tcp_socket.hpp"
+#include <functional> // std::hash
+#include <mutex> // std::mutex, std::lock_guard
+#include <stdint.h> // uint32_t
+#include "outbound_queue.hpp"
+#include "connection_handle.hpp"
 
 
-void smartbuilding::RemoteDevicesSocketsManager::Insert(const std::string& a_idAsKey, std::shared_ptr<infra::TCPSocket> a_socketAsValue)
+smartbuilding::RemoteDevicesSocketsManager::RemoteDevicesSocketsManager(size_t a_maxConnections)
+: m_shards()
+, m_slotsCount(a_maxConnections < SLOT_INDEX_MASK ? a_maxConnections : static_cast<size_t>(SLOT_INDEX_MASK))
+, m_slots(new Slot[m_slotsCount])
+, m_freeSlotsLock()
+, m_freeSlots()
 {
-    m_devicesIDsToSocketsTable.insert({a_idAsKey, a_socketAsValue});
+    m_freeSlots.reserve(m_slotsCount);
+    for(size_t i = m_slotsCount; i > 0; --i)
+    {
+        m_freeSlots.push_back(static_cast<uint32_t>(i - 1)); // The low slots are used first
+    }
+}
+
+
+smartbuilding::ConnectionHandle smartbuilding::RemoteDevicesSocketsManager::Insert(const std::string& a_idAsKey, std::shared_ptr<infra::OutboundQueue> a_outputAsValue)
+{
+    Shard& shard = ShardOf(a_idAsKey);
+    std::lock_guard<std::mutex> guard(shard.m_lock);
+    ConnectionHandle handle = AcquireSlot(a_outputAsValue);
+    if(handle == INVALID_CONNECTION_HANDLE)
+    {
+        return INVALID_CONNECTION_HANDLE;
+    }
+
+    auto insertResult = shard.m_devicesIDsToHandles.insert({a_idAsKey, handle});
+    if(!insertResult.second) // Connected again - the previous connection is released
+    {
+        ReleaseSlot(insertResult.first->second);
+        insertResult.first->second = handle;
+    }
+
+    return handle;
 }
 
 
 void smartbuilding::RemoteDevicesSocketsManager::Remove(const std::string& a_idAsKey)
 {
-    m_devicesIDsToSocketsTable.erase(a_idAsKey);
+    Shard& shard = ShardOf(a_idAsKey);
+    std::lock_guard<std::mutex> guard(shard.m_lock);
+    auto handleItr = shard.m_devicesIDsToHandles.find(a_idAsKey);
+    if(handleItr != shard.m_devicesIDsToHandles.end())
+    {
+        ReleaseSlot(handleItr->second);
+        shard.m_devicesIDsToHandles.erase(handleItr);
+    }
+}
+
+
+void smartbuilding::RemoteDevicesSocketsManager::Remove(const std::string& a_idAsKey, ConnectionHandle a_handle)
+{
+    Shard& shard = ShardOf(a_idAsKey);
+    std::lock_guard<std::mutex> guard(shard.m_lock);
+    auto handleItr = shard.m_devicesIDsToHandles.find(a_idAsKey);
+    if(handleItr != shard.m_devicesIDsToHandles.end() && handleItr->second == a_handle)
+    {
+        ReleaseSlot(handleItr->second);
+        shard.m_devicesIDsToHandles.erase(handleItr);
+    }
 }
 
 
-std::shared_ptr<infra::TCPSocket> smartbuilding::RemoteDevicesSocketsManager::Find(const std::string& a_idAsKey)
+std::shared_ptr<infra::OutboundQueue> smartbuilding::RemoteDevicesSocketsManager::Find(const std::string& a_idAsKey)
 {
-    if(m_devicesIDsToSocketsTable.find(a_idAsKey) == m_devicesIDsToSocketsTable.end())
+    Shard& shard = ShardOf(a_idAsKey);
+    std::lock_guard<std::mutex> guard(shard.m_lock);
+    auto handleItr = shard.m_devicesIDsToHandles.find(a_idAsKey);
+    if(handleItr == shard.m_devicesIDsToHandles.end())
     {
         return nullptr;
     }
 
-    return m_devicesIDsToSocketsTable[a_idAsKey];
+    return Find(handleItr->second);
+}
+
+
+std::shared_ptr<infra::OutboundQueue> smartbuilding::RemoteDevicesSocketsManager::Find(ConnectionHandle a_handle) const
+{
+    size_t slotIndex = static_cast<size_t>(a_handle & SLOT_INDEX_MASK);
+    if(a_handle == INVALID_CONNECTION_HANDLE || slotIndex >= m_slotsCount)
+    {
+        return nullptr;
+    }
+
+    const Slot& slot = m_slots[slotIndex];
+    std::shared_ptr<infra::OutboundQueue> output = std::atomic_load(&slot.m_output);
+    if(slot.m_generation.load() != static_cast<uint32_t>(a_handle >> GENERATION_SHIFT)) // Checked after the output was loaded - a reused slot has advanced its generation before its new output was stored
+    {
+        return nullptr;
+    }
+
+    return output;
+}
+
+
+smartbuilding::RemoteDevicesSocketsManager::Shard& smartbuilding::RemoteDevicesSocketsManager::ShardOf(const std::string& a_idAsKey)
+{
+    return m_shards[std::hash<std::string>()(a_idAsKey) & (SHARDS_COUNT - 1)];
+}
+
+
+smartbuilding::ConnectionHandle smartbuilding::RemoteDevicesSocketsManager::AcquireSlot(std::shared_ptr<infra::OutboundQueue> a_output)
+{
+    uint32_t slotIndex = 0;
+    {
+        std::lock_guard<std::mutex> guard(m_freeSlotsLock);
+        if(m_freeSlots.empty())
+        {
+            return INVALID_CONNECTION_HANDLE;
+        }
+        slotIndex = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+
+    Slot& slot = m_slots[slotIndex];
+    std::atomic_store(&slot.m_output, a_output);
+
+    return (static_cast<ConnectionHandle>(slot.m_generation.load()) << GENERATION_SHIFT) | slotIndex;
+}
+
+
+void smartbuilding::RemoteDevicesSocketsManager::ReleaseSlot(ConnectionHandle a_handle)
+{
+    uint32_t slotIndex = static_cast<uint32_t>(a_handle & SLOT_INDEX_MASK);
+    Slot& slot = m_slots[slotIndex];
+    slot.m_generation.fetch_add(1); // First - a reader that loads the next device's output would not match this handle's generation
+    std::atomic_store(&slot.m_output, std::shared_ptr<infra::OutboundQueue>());
+
+    std::lock_guard<std::mutex> guard(m_freeSlotsLock);
+    m_freeSlots.push_back(slotIndex);
 }
@@ -0,0 +1,45 @@
+#include "so_modules_cache.hpp"
+#include <string> // std::string
+#include <memory> // std::unique_ptr
+#include <mutex> // std::mutex, std::lock_guard
+#include <unordered_map>
+#include "so_loader.hpp"
+
+
+namespace smartbuilding
+{
+
+SoModulesCache& SoModulesCache::Instance()
+{
+    static SoModulesCache* cache = new SoModulesCache(); // Leaked on purpose - see the header
+
+    return *cache;
+}
+
+
+SoModulesCache::SoModulesCache()
+: m_lock()
+, m_modules()
+{
+}
+
+
+void* SoModulesCache::FetchSymbol(const std::string& a_module, const std::string& a_function)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    Module& module = m_modules[a_module];
+    if(!module.m_loader) // First use of the module (or its previous loading has failed)
+    {
+        module.m_loader.reset(new SoLoader(a_module));
+    }
+
+    auto symbolItr = module.m_symbols.find(a_function);
+    if(symbolItr == module.m_symbols.end()) // Key has not found
+    {
+        symbolItr = module.m_symbols.emplace(a_function, module.m_loader->Fetch<void*>(a_function)).first;
+    }
+
+    return symbolItr->second;
+}
+
+} // smartbuilding
@@ -1,12 +1,16 @@
 #include "software_agents_factory.hpp"
+#include <cstddef> // size_t
 #include <string> // std::string
 #include <memory> // std::shared_ptr
-#include <fstream> // std::ifstream
-#include <algorithm> // std::for_each
+#include <vector> // std::vector
+#include <thread> // std::thread::hardware_concurrency()
+#include <algorithm> // std::min
 #include "ini.h"
 #include "software_agents_manager.hpp"
-#include "so_loader.hpp"
+#include "so_modules_cache.hpp"
 #include "serialized_object.hpp"
+#include "thread_pool.hpp"
+#include "thread_pool_destruction_policies.hpp"
 
 
 smartbuilding::SoftwareAgentsFactory::SoftwareAgentsFactory(std::shared_ptr<SoftwareAgentsManager> a_agentsCollection, std::shared_ptr<SafeLoggersManager> a_loggersManager, std::shared_ptr<IConfigReader> a_configReader)
@@ -21,18 +25,63 @@ void smartbuilding::SoftwareAgentsFactory::CreateAgents(const std::string& a_con
 {
     // Read config file:
     smartbuilding::IConfigReader::SerializedObjectCollection serializedObjects = m_configReader->ReadConfig(a_configFileName);
-    std::for_each(serializedObjects.begin(), serializedObjects.end(),[&](const SerializedObject& a_serializedObject)
+    size_t agentsCount = serializedObjects.size();
+
+    // Fetch the factories and the loggers (cheap lookups after the first object of each .so / log file):
+    std::vector<AgentFactory> factories(agentsCount, nullptr);
+    std::vector<std::shared_ptr<ILogger>> loggers(agentsCount);
+    for(size_t i = 0; i < agentsCount; ++i)
     {
         try
         {
-            SoLoader dynLib(a_serializedObject.m_soName);
-            AgentFactory makeAgent = dynLib.Fetch<AgentFactory>("MakeAgent");
-            std::shared_ptr<SoftwareAgent> newAgent = std::shared_ptr<SoftwareAgent>((*makeAgent)(a_serializedObject.m_id, a_serializedObject.m_type, a_serializedObject.m_room, a_serializedObject.m_floor, a_serializedObject.m_configurations, m_loggersManager->GetLogger(a_serializedObject.m_logFileName)));
-            m_agentsCollection->Add(newAgent);
+            factories[i] = SoModulesCache::Instance().Fetch<AgentFactory>(serializedObjects[i].m_soName, "MakeAgent");
+            loggers[i] = m_loggersManager->GetLogger(serializedObjects[i].m_logFileName);
+        }
+        catch(...) // For exception safety - the agent is not made
+        {
+            factories[i] = nullptr;
+        }
+    }
+
+    // Make the agents in parallel - each work makes its own range of agents:
+    std::vector<std::shared_ptr<SoftwareAgent>> agents(agentsCount);
+    size_t worksCount = (agentsCount + AGENTS_PER_WORK - 1) / AGENTS_PER_WORK;
+    if(worksCount > 0)
+    {
+        size_t workersCount = std::min<size_t>(worksCount, std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1);
+        advcpp::ThreadPool<advcpp::ShutdownPolicy<>> makingWorkers(advcpp::ShutdownPolicy<>(), worksCount, workersCount);
+        for(size_t begin = 0; begin < agentsCount; begin += AGENTS_PER_WORK)
+        {
+            size_t end = std::min<size_t>(begin + AGENTS_PER_WORK, agentsCount);
+            makingWorkers.SubmitWork([&serializedObjects, &factories, &loggers, &agents, begin, end]()
+            {
+                for(size_t i = begin; i < end; ++i)
+                {
+                    if(!factories[i])
+                    {
+                        continue;
+                    }
+
+                    try
+                    {
+                        const SerializedObject& serializedObject = serializedObjects[i];
+                        agents[i] = std::shared_ptr<SoftwareAgent>((*factories[i])(serializedObject.m_id, serializedObject.m_type, serializedObject.m_room, serializedObject.m_floor, serializedObject.m_configurations, loggers[i]));
+                    }
+                    catch(...) // For exception safety
+                    {
+                        // Do nothing
+                    }
+                }
+            });
         }
-        catch(...) // For exception safety
+        makingWorkers.Shutdown(); // Blocks until the last agent has been made
+    }
+
+    for(const std::shared_ptr<SoftwareAgent>& agent : agents)
+    {
+        if(agent)
         {
-            // Do nothing
+            m_agentsCollection->Add(agent);
         }
-    });
+    }
 }
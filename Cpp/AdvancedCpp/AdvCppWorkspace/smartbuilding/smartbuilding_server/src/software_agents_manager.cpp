@@ -22,12 +22,13 @@ void SoftwareAgentsManager::RemoveByID(const std::string& a_id)
 
 std::shared_ptr<SoftwareAgent> SoftwareAgentsManager::FindByID(const std::string& a_id)
 {
-    if(m_agentsTable.find(a_id) == m_agentsTable.end()) // Key has not found
+    auto agentItr = m_agentsTable.find(a_id);
+    if(agentItr == m_agentsTable.end()) // Key has not found
     {
         return nullptr;
     }
 
-    return m_agentsTable[a_id];
+    return agentItr->second; // Not operator[] - a lookup never modifies the table, so all the hub's reactors can look up concurrently
 }
 
 } // smartbuilding
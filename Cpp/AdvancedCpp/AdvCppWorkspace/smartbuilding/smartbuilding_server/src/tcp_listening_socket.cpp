@@ -25,11 +25,12 @@ static void ChangeToNoBlockingSocket(int a_socketID)
 }
 
 
-infra::TCPListeningSocket::TCPListeningSocket(unsigned int a_listeningPortNumber, bool a_isNoBlockingRequired)
+infra::TCPListeningSocket::TCPListeningSocket(unsigned int a_listeningPortNumber, bool a_isNoBlockingRequired, bool a_isPortSharingRequired)
 : TCPSocket("0.0.0.0" , a_listeningPortNumber) // 0.0.0.0 => listening to any ip address
-, m_lastAcceptedClientSocketID(-1)
 , m_lastAcceptedClientSocket(nullptr)
+, m_lastAcceptedClientSocketID(-1)
 , m_isNoBlockingRequired(a_isNoBlockingRequired)
+, m_isPortSharingRequired(a_isPortSharingRequired)
 {
     Configure();
 }
@@ -87,6 +88,15 @@ void infra::TCPListeningSocket::SetSocketReuseOption()
     {
         throw std::runtime_error("Failed to set socket reuse option...");
     }
+
+    if(m_isPortSharingRequired)
+    {
+        statusResult = setsockopt(GetSelfSocketID(), SOL_SOCKET, SO_REUSEPORT, &optionValue, sizeof(optionValue));
+        if(statusResult < 0)
+        {
+            throw std::runtime_error("Failed to set socket port sharing option...");
+        }
+    }
 }
 
 
@@ -118,9 +128,8 @@ void infra::TCPListeningSocket::Listen(unsigned int a_connectionsWaitingQueueSiz
 
 infra::TCPSocket::BytesBufferProxy infra::TCPListeningSocket::Receive(size_t a_bytesToReceive)
 {
-    unsigned char* buffer = new unsigned char[a_bytesToReceive];
-    size_t receivedBytes = recv(GetSocketIDToReceiveTheMessageFrom(), static_cast<void*>(buffer), a_bytesToReceive, 0);
-    size_t sizeOfBufferToAllocate;
+    BytesBufferProxy bufferProxy;
+    size_t receivedBytes = ReceiveInto(GetSocketIDToReceiveTheMessageFrom(), a_bytesToReceive, bufferProxy); // Received directly into a pooled buffer of {receivedBytes} size
 
     if(receivedBytes == size_t(-1)) // Representation of max size_t value
     {
@@ -134,15 +143,8 @@ infra::TCPSocket::BytesBufferProxy infra::TCPListeningSocket::Receive(size_t a_b
             throw std::runtime_error("Failed to receive a message...");
         }
 
-        sizeOfBufferToAllocate = 0; // Just no block -> empty buffer (allocation of new[0] is allowed, and MUST be delete[] as well!)
+        // Just no block -> empty buffer
     }
-    else
-    {
-        sizeOfBufferToAllocate = receivedBytes; // creating the buffer only of {receivedBytes} size
-    }
-
-    BytesBufferProxy bufferProxy(buffer, sizeOfBufferToAllocate);
-    delete[] buffer;
 
     return bufferProxy;
 }
@@ -0,0 +1,142 @@
+#include "tcp_server_framing_policies.hpp"
+#include <cstddef> // size_t
+#include <vector> // std::vector
+#include <string.h> // memchr
+#include "tcp_socket.hpp"
+
+
+infra::InputBuffer::InputBuffer()
+: m_bytes()
+, m_consumedBytes(0)
+, m_framingState(0)
+{
+}
+
+
+void infra::InputBuffer::Append(const unsigned char* a_bytes, size_t a_bytesCount)
+{
+    if(m_consumedBytes > 0 && m_consumedBytes >= m_bytes.size() / 2) // Reuse the consumed space, instead of growing - moves less than the consumed bytes
+    {
+        m_bytes.erase(m_bytes.begin(), m_bytes.begin() + m_consumedBytes);
+        m_consumedBytes = 0;
+    }
+
+    m_bytes.insert(m_bytes.end(), a_bytes, a_bytes + a_bytesCount);
+}
+
+
+void infra::InputBuffer::Consume(size_t a_bytesCount)
+{
+    m_consumedBytes += a_bytesCount;
+    if(m_consumedBytes == m_bytes.size()) // All consumed - the capacity is kept for the next bytes
+    {
+        m_bytes.clear();
+        m_consumedBytes = 0;
+    }
+}
+
+
+const unsigned char* infra::InputBuffer::Data() const
+{
+    return m_bytes.data() + m_consumedBytes;
+}
+
+
+size_t infra::InputBuffer::Size() const
+{
+    return m_bytes.size() - m_consumedBytes;
+}
+
+
+int infra::InputBuffer::FramingState() const
+{
+    return m_framingState;
+}
+
+
+void infra::InputBuffer::SetFramingState(int a_framingState)
+{
+    m_framingState = a_framingState;
+}
+
+
+
+infra::FrameStatus infra::RawFramingPolicy::ExtractFrame(InputBuffer& a_input, TCPSocket::BytesBufferProxy& a_frame) const
+{
+    if(a_input.Size() == 0)
+    {
+        return FRAME_INCOMPLETE;
+    }
+
+    a_frame = TCPSocket::BytesBufferProxy(a_input.Data(), a_input.Size());
+    a_input.Consume(a_input.Size());
+
+    return FRAME_COMPLETE;
+}
+
+
+
+infra::LengthPrefixedFramingPolicy::LengthPrefixedFramingPolicy(size_t a_maxFrameSize)
+: m_maxFrameSize(a_maxFrameSize)
+{
+}
+
+
+infra::FrameStatus infra::LengthPrefixedFramingPolicy::ExtractFrame(InputBuffer& a_input, TCPSocket::BytesBufferProxy& a_frame) const
+{
+    if(a_input.Size() < LENGTH_PREFIX_SIZE)
+    {
+        return FRAME_INCOMPLETE;
+    }
+
+    const unsigned char* prefix = a_input.Data();
+    size_t frameSize = (static_cast<size_t>(prefix[0]) << 24) | (static_cast<size_t>(prefix[1]) << 16) | (static_cast<size_t>(prefix[2]) << 8) | static_cast<size_t>(prefix[3]);
+    if(frameSize > m_maxFrameSize)
+    {
+        return FRAME_MALFORMED;
+    }
+
+    if(a_input.Size() < LENGTH_PREFIX_SIZE + frameSize)
+    {
+        return FRAME_INCOMPLETE;
+    }
+
+    a_frame = TCPSocket::BytesBufferProxy(a_input.Data() + LENGTH_PREFIX_SIZE, frameSize);
+    a_input.Consume(LENGTH_PREFIX_SIZE + frameSize);
+
+    return FRAME_COMPLETE;
+}
+
+
+
+infra::DelimiterFramingPolicy::DelimiterFramingPolicy(unsigned char a_delimiter, size_t a_maxFrameSize)
+: m_delimiter(a_delimiter)
+, m_maxFrameSize(a_maxFrameSize)
+{
+}
+
+
+infra::FrameStatus infra::DelimiterFramingPolicy::ExtractFrame(InputBuffer& a_input, TCPSocket::BytesBufferProxy& a_frame) const
+{
+    if(a_input.Size() == 0)
+    {
+        return FRAME_INCOMPLETE;
+    }
+
+    const unsigned char* frameEnd = static_cast<const unsigned char*>(memchr(a_input.Data(), m_delimiter, a_input.Size()));
+    if(!frameEnd)
+    {
+        return a_input.Size() > m_maxFrameSize ? FRAME_MALFORMED : FRAME_INCOMPLETE;
+    }
+
+    size_t frameSize = static_cast<size_t>(frameEnd - a_input.Data());
+    if(frameSize > m_maxFrameSize)
+    {
+        return FRAME_MALFORMED;
+    }
+
+    a_frame = TCPSocket::BytesBufferProxy(a_input.Data(), frameSize);
+    a_input.Consume(frameSize + 1); // With the delimiter
+
+    return FRAME_COMPLETE;
+}
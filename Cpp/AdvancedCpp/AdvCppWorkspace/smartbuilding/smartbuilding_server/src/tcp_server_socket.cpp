@@ -2,8 +2,8 @@
 #include "tcp_listening_socket.hpp"
 
 
-infra::TCPServerSocket::TCPServerSocket(unsigned int a_listeningPortNumber, bool a_isNoBlockingRequired)
-: TCPListeningSocket(a_listeningPortNumber, a_isNoBlockingRequired)
+infra::TCPServerSocket::TCPServerSocket(unsigned int a_listeningPortNumber, bool a_isNoBlockingRequired, bool a_isPortSharingRequired)
+: TCPListeningSocket(a_listeningPortNumber, a_isNoBlockingRequired, a_isPortSharingRequired)
 , m_clientIDToSendMessageTo(-1)
 , m_clientIDToReceiveMessageFrom(-1)
 {
@@ -0,0 +1,152 @@
+#include "thread_pool_metrics_policies.hpp"
+#include <cstddef> // size_t
+#include <memory> // std::unique_ptr
+#include <chrono> // std::chrono::steady_clock, std::chrono::duration_cast, std::chrono::microseconds
+#include <ostream> // std::ostream
+#include <utility> // std::move
+#include "task.hpp"
+#include "latency_histogram.hpp"
+#include "atomic_value.hpp"
+
+
+namespace
+{
+
+void PrintHistogram(std::ostream& a_os, const char* a_name, const advcpp::HistogramSnapshot& a_histogram)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    a_os << ' ' << a_name << "[p50=" << duration_cast<microseconds>(a_histogram.Percentile(50)).count()
+         << "us p99=" << duration_cast<microseconds>(a_histogram.Percentile(99)).count()
+         << "us max=" << duration_cast<microseconds>(a_histogram.Max()).count() << "us]";
+}
+
+} // anonymous namespace
+
+
+advcpp::ThreadPoolMetricsSnapshot::ThreadPoolMetricsSnapshot()
+: m_isEnabled(false)
+, m_workers(0)
+, m_pendingWorks(0)
+, m_submittedWorks(0)
+, m_executedWorks(0)
+, m_stolenWorks(0)
+, m_queueWait()
+, m_runTime()
+, m_enqueueTime()
+{
+}
+
+
+std::ostream& advcpp::operator<<(std::ostream& a_os, const ThreadPoolMetricsSnapshot& a_snapshot)
+{
+    a_os << "workers=" << a_snapshot.m_workers << " pending=" << a_snapshot.m_pendingWorks;
+    if(!a_snapshot.m_isEnabled)
+    {
+        return a_os << " (metrics disabled)";
+    }
+
+    a_os << " submitted=" << a_snapshot.m_submittedWorks << " executed=" << a_snapshot.m_executedWorks << " stolen=" << a_snapshot.m_stolenWorks;
+    PrintHistogram(a_os, "wait", a_snapshot.m_queueWait);
+    PrintHistogram(a_os, "run", a_snapshot.m_runTime);
+    PrintHistogram(a_os, "enqueue", a_snapshot.m_enqueueTime);
+
+    return a_os;
+}
+
+
+advcpp::HdrMetricsPolicy::HdrMetricsPolicy()
+: m_shards(new Shard[SHARDS_COUNT])
+{
+}
+
+
+advcpp::HdrMetricsPolicy::Stamp advcpp::HdrMetricsPolicy::Now() const
+{
+    return std::chrono::steady_clock::now();
+}
+
+
+advcpp::HdrMetricsPolicy::Instrumented advcpp::HdrMetricsPolicy::Instrument(Task& a_work, Stamp a_submitted)
+{
+    if(!a_work) // Nothing to measure
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<Task> originalWork(new Task(std::move(a_work)));
+    Task* instrumented = originalWork.get();
+    a_work = Task(InstrumentedWork(std::move(originalWork), a_submitted, this));
+    ++CurrentShard().m_submittedWorks;
+
+    return instrumented;
+}
+
+
+void advcpp::HdrMetricsPolicy::Restore(Task& a_work, Instrumented a_instrumented)
+{
+    if(!a_instrumented)
+    {
+        return;
+    }
+
+    Task originalWork(std::move(*a_instrumented)); // Out of the instrumented work - before it is destroyed by the assignment
+    a_work = std::move(originalWork);
+    --CurrentShard().m_submittedWorks; // Might be another shard than the one that counted it up - only the sum is meaningful
+}
+
+
+void advcpp::HdrMetricsPolicy::EnqueueCompleted(Stamp a_submitted)
+{
+    CurrentShard().m_enqueueTime.Record(std::chrono::steady_clock::now() - a_submitted);
+}
+
+
+void advcpp::HdrMetricsPolicy::Fill(ThreadPoolMetricsSnapshot& a_snapshot) const
+{
+    a_snapshot.m_isEnabled = true;
+    for(size_t i = 0; i < SHARDS_COUNT; ++i)
+    {
+        a_snapshot.m_submittedWorks += m_shards[i].m_submittedWorks.Get();
+        a_snapshot.m_queueWait.Merge(m_shards[i].m_queueWait.Snapshot());
+        a_snapshot.m_runTime.Merge(m_shards[i].m_runTime.Snapshot());
+        a_snapshot.m_enqueueTime.Merge(m_shards[i].m_enqueueTime.Snapshot());
+    }
+    a_snapshot.m_executedWorks = a_snapshot.m_runTime.Count();
+}
+
+
+advcpp::HdrMetricsPolicy::Shard& advcpp::HdrMetricsPolicy::CurrentShard()
+{
+    static AtomicValue<size_t> s_nextShard(0);
+    static thread_local size_t s_shard = s_nextShard++ % SHARDS_COUNT; // Round-robin between the threads - the pool's workers get different shards
+
+    return m_shards[s_shard];
+}
+
+
+advcpp::HdrMetricsPolicy::InstrumentedWork::InstrumentedWork(std::unique_ptr<Task> a_work, Stamp a_submitted, HdrMetricsPolicy* a_metrics)
+: m_work(std::move(a_work))
+, m_submitted(a_submitted)
+, m_metrics(a_metrics)
+{
+}
+
+
+void advcpp::HdrMetricsPolicy::InstrumentedWork::operator()()
+{
+    Stamp started = std::chrono::steady_clock::now();
+    Shard& shard = m_metrics->CurrentShard();
+    shard.m_queueWait.Record(started - m_submitted);
+    try
+    {
+        (*m_work)();
+    }
+    catch(...)
+    {
+        shard.m_runTime.Record(std::chrono::steady_clock::now() - started);
+        throw;
+    }
+    shard.m_runTime.Record(std::chrono::steady_clock::now() - started);
+}
@@ -0,0 +1,35 @@
+#include "workers_activity.hpp"
+#include <cstddef> // size_t
+#include "atomic_value.hpp"
+
+
+advcpp::WorkersActivity::WorkersActivity()
+: m_busyWorkers(0)
+, m_completedWorks(0)
+{
+}
+
+
+void advcpp::WorkersActivity::WorkStarted()
+{
+    ++m_busyWorkers;
+}
+
+
+void advcpp::WorkersActivity::WorkCompleted()
+{
+    ++m_completedWorks;
+    --m_busyWorkers;
+}
+
+
+size_t advcpp::WorkersActivity::BusyWorkers() const
+{
+    return m_busyWorkers.Get();
+}
+
+
+size_t advcpp::WorkersActivity::CompletedWorks() const
+{
+    return m_completedWorks.Get();
+}
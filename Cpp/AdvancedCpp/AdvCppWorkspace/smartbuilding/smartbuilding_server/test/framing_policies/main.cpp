@@ -0,0 +1,217 @@
+#include "mu_test.h"
+#include <cstddef> // size_t
+#include <string> // std::string
+#include <vector> // std::vector
+#include "tcp_server_framing_policies.hpp"
+#include "tcp_socket.hpp"
+
+
+using namespace infra;
+
+
+static const unsigned char SELECTOR_BYTE = 0xB5;
+static const size_t SMALL_MAX_FRAME_SIZE = 16;
+static const size_t MANY_FRAMES_COUNT = 1000;
+
+
+static void Append(InputBuffer& a_input, const std::string& a_bytes)
+{
+    a_input.Append(reinterpret_cast<const unsigned char*>(a_bytes.data()), a_bytes.size());
+}
+
+
+static std::string LengthPrefixed(const std::string& a_payload)
+{
+    size_t size = a_payload.size();
+    std::string prefix;
+    prefix += static_cast<char>((size >> 24) & 0xFF);
+    prefix += static_cast<char>((size >> 16) & 0xFF);
+    prefix += static_cast<char>((size >> 8) & 0xFF);
+    prefix += static_cast<char>(size & 0xFF);
+
+    return prefix + a_payload;
+}
+
+
+// Extracts the frames until the policy stops completing them - returns the status that stopped it
+template <typename FramingPolicy>
+static FrameStatus ExtractAll(const FramingPolicy& a_framing, InputBuffer& a_input, std::vector<std::string>& a_frames)
+{
+    TCPSocket::BytesBufferProxy frame;
+    FrameStatus status = a_framing.ExtractFrame(a_input, frame);
+    while(status == FRAME_COMPLETE)
+    {
+        a_frames.push_back(std::string(reinterpret_cast<const char*>(frame.ToBytes()), frame.Size()));
+        status = a_framing.ExtractFrame(a_input, frame);
+    }
+
+    return status;
+}
+
+
+BEGIN_TEST(raw_framing_whole_input_is_a_frame_check)
+    RawFramingPolicy framing;
+    InputBuffer input;
+    std::vector<std::string> frames;
+
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE);
+    Append(input, "C&id1");
+    Append(input, "S&id1");
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE);
+    ASSERT_EQUAL(frames.size(), 1);
+    ASSERT_EQUAL(frames[0], "C&id1S&id1");
+    ASSERT_EQUAL(input.Size(), 0);
+END_TEST
+
+
+BEGIN_TEST(length_prefixed_split_frame_check)
+    LengthPrefixedFramingPolicy framing;
+    InputBuffer input;
+    std::vector<std::string> frames;
+    std::string wire = LengthPrefixed("split payload");
+
+    for(size_t i = 0; i + 1 < wire.size(); ++i) // Byte by byte - also the prefix is split
+    {
+        Append(input, wire.substr(i, 1));
+        ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE);
+    }
+    ASSERT_THAT(frames.empty());
+
+    Append(input, wire.substr(wire.size() - 1));
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE);
+    ASSERT_EQUAL(frames.size(), 1);
+    ASSERT_EQUAL(frames[0], "split payload");
+    ASSERT_EQUAL(input.Size(), 0);
+END_TEST
+
+
+BEGIN_TEST(length_prefixed_many_frames_per_read_check)
+    LengthPrefixedFramingPolicy framing;
+    InputBuffer input;
+    std::vector<std::string> frames;
+    std::string wire;
+    for(size_t i = 0; i < MANY_FRAMES_COUNT; ++i)
+    {
+        wire += LengthPrefixed(std::to_string(i));
+    }
+    wire += LengthPrefixed("partial").substr(0, 6); // A frame that continues in the next read
+
+    Append(input, wire);
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE);
+    ASSERT_EQUAL(frames.size(), MANY_FRAMES_COUNT);
+    for(size_t i = 0; i < MANY_FRAMES_COUNT; ++i)
+    {
+        ASSERT_EQUAL(frames[i], std::to_string(i));
+    }
+
+    Append(input, LengthPrefixed("partial").substr(6) + LengthPrefixed(""));
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE);
+    ASSERT_EQUAL(frames.size(), MANY_FRAMES_COUNT + 2);
+    ASSERT_EQUAL(frames[MANY_FRAMES_COUNT], "partial");
+    ASSERT_THAT(frames[MANY_FRAMES_COUNT + 1].empty());
+END_TEST
+
+
+BEGIN_TEST(length_prefixed_oversize_prefix_check)
+    LengthPrefixedFramingPolicy framing(SMALL_MAX_FRAME_SIZE);
+    InputBuffer input;
+    std::vector<std::string> frames;
+
+    Append(input, LengthPrefixed(std::string(SMALL_MAX_FRAME_SIZE, 'x')));
+    Append(input, LengthPrefixed(std::string(SMALL_MAX_FRAME_SIZE + 1, 'y')).substr(0, 4)); // Malformed by its prefix - before its payload arrives
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_MALFORMED);
+    ASSERT_EQUAL(frames.size(), 1);
+    ASSERT_EQUAL(frames[0], std::string(SMALL_MAX_FRAME_SIZE, 'x'));
+
+    InputBuffer textInput;
+    Append(textInput, "C&id1"); // A text request is read as a huge length
+    ASSERT_EQUAL(ExtractAll(framing, textInput, frames), FRAME_MALFORMED);
+END_TEST
+
+
+BEGIN_TEST(delimiter_split_and_coalesced_frames_check)
+    DelimiterFramingPolicy framing;
+    InputBuffer input;
+    std::vector<std::string> frames;
+
+    Append(input, "C&id1\nS&id1&1,2&0&fire\nE&i");
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE);
+    ASSERT_EQUAL(frames.size(), 2);
+    ASSERT_EQUAL(frames[0], "C&id1");
+    ASSERT_EQUAL(frames[1], "S&id1&1,2&0&fire");
+
+    Append(input, "d1&data");
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE);
+    Append(input, "\n\n");
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE);
+    ASSERT_EQUAL(frames.size(), 4);
+    ASSERT_EQUAL(frames[2], "E&id1&data");
+    ASSERT_THAT(frames[3].empty());
+END_TEST
+
+
+BEGIN_TEST(delimiter_missing_delimiter_check)
+    DelimiterFramingPolicy framing('\n', SMALL_MAX_FRAME_SIZE);
+    InputBuffer input;
+    std::vector<std::string> frames;
+
+    Append(input, std::string(SMALL_MAX_FRAME_SIZE, 'x'));
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE); // Might still end by the next byte
+    Append(input, "x");
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_MALFORMED);
+
+    InputBuffer longFrameInput;
+    Append(longFrameInput, std::string(SMALL_MAX_FRAME_SIZE + 1, 'y') + "\n");
+    ASSERT_EQUAL(ExtractAll(framing, longFrameInput, frames), FRAME_MALFORMED);
+    ASSERT_THAT(frames.empty());
+END_TEST
+
+
+BEGIN_TEST(first_byte_selected_framing_by_selector_check)
+    FirstByteSelectedFramingPolicy<SELECTOR_BYTE,LengthPrefixedFramingPolicy,DelimiterFramingPolicy> framing; // As the hub's framing
+    InputBuffer input;
+    std::vector<std::string> frames;
+
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE); // Nothing to select by yet
+    Append(input, std::string(1, static_cast<char>(SELECTOR_BYTE))); // The selector alone in its read
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE);
+    ASSERT_EQUAL(input.Size(), 0);
+
+    std::string binaryRequest = std::string(1, static_cast<char>(SELECTOR_BYTE)) + "binary request"; // Starts by the selector too - it is kept in the frame
+    Append(input, LengthPrefixed(binaryRequest) + LengthPrefixed("second"));
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE);
+    ASSERT_EQUAL(frames.size(), 2);
+    ASSERT_EQUAL(frames[0], binaryRequest);
+    ASSERT_EQUAL(frames[1], "second");
+END_TEST
+
+
+BEGIN_TEST(first_byte_selected_framing_by_other_byte_check)
+    FirstByteSelectedFramingPolicy<SELECTOR_BYTE,LengthPrefixedFramingPolicy,DelimiterFramingPolicy> framing; // As the hub's framing
+    InputBuffer input;
+    std::vector<std::string> frames;
+
+    Append(input, "C&id1\nS&id1&0&0&fi"); // A text request per line - coalesced and split by the reads
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE);
+    ASSERT_EQUAL(frames.size(), 1);
+    Append(input, "re\n" + std::string(1, static_cast<char>(SELECTOR_BYTE)) + "&not a selector\n"); // Only the first byte of the connection selects
+    ASSERT_EQUAL(ExtractAll(framing, input, frames), FRAME_INCOMPLETE);
+    ASSERT_EQUAL(frames.size(), 3);
+    ASSERT_EQUAL(frames[0], "C&id1");
+    ASSERT_EQUAL(frames[1], "S&id1&0&0&fire");
+    ASSERT_EQUAL(frames[2], std::string(1, static_cast<char>(SELECTOR_BYTE)) + "&not a selector");
+END_TEST
+
+
+BEGIN_SUITE(FramingPoliciesTests)
+
+    TEST(raw_framing_whole_input_is_a_frame_check)
+    TEST(length_prefixed_split_frame_check)
+    TEST(length_prefixed_many_frames_per_read_check)
+    TEST(length_prefixed_oversize_prefix_check)
+    TEST(delimiter_split_and_coalesced_frames_check)
+    TEST(delimiter_missing_delimiter_check)
+    TEST(first_byte_selected_framing_by_selector_check)
+    TEST(first_byte_selected_framing_by_other_byte_check)
+
+END_SUITE
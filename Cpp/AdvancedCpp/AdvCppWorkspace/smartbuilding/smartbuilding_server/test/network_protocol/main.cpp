@@ -0,0 +1,294 @@
+#include "mu_test.h"
+#include <cstddef> // size_t
+#include <string> // std::string
+#include <vector> // std::vector
+#include <memory> // std::unique_ptr
+#include "smartbuilding_network_protocol.hpp"
+#include "smartbuilding_request.hpp"
+#include "subscription_location.hpp"
+#include "tcp_socket.hpp"
+
+
+using namespace smartbuilding;
+
+
+static std::unique_ptr<SmartBuildingNetworkProtocol> g_protocol = SmartBuildingNetworkProtocol::GetNetworkProtocol(); // A singleton - initialized once for all the tests
+
+
+static infra::TCPSocket::BytesBufferProxy ToBuffer(const std::string& a_bytes)
+{
+    return infra::TCPSocket::BytesBufferProxy(reinterpret_cast<const unsigned char*>(a_bytes.data()), a_bytes.size());
+}
+
+
+static bool Parse(const std::string& a_bytes, SmartBuildingRequest& a_request, infra::TCPSocket::BytesBufferProxy& a_buffer)
+{
+    a_buffer = ToBuffer(a_bytes); // The request views its bytes
+    return g_protocol->Parse(a_buffer, a_request);
+}
+
+
+static bool IsParsed(const std::string& a_bytes)
+{
+    SmartBuildingRequest request;
+    infra::TCPSocket::BytesBufferProxy buffer;
+    return Parse(a_bytes, request, buffer);
+}
+
+
+static std::string Varint(unsigned int a_number)
+{
+    std::string bytes;
+    while(a_number >= 0x80)
+    {
+        bytes += static_cast<char>((a_number & 0x7F) | 0x80);
+        a_number >>= 7;
+    }
+    bytes += static_cast<char>(a_number);
+
+    return bytes;
+}
+
+
+static std::string Field(const std::string& a_field)
+{
+    return Varint(static_cast<unsigned int>(a_field.size())) + a_field;
+}
+
+
+static std::string Binary(char a_requestType, const std::string& a_deviceID, const std::string& a_additionalData = std::string())
+{
+    std::string bytes;
+    bytes += static_cast<char>(SmartBuildingNetworkProtocol::BINARY_FORMAT_MAGIC);
+    bytes += static_cast<char>(SmartBuildingNetworkProtocol::BINARY_FORMAT_VERSION);
+    bytes += a_requestType;
+
+    return bytes + Field(a_deviceID) + a_additionalData;
+}
+
+
+static std::string NumbersList(const std::vector<unsigned int>& a_numbers)
+{
+    std::string bytes = Varint(static_cast<unsigned int>(a_numbers.size()));
+    for(size_t i = 0; i < a_numbers.size(); ++i)
+    {
+        bytes += Varint(a_numbers[i]);
+    }
+
+    return bytes;
+}
+
+
+static std::string ToString(const infra::TCPSocket::BytesBufferProxy& a_buffer)
+{
+    return std::string(reinterpret_cast<const char*>(a_buffer.ToBytes()), a_buffer.Size());
+}
+
+
+BEGIN_TEST(text_connect_and_disconnect_requests_check)
+    SmartBuildingRequest request;
+    infra::TCPSocket::BytesBufferProxy buffer;
+
+    ASSERT_THAT(Parse("C&sensor-17", request, buffer));
+    ASSERT_EQUAL(request.Type(), CONNECT_REQUEST);
+    ASSERT_EQUAL(request.RequestSenderID().ToString(), "sensor-17");
+
+    ASSERT_THAT(Parse("D&sensor-17", request, buffer));
+    ASSERT_EQUAL(request.Type(), DISCONNECT_REQUEST);
+    ASSERT_EQUAL(request.RequestSenderID().ToString(), "sensor-17");
+END_TEST
+
+
+BEGIN_TEST(text_subscribe_request_check)
+    SmartBuildingRequest request;
+    infra::TCPSocket::BytesBufferProxy buffer;
+
+    ASSERT_THAT(Parse("S&controller-3&1,22,333&4,5&fire", request, buffer));
+    ASSERT_EQUAL(request.Type(), SUBSCRIBE_REQUEST);
+    ASSERT_EQUAL(request.RequestSenderID().ToString(), "controller-3");
+    ASSERT_EQUAL(request.EventType().ToString(), "fire");
+
+    SubscriptionLocation location = request.SubscriptionLoc();
+    ASSERT_THAT(!location.IsAllRooms() && !location.IsAllFloors());
+    ASSERT_THAT(location.SpecifiedRooms() == std::vector<unsigned int>({1, 22, 333}));
+    ASSERT_THAT(location.SpecifiedFloors() == std::vector<unsigned int>({4, 5}));
+END_TEST
+
+
+BEGIN_TEST(text_subscribe_all_lists_check)
+    SmartBuildingRequest request;
+    infra::TCPSocket::BytesBufferProxy buffer;
+
+    ASSERT_THAT(Parse("S&controller-3&0&0&fire", request, buffer));
+    ASSERT_THAT(request.SubscriptionLoc().IsAllRooms() && request.SubscriptionLoc().IsAllFloors());
+
+    ASSERT_THAT(Parse("S&controller-3&0&7&fire", request, buffer));
+    ASSERT_THAT(request.SubscriptionLoc().IsAllRooms() && !request.SubscriptionLoc().IsAllFloors());
+
+    ASSERT_THAT(Parse("S&controller-3&0,1&7&fire", request, buffer)); // 0 indicates all the rooms only without any additional commas
+    ASSERT_THAT(!request.SubscriptionLoc().IsAllRooms());
+    ASSERT_THAT(request.SubscriptionLoc().SpecifiedRooms() == std::vector<unsigned int>({0, 1}));
+END_TEST
+
+
+BEGIN_TEST(text_unsubscribe_and_event_requests_check)
+    SmartBuildingRequest request;
+    infra::TCPSocket::BytesBufferProxy buffer;
+
+    ASSERT_THAT(Parse("U&controller-3&fire", request, buffer));
+    ASSERT_EQUAL(request.Type(), UNSUBSCRIBE_REQUEST);
+    ASSERT_EQUAL(request.RequestSenderID().ToString(), "controller-3");
+    ASSERT_EQUAL(request.EventType().ToString(), "fire");
+
+    ASSERT_THAT(Parse("E&sensor-17&fire|2|14|on", request, buffer));
+    ASSERT_EQUAL(request.Type(), EVENT_REQUEST);
+    ASSERT_EQUAL(request.RequestSenderID().ToString(), "sensor-17");
+    ASSERT_EQUAL(ToString(request.EventDataBuffer()), "fire|2|14|on");
+    ASSERT_THAT(request.EventType().Size() == 0); // Cleared from the previous request
+END_TEST
+
+
+BEGIN_TEST(text_malformed_requests_check)
+    ASSERT_THAT(!IsParsed(""));
+    ASSERT_THAT(!IsParsed("X&sensor-17"));
+    ASSERT_THAT(!IsParsed("C"));
+    ASSERT_THAT(!IsParsed("S&controller-3&1&2")); // No event type
+    ASSERT_THAT(!IsParsed("U&controller-3"));
+    ASSERT_THAT(!IsParsed("E&sensor-17"));
+END_TEST
+
+
+BEGIN_TEST(text_malformed_decimal_lists_check)
+    ASSERT_THAT(!IsParsed("S&controller-3&&1&fire")); // Empty list
+    ASSERT_THAT(!IsParsed("S&controller-3&1,,2&1&fire"));
+    ASSERT_THAT(!IsParsed("S&controller-3&1,&1&fire"));
+    ASSERT_THAT(!IsParsed("S&controller-3&,1&1&fire"));
+    ASSERT_THAT(!IsParsed("S&controller-3&1;2&1&fire"));
+    ASSERT_THAT(!IsParsed("S&controller-3&-1&1&fire"));
+    ASSERT_THAT(!IsParsed("S&controller-3&1 &1&fire"));
+    ASSERT_THAT(!IsParsed("S&controller-3&1&a&fire"));
+    ASSERT_THAT(!IsParsed("S&controller-3&1234567890&1&fire")); // Might overflow
+    ASSERT_THAT(IsParsed("S&controller-3&123456789&1&fire"));
+END_TEST
+
+
+BEGIN_TEST(binary_connect_and_disconnect_requests_check)
+    SmartBuildingRequest request;
+    infra::TCPSocket::BytesBufferProxy buffer;
+
+    ASSERT_THAT(Parse(Binary('C', "sensor-17"), request, buffer));
+    ASSERT_EQUAL(request.Type(), CONNECT_REQUEST);
+    ASSERT_EQUAL(request.RequestSenderID().ToString(), "sensor-17");
+
+    ASSERT_THAT(Parse(Binary('D', "sensor&17"), request, buffer)); // The binary fields may hold any byte
+    ASSERT_EQUAL(request.Type(), DISCONNECT_REQUEST);
+    ASSERT_EQUAL(request.RequestSenderID().ToString(), "sensor&17");
+END_TEST
+
+
+BEGIN_TEST(binary_subscribe_request_check)
+    SmartBuildingRequest request;
+    infra::TCPSocket::BytesBufferProxy buffer;
+
+    ASSERT_THAT(Parse(Binary('S', "controller-3", NumbersList({1, 200, 70000}) + NumbersList({4}) + Field("fire")), request, buffer));
+    ASSERT_EQUAL(request.Type(), SUBSCRIBE_REQUEST);
+    ASSERT_EQUAL(request.RequestSenderID().ToString(), "controller-3");
+    ASSERT_EQUAL(request.EventType().ToString(), "fire");
+
+    SubscriptionLocation location = request.SubscriptionLoc();
+    ASSERT_THAT(!location.IsAllRooms() && !location.IsAllFloors());
+    ASSERT_THAT(location.SpecifiedRooms() == std::vector<unsigned int>({1, 200, 70000}));
+    ASSERT_THAT(location.SpecifiedFloors() == std::vector<unsigned int>({4}));
+END_TEST
+
+
+BEGIN_TEST(binary_subscribe_all_lists_check)
+    SmartBuildingRequest request;
+    infra::TCPSocket::BytesBufferProxy buffer;
+
+    ASSERT_THAT(Parse(Binary('S', "controller-3", NumbersList({}) + NumbersList({}) + Field("fire")), request, buffer));
+    SubscriptionLocation location = request.SubscriptionLoc();
+    ASSERT_THAT(location.IsAllRooms() && location.IsAllFloors());
+    ASSERT_THAT(location.SpecifiedRooms().empty() && location.SpecifiedFloors().empty());
+
+    ASSERT_THAT(Parse(Binary('S', "controller-3", NumbersList({}) + NumbersList({0}) + Field("fire")), request, buffer)); // Only a count of 0 indicates all
+    ASSERT_THAT(request.SubscriptionLoc().IsAllRooms() && !request.SubscriptionLoc().IsAllFloors());
+    ASSERT_THAT(request.SubscriptionLoc().SpecifiedFloors() == std::vector<unsigned int>({0}));
+END_TEST
+
+
+BEGIN_TEST(binary_unsubscribe_and_event_requests_check)
+    SmartBuildingRequest request;
+    infra::TCPSocket::BytesBufferProxy buffer;
+
+    ASSERT_THAT(Parse(Binary('U', "controller-3", Field("fire")), request, buffer));
+    ASSERT_EQUAL(request.Type(), UNSUBSCRIBE_REQUEST);
+    ASSERT_EQUAL(request.EventType().ToString(), "fire");
+
+    std::string eventData("fire&2\0|on", 10);
+    ASSERT_THAT(Parse(Binary('E', "sensor-17", eventData), request, buffer));
+    ASSERT_EQUAL(request.Type(), EVENT_REQUEST);
+    ASSERT_EQUAL(request.RequestSenderID().ToString(), "sensor-17");
+    ASSERT_THAT(ToString(request.EventDataBuffer()) == eventData); // All the rest of the buffer
+
+    ASSERT_THAT(Parse(Binary('E', "sensor-17"), request, buffer));
+    ASSERT_EQUAL(request.EventDataBuffer().Size(), 0);
+END_TEST
+
+
+BEGIN_TEST(binary_malformed_header_check)
+    std::string connect = Binary('C', "sensor-17");
+
+    ASSERT_THAT(!IsParsed(connect.substr(0, 1)));
+    ASSERT_THAT(!IsParsed(connect.substr(0, 2)));
+    ASSERT_THAT(!IsParsed(connect.substr(0, 3))); // No device ID length
+    std::string wrongVersion = connect;
+    wrongVersion[1] = static_cast<char>(SmartBuildingNetworkProtocol::BINARY_FORMAT_VERSION + 1);
+    ASSERT_THAT(!IsParsed(wrongVersion));
+    ASSERT_THAT(!IsParsed(Binary('X', "sensor-17")));
+END_TEST
+
+
+BEGIN_TEST(binary_truncated_varints_check)
+    std::string header = Binary('C', "").substr(0, 3);
+    std::string truncated("\x80", 1);
+
+    ASSERT_THAT(!IsParsed(header + truncated)); // The device ID length
+    ASSERT_THAT(!IsParsed(header + std::string("\xFF\xFF\xFF\xFF\xFF\x01", 6))); // Longer than 32 bits
+    ASSERT_THAT(!IsParsed(Binary('S', "controller-3", truncated))); // The rooms count
+    ASSERT_THAT(!IsParsed(Binary('S', "controller-3", Varint(2) + Varint(1) + truncated))); // A room
+    ASSERT_THAT(!IsParsed(Binary('S', "controller-3", NumbersList({1}) + Varint(1) + std::string("\x81\x81", 2)))); // A floor
+    ASSERT_THAT(!IsParsed(Binary('S', "controller-3", NumbersList({1}) + NumbersList({1}) + truncated))); // The event type length
+    ASSERT_THAT(!IsParsed(Binary('U', "controller-3", truncated)));
+END_TEST
+
+
+BEGIN_TEST(binary_oversize_field_lengths_check)
+    std::string header = Binary('C', "").substr(0, 3);
+
+    ASSERT_THAT(!IsParsed(header + Varint(10) + "sensor"));
+    ASSERT_THAT(!IsParsed(header + Varint(0xFFFFFFFF) + "sensor"));
+    ASSERT_THAT(!IsParsed(Binary('S', "controller-3", NumbersList({}) + NumbersList({}) + Varint(5) + "fire")));
+    ASSERT_THAT(!IsParsed(Binary('S', "controller-3", Varint(3) + Varint(1) + Varint(2) + Field("fire").substr(0, 1)))); // More rooms than the buffer holds
+    ASSERT_THAT(!IsParsed(Binary('U', "controller-3", Varint(100) + "fire")));
+    ASSERT_THAT(IsParsed(header + Varint(6) + "sensor"));
+END_TEST
+
+
+BEGIN_SUITE(NetworkProtocolTests)
+
+    TEST(text_connect_and_disconnect_requests_check)
+    TEST(text_subscribe_request_check)
+    TEST(text_subscribe_all_lists_check)
+    TEST(text_unsubscribe_and_event_requests_check)
+    TEST(text_malformed_requests_check)
+    TEST(text_malformed_decimal_lists_check)
+    TEST(binary_connect_and_disconnect_requests_check)
+    TEST(binary_subscribe_request_check)
+    TEST(binary_subscribe_all_lists_check)
+    TEST(binary_unsubscribe_and_event_requests_check)
+    TEST(binary_malformed_header_check)
+    TEST(binary_truncated_varints_check)
+    TEST(binary_oversize_field_lengths_check)
+
+END_SUITE
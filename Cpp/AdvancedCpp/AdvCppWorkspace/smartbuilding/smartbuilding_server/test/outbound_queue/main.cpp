@@ -0,0 +1,107 @@
+#include "mu_test.h"
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr, std::make_shared
+#include <deque> // std::deque
+#include <vector> // std::vector
+#include <sys/eventfd.h> // eventfd
+#include <unistd.h> // close
+#include "outbound_queue.hpp"
+#include "tcp_socket.hpp"
+
+
+using namespace infra;
+
+
+static const size_t HIGH_WATER_MARK = 64;
+static const size_t MESSAGE_SIZE = 16;
+
+
+// A queue without a connection (its socket only identifies the connection), whose scheduler wakes up an eventfd instead of a reactor
+class QueueFixture
+{
+public:
+    QueueFixture()
+    : m_wakeupID(eventfd(0, EFD_NONBLOCK))
+    , m_queue(std::make_shared<OutboundQueue>(1, std::shared_ptr<TCPSocket>(), std::make_shared<OutboundQueuesScheduler>(m_wakeupID), HIGH_WATER_MARK))
+    {
+    }
+
+    ~QueueFixture()
+    {
+        m_queue->Close();
+        close(m_wakeupID);
+    }
+
+    OutboundQueue& Queue() { return *m_queue; }
+
+private:
+    int m_wakeupID;
+    std::shared_ptr<OutboundQueue> m_queue;
+};
+
+
+static OutboundQueue::Message MakeMessage()
+{
+    std::vector<unsigned char> bytes(MESSAGE_SIZE, 'm');
+    return OutboundQueue::Message(bytes.data(), bytes.size());
+}
+
+
+BEGIN_TEST(outbound_queue_refuses_and_counts_above_high_water_mark_check)
+    QueueFixture fixture;
+    OutboundQueue& queue = fixture.Queue();
+
+    size_t postedCount = 0;
+    while(queue.Post(MakeMessage()))
+    {
+        ++postedCount;
+    }
+    ASSERT_EQUAL(postedCount, HIGH_WATER_MARK / MESSAGE_SIZE);
+    ASSERT_THAT(queue.IsAboveHighWaterMark());
+    ASSERT_EQUAL(queue.DroppedMessagesCount(), 1);
+
+    ASSERT_THAT(!queue.Post(MakeMessage()));
+    ASSERT_EQUAL(queue.DroppedMessagesCount(), 2);
+END_TEST
+
+
+BEGIN_TEST(outbound_queue_close_counts_the_posted_messages_as_dropped_check)
+    QueueFixture fixture;
+    OutboundQueue& queue = fixture.Queue();
+
+    ASSERT_THAT(queue.Post(MakeMessage()));
+    ASSERT_THAT(queue.Post(MakeMessage()));
+    queue.Close();
+
+    ASSERT_EQUAL(queue.DroppedMessagesCount(), 2);
+    ASSERT_EQUAL(queue.QueuedBytes(), 0);
+    ASSERT_THAT(!queue.Post(MakeMessage()));
+    ASSERT_EQUAL(queue.DroppedMessagesCount(), 3);
+END_TEST
+
+
+BEGIN_TEST(outbound_queue_close_keeps_the_taken_bytes_to_the_flush_check)
+    QueueFixture fixture;
+    OutboundQueue& queue = fixture.Queue();
+
+    std::deque<OutboundQueue::Message> output;
+    ASSERT_THAT(queue.Post(MakeMessage()));
+    queue.TakePosted(output); // In the server's output - not dropped by Close
+    ASSERT_THAT(queue.Post(MakeMessage()));
+    queue.Close();
+
+    ASSERT_EQUAL(queue.DroppedMessagesCount(), 1);
+    ASSERT_EQUAL(queue.QueuedBytes(), MESSAGE_SIZE);
+
+    queue.RemoveSentBytes(output.front().Size()); // A flush after the close never underflows the count
+    ASSERT_EQUAL(queue.QueuedBytes(), 0);
+END_TEST
+
+
+BEGIN_SUITE(OutboundQueueTests)
+
+    TEST(outbound_queue_refuses_and_counts_above_high_water_mark_check)
+    TEST(outbound_queue_close_counts_the_posted_messages_as_dropped_check)
+    TEST(outbound_queue_close_keeps_the_taken_bytes_to_the_flush_check)
+
+END_SUITE
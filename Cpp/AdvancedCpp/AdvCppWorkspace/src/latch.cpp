@@ -0,0 +1,74 @@
+#include "latch.hpp"
+#include <mutex> // std::mutex, std::unique_lock, std::lock_guard
+#include <condition_variable> // std::condition_variable
+#include <chrono> // std::chrono::steady_clock
+#include <stdexcept> // std::runtime_error
+#include "atomic_value.hpp"
+
+
+advcpp::Latch::Latch(size_t a_count)
+: m_count(a_count)
+, m_waiters(0)
+, m_mutex()
+, m_reachedZero()
+{
+}
+
+
+void advcpp::Latch::CountUp(size_t a_count)
+{
+    m_count.Add(a_count);
+}
+
+
+void advcpp::Latch::CountDown(size_t a_count)
+{
+    size_t currentCount;
+    do
+    {
+        currentCount = m_count.Get();
+        if(a_count > currentCount)
+        {
+            throw std::runtime_error("Failed while tried to count down a latch below 0");
+        }
+    }
+    while(!m_count.SetIf(currentCount, currentCount - a_count));
+
+    // Both counters are full barriers - either the waiter sees the 0 count, or this thread sees the waiter
+    if(currentCount == a_count && m_waiters.Get() > 0)
+    {
+        std::lock_guard<std::mutex> guard(m_mutex); // The waiter checks the count and waits under this lock - no wake-up is lost
+        m_reachedZero.notify_all();
+    }
+}
+
+
+size_t advcpp::Latch::Count() const
+{
+    return m_count.Get();
+}
+
+
+void advcpp::Latch::Wait()
+{
+    ++m_waiters;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_reachedZero.wait(lock, [this]() { return m_count.Get() == 0; });
+    }
+    --m_waiters;
+}
+
+
+bool advcpp::Latch::WaitUntil(std::chrono::steady_clock::time_point a_deadline)
+{
+    ++m_waiters;
+    bool hasReachedZero;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        hasReachedZero = m_reachedZero.wait_until(lock, a_deadline, [this]() { return m_count.Get() == 0; });
+    }
+    --m_waiters;
+
+    return hasReachedZero;
+}
@@ -1,8 +0,0 @@
-#include "suicide_mission.hpp"
-#include <stdexcept>
-
-
-void advcpp::SuicideMission::operator()()
-{
-    throw std::runtime_error("Kamikaze!!!");
-}
@@ -0,0 +1,59 @@
+#include "thread_budget.hpp"
+#include <cstddef> // size_t
+#include <stdexcept> // std::runtime_error
+#include "atomic_value.hpp"
+
+
+advcpp::ThreadBudget::ThreadBudget(size_t a_capacity)
+: m_available(a_capacity)
+, m_capacity(a_capacity)
+{
+    if(!a_capacity)
+    {
+        throw std::runtime_error("Thread budget capacity cannot be zero");
+    }
+}
+
+
+bool advcpp::ThreadBudget::TryAcquire(size_t a_threads)
+{
+    size_t available;
+    do
+    {
+        available = m_available.Get();
+        if(a_threads > available)
+        {
+            return false;
+        }
+    }
+    while(!m_available.SetIf(available, available - a_threads));
+
+    return true;
+}
+
+
+void advcpp::ThreadBudget::Release(size_t a_threads)
+{
+    size_t available;
+    do
+    {
+        available = m_available.Get();
+        if(available + a_threads > m_capacity)
+        {
+            throw std::runtime_error("Released more threads than were acquired from the thread budget");
+        }
+    }
+    while(!m_available.SetIf(available, available + a_threads));
+}
+
+
+size_t advcpp::ThreadBudget::Available() const
+{
+    return m_available.Get();
+}
+
+
+size_t advcpp::ThreadBudget::Capacity() const
+{
+    return m_capacity;
+}
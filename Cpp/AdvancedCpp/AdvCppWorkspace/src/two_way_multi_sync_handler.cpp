@@ -1,4 +1,8 @@
 #include "two_way_multi_sync_handler.hpp"
+#include <vector> // std::vector
+#include <mutex> // std::mutex, std::lock_guard
+#include <utility> // std::swap
+#include <pthread.h> // pthread_t, pthread_self
 #include "atomic_value.hpp"
 #include "barrier.hpp"
 
@@ -6,6 +10,8 @@
 advcpp::TwoWayMultiSyncHandler::TwoWayMultiSyncHandler()
 : m_firstDirectionNotifications(0)
 , m_secondDirectionSignals(1) // Dummy initialization
+, m_acceptingThreadsLock()
+, m_acceptingThreads()
 {
 }
 
@@ -30,6 +36,10 @@ void advcpp::TwoWayMultiSyncHandler::ResetAllNotifications()
 
 void advcpp::TwoWayMultiSyncHandler::OneNotificationAccept()
 {
+    {
+        std::lock_guard<std::mutex> guard(m_acceptingThreadsLock);
+        m_acceptingThreads.push_back(pthread_self());
+    }
     --m_firstDirectionNotifications;
 }
 
@@ -51,3 +61,13 @@ void advcpp::TwoWayMultiSyncHandler::SetWantedSignalsBack(size_t a_signalsToWait
 {
     m_secondDirectionSignals.Reset(a_signalsToWaitFor + 1); // +1 for the notifier itself
 }
+
+
+std::vector<pthread_t> advcpp::TwoWayMultiSyncHandler::TakeAcceptingThreads()
+{
+    std::vector<pthread_t> acceptingThreads;
+    std::lock_guard<std::mutex> guard(m_acceptingThreadsLock);
+    std::swap(acceptingThreads, m_acceptingThreads);
+
+    return acceptingThreads;
+}
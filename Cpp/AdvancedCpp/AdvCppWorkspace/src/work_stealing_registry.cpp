@@ -0,0 +1,150 @@
+#include "work_stealing_registry.hpp"
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr, std::atomic_load, std::atomic_store
+#include <mutex> // std::mutex, std::lock_guard
+#include <random> // std::minstd_rand
+#include <utility> // std::move
+#include "work_stealing_deque.hpp"
+#include "task.hpp"
+
+
+thread_local advcpp::WorkStealingRegistry* advcpp::WorkStealingRegistry::s_currentRegistry = nullptr;
+thread_local advcpp::WorkStealingRegistry::WorksDeque* advcpp::WorkStealingRegistry::s_currentDeque = nullptr;
+
+
+advcpp::WorkStealingRegistry::WorkStealingRegistry(size_t a_dequeCapacity)
+: m_dequeCapacity(a_dequeCapacity)
+, m_deques(new WorkerDeques())
+, m_registrationLock()
+, m_idleWorkers(0)
+, m_stolenWorks(0)
+{
+}
+
+
+std::shared_ptr<advcpp::WorkStealingRegistry::WorksDeque> advcpp::WorkStealingRegistry::Register()
+{
+    std::lock_guard<std::mutex> guard(m_registrationLock);
+
+    std::shared_ptr<WorksDeque> ownDeque;
+    std::shared_ptr<const WorkerDeques> deques = Snapshot();
+    for(size_t i = 0; i < deques->size() && !ownDeque; ++i)
+    {
+        if(!(*deques)[i]->m_hasOwner) // Adopt the deque of a removed worker (with its remained works)
+        {
+            (*deques)[i]->m_hasOwner = true;
+            ownDeque = (*deques)[i]->m_works;
+        }
+    }
+
+    if(!ownDeque)
+    {
+        std::shared_ptr<WorkerDeque> newDeque(new WorkerDeque(m_dequeCapacity));
+        std::shared_ptr<WorkerDeques> newDeques(new WorkerDeques(*deques));
+        newDeques->push_back(newDeque);
+        std::atomic_store(&m_deques, std::shared_ptr<const WorkerDeques>(newDeques));
+        ownDeque = newDeque->m_works;
+    }
+
+    s_currentRegistry = this;
+    s_currentDeque = ownDeque.get();
+
+    return ownDeque;
+}
+
+
+void advcpp::WorkStealingRegistry::Unregister()
+{
+    std::lock_guard<std::mutex> guard(m_registrationLock);
+
+    std::shared_ptr<const WorkerDeques> deques = Snapshot();
+    for(size_t i = 0; i < deques->size(); ++i)
+    {
+        if((*deques)[i]->m_works.get() == s_currentDeque)
+        {
+            (*deques)[i]->m_hasOwner = false;
+        }
+    }
+
+    s_currentRegistry = nullptr;
+    s_currentDeque = nullptr;
+}
+
+
+bool advcpp::WorkStealingRegistry::Steal(Work& a_stolenWork, std::minstd_rand& a_randomGenerator)
+{
+    std::shared_ptr<const WorkerDeques> deques = Snapshot();
+    size_t dequesCount = deques->size();
+    if(dequesCount == 0)
+    {
+        return false;
+    }
+
+    size_t victim = a_randomGenerator() % dequesCount;
+    for(size_t i = 0; i < dequesCount; ++i, victim = (victim + 1) % dequesCount)
+    {
+        WorksDeque* victimDeque = (*deques)[victim]->m_works.get();
+        if(victimDeque != s_currentDeque && victimDeque->Steal(a_stolenWork))
+        {
+            ++m_stolenWorks;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void advcpp::WorkStealingRegistry::EnterIdle()
+{
+    ++m_idleWorkers;
+}
+
+
+void advcpp::WorkStealingRegistry::ExitIdle()
+{
+    --m_idleWorkers;
+}
+
+
+size_t advcpp::WorkStealingRegistry::IdleWorkersCount() const
+{
+    return m_idleWorkers.Get();
+}
+
+
+bool advcpp::WorkStealingRegistry::PushLocal(Work&& a_work)
+{
+    if(s_currentRegistry != this) // Not a worker of this registry (an external thread, or a worker of another pool)
+    {
+        return false;
+    }
+
+    return s_currentDeque->Push(std::move(a_work));
+}
+
+
+size_t advcpp::WorkStealingRegistry::PendingWorksCount() const
+{
+    std::shared_ptr<const WorkerDeques> deques = Snapshot();
+
+    size_t pendingWorks = 0;
+    for(size_t i = 0; i < deques->size(); ++i)
+    {
+        pendingWorks += (*deques)[i]->m_works->Size();
+    }
+
+    return pendingWorks;
+}
+
+
+size_t advcpp::WorkStealingRegistry::StolenWorksCount() const
+{
+    return m_stolenWorks.Get();
+}
+
+
+std::shared_ptr<const advcpp::WorkStealingRegistry::WorkerDeques> advcpp::WorkStealingRegistry::Snapshot() const
+{
+    return std::atomic_load(&m_deques);
+}
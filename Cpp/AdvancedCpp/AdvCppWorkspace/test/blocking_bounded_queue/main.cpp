@@ -1,6 +1,9 @@
 #include "mu_test.h"
 #include <memory> // std::shared_ptr, std::make_shared
 #include <algorithm> // std::is_sorted
+#include <chrono> // std::chrono::milliseconds
+#include <vector> // std::vector
+#include <iterator> // std::back_inserter
 #include "blocking_bounded_queue.hpp"
 #include "thread.hpp"
 #include "producer_task.hpp"
@@ -236,6 +239,104 @@ BEGIN_TEST(queue_two_consumers_two_producers)
 END_TEST
 
 
+BEGIN_TEST(queue_try_enqueue_check)
+    constexpr size_t N = 3;
+
+    BlockingBoundedQueue<int, ClearPolicy<int>> numbers(N, ClearPolicy<int>());
+    for(size_t i = 0; i < N; ++i)
+    {
+        ASSERT_THAT(numbers.TryEnqueue(i));
+    }
+    ASSERT_THAT(!numbers.TryEnqueue(N));
+    ASSERT_EQUAL(numbers.Size(), N);
+
+    int number;
+    numbers.Dequeue(number);
+    ASSERT_THAT(numbers.TryEnqueue(N));
+END_TEST
+
+
+BEGIN_TEST(queue_enqueue_for_check)
+    constexpr size_t N = 2;
+
+    BlockingBoundedQueue<int, ClearPolicy<int>> numbers(N, ClearPolicy<int>());
+    for(size_t i = 0; i < N; ++i)
+    {
+        ASSERT_THAT(numbers.EnqueueFor(i, std::chrono::milliseconds(50)));
+    }
+    ASSERT_THAT(!numbers.EnqueueFor(N, std::chrono::milliseconds(50)));
+    ASSERT_EQUAL(numbers.Size(), N);
+END_TEST
+
+
+BEGIN_TEST(queue_enqueue_bulk_check)
+    constexpr size_t N = 4;
+
+    BlockingBoundedQueue<int, ClearPolicy<int>> numbers(N, ClearPolicy<int>());
+    std::vector<int> numbersToEnqueue;
+    for(size_t i = 0; i < N; ++i)
+    {
+        numbersToEnqueue.push_back(i);
+    }
+    ASSERT_EQUAL(numbers.EnqueueBulk(numbersToEnqueue.begin(), numbersToEnqueue.end()), N);
+    ASSERT_THAT(numbers.IsFull());
+
+    for(size_t i = 0; i < N; ++i)
+    {
+        int number;
+        numbers.Dequeue(number);
+        ASSERT_EQUAL(number, int(i));
+    }
+END_TEST
+
+
+BEGIN_TEST(queue_try_enqueue_bulk_check)
+    constexpr size_t N = 4;
+
+    BlockingBoundedQueue<int, ClearPolicy<int>> numbers(N, ClearPolicy<int>());
+    numbers.Enqueue(-1);
+    std::vector<int> numbersToEnqueue;
+    for(size_t i = 0; i < N; ++i)
+    {
+        numbersToEnqueue.push_back(i);
+    }
+    ASSERT_EQUAL(numbers.TryEnqueueBulk(numbersToEnqueue.begin(), numbersToEnqueue.end()), N - 1); // Only the free slots - without waiting
+    ASSERT_THAT(numbers.IsFull());
+    ASSERT_EQUAL(numbers.TryEnqueueBulk(numbersToEnqueue.begin(), numbersToEnqueue.end()), 0);
+
+    int number;
+    numbers.Dequeue(number);
+    ASSERT_EQUAL(number, -1);
+    for(size_t i = 0; i < N - 1; ++i)
+    {
+        numbers.Dequeue(number);
+        ASSERT_EQUAL(number, int(i));
+    }
+END_TEST
+
+
+BEGIN_TEST(queue_dequeue_bulk_check)
+    constexpr size_t N = 5;
+    constexpr size_t BATCH_SIZE = 3;
+
+    BlockingBoundedQueue<int, ClearPolicy<int>> numbers(N, ClearPolicy<int>());
+    for(size_t i = 0; i < N; ++i)
+    {
+        numbers.Enqueue(i);
+    }
+
+    std::vector<int> dequeuedNumbers;
+    ASSERT_EQUAL(numbers.DequeueBulk(std::back_inserter(dequeuedNumbers), BATCH_SIZE, std::chrono::milliseconds(50)), BATCH_SIZE);
+    ASSERT_EQUAL(numbers.DequeueBulk(std::back_inserter(dequeuedNumbers), BATCH_SIZE, std::chrono::milliseconds(50)), N - BATCH_SIZE);
+    ASSERT_EQUAL(numbers.DequeueBulk(std::back_inserter(dequeuedNumbers), BATCH_SIZE, std::chrono::milliseconds(50)), 0);
+    ASSERT_EQUAL(dequeuedNumbers.size(), N);
+    ASSERT_THAT(std::is_sorted(dequeuedNumbers.begin(), dequeuedNumbers.end()));
+    ASSERT_THAT(numbers.IsEmpty());
+    ASSERT_EQUAL(numbers.Capacity() - numbers.Size(), N); // All the free slots were released
+    ASSERT_THAT(numbers.TryEnqueue(N));
+END_TEST
+
+
 TEST_SUITE(BlockingBoundedQueueTest)
 
     IGNORE_TEST(queue_assert_policy_check)
@@ -247,6 +348,11 @@ TEST_SUITE(BlockingBoundedQueueTest)
     TEST(queue_size_check)
     TEST(queue_is_full_check)
     TEST(queue_is_empty_check)
+    TEST(queue_try_enqueue_check)
+    TEST(queue_enqueue_for_check)
+    TEST(queue_enqueue_bulk_check)
+    TEST(queue_try_enqueue_bulk_check)
+    TEST(queue_dequeue_bulk_check)
     TEST(queue_one_consumer_one_producer)
     TEST(queue_one_consumer_two_producers)
     TEST(queue_two_consumers_one_producer)
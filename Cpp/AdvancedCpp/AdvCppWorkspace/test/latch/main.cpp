@@ -0,0 +1,80 @@
+#include "mu_test.h"
+#include <thread> // std::thread
+#include <chrono> // std::chrono::steady_clock, std::chrono::milliseconds
+#include <stdexcept> // std::runtime_error
+#include "latch.hpp"
+#include "atomic_value.hpp"
+
+
+using namespace advcpp;
+
+
+BEGIN_TEST(latch_zero_count_check)
+    Latch latch;
+    ASSERT_EQUAL(latch.Count(), 0u);
+
+    latch.Wait(); // Never blocks on a zero count
+    ASSERT_THAT(latch.WaitUntil(std::chrono::steady_clock::now()));
+END_TEST
+
+
+BEGIN_TEST(latch_count_up_and_down_check)
+    Latch latch(2);
+    latch.CountUp(3);
+    ASSERT_EQUAL(latch.Count(), 5u);
+
+    latch.CountDown(4);
+    ASSERT_EQUAL(latch.Count(), 1u);
+    ASSERT_THAT(!latch.WaitUntil(std::chrono::steady_clock::now() + std::chrono::milliseconds(10)));
+
+    bool hasThrown = false;
+    try
+    {
+        latch.CountDown(2);
+    }
+    catch(const std::runtime_error&)
+    {
+        hasThrown = true;
+    }
+    ASSERT_THAT(hasThrown);
+    ASSERT_EQUAL(latch.Count(), 1u);
+END_TEST
+
+
+BEGIN_TEST(latch_wait_for_other_threads_check)
+    constexpr size_t THREADS_N = 8;
+    constexpr size_t COUNTS_PER_THREAD = 1000;
+
+    Latch latch(THREADS_N * COUNTS_PER_THREAD);
+    AtomicValue<size_t> countedDown(0);
+
+    std::thread threads[THREADS_N];
+    for(size_t i = 0; i < THREADS_N; ++i)
+    {
+        threads[i] = std::thread([&latch, &countedDown]()
+        {
+            for(size_t j = 0; j < COUNTS_PER_THREAD; ++j)
+            {
+                ++countedDown;
+                latch.CountDown();
+            }
+        });
+    }
+
+    latch.Wait();
+    ASSERT_EQUAL(countedDown.Get(), THREADS_N * COUNTS_PER_THREAD);
+
+    for(size_t i = 0; i < THREADS_N; ++i)
+    {
+        threads[i].join();
+    }
+END_TEST
+
+
+BEGIN_SUITE(LatchTests)
+
+    TEST(latch_zero_count_check)
+    TEST(latch_count_up_and_down_check)
+    TEST(latch_wait_for_other_threads_check)
+
+END_SUITE
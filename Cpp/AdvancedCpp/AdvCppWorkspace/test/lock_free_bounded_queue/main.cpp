@@ -0,0 +1,231 @@
+#include "mu_test.h"
+#include <memory> // std::shared_ptr, std::make_shared
+#include <vector> // std::vector
+#include <mutex> // std::mutex, std::lock_guard
+#include <algorithm> // std::is_sorted, std::sort
+#include <chrono> // std::chrono::milliseconds
+#include "lock_free_bounded_queue.hpp"
+#include "blocking_bounded_queue_destruction_policies.hpp"
+#include "thread.hpp"
+#include "thread_destruction_policies.hpp"
+#include "icallable.hpp"
+
+
+using namespace advcpp;
+using NumbersQueue = LockFreeBoundedQueue<int, AssertPolicy<int>>;
+
+
+class LockFreeProducerTask : public ICallable
+{
+public:
+    LockFreeProducerTask(std::shared_ptr<NumbersQueue> a_queue, size_t a_maximumNumberOfIterations)
+    : m_queue(a_queue)
+    , m_maximumNumberOfIterations(a_maximumNumberOfIterations)
+    {
+    }
+
+    virtual void operator()() override
+    {
+        for(size_t i = 0; i < m_maximumNumberOfIterations; ++i)
+        {
+            m_queue->Enqueue(i);
+        }
+    }
+
+private:
+    std::shared_ptr<NumbersQueue> m_queue;
+    size_t m_maximumNumberOfIterations;
+};
+
+
+class LockFreeConsumerTask : public ICallable
+{
+public:
+    LockFreeConsumerTask(std::shared_ptr<NumbersQueue> a_queue, size_t a_maximumNumberOfIterations, std::shared_ptr<std::vector<int>> a_resultVector, std::mutex& a_mtx)
+    : m_queue(a_queue)
+    , m_resultVector(a_resultVector)
+    , m_mtx(a_mtx)
+    , m_maximumNumberOfIterations(a_maximumNumberOfIterations)
+    {
+    }
+
+    virtual void operator()() override
+    {
+        for(size_t i = 0; i < m_maximumNumberOfIterations; ++i)
+        {
+            int number;
+            m_queue->Dequeue(number);
+
+            std::lock_guard<std::mutex> guard(m_mtx); // To make a thread-safety (between the consumers), and push into the vector
+            m_resultVector->push_back(number);
+        }
+    }
+
+private:
+    std::shared_ptr<NumbersQueue> m_queue;
+    std::shared_ptr<std::vector<int>> m_resultVector;
+    std::mutex& m_mtx;
+    size_t m_maximumNumberOfIterations;
+};
+
+
+BEGIN_TEST(lock_free_queue_clear_policy_check)
+    constexpr size_t N = 100;
+
+    {
+        LockFreeBoundedQueue<int, ClearPolicy<int>> numbers(N, ClearPolicy<int>());
+        numbers.Enqueue(1);
+        numbers.Enqueue(2);
+        numbers.Enqueue(3);
+    }
+    ASSERT_PASS();
+END_TEST
+
+
+BEGIN_TEST(lock_free_queue_save_policy_check)
+    constexpr size_t N = 100;
+    std::shared_ptr<std::vector<int>> savedNumbers(new std::vector<int>());
+
+    {
+        LockFreeBoundedQueue<int, SavePolicy<int, std::vector<int>>> numbers(N, SavePolicy<int, std::vector<int>>(savedNumbers));
+        numbers.Enqueue(1);
+        numbers.Enqueue(2);
+        numbers.Enqueue(3);
+    }
+    ASSERT_EQUAL(savedNumbers->size(), 3);
+    ASSERT_EQUAL((*savedNumbers)[0], 1);
+    ASSERT_EQUAL((*savedNumbers)[2], 3);
+END_TEST
+
+
+BEGIN_TEST(lock_free_queue_capacity_check)
+    LockFreeBoundedQueue<int, ClearPolicy<int>> numbers(100, ClearPolicy<int>());
+    ASSERT_EQUAL(numbers.Capacity(), 128); // Rounded up to the next power of two
+
+    LockFreeBoundedQueue<int, ClearPolicy<int>> powerOfTwoNumbers(64, ClearPolicy<int>());
+    ASSERT_EQUAL(powerOfTwoNumbers.Capacity(), 64);
+END_TEST
+
+
+BEGIN_TEST(lock_free_queue_fifo_check)
+    constexpr size_t N = 8;
+    LockFreeBoundedQueue<int, ClearPolicy<int>> numbers(N, ClearPolicy<int>());
+
+    for(size_t round = 0; round < 3; ++round) // Wrap around the ring a few times
+    {
+        for(size_t i = 0; i < N; ++i)
+        {
+            ASSERT_THAT(numbers.Enqueue(i));
+        }
+        ASSERT_THAT(numbers.IsFull());
+
+        for(size_t i = 0; i < N; ++i)
+        {
+            int number;
+            ASSERT_THAT(numbers.Dequeue(number));
+            ASSERT_EQUAL(number, int(i));
+        }
+        ASSERT_THAT(numbers.IsEmpty());
+    }
+END_TEST
+
+
+BEGIN_TEST(lock_free_queue_try_enqueue_check)
+    constexpr size_t N = 4;
+
+    LockFreeBoundedQueue<int, ClearPolicy<int>> numbers(N, ClearPolicy<int>());
+    for(size_t i = 0; i < N; ++i)
+    {
+        ASSERT_THAT(numbers.TryEnqueue(i));
+    }
+    ASSERT_THAT(!numbers.TryEnqueue(N));
+    ASSERT_EQUAL(numbers.Size(), N);
+
+    int number;
+    numbers.Dequeue(number);
+    ASSERT_THAT(numbers.TryEnqueue(N));
+END_TEST
+
+
+BEGIN_TEST(lock_free_queue_enqueue_for_check)
+    constexpr size_t N = 2;
+
+    LockFreeBoundedQueue<int, ClearPolicy<int>> numbers(N, ClearPolicy<int>());
+    for(size_t i = 0; i < N; ++i)
+    {
+        ASSERT_THAT(numbers.EnqueueFor(i, std::chrono::milliseconds(50)));
+    }
+    ASSERT_THAT(!numbers.EnqueueFor(N, std::chrono::milliseconds(50)));
+    ASSERT_EQUAL(numbers.Size(), N);
+END_TEST
+
+
+BEGIN_TEST(lock_free_queue_one_consumer_one_producer)
+    constexpr size_t N = 1000000;
+    std::shared_ptr<NumbersQueue> numbers = std::make_shared<NumbersQueue>(64, AssertPolicy<int>());
+    std::shared_ptr<std::vector<int>> resultVector(new std::vector<int>());
+    resultVector->reserve(N);
+    std::mutex lock;
+
+    std::shared_ptr<LockFreeProducerTask> producerTask = std::make_shared<LockFreeProducerTask>(numbers, N);
+    std::shared_ptr<LockFreeConsumerTask> consumerTask = std::make_shared<LockFreeConsumerTask>(numbers, N, resultVector, lock);
+
+    Thread<AssertionPolicy> producer(producerTask, AssertionPolicy());
+    Thread<AssertionPolicy> consumer(consumerTask, AssertionPolicy());
+
+    producer.Join();
+    consumer.Join();
+
+    ASSERT_EQUAL(resultVector->size(), N);
+    ASSERT_THAT(numbers->IsEmpty());
+    ASSERT_THAT(std::is_sorted(resultVector->begin(), resultVector->end()));
+END_TEST
+
+
+BEGIN_TEST(lock_free_queue_two_consumers_two_producers)
+    constexpr size_t N = 1000000;
+    std::shared_ptr<NumbersQueue> numbers = std::make_shared<NumbersQueue>(64, AssertPolicy<int>());
+    std::shared_ptr<std::vector<int>> resultVector(new std::vector<int>());
+    resultVector->reserve(N);
+    std::mutex lock;
+
+    std::shared_ptr<LockFreeProducerTask> producerTask = std::make_shared<LockFreeProducerTask>(numbers, N/2);
+    std::shared_ptr<LockFreeConsumerTask> consumerTask = std::make_shared<LockFreeConsumerTask>(numbers, N/2, resultVector, lock);
+
+    Thread<AssertionPolicy> producer1(producerTask, AssertionPolicy());
+    Thread<AssertionPolicy> producer2(producerTask, AssertionPolicy());
+    Thread<AssertionPolicy> consumer1(consumerTask, AssertionPolicy());
+    Thread<AssertionPolicy> consumer2(consumerTask, AssertionPolicy());
+
+    producer1.Join();
+    producer2.Join();
+    consumer1.Join();
+    consumer2.Join();
+
+    ASSERT_EQUAL(resultVector->size(), N);
+    ASSERT_THAT(numbers->IsEmpty());
+
+    std::sort(resultVector->begin(), resultVector->end()); // Each number (0...N/2-1) must be received exactly twice
+    for(size_t i = 0; i < N; ++i)
+    {
+        if((*resultVector)[i] != int(i / 2))
+        {
+            ASSERT_FAIL("Lost or duplicated item");
+        }
+    }
+    ASSERT_PASS();
+END_TEST
+
+
+TEST_SUITE(LockFreeBoundedQueueTest)
+
+    TEST(lock_free_queue_clear_policy_check)
+    TEST(lock_free_queue_save_policy_check)
+    TEST(lock_free_queue_capacity_check)
+    TEST(lock_free_queue_fifo_check)
+    TEST(lock_free_queue_try_enqueue_check)
+    TEST(lock_free_queue_enqueue_for_check)
+    TEST(lock_free_queue_one_consumer_one_producer)
+    TEST(lock_free_queue_two_consumers_two_producers)
+
+END_SUITE
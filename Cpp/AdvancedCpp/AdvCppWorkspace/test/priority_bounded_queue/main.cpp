@@ -0,0 +1,175 @@
+#include "mu_test.h"
+#include <memory> // std::shared_ptr
+#include <vector> // std::vector
+#include <thread> // std::thread
+#include <chrono> // std::chrono::milliseconds
+#include "priority_bounded_queue.hpp"
+#include "blocking_bounded_queue_destruction_policies.hpp"
+#include "atomic_value.hpp"
+
+
+using namespace advcpp;
+
+
+BEGIN_TEST(priority_queue_lane_size_check)
+    constexpr size_t LANE_SIZE = 4;
+
+    PriorityBoundedQueue<int, ClearPolicy<int>> numbers(LANE_SIZE, ClearPolicy<int>());
+    ASSERT_THAT(numbers.IsEmpty());
+    ASSERT_EQUAL(numbers.Capacity(), LANE_SIZE * PRIORITIES_COUNT);
+
+    numbers.Enqueue(1, Priority::HIGH);
+    numbers.Enqueue(2); // The NORMAL lane by default
+    numbers.Enqueue(3, Priority::LOW);
+    numbers.Enqueue(4, Priority::LOW);
+
+    ASSERT_EQUAL(numbers.LaneSize(Priority::HIGH), 1);
+    ASSERT_EQUAL(numbers.LaneSize(Priority::NORMAL), 1);
+    ASSERT_EQUAL(numbers.LaneSize(Priority::LOW), 2);
+    ASSERT_EQUAL(numbers.Size(), 4);
+END_TEST
+
+
+BEGIN_TEST(priority_queue_weighted_round_robin_check)
+    constexpr size_t LANE_SIZE = 8;
+    constexpr size_t ITEMS = 4;
+    enum { HIGH_ITEM = 1, LOW_ITEM = 3 };
+
+    PriorityBoundedQueue<int, ClearPolicy<int>> numbers(LANE_SIZE, ClearPolicy<int>(), {{2, 1, 1}});
+    for(size_t i = 0; i < ITEMS; ++i)
+    {
+        numbers.Enqueue(LOW_ITEM, Priority::LOW);
+    }
+    for(size_t i = 0; i < ITEMS; ++i)
+    {
+        numbers.Enqueue(HIGH_ITEM, Priority::HIGH);
+    }
+
+    // Each round serves the HIGH lane twice and the LOW lane once - the LOW lane is never starved
+    const int expected[] = { HIGH_ITEM, HIGH_ITEM, LOW_ITEM, HIGH_ITEM, HIGH_ITEM, LOW_ITEM, LOW_ITEM, LOW_ITEM };
+    for(size_t i = 0; i < 2 * ITEMS; ++i)
+    {
+        int item = 0;
+        ASSERT_THAT(numbers.TryDequeue(item));
+        ASSERT_EQUAL(item, expected[i]);
+    }
+
+    int item = 0;
+    ASSERT_THAT(!numbers.TryDequeue(item));
+END_TEST
+
+
+BEGIN_TEST(priority_queue_full_lane_isolation_check)
+    constexpr size_t LANE_SIZE = 2;
+
+    PriorityBoundedQueue<int, ClearPolicy<int>> numbers(LANE_SIZE, ClearPolicy<int>());
+    for(size_t i = 0; i < LANE_SIZE; ++i)
+    {
+        ASSERT_THAT(numbers.TryEnqueue(0, Priority::LOW));
+    }
+
+    // A flooded lane never takes the free slots of the other lanes
+    ASSERT_THAT(!numbers.TryEnqueue(0, Priority::LOW));
+    ASSERT_THAT(!numbers.EnqueueFor(0, Priority::LOW, std::chrono::milliseconds(50)));
+    ASSERT_THAT(numbers.TryEnqueue(1, Priority::HIGH));
+    ASSERT_THAT(numbers.TryEnqueue(2));
+
+    int item = 0;
+    ASSERT_THAT(numbers.Dequeue(item));
+    ASSERT_EQUAL(item, 1);
+    ASSERT_THAT(numbers.Dequeue(item));
+    ASSERT_EQUAL(item, 2);
+END_TEST
+
+
+BEGIN_TEST(priority_queue_save_policy_order_check)
+    constexpr size_t LANE_SIZE = 4;
+
+    std::shared_ptr<std::vector<int>> vectorPtr(new std::vector<int>());
+    {
+        PriorityBoundedQueue<int, SavePolicy<int,std::vector<int>>> numbers(LANE_SIZE, SavePolicy<int,std::vector<int>>(vectorPtr));
+        numbers.Enqueue(3, Priority::LOW);
+        numbers.Enqueue(2);
+        numbers.Enqueue(1, Priority::HIGH);
+    }
+
+    // The remained items are saved from the most urgent lane
+    ASSERT_EQUAL(vectorPtr->size(), 3);
+    ASSERT_EQUAL((*vectorPtr)[0], 1);
+    ASSERT_EQUAL((*vectorPtr)[1], 2);
+    ASSERT_EQUAL((*vectorPtr)[2], 3);
+END_TEST
+
+
+BEGIN_TEST(priority_queue_destruction_releases_consumer_check)
+    constexpr size_t LANE_SIZE = 4;
+
+    AtomicValue<bool> hasDequeued(true);
+    std::thread consumer;
+    {
+        PriorityBoundedQueue<int, ClearPolicy<int>> numbers(LANE_SIZE, ClearPolicy<int>());
+        consumer = std::thread([&numbers, &hasDequeued]()
+        {
+            int item = 0;
+            hasDequeued = numbers.Dequeue(item);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    consumer.join();
+
+    ASSERT_THAT(!hasDequeued.Check());
+END_TEST
+
+
+BEGIN_TEST(priority_queue_producers_consumers_check)
+    constexpr size_t LANE_SIZE = 16;
+    constexpr size_t ITEMS_PER_PRODUCER = 10000;
+    constexpr size_t PRODUCERS_N = PRIORITIES_COUNT;
+    constexpr size_t CONSUMERS_N = 2;
+
+    PriorityBoundedQueue<size_t, ClearPolicy<size_t>> numbers(LANE_SIZE, ClearPolicy<size_t>());
+    AtomicValue<size_t> sum(0);
+    std::vector<std::thread> threads;
+
+    for(size_t p = 0; p < PRODUCERS_N; ++p)
+    {
+        threads.push_back(std::thread([&numbers, p]()
+        {
+            for(size_t i = 1; i <= ITEMS_PER_PRODUCER; ++i)
+            {
+                numbers.Enqueue(i, static_cast<Priority>(p));
+            }
+        }));
+    }
+    for(size_t c = 0; c < CONSUMERS_N; ++c)
+    {
+        threads.push_back(std::thread([&numbers, &sum]()
+        {
+            for(size_t i = 0; i < PRODUCERS_N * ITEMS_PER_PRODUCER / CONSUMERS_N; ++i)
+            {
+                size_t item = 0;
+                numbers.Dequeue(item);
+                sum += item;
+            }
+        }));
+    }
+    for(size_t i = 0; i < threads.size(); ++i)
+    {
+        threads[i].join();
+    }
+
+    ASSERT_EQUAL(sum.Get(), PRODUCERS_N * ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER + 1) / 2);
+    ASSERT_THAT(numbers.IsEmpty());
+END_TEST
+
+
+BEGIN_SUITE(PriorityBoundedQueueTests)
+
+    TEST(priority_queue_lane_size_check)
+    TEST(priority_queue_weighted_round_robin_check)
+    TEST(priority_queue_full_lane_isolation_check)
+    TEST(priority_queue_save_policy_order_check)
+    TEST(priority_queue_destruction_releases_consumer_check)
+    TEST(priority_queue_producers_consumers_check)
+
+END_SUITE
@@ -0,0 +1,129 @@
+#include "mu_test.h"
+#include <memory> // std::shared_ptr
+#include <utility> // std::move
+#include <stdexcept> // std::runtime_error
+#include "task.hpp"
+#include "icallable.hpp"
+#include "callable_functions_adapters.hpp"
+
+
+using namespace advcpp;
+
+
+class CountingCallable : public ICallable
+{
+public:
+    explicit CountingCallable(size_t& a_counter) : m_counter(a_counter) {}
+
+    virtual void operator()() override { ++m_counter; }
+
+private:
+    size_t& m_counter;
+};
+
+
+BEGIN_TEST(task_empty_check)
+    Task task;
+    ASSERT_THAT(!task);
+    ASSERT_THAT(!task.IsInline());
+
+    bool hasThrown = false;
+    try
+    {
+        task();
+    }
+    catch(const std::runtime_error&)
+    {
+        hasThrown = true;
+    }
+    ASSERT_THAT(hasThrown);
+END_TEST
+
+
+BEGIN_TEST(task_inline_check)
+    size_t counter = 0;
+    Task task([&counter]() { ++counter; });
+    ASSERT_THAT(task);
+    ASSERT_THAT(task.IsInline());
+
+    task();
+    task();
+    ASSERT_EQUAL(counter, 2);
+END_TEST
+
+
+BEGIN_TEST(task_heap_check)
+    size_t counter = 0;
+    char bigCapture[Task::INLINE_BUFFER_SIZE * 2] = {1};
+    Task task([&counter, bigCapture]() { counter += bigCapture[0]; });
+    ASSERT_THAT(task);
+    ASSERT_THAT(!task.IsInline());
+
+    task();
+    ASSERT_EQUAL(counter, 1);
+END_TEST
+
+
+BEGIN_TEST(task_move_check)
+    size_t counter = 0;
+    char bigCapture[Task::INLINE_BUFFER_SIZE * 2] = {1};
+    Task inlineTask([&counter]() { ++counter; });
+    Task heapTask([&counter, bigCapture]() { counter += bigCapture[0]; });
+
+    Task movedInlineTask(std::move(inlineTask));
+    ASSERT_THAT(!inlineTask);
+    ASSERT_THAT(movedInlineTask.IsInline());
+
+    Task movedHeapTask;
+    movedHeapTask = std::move(heapTask);
+    ASSERT_THAT(!heapTask);
+    ASSERT_THAT(!movedHeapTask.IsInline());
+
+    movedInlineTask();
+    movedHeapTask();
+    ASSERT_EQUAL(counter, 2);
+
+    movedInlineTask = std::move(movedHeapTask); // Replaces (destroys) the held inline callable
+    movedInlineTask();
+    ASSERT_EQUAL(counter, 3);
+END_TEST
+
+
+BEGIN_TEST(task_destroys_callable_check)
+    std::shared_ptr<int> sharedValue(new int(0));
+    char bigCapture[Task::INLINE_BUFFER_SIZE * 2] = {0};
+    {
+        Task inlineTask([sharedValue]() { ++*sharedValue; });
+        Task heapTask([sharedValue, bigCapture]() { *sharedValue += bigCapture[0]; });
+        Task movedTask(std::move(inlineTask));
+        ASSERT_EQUAL(sharedValue.use_count(), 3);
+    }
+    ASSERT_EQUAL(sharedValue.use_count(), 1);
+END_TEST
+
+
+BEGIN_TEST(task_icallable_adapter_check)
+    size_t counter = 0;
+    std::shared_ptr<ICallable> callable(new CountingCallable(counter));
+
+    Task task = ICallableToTaskAdapter(callable);
+    ASSERT_THAT(task.IsInline());
+    task();
+    ASSERT_EQUAL(counter, 1);
+
+    Task nullCallableTask = ICallableToTaskAdapter(std::shared_ptr<ICallable>()); // A null ICallable is skipped
+    nullCallableTask();
+    ASSERT_EQUAL(counter, 1);
+END_TEST
+
+
+BEGIN_SUITE(TaskTests)
+
+    TEST(task_empty_check)
+    TEST(task_inline_check)
+    TEST(task_heap_check)
+    TEST(task_move_check)
+    TEST(task_destroys_callable_check)
+    TEST(task_icallable_adapter_check)
+
+END_SUITE
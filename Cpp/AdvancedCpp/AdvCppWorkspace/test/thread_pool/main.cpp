@@ -1,12 +1,43 @@
 #include "mu_test.h"
 #include <unistd.h> // sleep
+#include <chrono> // std::chrono::milliseconds, std::chrono::steady_clock
+#include <vector> // std::vector
+#include <thread> // std::this_thread::sleep_for
+#include <stdexcept> // std::runtime_error
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
+#include "lock_free_bounded_queue.hpp"
+#include "priority_bounded_queue.hpp"
 #include "icallable.hpp"
 #include "thread_pool.hpp"
+#include "future.hpp"
 #include "counter.hpp"
 #include "counter_increment_task.hpp"
 #include "thread_pool_destruction_policies.hpp"
+#include "thread_pool_submission_policies.hpp"
+#include "atomic_value.hpp"
+
+
+// Submits N copies of a work to the pool it runs on (from a worker's thread)
+template <typename PoolType>
+class SubWorksSpawnerTask : public advcpp::ICallable
+{
+public:
+    SubWorksSpawnerTask(PoolType& a_pool, std::shared_ptr<advcpp::ICallable> a_subWork, size_t a_subWorksCount) : m_pool(a_pool), m_subWork(a_subWork), m_subWorksCount(a_subWorksCount) {}
+
+    virtual void operator()() override
+    {
+        for(size_t i = 0; i < m_subWorksCount; ++i)
+        {
+            m_pool.SubmitWork(m_subWork);
+        }
+    }
+
+private:
+    PoolType& m_pool;
+    std::shared_ptr<advcpp::ICallable> m_subWork;
+    size_t m_subWorksCount;
+};
 
 
 BEGIN_TEST(thread_pool_submit_and_add_check)
@@ -207,14 +238,524 @@ BEGIN_TEST(thread_pool_remove_while_executing_work)
 END_TEST
 
 
+BEGIN_TEST(thread_pool_try_submit_full_queue)
+    using advcpp::ThreadPool;
+    using advcpp::Counter;
+    using advcpp::CounterIncrementTask;
+    using advcpp::ShutdownPolicy;
+
+    constexpr size_t N = 1000;
+    constexpr size_t QUEUE_SIZE = 3;
+
+    std::shared_ptr<Counter> counter(new Counter());
+    std::shared_ptr<CounterIncrementTask> work(new CounterIncrementTask(counter, N));
+
+    ThreadPool<ShutdownPolicy<>> pool(ShutdownPolicy<>(), QUEUE_SIZE, 0);
+
+    for(size_t i = 0; i < QUEUE_SIZE; ++i)
+    {
+        ASSERT_THAT(pool.TrySubmit(work));
+    }
+    ASSERT_THAT(!pool.TrySubmit(work));
+    ASSERT_EQUAL(pool.PendingWorksCount(), QUEUE_SIZE);
+
+    pool.AddWorkers(1);
+    pool.Shutdown();
+
+    ASSERT_EQUAL(counter->Count(), QUEUE_SIZE * N);
+END_TEST
+
+
+BEGIN_TEST(thread_pool_submit_for_timeout)
+    using advcpp::ThreadPool;
+    using advcpp::Counter;
+    using advcpp::CounterIncrementTask;
+    using advcpp::ShutdownImmediatePolicy;
+
+    constexpr size_t N = 1000;
+    constexpr size_t QUEUE_SIZE = 2;
+
+    std::shared_ptr<Counter> counter(new Counter());
+    std::shared_ptr<CounterIncrementTask> work(new CounterIncrementTask(counter, N));
+
+    ThreadPool<ShutdownImmediatePolicy<>> pool(ShutdownImmediatePolicy<>(), QUEUE_SIZE, 0);
+
+    for(size_t i = 0; i < QUEUE_SIZE; ++i)
+    {
+        ASSERT_THAT(pool.SubmitFor(work, std::chrono::milliseconds(100)));
+    }
+    ASSERT_THAT(!pool.SubmitFor(work, std::chrono::milliseconds(100)));
+    ASSERT_EQUAL(pool.PendingWorksCount(), QUEUE_SIZE);
+END_TEST
+
+
+BEGIN_TEST(thread_pool_async_submission_shutdown_check)
+    using advcpp::ThreadPool;
+    using advcpp::Counter;
+    using advcpp::CounterIncrementTask;
+    using advcpp::ClearPolicy;
+    using advcpp::ICallable;
+    using advcpp::BlockingBoundedQueue;
+    using advcpp::AssertingPolicy;
+    using advcpp::AsyncSubmissionPolicy;
+
+    using QueueDestructionPolicy = ClearPolicy<advcpp::Task>;
+    using QueueType = BlockingBoundedQueue<advcpp::Task, QueueDestructionPolicy>;
+    using SubmissionPolicy = AsyncSubmissionPolicy<QueueDestructionPolicy, QueueType>;
+    using PoolDestructionPolicy = AssertingPolicy<QueueDestructionPolicy, QueueType, SubmissionPolicy>;
+
+    constexpr size_t N = 100000;
+    constexpr size_t WORKERS_N = 2;
+    constexpr size_t QUEUE_SIZE = 5;
+    constexpr size_t WORKS_COUNT = 15;
+
+    std::shared_ptr<Counter> counter(new Counter());
+    std::shared_ptr<CounterIncrementTask> work(new CounterIncrementTask(counter, N));
+
+    ThreadPool<PoolDestructionPolicy, QueueDestructionPolicy, QueueType, SubmissionPolicy> pool(PoolDestructionPolicy(), QUEUE_SIZE, WORKERS_N);
+
+    for(size_t i = 0; i < WORKS_COUNT; ++i)
+    {
+        pool.SubmitWork(work); // Never blocks, even though the works queue is smaller than the works count
+    }
+
+    pool.Shutdown();
+
+    TRACE(counter->Count());
+    ASSERT_EQUAL(counter->Count(), WORKS_COUNT * N);
+END_TEST
+
+
+BEGIN_TEST(thread_pool_lock_free_queue_shutdown_check)
+    using advcpp::ThreadPool;
+    using advcpp::Counter;
+    using advcpp::CounterIncrementTask;
+    using advcpp::ClearPolicy;
+    using advcpp::ICallable;
+    using advcpp::LockFreeBoundedQueue;
+    using advcpp::AssertingPolicy;
+
+    using QueueDestructionPolicy = ClearPolicy<advcpp::Task>;
+    using QueueType = LockFreeBoundedQueue<advcpp::Task, QueueDestructionPolicy>;
+    using PoolDestructionPolicy = AssertingPolicy<QueueDestructionPolicy, QueueType>;
+
+    constexpr size_t N = 100000;
+    constexpr size_t WORKERS_N = 4;
+    constexpr size_t QUEUE_SIZE = 8;
+    constexpr size_t WORKS_COUNT = 100;
+
+    std::shared_ptr<Counter> counter(new Counter());
+    std::shared_ptr<CounterIncrementTask> work(new CounterIncrementTask(counter, N));
+
+    ThreadPool<PoolDestructionPolicy, QueueDestructionPolicy, QueueType> pool(PoolDestructionPolicy(), QUEUE_SIZE, WORKERS_N);
+
+    for(size_t i = 0; i < WORKS_COUNT; ++i)
+    {
+        pool.SubmitWork(work);
+    }
+
+    pool.RemoveWorkers(2);
+    ASSERT_EQUAL(pool.WorkersCount(), WORKERS_N - 2);
+
+    pool.Shutdown();
+
+    TRACE(counter->Count());
+    ASSERT_EQUAL(counter->Count(), WORKS_COUNT * N);
+END_TEST
+
+
+BEGIN_TEST(thread_pool_work_stealing_sub_works_check)
+    using advcpp::ThreadPool;
+    using advcpp::Counter;
+    using advcpp::CounterIncrementTask;
+    using advcpp::ClearPolicy;
+    using advcpp::ICallable;
+    using advcpp::BlockingBoundedQueue;
+    using advcpp::AssertingPolicy;
+    using advcpp::WorkStealingPolicy;
+
+    using QueueDestructionPolicy = ClearPolicy<advcpp::Task>;
+    using QueueType = BlockingBoundedQueue<advcpp::Task, QueueDestructionPolicy>;
+    using SubmissionPolicy = WorkStealingPolicy<QueueDestructionPolicy, QueueType>;
+    using PoolDestructionPolicy = AssertingPolicy<QueueDestructionPolicy, QueueType, SubmissionPolicy>;
+    using PoolType = ThreadPool<PoolDestructionPolicy, QueueDestructionPolicy, QueueType, SubmissionPolicy>;
+
+    constexpr size_t N = 1000;
+    constexpr size_t WORKERS_N = 4;
+    constexpr size_t QUEUE_SIZE = 4;
+    constexpr size_t SPAWNERS_COUNT = 20;
+    constexpr size_t SUB_WORKS_COUNT = 100; // Much more than the works queue size - the sub works are pushed to the workers' own deques
+
+    std::shared_ptr<Counter> counter(new Counter());
+    std::shared_ptr<CounterIncrementTask> work(new CounterIncrementTask(counter, N));
+
+    PoolType pool(PoolDestructionPolicy(), QUEUE_SIZE, WORKERS_N);
+    std::shared_ptr<SubWorksSpawnerTask<PoolType>> spawner(new SubWorksSpawnerTask<PoolType>(pool, work, SUB_WORKS_COUNT));
+
+    for(size_t i = 0; i < SPAWNERS_COUNT; ++i)
+    {
+        pool.SubmitWork(spawner);
+    }
+
+    sleep(1); // To let the spawners submit all their sub works (a Shutdown call rejects new works, from the workers' threads as well)
+    pool.Shutdown();
+
+    TRACE(counter->Count());
+    ASSERT_EQUAL(counter->Count(), SPAWNERS_COUNT * SUB_WORKS_COUNT * N);
+END_TEST
+
+
+BEGIN_TEST(thread_pool_work_stealing_add_remove_check)
+    using advcpp::ThreadPool;
+    using advcpp::Counter;
+    using advcpp::CounterIncrementTask;
+    using advcpp::ClearPolicy;
+    using advcpp::ICallable;
+    using advcpp::BlockingBoundedQueue;
+    using advcpp::ShutdownPolicy;
+    using advcpp::WorkStealingPolicy;
+
+    using QueueDestructionPolicy = ClearPolicy<advcpp::Task>;
+    using QueueType = BlockingBoundedQueue<advcpp::Task, QueueDestructionPolicy>;
+    using SubmissionPolicy = WorkStealingPolicy<QueueDestructionPolicy, QueueType>;
+    using PoolDestructionPolicy = ShutdownPolicy<QueueDestructionPolicy, QueueType, SubmissionPolicy>;
+    using PoolType = ThreadPool<PoolDestructionPolicy, QueueDestructionPolicy, QueueType, SubmissionPolicy>;
+
+    constexpr size_t N = 1000;
+    constexpr size_t WORKERS_N = 4;
+    constexpr size_t QUEUE_SIZE = 8;
+    constexpr size_t SPAWNERS_COUNT = 10;
+    constexpr size_t SUB_WORKS_COUNT = 50;
+
+    std::shared_ptr<Counter> counter(new Counter());
+    std::shared_ptr<CounterIncrementTask> work(new CounterIncrementTask(counter, N));
+
+    {
+        PoolType pool(PoolDestructionPolicy(), QUEUE_SIZE, WORKERS_N);
+        std::shared_ptr<SubWorksSpawnerTask<PoolType>> spawner(new SubWorksSpawnerTask<PoolType>(pool, work, SUB_WORKS_COUNT));
+
+        for(size_t i = 0; i < SPAWNERS_COUNT; ++i)
+        {
+            pool.SubmitWork(spawner);
+        }
+
+        pool.RemoveWorkers(2); // The deques of the removed workers stay stealable
+        ASSERT_EQUAL(pool.WorkersCount(), WORKERS_N - 2);
+        pool.AddWorkers(3); // The new workers adopt the deques of the removed ones
+        ASSERT_EQUAL(pool.WorkersCount(), WORKERS_N + 1);
+
+        sleep(1); // To let the spawners submit all their sub works
+    } // ShutdownPolicy - executes all pending works
+
+    TRACE(counter->Count());
+    ASSERT_EQUAL(counter->Count(), SPAWNERS_COUNT * SUB_WORKS_COUNT * N);
+END_TEST
+
+
+BEGIN_TEST(thread_pool_submit_lambda_check)
+    using advcpp::ThreadPool;
+    using advcpp::ShutdownPolicy;
+    using advcpp::AtomicValue;
+
+    constexpr size_t WORKERS_N = 4;
+    constexpr size_t QUEUE_SIZE = 10;
+    constexpr size_t WORKS_COUNT = 1000;
+
+    AtomicValue<size_t> executedWorks(0);
+    ThreadPool<ShutdownPolicy<>> pool(ShutdownPolicy<>(), QUEUE_SIZE, WORKERS_N);
+
+    for(size_t i = 0; i < WORKS_COUNT; ++i)
+    {
+        pool.SubmitWork([&executedWorks]() { ++executedWorks; }); // Held by value in the works queue
+    }
+
+    pool.Shutdown();
+
+    ASSERT_EQUAL(executedWorks.Get(), WORKS_COUNT);
+END_TEST
+
+
+BEGIN_TEST(thread_pool_submit_future_check)
+    using advcpp::ThreadPool;
+    using advcpp::ShutdownPolicy;
+    using advcpp::Future;
+
+    constexpr size_t WORKERS_N = 4;
+    constexpr size_t QUEUE_SIZE = 10;
+
+    ThreadPool<ShutdownPolicy<>> pool(ShutdownPolicy<>(), QUEUE_SIZE, WORKERS_N);
+
+    Future<int> value = pool.Submit([]() { return 42; });
+    Future<void> failure = pool.Submit([]() { throw std::runtime_error("work failed"); });
+
+    bool hasThrown = false;
+    try
+    {
+        failure.Get();
+    }
+    catch(const std::runtime_error&)
+    {
+        hasThrown = true;
+    }
+
+    pool.Shutdown();
+
+    ASSERT_EQUAL(value.Get(), 42);
+    ASSERT_THAT(hasThrown);
+END_TEST
+
+
+BEGIN_TEST(thread_pool_future_then_chain_check)
+    using advcpp::ThreadPool;
+    using advcpp::ShutdownPolicy;
+    using advcpp::Future;
+
+    constexpr size_t WORKERS_N = 4;
+    constexpr size_t QUEUE_SIZE = 10;
+
+    ThreadPool<ShutdownPolicy<>> pool(ShutdownPolicy<>(), QUEUE_SIZE, WORKERS_N);
+
+    Future<int> doubled = pool.Submit([]() { return 21; }).Then([](Future<int> a_ready) { return a_ready.Get() * 2; });
+    Future<int> unwrapped = doubled.Then([&pool](Future<int> a_ready) { int value = a_ready.Get(); return pool.Submit([value]() { return value + 1; }); });
+    Future<int> recovered = pool.Submit([]() -> int { throw std::runtime_error("work failed"); }).Then([](Future<int> a_ready) {
+        try
+        {
+            return a_ready.Get();
+        }
+        catch(const std::runtime_error&)
+        {
+            return -1;
+        }
+    });
+
+    ASSERT_EQUAL(doubled.Get(), 42);
+    ASSERT_EQUAL(unwrapped.Get(), 43);
+    ASSERT_EQUAL(recovered.Get(), -1);
+
+    pool.Shutdown();
+END_TEST
+
+
+BEGIN_TEST(thread_pool_future_when_all_check)
+    using advcpp::ThreadPool;
+    using advcpp::ShutdownPolicy;
+    using advcpp::Future;
+
+    constexpr size_t WORKERS_N = 4;
+    constexpr size_t QUEUE_SIZE = 10;
+    constexpr size_t WORKS_COUNT = 100;
+
+    ThreadPool<ShutdownPolicy<>> pool(ShutdownPolicy<>(), QUEUE_SIZE, WORKERS_N);
+
+    std::vector<Future<size_t>> futures;
+    for(size_t i = 0; i < WORKS_COUNT; ++i)
+    {
+        futures.push_back(pool.Submit([i]() { return i; }));
+    }
+
+    std::vector<size_t> values = advcpp::WhenAll(futures).Get();
+    ASSERT_EQUAL(values.size(), WORKS_COUNT);
+    for(size_t i = 0; i < WORKS_COUNT; ++i)
+    {
+        ASSERT_EQUAL(values[i], i);
+    }
+
+    std::vector<Future<void>> voids;
+    voids.push_back(pool.Submit([]() {}));
+    voids.push_back(pool.Submit([]() { throw std::runtime_error("work failed"); }));
+    bool hasThrown = false;
+    try
+    {
+        advcpp::WhenAll(voids).Get();
+    }
+    catch(const std::runtime_error&)
+    {
+        hasThrown = true;
+    }
+
+    ASSERT_THAT(hasThrown);
+    ASSERT_THAT(advcpp::WhenAll(std::vector<Future<void>>()).IsReady());
+
+    pool.Shutdown();
+END_TEST
+
+
+BEGIN_TEST(thread_pool_future_when_any_check)
+    using advcpp::ThreadPool;
+    using advcpp::ShutdownPolicy;
+    using advcpp::Future;
+
+    constexpr size_t WORKERS_N = 2;
+    constexpr size_t QUEUE_SIZE = 10;
+
+    ThreadPool<ShutdownPolicy<>> pool(ShutdownPolicy<>(), QUEUE_SIZE, WORKERS_N);
+
+    std::vector<Future<int>> futures;
+    futures.push_back(pool.Submit([]() { sleep(1); return 0; }));
+    futures.push_back(pool.Submit([]() { return 1; }));
+
+    ASSERT_EQUAL(advcpp::WhenAny(futures).Get(), 1u);
+
+    pool.Shutdown();
+END_TEST
+
+
+BEGIN_TEST(thread_pool_shutdown_deadline_check)
+    using advcpp::ThreadPool;
+    using advcpp::ShutdownPolicy;
+    using advcpp::AtomicValue;
+
+    constexpr size_t WORKERS_N = 1;
+    constexpr size_t QUEUE_SIZE = 10;
+    constexpr size_t WORKS_COUNT = 5;
+
+    AtomicValue<size_t> executedWorks(0);
+    ThreadPool<ShutdownPolicy<>> pool(ShutdownPolicy<>(), QUEUE_SIZE, WORKERS_N);
+
+    for(size_t i = 0; i < WORKS_COUNT; ++i)
+    {
+        pool.SubmitWork([&executedWorks]() { std::this_thread::sleep_for(std::chrono::milliseconds(100)); ++executedWorks; });
+    }
+
+    size_t pendingWorks = pool.Shutdown(std::chrono::steady_clock::now() + std::chrono::milliseconds(150));
+
+    ASSERT_THAT(pendingWorks > 0);
+    ASSERT_EQUAL(pendingWorks + executedWorks.Get(), WORKS_COUNT); // The executing work was completed, the rest were left pending
+    ASSERT_EQUAL(pool.WorkersCount(), 0u);
+END_TEST
+
+
+BEGIN_TEST(thread_pool_shutdown_drains_nested_works_check)
+    using advcpp::ThreadPool;
+    using advcpp::ShutdownPolicy;
+    using advcpp::AtomicValue;
+
+    constexpr size_t WORKERS_N = 4;
+    constexpr size_t QUEUE_SIZE = 100;
+    constexpr size_t WORKS_COUNT = 50;
+
+    AtomicValue<size_t> executedWorks(0);
+    AtomicValue<size_t> acceptedNestedWorks(0);
+    ThreadPool<ShutdownPolicy<>> pool(ShutdownPolicy<>(), QUEUE_SIZE, WORKERS_N);
+
+    for(size_t i = 0; i < WORKS_COUNT; ++i)
+    {
+        pool.SubmitWork([&pool, &executedWorks, &acceptedNestedWorks]()
+        {
+            try
+            {
+                pool.SubmitWork([&executedWorks]() { ++executedWorks; }); // Submitted before the parent work has completed - drained as well
+                ++acceptedNestedWorks;
+            }
+            catch(const std::runtime_error&)
+            {
+                // Rejected - the shutdown has started already
+            }
+            ++executedWorks;
+        });
+    }
+
+    pool.Shutdown();
+
+    ASSERT_EQUAL(executedWorks.Get(), WORKS_COUNT + acceptedNestedWorks.Get());
+END_TEST
+
+
+BEGIN_TEST(thread_pool_priority_lanes_check)
+    using advcpp::ThreadPool;
+    using advcpp::ClearPolicy;
+    using advcpp::PriorityBoundedQueue;
+    using advcpp::AssertingPolicy;
+    using advcpp::Priority;
+
+    using QueueDestructionPolicy = ClearPolicy<advcpp::Task>;
+    using QueueType = PriorityBoundedQueue<advcpp::Task, QueueDestructionPolicy>;
+    using PoolDestructionPolicy = AssertingPolicy<QueueDestructionPolicy, QueueType>;
+
+    constexpr size_t LANE_SIZE = 16;
+    constexpr size_t FLOOD_WORKS = 10;
+
+    std::vector<Priority> executionOrder; // A single worker - no sync is needed
+    ThreadPool<PoolDestructionPolicy, QueueDestructionPolicy, QueueType> pool(PoolDestructionPolicy(), LANE_SIZE, 0);
+
+    for(size_t i = 0; i < FLOOD_WORKS; ++i)
+    {
+        pool.SubmitWork([&executionOrder]() { executionOrder.push_back(Priority::LOW); }, Priority::LOW);
+    }
+    pool.SubmitWork([&executionOrder]() { executionOrder.push_back(Priority::NORMAL); }); // The NORMAL lane by default
+    pool.SubmitWork([&executionOrder]() { executionOrder.push_back(Priority::HIGH); }, Priority::HIGH);
+
+    ASSERT_EQUAL(pool.PendingWorksCount(Priority::LOW), FLOOD_WORKS);
+    ASSERT_EQUAL(pool.PendingWorksCount(Priority::NORMAL), 1);
+    ASSERT_EQUAL(pool.PendingWorksCount(Priority::HIGH), 1);
+    ASSERT_EQUAL(pool.PendingWorksCount(), FLOOD_WORKS + 2);
+
+    pool.AddWorkers(1);
+    pool.Shutdown();
+
+    ASSERT_EQUAL(executionOrder.size(), FLOOD_WORKS + 2);
+    ASSERT_THAT(executionOrder[0] == Priority::HIGH);
+    ASSERT_THAT(executionOrder[1] == Priority::NORMAL);
+    ASSERT_EQUAL(pool.PendingWorksCount(Priority::LOW), 0);
+END_TEST
+
+
+BEGIN_TEST(thread_pool_priority_try_submit_full_lane_check)
+    using advcpp::ThreadPool;
+    using advcpp::ClearPolicy;
+    using advcpp::PriorityBoundedQueue;
+    using advcpp::AssertingPolicy;
+    using advcpp::Priority;
+
+    using QueueDestructionPolicy = ClearPolicy<advcpp::Task>;
+    using QueueType = PriorityBoundedQueue<advcpp::Task, QueueDestructionPolicy>;
+    using PoolDestructionPolicy = AssertingPolicy<QueueDestructionPolicy, QueueType>;
+
+    constexpr size_t LANE_SIZE = 4;
+
+    std::vector<Priority> executionOrder; // A single worker - no sync is needed
+    ThreadPool<PoolDestructionPolicy, QueueDestructionPolicy, QueueType> pool(PoolDestructionPolicy(), LANE_SIZE, 0);
+
+    for(size_t i = 0; i < LANE_SIZE; ++i)
+    {
+        ASSERT_THAT(pool.TrySubmit([&executionOrder]() { executionOrder.push_back(Priority::NORMAL); }, Priority::NORMAL));
+    }
+    ASSERT_THAT(!pool.TrySubmit([&executionOrder]() { executionOrder.push_back(Priority::NORMAL); }, Priority::NORMAL));
+    ASSERT_THAT(pool.TrySubmit([&executionOrder]() { executionOrder.push_back(Priority::HIGH); }, Priority::HIGH)); // A full lane never fills the other lanes
+    ASSERT_EQUAL(pool.PendingWorksCount(Priority::NORMAL), LANE_SIZE);
+    ASSERT_EQUAL(pool.PendingWorksCount(Priority::HIGH), 1);
+
+    pool.AddWorkers(1);
+    pool.Shutdown();
+
+    ASSERT_EQUAL(executionOrder.size(), LANE_SIZE + 1);
+    ASSERT_THAT(executionOrder[0] == Priority::HIGH);
+END_TEST
+
+
 BEGIN_SUITE(ThreadPoolTests)
 
     TEST(thread_pool_submit_and_add_check)
+    TEST(thread_pool_submit_lambda_check)
+    TEST(thread_pool_submit_future_check)
+    TEST(thread_pool_future_then_chain_check)
+    TEST(thread_pool_future_when_all_check)
+    TEST(thread_pool_future_when_any_check)
     TEST(thread_pool_submit_shutdown_check)
+    TEST(thread_pool_shutdown_deadline_check)
+    TEST(thread_pool_shutdown_drains_nested_works_check)
     TEST(thread_pool_shutdown_waiting_on_dequeue_check)
     TEST(thread_pool_shutdown_immidiate_waiting_on_dequeue_check)
     TEST(thread_pool_shutdown_immidiate_in_middle_of_work)
-    // TEST(thread_pool_remove_worker_empty_queue)
-    // TEST(thread_pool_remove_while_executing_work)
+    TEST(thread_pool_remove_worker_empty_queue)
+    TEST(thread_pool_remove_while_executing_work)
+    TEST(thread_pool_try_submit_full_queue)
+    TEST(thread_pool_submit_for_timeout)
+    TEST(thread_pool_async_submission_shutdown_check)
+    TEST(thread_pool_lock_free_queue_shutdown_check)
+    TEST(thread_pool_priority_lanes_check)
+    TEST(thread_pool_priority_try_submit_full_lane_check)
+    TEST(thread_pool_work_stealing_sub_works_check)
+    TEST(thread_pool_work_stealing_add_remove_check)
 
 END_SUITE
@@ -0,0 +1,226 @@
+#include "mu_test.h"
+#include <memory> // std::shared_ptr
+#include <chrono> // std::chrono::hours, std::chrono::milliseconds
+#include <thread> // std::this_thread::sleep_for
+#include <stdexcept> // std::runtime_error
+#include "thread_pool.hpp"
+#include "thread_pool_destruction_policies.hpp"
+#include "thread_pool_autoscaler.hpp"
+#include "thread_budget.hpp"
+#include "atomic_value.hpp"
+
+
+using Pool = advcpp::ThreadPool<advcpp::ShutdownPolicy<>>;
+
+static const std::chrono::milliseconds SAMPLES_GAP(20); // Longer than the default max queue wait (10ms)
+
+
+// Only the explicit Sample calls scale the pool
+static advcpp::AutoscalerConfig ManualSamplingConfig(size_t a_minWorkers, size_t a_maxWorkers)
+{
+    advcpp::AutoscalerConfig config;
+    config.m_minWorkers = a_minWorkers;
+    config.m_maxWorkers = a_maxWorkers;
+    config.m_sampleInterval = std::chrono::hours(1);
+    config.m_samplesToGrow = 2;
+    config.m_samplesToShrink = 3;
+
+    return config;
+}
+
+
+static void SubmitBlockedWorks(Pool& a_pool, size_t a_worksCount, advcpp::AtomicFlag& a_release)
+{
+    for(size_t i = 0; i < a_worksCount; ++i)
+    {
+        a_pool.SubmitWork([&a_release]()
+        {
+            while(!a_release.Check())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+}
+
+
+BEGIN_TEST(thread_budget_acquire_release_check)
+    advcpp::ThreadBudget budget(4);
+
+    ASSERT_THAT(budget.TryAcquire(3));
+    ASSERT_THAT(!budget.TryAcquire(2));
+    ASSERT_EQUAL(budget.Available(), 1);
+
+    budget.Release(3);
+    ASSERT_EQUAL(budget.Available(), budget.Capacity());
+
+    bool hasThrown = false;
+    try
+    {
+        budget.Release();
+    }
+    catch(const std::runtime_error&)
+    {
+        hasThrown = true;
+    }
+    ASSERT_THAT(hasThrown);
+END_TEST
+
+
+BEGIN_TEST(autoscaler_resize_into_range_check)
+    constexpr size_t QUEUE_SIZE = 10;
+
+    Pool pool(advcpp::ShutdownPolicy<>(), QUEUE_SIZE, 0);
+    std::shared_ptr<advcpp::ThreadBudget> budget(new advcpp::ThreadBudget(8));
+    {
+        advcpp::ThreadPoolAutoscaler<Pool> autoscaler(pool, ManualSamplingConfig(2, 4), budget);
+        ASSERT_EQUAL(pool.WorkersCount(), 2);
+        ASSERT_EQUAL(budget->Available(), 6);
+    }
+    ASSERT_EQUAL(budget->Available(), 8);
+END_TEST
+
+
+BEGIN_TEST(autoscaler_grow_under_load_check)
+    constexpr size_t QUEUE_SIZE = 20;
+    constexpr size_t MAX_WORKERS = 4;
+    constexpr size_t SAMPLES = 12;
+
+    Pool pool(advcpp::ShutdownPolicy<>(), QUEUE_SIZE, 1);
+    advcpp::AtomicFlag release(false);
+    SubmitBlockedWorks(pool, QUEUE_SIZE, release);
+
+    size_t workersAfterFirstSample = 0;
+    size_t workersAfterSecondSample = 0;
+    advcpp::AutoscalerStats stats;
+    {
+        advcpp::ThreadPoolAutoscaler<Pool> autoscaler(pool, ManualSamplingConfig(1, MAX_WORKERS));
+
+        for(size_t i = 0; i < SAMPLES; ++i)
+        {
+            std::this_thread::sleep_for(SAMPLES_GAP); // Lets the added workers take their works
+            autoscaler.Sample();
+            if(i == 0)
+            {
+                workersAfterFirstSample = pool.WorkersCount();
+            }
+            else if(i == 1)
+            {
+                workersAfterSecondSample = pool.WorkersCount();
+            }
+        }
+        stats = autoscaler.Stats();
+    }
+    size_t workers = pool.WorkersCount();
+    release.True();
+    pool.Shutdown();
+
+    ASSERT_EQUAL(workersAfterFirstSample, 1); // Hysteresis - a single sample is not enough
+    ASSERT_EQUAL(workersAfterSecondSample, 2);
+    ASSERT_EQUAL(workers, MAX_WORKERS);
+    ASSERT_EQUAL(stats.m_workers, MAX_WORKERS);
+    ASSERT_EQUAL(stats.m_grows, MAX_WORKERS - 1);
+    ASSERT_EQUAL(stats.m_samples, SAMPLES);
+    ASSERT_THAT(stats.m_queueWait.count() > 0);
+END_TEST
+
+
+BEGIN_TEST(autoscaler_shrink_when_idle_check)
+    constexpr size_t QUEUE_SIZE = 10;
+    constexpr size_t WORKERS_N = 4;
+
+    Pool pool(advcpp::ShutdownPolicy<>(), QUEUE_SIZE, WORKERS_N);
+    advcpp::ThreadPoolAutoscaler<Pool> autoscaler(pool, ManualSamplingConfig(1, WORKERS_N));
+
+    for(size_t i = 0; i < 2; ++i)
+    {
+        autoscaler.Sample();
+    }
+    ASSERT_EQUAL(pool.WorkersCount(), WORKERS_N);
+
+    for(size_t i = 0; i < 20; ++i)
+    {
+        autoscaler.Sample();
+    }
+
+    advcpp::AutoscalerStats stats = autoscaler.Stats();
+    ASSERT_EQUAL(pool.WorkersCount(), 1);
+    ASSERT_EQUAL(stats.m_shrinks, WORKERS_N - 1);
+    ASSERT_EQUAL(stats.m_busyRatio, 0);
+END_TEST
+
+
+BEGIN_TEST(autoscaler_shared_budget_check)
+    constexpr size_t QUEUE_SIZE = 10;
+    constexpr size_t BUDGET = 3;
+
+    Pool firstPool(advcpp::ShutdownPolicy<>(), QUEUE_SIZE, 1);
+    Pool secondPool(advcpp::ShutdownPolicy<>(), QUEUE_SIZE, 1);
+    advcpp::AtomicFlag release(false);
+    SubmitBlockedWorks(firstPool, QUEUE_SIZE, release);
+    SubmitBlockedWorks(secondPool, QUEUE_SIZE, release);
+
+    std::shared_ptr<advcpp::ThreadBudget> budget(new advcpp::ThreadBudget(BUDGET));
+    size_t availableWhileScaling = 0;
+    size_t workers = 0;
+    advcpp::AutoscalerStats secondStats;
+    {
+        advcpp::ThreadPoolAutoscaler<Pool> firstAutoscaler(firstPool, ManualSamplingConfig(1, BUDGET), budget);
+        advcpp::ThreadPoolAutoscaler<Pool> secondAutoscaler(secondPool, ManualSamplingConfig(1, BUDGET), budget);
+
+        for(size_t i = 0; i < 4; ++i)
+        {
+            std::this_thread::sleep_for(SAMPLES_GAP);
+            firstAutoscaler.Sample();
+            secondAutoscaler.Sample();
+        }
+
+        availableWhileScaling = budget->Available();
+        workers = firstPool.WorkersCount() + secondPool.WorkersCount();
+        secondStats = secondAutoscaler.Stats();
+    }
+    size_t availableAfterScaling = budget->Available();
+    release.True();
+    firstPool.Shutdown();
+    secondPool.Shutdown();
+
+    ASSERT_EQUAL(availableWhileScaling, 0);
+    ASSERT_EQUAL(workers, BUDGET);
+    ASSERT_THAT(secondStats.m_deniedGrows > 0);
+    ASSERT_EQUAL(availableAfterScaling, BUDGET);
+END_TEST
+
+
+BEGIN_TEST(autoscaler_background_sampling_check)
+    constexpr size_t QUEUE_SIZE = 10;
+
+    Pool pool(advcpp::ShutdownPolicy<>(), QUEUE_SIZE, 1);
+    advcpp::AtomicFlag release(false);
+    SubmitBlockedWorks(pool, QUEUE_SIZE, release);
+
+    advcpp::AutoscalerConfig config = ManualSamplingConfig(1, 2);
+    config.m_sampleInterval = std::chrono::milliseconds(5);
+    advcpp::ThreadPoolAutoscaler<Pool> autoscaler(pool, config);
+
+    while(pool.WorkersCount() < 2) // Grown by the sampling thread
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    autoscaler.Stop();
+    release.True();
+    pool.Shutdown();
+
+    ASSERT_THAT(autoscaler.Stats().m_samples >= 2);
+END_TEST
+
+
+BEGIN_SUITE(ThreadPoolAutoscalerTests)
+
+    TEST(thread_budget_acquire_release_check)
+    TEST(autoscaler_resize_into_range_check)
+    TEST(autoscaler_grow_under_load_check)
+    TEST(autoscaler_shrink_when_idle_check)
+    TEST(autoscaler_shared_budget_check)
+    TEST(autoscaler_background_sampling_check)
+
+END_SUITE
@@ -0,0 +1,191 @@
+#include "mu_test.h"
+#include <cstddef> // size_t
+#include <chrono> // std::chrono::nanoseconds, std::chrono::microseconds, std::chrono::milliseconds
+#include <thread> // std::this_thread::sleep_for
+#include <sstream> // std::ostringstream
+#include <string> // std::string
+#include <utility> // std::move
+#include "thread_pool.hpp"
+#include "thread_pool_destruction_policies.hpp"
+#include "thread_pool_metrics_policies.hpp"
+#include "latency_histogram.hpp"
+#include "atomic_value.hpp"
+
+
+using Queue = advcpp::BlockingBoundedQueue<advcpp::Task, advcpp::ClearPolicy<advcpp::Task>>;
+using Shutdown = advcpp::ShutdownPolicy<advcpp::ClearPolicy<advcpp::Task>, Queue, advcpp::DirectSubmissionPolicy<>, advcpp::HdrMetricsPolicy>;
+using MeasuredPool = advcpp::ThreadPool<Shutdown, advcpp::ClearPolicy<advcpp::Task>, Queue, advcpp::DirectSubmissionPolicy<>, advcpp::HdrMetricsPolicy>;
+
+
+BEGIN_TEST(latency_histogram_percentiles_check)
+    advcpp::LatencyHistogram histogram;
+    for(size_t i = 1; i <= 1000; ++i)
+    {
+        histogram.Record(std::chrono::nanoseconds(i * 1000));
+    }
+
+    advcpp::HistogramSnapshot snapshot = histogram.Snapshot();
+    ASSERT_EQUAL(snapshot.Count(), 1000);
+    ASSERT_EQUAL(snapshot.Max().count(), 1000000);
+    ASSERT_EQUAL(snapshot.Mean().count(), 500500);
+
+    // The bucket of a value is at most 12.5% above it
+    long long p50 = snapshot.Percentile(50).count();
+    long long p99 = snapshot.Percentile(99).count();
+    ASSERT_THAT(p50 >= 500000 && p50 <= 562500);
+    ASSERT_THAT(p99 >= 990000 && p99 <= 1000000);
+    ASSERT_EQUAL(snapshot.Percentile(100).count(), 1000000);
+END_TEST
+
+
+BEGIN_TEST(latency_histogram_small_values_are_exact_check)
+    advcpp::LatencyHistogram histogram;
+    for(size_t i = 0; i < 16; ++i)
+    {
+        histogram.Record(std::chrono::nanoseconds(i));
+    }
+    histogram.Record(std::chrono::nanoseconds(-5)); // Recorded as 0
+
+    advcpp::HistogramSnapshot snapshot = histogram.Snapshot();
+    ASSERT_EQUAL(snapshot.Count(), 17);
+    ASSERT_EQUAL(snapshot.Percentile(0).count(), 0);
+    ASSERT_EQUAL(snapshot.Percentile(50).count(), 7);
+    ASSERT_EQUAL(snapshot.Max().count(), 15);
+END_TEST
+
+
+BEGIN_TEST(histogram_snapshots_merge_check)
+    advcpp::LatencyHistogram fast;
+    advcpp::LatencyHistogram slow;
+    for(size_t i = 0; i < 90; ++i)
+    {
+        fast.Record(std::chrono::nanoseconds(10));
+    }
+    for(size_t i = 0; i < 10; ++i)
+    {
+        slow.Record(std::chrono::nanoseconds(1000000));
+    }
+
+    advcpp::HistogramSnapshot merged;
+    ASSERT_EQUAL(merged.Count(), 0);
+    ASSERT_EQUAL(merged.Percentile(99).count(), 0);
+
+    merged.Merge(fast.Snapshot());
+    merged.Merge(slow.Snapshot());
+    ASSERT_EQUAL(merged.Count(), 100);
+    ASSERT_EQUAL(merged.Percentile(50).count(), 10);
+    ASSERT_EQUAL(merged.Percentile(99).count(), 1000000);
+END_TEST
+
+
+BEGIN_TEST(thread_pool_metrics_count_works_check)
+    const size_t WORKS = 200;
+    advcpp::AtomicValue<size_t> executed(0);
+    advcpp::ThreadPoolMetricsSnapshot snapshot;
+    {
+        MeasuredPool pool(Shutdown(), 64, 4);
+        for(size_t i = 0; i < WORKS; ++i)
+        {
+            pool.SubmitWork([&executed]()
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+                ++executed;
+            });
+        }
+        pool.Shutdown();
+        snapshot = pool.Snapshot();
+    }
+
+    ASSERT_EQUAL(executed.Get(), WORKS);
+    ASSERT_THAT(snapshot.m_isEnabled);
+    ASSERT_EQUAL(snapshot.m_submittedWorks, WORKS);
+    ASSERT_EQUAL(snapshot.m_executedWorks, WORKS);
+    ASSERT_EQUAL(snapshot.m_pendingWorks, 0);
+    ASSERT_EQUAL(snapshot.m_stolenWorks, 0);
+    ASSERT_EQUAL(snapshot.m_queueWait.Count(), WORKS);
+    ASSERT_EQUAL(snapshot.m_enqueueTime.Count(), WORKS);
+    ASSERT_THAT(snapshot.m_runTime.Percentile(50) >= std::chrono::microseconds(50));
+END_TEST
+
+
+BEGIN_TEST(thread_pool_metrics_failed_try_submit_keeps_work_check)
+    advcpp::AtomicFlag release;
+    advcpp::AtomicValue<size_t> executed(0);
+    bool hasSubmittedToFullQueue = true;
+    bool hasKeptWork = false;
+    advcpp::ThreadPoolMetricsSnapshot snapshot;
+    {
+        MeasuredPool pool(Shutdown(), 1, 1);
+        pool.SubmitWork([&release]()
+        {
+            while(!release.Check())
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        while(pool.BusyWorkersCount() == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        pool.SubmitWork([](){}); // Fills the works queue
+
+        advcpp::Task work([&executed](){ ++executed; });
+        hasSubmittedToFullQueue = pool.TrySubmit(std::move(work));
+        hasKeptWork = static_cast<bool>(work);
+        if(hasKeptWork)
+        {
+            work(); // The original work - not the instrumented one
+        }
+
+        release.True();
+        pool.Shutdown();
+        snapshot = pool.Snapshot();
+    }
+
+    ASSERT_THAT(!hasSubmittedToFullQueue);
+    ASSERT_THAT(hasKeptWork);
+    ASSERT_EQUAL(executed.Get(), 1);
+    ASSERT_EQUAL(snapshot.m_submittedWorks, 2);
+    ASSERT_EQUAL(snapshot.m_executedWorks, 2);
+END_TEST
+
+
+BEGIN_TEST(thread_pool_without_metrics_snapshot_check)
+    advcpp::ThreadPool<advcpp::ShutdownPolicy<>> pool(advcpp::ShutdownPolicy<>(), 8, 2);
+    pool.SubmitWork([](){});
+    pool.Shutdown();
+
+    advcpp::ThreadPoolMetricsSnapshot snapshot = pool.Snapshot();
+    ASSERT_THAT(!snapshot.m_isEnabled);
+    ASSERT_EQUAL(snapshot.m_submittedWorks, 0);
+    ASSERT_EQUAL(snapshot.m_queueWait.Count(), 0);
+
+    std::ostringstream line;
+    line << snapshot;
+    ASSERT_THAT(line.str().find("metrics disabled") != std::string::npos);
+END_TEST
+
+
+BEGIN_TEST(thread_pool_metrics_log_line_check)
+    MeasuredPool pool(Shutdown(), 8, 2);
+    pool.SubmitWork([](){});
+    pool.Shutdown();
+
+    std::ostringstream line;
+    line << pool.Snapshot();
+    ASSERT_THAT(line.str().find("submitted=1 executed=1") != std::string::npos);
+    ASSERT_THAT(line.str().find("wait[p50=") != std::string::npos);
+END_TEST
+
+
+BEGIN_SUITE(ThreadPoolMetricsTests)
+
+    TEST(latency_histogram_percentiles_check)
+    TEST(latency_histogram_small_values_are_exact_check)
+    TEST(histogram_snapshots_merge_check)
+    TEST(thread_pool_metrics_count_works_check)
+    TEST(thread_pool_metrics_failed_try_submit_keeps_work_check)
+    TEST(thread_pool_without_metrics_snapshot_check)
+    TEST(thread_pool_metrics_log_line_check)
+
+END_SUITE
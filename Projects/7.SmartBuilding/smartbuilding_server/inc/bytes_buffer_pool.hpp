@@ -0,0 +1,66 @@
+#ifndef NM_BYTES_BUFFER_POOL_HPP
+#define NM_BYTES_BUFFER_POOL_HPP
+
+
+#include <cstddef> // size_t
+#include <atomic> // std::atomic
+#include <mutex> // std::mutex
+
+
+namespace infra
+{
+
+// A reference counted block of bytes - the bytes are allocated right after the block's header (a single allocation per block)
+struct BytesBlock
+{
+    std::atomic<size_t> m_referencesCount;
+    size_t m_capacity;
+    size_t m_sizeClass; // The pool's free list that the block is returned to (NO_SIZE_CLASS if the block is too big to be pooled)
+    BytesBlock* m_next; // Link of the free list (valid only while the block is in the pool)
+
+    unsigned char* Bytes() { return reinterpret_cast<unsigned char*>(this + 1); }
+};
+
+
+// A process-wide pool of BytesBlocks, in size classes of powers of 2 (64 bytes up to 64KB) - a released block is kept for the next acquire of
+// its size class, so receiving and fanning out buffers does not hit the allocator [Thread safety: each size class is guarded by its own lock]
+class BytesBufferPool
+{
+public:
+    static BytesBufferPool& Instance(); // Never destroyed - buffers might be released by static objects' destructors
+
+    BytesBlock* Acquire(size_t a_capacity); // The block is referenced once, and has at least a_capacity bytes, throws std::bad_alloc on failure
+    static void AddReference(BytesBlock* a_block) noexcept;
+    static void Release(BytesBlock* a_block) noexcept; // Returns the block to the pool when its last reference is released
+
+private:
+    BytesBufferPool();
+    BytesBufferPool(const BytesBufferPool& a_other) = delete;
+    BytesBufferPool& operator=(const BytesBufferPool& a_other) = delete;
+    ~BytesBufferPool() = default;
+
+    void Recycle(BytesBlock* a_block) noexcept;
+
+private:
+    static const size_t SIZE_CLASSES_COUNT = 11;
+    static const size_t MIN_CLASS_CAPACITY = 64;
+    static const size_t MAX_POOLED_BLOCKS_PER_CLASS = 1024; // Bounds the memory that is kept after a burst
+    static const size_t NO_SIZE_CLASS = SIZE_CLASSES_COUNT;
+
+    struct FreeList
+    {
+        FreeList() : m_lock(), m_head(nullptr), m_blocksCount(0) {}
+
+        std::mutex m_lock;
+        BytesBlock* m_head;
+        size_t m_blocksCount;
+    };
+
+private:
+    FreeList m_freeLists[SIZE_CLASSES_COUNT];
+};
+
+} // infra
+
+
+#endif // NM_BYTES_BUFFER_POOL_HPP
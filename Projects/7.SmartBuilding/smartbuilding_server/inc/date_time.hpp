@@ -10,8 +10,12 @@ namespace smartbuilding
 
 // A class to represent the current Time Stamp
 // To takes a snapshot of the current timestamp (position) [local time] - use DateTime::Now static method (it saves and returns its current call time)
+// Note: Now and ToString go through the libc local time conversion and the integers formatting on every call - a hot path should take a Timestamp, and convert it when it is serialized
 class DateTime
 {
+public:
+    static const unsigned int OFFSET_OF_YEARS_IN_SYSTEM = 1900; // struct tm's years offset
+
 public:
     DateTime() = default;
     DateTime(int a_hours, int a_minutes, int a_seconds, int a_day, int a_month, int a_year);
@@ -31,9 +35,6 @@ public:
     std::string TimeToString() const;
     std::string DateToString() const;
 
-private:
-    static const unsigned int OFFSET_OF_YEARS_IN_SYSTEM = 1900;
-
 private:
     int m_hours;
     int m_minutes;
@@ -3,7 +3,10 @@
 
 
 #include <string> // std::string
+#include <stdint.h> // uint64_t
+#include <atomic> // std::atomic
 #include "date_time.hpp"
+#include "timestamp.hpp"
 #include "location.hpp"
 #include "tcp_socket.hpp"
 
@@ -16,22 +19,29 @@ class Event
 {
 public:
     using EventType = std::string;
-    using EventTimestamp = DateTime;
-    using EventLocation = Location;
+    using EventTimestamp = smartbuilding::Timestamp; // Raw nanoseconds - converted to a DateTime / text only by the encoders that serialize it
+    using EventLocation = smartbuilding::Location; // Qualified - the accessors below reuse the names of the types
     using DataPayload = infra::TCPSocket::BytesBufferProxy;
+    using EventID = uint64_t;
 
-    Event() = default;
-    Event(const DataPayload& a_data, const DateTime& a_timestamp, const EventLocation& a_location, const EventType& a_type)
-    : m_data(a_data)
+    Event() : m_id(0), m_data(), m_timestamp(), m_location(), m_type() {}
+    Event(const DataPayload& a_data, const EventTimestamp& a_timestamp, const EventLocation& a_location, const EventType& a_type)
+    : m_id(NextID())
+    , m_data(a_data)
     , m_timestamp(a_timestamp)
     , m_location(a_location)
     , m_type(a_type)
     {
     }
+    Event(const DataPayload& a_data, const DateTime& a_timestamp, const EventLocation& a_location, const EventType& a_type) // For decoders that still report a DateTime (seconds resolution)
+    : Event(a_data, smartbuilding::Timestamp::FromDateTime(a_timestamp), a_location, a_type)
+    {
+    }
     Event(const Event& a_other) = default;
     Event& operator=(const Event& a_other) = default;
     Event(Event&& a_other) noexcept // Move semantics (performance)
-    : m_data(std::move(a_other.m_data))
+    : m_id(a_other.m_id)
+    , m_data(std::move(a_other.m_data))
     , m_timestamp(a_other.m_timestamp)
     , m_location(a_other.m_location)
     , m_type(std::move(a_other.m_type))
@@ -41,6 +51,7 @@ public:
     {
         if(this != &a_other)
         {
+            m_id = a_other.m_id;
             m_data = std::move(a_other.m_data);
             m_timestamp = a_other.m_timestamp;
             m_location = a_other.m_location;
@@ -51,12 +62,21 @@ public:
     }
     ~Event() = default;
 
-    DataPayload Data() const { return m_data; }
+    EventID ID() const { return m_id; } // Unique per constructed event (0 for a default constructed event) - the copies of an event share its ID
+    const DataPayload& Data() const { return m_data; } // The payload is shared (reference counted) - copying it is O(1), without copying the bytes
     EventTimestamp Timestamp() const { return m_timestamp; }
     EventLocation Location() const { return m_location; }
     EventType Type() const { return m_type; }
 
 private:
+    static EventID NextID()
+    {
+        static std::atomic<EventID> lastID(0);
+        return lastID.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+private:
+    EventID m_id;
     DataPayload m_data;
     EventTimestamp m_timestamp;
     EventLocation m_location;
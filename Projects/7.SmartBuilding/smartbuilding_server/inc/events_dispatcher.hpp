@@ -2,35 +2,76 @@
 #define NM_EVENTS_DISPATCHER_HPP
 
 
+#include <cstddef> // size_t
 #include <memory> // std::shared_ptr
+#include <atomic> // std::atomic
+#include "icallable.hpp"
 #include "isubscriber.hpp"
 #include "event.hpp"
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
 #include "thread_pool.hpp"
 #include "thread_pool_destruction_policies.hpp"
+#include "future.hpp"
+#include "thread_budget.hpp"
+#include "thread_pool_autoscaler.hpp"
 
 
 namespace smartbuilding
 {
 
+// Fans out each event in batches of subscribers - one invoker work per batch (and not per subscriber), so a large fan-out costs a few tasks
+// and each invoker walks a cache-sized chunk of subscribers
 class EventsDispatcher
 {
 public:
-    EventsDispatcher();
+    // The fan-out counters since the dispatcher was created (a snapshot of counters that are updated concurrently - not an atomic view of all of them)
+    struct FanOutStatistics
+    {
+        size_t m_eventsCount;
+        size_t m_batchesCount;
+        size_t m_subscribersCount; // m_subscribersCount / m_batchesCount - the average subscribers per batch
+        size_t m_largestBatchSize;
+        size_t m_droppedBatchesCount; // The batches that could not be submitted to the invokers
+        size_t m_droppedSubscribersCount;
+    };
+
+    static const size_t DEFAULT_SUBSCRIBERS_PER_BATCH = 64;
+
+    // The invokers are autoscaled within a_threadsBudget, throws std::invalid_argument if a_subscribersPerBatch is 0
+    explicit EventsDispatcher(std::shared_ptr<advcpp::ThreadBudget> a_threadsBudget, size_t a_subscribersPerBatch = DEFAULT_SUBSCRIBERS_PER_BATCH);
     EventsDispatcher(const EventsDispatcher& a_other) = delete;
     EventsDispatcher& operator=(const EventsDispatcher& a_other) = delete;
     ~EventsDispatcher();
 
     // Concept of C: C must be an iterable container (implement begin() and end()), must have value_type info (typedef), and C::value_type must be ISubscriber*
+    // The invokers trigger a_handledBuffersSender after every flush to a_handledBuffersQueue - it must drain the queue without blocking (see InvokerWork)
+    // Returns a future that is ready when all the subscribers were notified (completed on the invoker that notifies the last subscriber),
+    // it fails if a batch could not be submitted to the invokers (its subscribers are not notified, and are counted as dropped)
     template <typename C>
-    void Invoke(C a_subscribersCollection, const Event& a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue) noexcept;
+    advcpp::Future<void> Invoke(const C& a_subscribersCollection, const Event& a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue, std::shared_ptr<advcpp::ICallable> a_handledBuffersSender);
+
+    size_t SubscribersPerBatch() const { return m_subscribersPerBatch; }
+    FanOutStatistics Statistics() const;
+
+private:
+    void RecordBatch(size_t a_batchSize);
+    void RecordDroppedBatch(size_t a_batchSize);
 
 private:
     static const unsigned int WORKERS_QUEUE_SIZE = 100; // TODO: in version 2, read this constant from a configuration file
+    static const unsigned int MIN_WORKERS = 1; // The autoscaler adds workers under load
 
 private:
     advcpp::ThreadPool<advcpp::ShutdownPolicy<>> m_invokers;
+    advcpp::ThreadPoolAutoscaler<advcpp::ThreadPool<advcpp::ShutdownPolicy<>>> m_invokersScaler;
+    size_t m_subscribersPerBatch;
+    std::atomic<size_t> m_eventsCount;
+    std::atomic<size_t> m_batchesCount;
+    std::atomic<size_t> m_subscribersCount;
+    std::atomic<size_t> m_largestBatchSize;
+    std::atomic<size_t> m_droppedBatchesCount;
+    std::atomic<size_t> m_droppedSubscribersCount;
 };
 
 } // smartbuilding
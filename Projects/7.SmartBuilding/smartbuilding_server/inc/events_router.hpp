@@ -2,14 +2,18 @@
 #define NM_EVENTS_ROUTER_HPP
 
 
+#include <cstddef> // size_t
 #include <unordered_map> // std::unordered_map
 #include <memory> // std::shared_ptr
+#include "icallable.hpp"
 #include "isubscriber.hpp"
 #include "event.hpp"
 #include "events_subscription_organizer.hpp"
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
 #include "events_dispatcher.hpp"
+#include "future.hpp"
+#include "thread_budget.hpp"
 
 
 namespace smartbuilding
@@ -18,15 +22,16 @@ namespace smartbuilding
 class EventsRouter
 {
 public:
-    explicit EventsRouter(std::shared_ptr<EventsSubscriptionOrganizer> a_subscribersOrganizer);
+    EventsRouter(std::shared_ptr<EventsSubscriptionOrganizer> a_subscribersOrganizer, std::shared_ptr<advcpp::ThreadBudget> a_threadsBudget, size_t a_subscribersPerBatch = EventsDispatcher::DEFAULT_SUBSCRIBERS_PER_BATCH); // The dispatcher's workers are acquired from a_threadsBudget
     EventsRouter(const EventsRouter& a_other) = delete;
     EventsRouter& operator=(const EventsRouter& a_other) = delete;
     ~EventsRouter() = default;
 
-    void RouteEvent(Event a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue); // Passes the event by copy (cannot ensure that the reference to the event is still valid)
+    EventsDispatcher::FanOutStatistics DispatchStatistics() const { return m_eventsNotifier.Statistics(); }
+    advcpp::Future<void> RouteEvent(Event a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue, std::shared_ptr<advcpp::ICallable> a_handledBuffersSender); // Passes the event by copy (cannot ensure that the reference to the event is still valid), returns a future that is ready when all its subscribers were notified
 
 private:
-    void Alert(EventsSubscriptionOrganizer::SubscribersContainer& a_subscribersToAlert, const Event& a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue);
+    advcpp::Future<void> Alert(EventsSubscriptionOrganizer::SubscribersContainer& a_subscribersToAlert, const Event& a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue, std::shared_ptr<advcpp::ICallable> a_handledBuffersSender);
 
 private:
     EventsDispatcher m_eventsNotifier;
@@ -0,0 +1,289 @@
+#ifndef NM_FUTURE_HPP
+#define NM_FUTURE_HPP
+
+
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr, std::unique_ptr
+#include <mutex> // std::mutex
+#include <condition_variable> // std::condition_variable
+#include <exception> // std::exception_ptr
+#include <chrono> // std::chrono::nanoseconds
+#include <vector> // std::vector
+#include <type_traits> // std::result_of, std::decay
+#include "task.hpp"
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+template <typename T>
+class Future;
+
+namespace future_details
+{
+
+// UnwrappedResult<R>::type is R, unless R is a Future<U> - then it is U (a callable that returns a future completes the returned future by the inner one)
+template <typename R>
+struct UnwrappedResult
+{
+    using type = R;
+};
+
+template <typename U>
+struct UnwrappedResult<Future<U>>
+{
+    using type = U;
+};
+
+
+// The shared state between the producer of a result (a submitted work / a continuation / a combinator) and all the Future copies that wait for it
+// The first completion (value or exception) wins - next completions are ignored
+// Continuations that were added before the completion are executed INLINE by the completing thread (after the lock is released),
+// continuations that are added after the completion are executed inline by the adding thread
+class FutureStateBase
+{
+public:
+    FutureStateBase();
+    FutureStateBase(const FutureStateBase& a_other) = delete;
+    FutureStateBase& operator=(const FutureStateBase& a_other) = delete;
+    virtual ~FutureStateBase() = default;
+
+    bool IsReady() const;
+    void Wait() const;
+    bool WaitFor(std::chrono::nanoseconds a_timeout) const; // Returns false if the state was not completed until the timeout has expired
+
+    bool SetException(std::exception_ptr a_exception); // Returns false if the state was already completed
+    void AddContinuation(Task a_continuation);
+
+protected:
+    void RethrowIfFailed() const; // Assumes the state is completed
+    void Complete(std::unique_lock<std::mutex>& a_lock); // Assumes a_lock holds m_mutex and the result was stored, releases the lock
+
+protected:
+    mutable std::mutex m_mutex;
+    bool m_isReady;
+
+private:
+    mutable std::condition_variable m_readyCondition;
+    std::exception_ptr m_exception;
+    std::vector<Task> m_continuations;
+};
+
+
+template <typename T>
+class FutureState : public FutureStateBase
+{
+public:
+    using ResultType = const T&;
+
+    template <typename Value>
+    bool SetValue(Value&& a_value); // Returns false if the state was already completed
+    const T& Get() const; // Blocks until completed, rethrows the stored exception
+
+private:
+    std::unique_ptr<T> m_value;
+};
+
+
+template <>
+class FutureState<void> : public FutureStateBase
+{
+public:
+    using ResultType = void;
+
+    bool SetValue(); // Returns false if the state was already completed
+    void Get() const; // Blocks until completed, rethrows the stored exception
+};
+
+
+// Grants the internal producers an access to the state of a future, and the creation of a future from a state
+struct FutureAccess
+{
+    template <typename T>
+    static const std::shared_ptr<FutureState<T>>& StateOf(const Future<T>& a_future);
+    template <typename T>
+    static Future<T> MakeFuture(std::shared_ptr<FutureState<T>> a_state);
+};
+
+} // future_details
+
+
+// A shared (copyable) handle to a result that is produced asynchronously - by ThreadPool::Submit, by Then, or by WhenAll / WhenAny
+// Concept of T: T must be copy-constructable or move-constructable, or void
+template <typename T>
+class Future
+{
+    friend struct future_details::FutureAccess;
+public:
+    Future() = default; // An invalid future (without a state) - only assignable
+    Future(const Future& a_other) = default;
+    Future& operator=(const Future& a_other) = default;
+    ~Future() = default;
+
+    bool IsValid() const noexcept;
+    bool IsReady() const; // Never blocks
+    void Wait() const;
+    bool WaitFor(std::chrono::nanoseconds a_timeout) const; // Returns false if the result is not ready until the timeout has expired
+    typename future_details::FutureState<T>::ResultType Get() const; // Blocks until ready - returns the value (nothing for Future<void>) or rethrows the exception
+
+    // Attaches a continuation that is called with this (ready) future - from the thread that completes this future, without any extra queue hop
+    // (or immediately, from the calling thread, if this future is already ready)
+    // The continuation gets the future itself, so it decides how to treat an exception (a_ready.Get() rethrows it)
+    // Concept of Func: Func must be move-constructable (or copy-constructable), and must be callable as R(Future<T>)
+    // Returns Future<R> (Future<U> if R is Future<U>), that completes with the continuation's result or its exception
+    template <typename Func>
+    Future<typename future_details::UnwrappedResult<typename std::result_of<typename std::decay<Func>::type(Future<T>)>::type>::type> Then(Func&& a_continuation) const;
+
+private:
+    explicit Future(std::shared_ptr<future_details::FutureState<T>> a_state);
+
+private:
+    std::shared_ptr<future_details::FutureState<T>> m_state;
+};
+
+
+namespace future_details
+{
+
+struct VoidResultTag {};
+struct ValueResultTag {};
+struct FutureResultTag {};
+
+template <typename R>
+struct ResultTagOf
+{
+    using type = ValueResultTag;
+};
+
+template <>
+struct ResultTagOf<void>
+{
+    using type = VoidResultTag;
+};
+
+template <typename U>
+struct ResultTagOf<Future<U>>
+{
+    using type = FutureResultTag;
+};
+
+
+// Calls a_func(a_args...) - a function that returns R - and completes a_state by its result (or by its exception), never throws
+template <typename R, typename Func, typename... Args>
+void Fulfill(const std::shared_ptr<FutureState<typename UnwrappedResult<R>::type>>& a_state, Func& a_func, Args&&... a_args) noexcept;
+
+
+// A work that completes a future state by the result of its callable - the work type behind ThreadPool::Submit
+// If the work is destroyed without being executed (e.g. the pool has stopped), the state is completed by a "broken promise" std::runtime_error
+template <typename Func, typename R>
+class PromisedWork
+{
+public:
+    PromisedWork(Func a_func, std::shared_ptr<FutureState<typename UnwrappedResult<R>::type>> a_state);
+    PromisedWork(PromisedWork&& a_other) = default;
+    PromisedWork(const PromisedWork& a_other) = delete;
+    PromisedWork& operator=(const PromisedWork& a_other) = delete;
+    ~PromisedWork();
+
+    void operator()();
+
+private:
+    Func m_func;
+    std::shared_ptr<FutureState<typename UnwrappedResult<R>::type>> m_state; // nullptr once fulfilled (or moved from)
+};
+
+
+// The continuation that Future<T>::Then attaches - calls the user's continuation with the ready source future
+template <typename T, typename Func, typename R>
+class ThenContinuation
+{
+public:
+    ThenContinuation(Future<T> a_source, Func a_func, std::shared_ptr<FutureState<typename UnwrappedResult<R>::type>> a_state);
+
+    void operator()();
+
+private:
+    Future<T> m_source;
+    Func m_func;
+    std::shared_ptr<FutureState<typename UnwrappedResult<R>::type>> m_state;
+};
+
+
+// Completes a_target by the result of a_source (a returned inner future) - used to unwrap a Future<Future<U>>
+template <typename U>
+class ResultForwarder
+{
+public:
+    ResultForwarder(Future<U> a_source, std::shared_ptr<FutureState<U>> a_target);
+
+    void operator()();
+
+private:
+    Future<U> m_source;
+    std::shared_ptr<FutureState<U>> m_target;
+};
+
+
+// The shared countdown of WhenAll - the last completed future collects the results
+template <typename T, typename Result>
+struct AllCompletion
+{
+    explicit AllCompletion(const std::vector<Future<T>>& a_futures);
+
+    std::vector<Future<T>> m_futures;
+    AtomicValue<size_t> m_remained;
+    std::shared_ptr<FutureState<Result>> m_state;
+};
+
+template <typename T, typename Result>
+class AllCompletionNotifier
+{
+public:
+    explicit AllCompletionNotifier(std::shared_ptr<AllCompletion<T,Result>> a_completion);
+
+    void operator()();
+
+private:
+    std::shared_ptr<AllCompletion<T,Result>> m_completion;
+};
+
+
+// Completes the WhenAny state by the index of the future it was attached to (only the first completion wins)
+class AnyCompletionNotifier
+{
+public:
+    AnyCompletionNotifier(std::shared_ptr<FutureState<size_t>> a_state, size_t a_index);
+
+    void operator()();
+
+private:
+    std::shared_ptr<FutureState<size_t>> m_state;
+    size_t m_index;
+};
+
+} // future_details
+
+
+// Returns a future that is ready when all of a_futures are ready - with all the values (in the same order), or with the first exception found
+// An empty a_futures gives a ready future
+template <typename T>
+Future<std::vector<T>> WhenAll(const std::vector<Future<T>>& a_futures);
+Future<void> WhenAll(const std::vector<Future<void>>& a_futures);
+
+// Returns a ready future that holds a_exception - for a producer that has failed before its work could even be submitted
+template <typename T>
+Future<T> MakeFailedFuture(std::exception_ptr a_exception);
+
+// Returns a future that is ready when the first of a_futures is ready - with its index in a_futures (even if it holds an exception)
+// Throws std::runtime_error if a_futures is empty
+template <typename T>
+Future<size_t> WhenAny(const std::vector<Future<T>>& a_futures);
+
+} // advcpp
+
+
+#include "inl/future.hxx"
+
+
+#endif // NM_FUTURE_HPP
@@ -2,14 +2,24 @@
 #define NM_HUB_HPP
 
 
+#include <cstddef> // size_t
 #include <memory> // std::shared_ptr
 #include <utility> // std::pair
+#include <vector> // std::vector
+#include <string> // std::string
+#include <deque> // std::deque
+#include <mutex> // std::mutex
+#include <unordered_map> // std::unordered_map
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
-#include "thread.hpp"
-#include "thread_destruction_policies.hpp"
 #include "thread_pool.hpp"
 #include "thread_pool_destruction_policies.hpp"
+#include "thread_pool_autoscaler.hpp"
+#include "thread_budget.hpp"
+#include "task.hpp"
+#include "priority.hpp"
+#include "priority_bounded_queue.hpp"
+#include "icallable.hpp"
 #include "tcp_server.hpp"
 #include "event.hpp"
 #include "smartbuilding_network_protocol.hpp"
@@ -20,11 +30,7 @@
 #include "remote_devices_sockets_manager.hpp"
 #include "iconfig_reader.hpp"
 #include "smartbuilding_request.hpp"
-#include "smartbuilding_connect_request.hpp"
-#include "smartbuilding_disconnect_request.hpp"
-#include "smartbuilding_subscribe_request.hpp"
-#include "smartbuilding_unsubscribe_request.hpp"
-#include "smartbuilding_event_request.hpp"
+#include "connection_handle.hpp"
 
 
 namespace smartbuilding
@@ -32,41 +38,109 @@ namespace smartbuilding
 
 // Note: the hub sends response messages for each request message from a client device in JSON format,
 // but the Events to the listening devices (Controllers) are sent only after been encoded to a special format that can be read by the listening device
+// Note 2: the hub can run several reactors (TCP servers) - each one listens on the same port (SO_REUSEPORT), runs on its own core, and owns the connections
+// that the kernel has balanced to it, so the requests of different devices are parsed and handled in parallel
+// Note 3: a reactor only frames and parses the requests - they are handled by the requests workers (so a slow subscribe or a full published events queue never
+// stalls the reactor), one request at a time per connection (the responses keep the requests' order), and the responses are posted back to the connection's reactor
+// Note 4: a requests worker never blocks on a full queue - a connection whose requests cannot progress is paused (its reading) and parked, instead of its worker
 class Hub
 {
 public:
-    Hub(std::unique_ptr<SmartBuildingNetworkProtocol> a_networkProtocolParser, std::shared_ptr<IConfigReader> a_configFileReader, const std::string& a_configFileName, unsigned int a_serverPort, unsigned int a_maxWaitingClientsAtSameTime);
+    Hub(std::unique_ptr<SmartBuildingNetworkProtocol> a_networkProtocolParser, std::shared_ptr<IConfigReader> a_configFileReader, const std::string& a_configFileName, unsigned int a_serverPort, unsigned int a_maxWaitingClientsAtSameTime, unsigned int a_reactorsCount = 1);
     Hub(const Hub& a_other) = delete;
     Hub& operator=(const Hub& a_other) = delete;
     ~Hub();
 
-    void Start();
+    void Start(); // Runs all the reactors - when the first reactor stops (on the calling thread), the others are stopped too, and it returns when all of them have stopped (after logging the transmission statistics) - if the first reactor throws, the exception is rethrown after the others have stopped
 
 private:
-    // TODO: in version 2 - improve the handlers to act like in real time server action handlers
-    class OnClientMessageHandler
+    // The parsed requests of a single connection that were not handled yet, in their arrival order
+    class ConnectionRequests
     {
     public:
-        OnClientMessageHandler(Hub* a_thisHub) : m_thisHub(a_thisHub) {};
+        struct PendingRequest
+        {
+            infra::tcpserver_details::Message m_message; // Keeps the bytes that the request views alive
+            SmartBuildingRequest m_request;
+            std::pair<infra::tcpserver_details::ClientID,std::shared_ptr<infra::TCPSocket>> m_clientInfo;
+        };
 
-        bool operator()(infra::tcpserver_details::Message& a_receivedMessage, std::pair<infra::tcpserver_details::ClientID,std::shared_ptr<infra::TCPSocket>> a_clientInfo, infra::tcpserver_details::Response& a_response);
+        using AttachedDevice = std::pair<std::string,ConnectionHandle>;
+
+        ConnectionRequests() : m_lock(), m_requests(), m_isScheduled(false), m_attachedDevices(), m_isClosed(false) {};
+
+        bool Push(PendingRequest&& a_request); // Returns true if the connection has no scheduled requests work - so the caller should schedule one
+        bool Pop(PendingRequest& a_request); // Returns false if there are no more requests - the connection's requests work is done (unscheduled)
+        void Restore(PendingRequest&& a_request); // Returns a popped request that was not handled to the front - the connection's requests work stays scheduled
+        bool AttachDevice(const std::string& a_deviceID, ConnectionHandle a_connection); // Returns false if the connection has closed already - the caller detaches the device
+        void Close(std::vector<AttachedDevice>& a_attachedDevices); // The connection has closed - a_attachedDevices gets the devices that connected through it (to be detached)
+
+    private:
+        std::mutex m_lock;
+        std::deque<PendingRequest> m_requests;
+        bool m_isScheduled; // At most one requests work per connection - the connection's requests are handled one by one, in order
+        std::vector<AttachedDevice> m_attachedDevices;
+        bool m_isClosed;
+    };
+
+    using ConnectionsRequestsTable = std::unordered_map<infra::tcpserver_details::ClientID,std::shared_ptr<ConnectionRequests>>; // Of a single reactor - used only by its thread
+
+    // Handles the pending requests of a single connection on the requests workers, and posts their responses back to the connection's reactor -
+    // then, while there are starved connections (see DeferRequestsWork), it takes them over one by one
+    // An event request that finds the published events queue full is not waited for - the connection's reading is paused, and its work is parked until the
+    // routing workers have drained the queue (see ParkPublishingRequestsWork)
+    // Submitted BY VALUE to the requests workers
+    class RequestsWork
+    {
+    public:
+        RequestsWork(Hub* a_thisHub, size_t a_reactorIndex, std::shared_ptr<ConnectionRequests> a_connectionRequests) : m_thisHub(a_thisHub), m_reactorIndex(a_reactorIndex), m_connectionRequests(a_connectionRequests) {};
+        explicit RequestsWork(Hub* a_thisHub) : m_thisHub(a_thisHub), m_reactorIndex(0), m_connectionRequests() {}; // Only takes over the starved connections
+
+        void operator()();
 
     private:
-        void HandleNewConnectRequest(std::shared_ptr<SmartBuildingConnectRequest> a_connectRequest, infra::tcpserver_details::Response& a_response, std::shared_ptr<infra::TCPSocket> a_deviceSocket);
-        void HandleNewDisconnectRequest(std::shared_ptr<SmartBuildingDisconnectRequest> a_disconnectRequest, infra::tcpserver_details::Response& a_response);
-        void HandleNewSubscribeRequest(std::shared_ptr<SmartBuildingSubscribeRequest> a_subscribeRequest, infra::tcpserver_details::Response& a_response);
-        void HandleNewUnsubscribeRequest(std::shared_ptr<SmartBuildingUnsubscribeRequest> a_unsubscribeRequest, infra::tcpserver_details::Response& a_response);
-        void HandleNewEventRequest(std::shared_ptr<SmartBuildingEventRequest> a_eventRequest, infra::tcpserver_details::Response& a_response);
+        void HandlePendingRequests();
+        void HandleNewConnectRequest(const SmartBuildingRequest& a_connectRequest, infra::tcpserver_details::Response& a_response, std::pair<infra::tcpserver_details::ClientID,std::shared_ptr<infra::TCPSocket>> a_deviceClientInfo);
+        void HandleNewDisconnectRequest(const SmartBuildingRequest& a_disconnectRequest, infra::tcpserver_details::Response& a_response);
+        void HandleNewSubscribeRequest(const SmartBuildingRequest& a_subscribeRequest, infra::tcpserver_details::Response& a_response);
+        void HandleNewUnsubscribeRequest(const SmartBuildingRequest& a_unsubscribeRequest, infra::tcpserver_details::Response& a_response);
+        bool HandleNewEventRequest(const SmartBuildingRequest& a_eventRequest, infra::tcpserver_details::Response& a_response); // Returns false if the published events queue is full - the request was not handled
         bool IsConnected(const std::string& a_deviceID);
         bool IsExistInSystem(const std::string& a_deviceID);
 
     private:
         Hub* m_thisHub;
+        size_t m_reactorIndex;
+        std::shared_ptr<ConnectionRequests> m_connectionRequests;
     };
 
+    // TODO: in version 2 - improve the handlers to act like in real time server action handlers
+    class OnClientMessageHandler
+    {
+    public:
+        OnClientMessageHandler(Hub* a_thisHub, size_t a_reactorIndex, std::shared_ptr<ConnectionsRequestsTable> a_connectionsRequests) : m_thisHub(a_thisHub), m_reactorIndex(a_reactorIndex), m_connectionsRequests(a_connectionsRequests) {};
+
+        bool operator()(infra::tcpserver_details::Message& a_receivedMessage, std::pair<infra::tcpserver_details::ClientID,std::shared_ptr<infra::TCPSocket>> a_clientInfo, infra::tcpserver_details::Response& a_response);
+
+    private:
+        Hub* m_thisHub;
+        size_t m_reactorIndex; // The reactor that the responses are posted to
+        std::shared_ptr<ConnectionsRequestsTable> m_connectionsRequests;
+    };
+
+
+    void DetachDevice(const std::string& a_deviceID, ConnectionHandle a_connection); // Only if a_connection is still the device's connection
+    void DeferRequestsWork(RequestsWork&& a_starvedWork, advcpp::Priority a_priority); // The a_priority lane of the requests workers is full - the work waits for a worker to free up (the reactor never handles requests by itself)
+    bool TakeStarvedRequestsWork(RequestsWork& a_work); // Returns false if there are no starved connections
+    void ParkPublishingRequestsWork(RequestsWork&& a_blockedWork); // The published events queue is full - the work is resumed after the next drain of the queue
+    void ResumePublishingRequestsWorks(); // The published events queue was drained - the parked works are submitted again
+    void TransmitPublishedEvents(); // Runs the route -> encode -> send stages of the published events on the workers - without any dedicated transmitter thread
+    void StopOtherReactors(); // The hub stops with its first reactor (also by an exception) - the others would never return to be joined
+    void LogTransmissionStatistics(); // The fan-out and the encoding cache counters - to the hub's log (default.log)
 
     class OnErrorHandler
     {
+    public:
         bool operator()(infra::tcpserver_details::StatusCode a_status, const std::string& a_error)
         {
             (void)(a_status); // Not in use
@@ -80,6 +154,7 @@ private:
 
     class OnNewClientConnectionHandler
     {
+    public:
         void operator()(std::pair<infra::tcpserver_details::ClientID,std::shared_ptr<infra::TCPSocket>> a_clientInfo, infra::tcpserver_details::Response& a_response)
         {
             a_response.m_status = infra::tcpserver_details::DO_NOTHING;
@@ -88,31 +163,84 @@ private:
     };
 
 
+    // Detaches the devices that connected through the closed connection (their handles are released, and their agents stop addressing them)
     class OnCloseClientConnectionHandler
     {
-        void operator()(infra::tcpserver_details::ClientID a_clientID)
-        {
-            (void)(a_clientID); // Not in use
-        }
+    public:
+        OnCloseClientConnectionHandler(Hub* a_thisHub, std::shared_ptr<ConnectionsRequestsTable> a_connectionsRequests) : m_thisHub(a_thisHub), m_connectionsRequests(a_connectionsRequests) {};
+
+        void operator()(infra::tcpserver_details::ClientID a_clientID);
+
+    private:
+        Hub* m_thisHub;
+        std::shared_ptr<ConnectionsRequestsTable> m_connectionsRequests;
     };
 
+
+    // A binary format device opens its connection by the BINARY_FORMAT_MAGIC byte, and then pipelines length-prefixed requests - a text format device
+    // ends each of its requests by a new line (see smartbuilding_network_protocol.hpp), so its requests are framed whatever the reads have split or coalesced
+    using HubFraming = infra::FirstByteSelectedFramingPolicy<SmartBuildingNetworkProtocol::BINARY_FORMAT_MAGIC,infra::LengthPrefixedFramingPolicy,infra::DelimiterFramingPolicy>;
+    using HubServer = infra::TCPServer<OnClientMessageHandler,OnErrorHandler,OnNewClientConnectionHandler,OnCloseClientConnectionHandler,infra::EpollReactorPolicy,HubFraming>; // A building has more sensors than select can watch
+
+    static advcpp::Priority PriorityOf(const SmartBuildingRequest& a_request); // The control requests are HIGH - a flood of events never delays a device's (dis)connection or subscriptions
+
+    // Routes the published events (see RoutingWork), then resumes the requests works that the full published events queue has parked
+    // Submitted BY VALUE to the routing workers
+    class TransmittingWork
+    {
+    public:
+        explicit TransmittingWork(Hub* a_thisHub) : m_thisHub(a_thisHub) {};
+
+        void operator()();
+
+    private:
+        Hub* m_thisHub;
+    };
+
+    // Runs a single reactor on its own core
+    class ReactorRunner : public advcpp::ICallable
+    {
+    public:
+        ReactorRunner(HubServer& a_reactor, unsigned int a_core) : m_reactor(a_reactor), m_core(a_core) {};
+
+        virtual void operator()() override;
+
+    private:
+        HubServer& m_reactor;
+        unsigned int m_core;
+    };
+
+    // The requests works are queued by their priority lanes - the control requests have their own lane (see PriorityOf)
+    using RequestsWorksQueue = advcpp::PriorityBoundedQueue<advcpp::Task,advcpp::ClearPolicy<advcpp::Task>>;
+    using RequestsWorkers = advcpp::ThreadPool<advcpp::ShutdownPolicy<advcpp::ClearPolicy<advcpp::Task>,RequestsWorksQueue>,advcpp::ClearPolicy<advcpp::Task>,RequestsWorksQueue>;
+
 private:
-    static const unsigned int QUEUE_SIZE = 100; // TODO: in version 2, read this constant from a configuration file
+    static const unsigned int QUEUE_SIZE = 100; // Per lane of the requests workers' queue - TODO: in version 2, read this constant from a configuration file
+    static const unsigned int MIN_WORKERS = 1; // Per pool - the autoscalers add workers under load
+    static const unsigned int MIN_THREADS_BUDGET = 4; // The minimal workers of the requests, routing, sending and dispatching pools
 
 private:
     std::unique_ptr<SmartBuildingNetworkProtocol> m_networkProtocolParser;
+    std::shared_ptr<advcpp::ThreadBudget> m_threadsBudget; // Shared by all the workers pools - together they never run more workers than the machine's cores
     std::shared_ptr<EventsSubscriptionOrganizer> m_subscribersOrganizer;
     std::shared_ptr<EventsRouter> m_router;
     std::shared_ptr<SoftwareAgentsManager> m_agentsManager;
     std::shared_ptr<SafeLoggersManager> m_loggersManager;
     std::shared_ptr<RemoteDevicesSocketsManager> m_socketsManager;
+    std::shared_ptr<RequestsWorkers> m_requestsWorkers;
+    std::mutex m_starvedRequestsWorksLock;
+    std::deque<RequestsWork> m_starvedRequestsWorks; // Of the connections whose requests work could not be submitted - their reading is paused until a worker takes them over
+    std::mutex m_parkedRequestsWorksLock;
+    std::vector<RequestsWork> m_parkedRequestsWorks; // Of the connections whose event could not be published - their reading is paused until the routing workers resume them
     std::shared_ptr<advcpp::ThreadPool<advcpp::ShutdownPolicy<>>> m_routingWorkers;
     std::shared_ptr<advcpp::ThreadPool<advcpp::ShutdownPolicy<>>> m_sendingWorkers;
+    advcpp::ThreadPoolAutoscaler<RequestsWorkers> m_requestsWorkersScaler;
+    advcpp::ThreadPoolAutoscaler<advcpp::ThreadPool<advcpp::ShutdownPolicy<>>> m_routingWorkersScaler;
+    advcpp::ThreadPoolAutoscaler<advcpp::ThreadPool<advcpp::ShutdownPolicy<>>> m_sendingWorkersScaler;
     std::shared_ptr<advcpp::BlockingBoundedQueue<Event, advcpp::NoOperationPolicy<Event>>> m_publishedEventsQueue;
-    std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> m_handledBuffersQueue;
-    std::shared_ptr<advcpp::Thread<advcpp::DetachPolicy>> m_publishedEventsTransmitter;
-    std::shared_ptr<advcpp::Thread<advcpp::DetachPolicy>> m_handledBuffersTransmitter;
-    infra::TCPServer<OnClientMessageHandler,OnErrorHandler,OnNewClientConnectionHandler,OnCloseClientConnectionHandler> m_tcpServerDriver;
+    std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>> m_handledBuffersQueue;
+    std::shared_ptr<advcpp::ICallable> m_handledBuffersSender; // Triggered by the invokers after every flush to m_handledBuffersQueue
+    std::vector<std::unique_ptr<HubServer>> m_tcpServerDrivers; // One per reactor - each with its own listening socket and connections
 };
 
 } // smartbuilding
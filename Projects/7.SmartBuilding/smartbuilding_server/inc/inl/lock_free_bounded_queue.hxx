@@ -0,0 +1,494 @@
+#ifndef NM_LOCK_FREE_BOUNDED_QUEUE_HXX
+#define NM_LOCK_FREE_BOUNDED_QUEUE_HXX
+
+
+#include <cstddef> // size_t
+#include <chrono> // std::chrono::nanoseconds, std::chrono::steady_clock
+#include <mutex> // std::mutex, std::lock_guard, std::unique_lock
+#include <condition_variable> // std::condition_variable, std::cv_status
+#include <thread> // std::this_thread::yield
+#include <utility> // std::move
+#include <stdexcept> // std::runtime_error
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+template <typename T, typename DestructionPolicy>
+LockFreeBoundedQueue<T,DestructionPolicy>::LockFreeBoundedQueue(size_t a_initialCapacity, DestructionPolicy a_destructionPolicy)
+: m_capacity(RoundUpToPowerOfTwo(a_initialCapacity))
+, m_indexMask(m_capacity - 1)
+, m_slots(m_capacity)
+, m_enqueuePositionPadding()
+, m_enqueuePosition(0)
+, m_dequeuePositionPadding()
+, m_dequeuePosition(0)
+, m_parkedWaitersPadding()
+, m_parkedProducers(0)
+, m_parkedConsumers(0)
+, m_notFullMutex()
+, m_notFull()
+, m_notEmptyMutex()
+, m_notEmpty()
+, m_destructionPolicy(a_destructionPolicy)
+, m_enqueueWaiters(0)
+, m_dequeueWaiters(0)
+, m_isValid(true)
+{
+    if(!a_initialCapacity)
+    {
+        throw std::runtime_error("Initial capacity cannot be zero");
+    }
+
+    for(size_t i = 0; i < m_capacity; ++i)
+    {
+        m_slots[i].m_sequence.Set(i); // Slot i is free for the producer of position i
+    }
+}
+
+
+template <typename T, typename DestructionPolicy>
+LockFreeBoundedQueue<T,DestructionPolicy>::~LockFreeBoundedQueue()
+{
+    Close();
+    ReleaseAllBlockedWaiters();
+    m_destructionPolicy(*this);
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::Enqueue(const T& a_item)
+{
+    T itemCopy(a_item); // Exception prone code - copy-constructor may fail (before the queue is touched)
+
+    return Enqueue(std::move(itemCopy));
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::Enqueue(T&& a_item)
+{
+    if(IsClosed())
+    {
+        return false;
+    }
+
+    if(TryPush(a_item)) // Fast path - a free slot is available, not counted as a waiter
+    {
+        WakeParkedConsumer();
+        return true;
+    }
+
+    ++m_enqueueWaiters;
+    bool hasPushed = PushOrWait(a_item, nullptr);
+    --m_enqueueWaiters;
+
+    return hasPushed;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::Dequeue(T& a_itemToReturnByRef)
+{
+    if(IsClosed())
+    {
+        return false;
+    }
+
+    if(TryPop(a_itemToReturnByRef)) // Fast path - an item is available, not counted as a waiter
+    {
+        WakeParkedProducer();
+        return true;
+    }
+
+    ++m_dequeueWaiters;
+    bool hasPopped = PopOrWait(a_itemToReturnByRef);
+    --m_dequeueWaiters;
+
+    return hasPopped;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::TryEnqueue(const T& a_item)
+{
+    T itemCopy(a_item); // Exception prone code - copy-constructor may fail (before the queue is touched)
+
+    return TryEnqueue(std::move(itemCopy));
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::TryEnqueue(T&& a_item)
+{
+    if(IsClosed())
+    {
+        return false;
+    }
+
+    if(!TryPush(a_item)) // The queue is full - not waiting at all
+    {
+        return false;
+    }
+    WakeParkedConsumer();
+
+    return true;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::EnqueueFor(const T& a_item, std::chrono::nanoseconds a_timeout)
+{
+    T itemCopy(a_item); // Exception prone code - copy-constructor may fail (before the queue is touched)
+
+    return EnqueueFor(std::move(itemCopy), a_timeout);
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::EnqueueFor(T&& a_item, std::chrono::nanoseconds a_timeout)
+{
+    if(IsClosed())
+    {
+        return false;
+    }
+
+    TimePoint deadline = std::chrono::steady_clock::now() + a_timeout;
+
+    ++m_enqueueWaiters;
+    bool hasPushed = PushOrWait(a_item, &deadline);
+    --m_enqueueWaiters;
+
+    return hasPushed;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::TryDequeue(T& a_itemToReturnByRef)
+{
+    if(IsClosed())
+    {
+        return false;
+    }
+
+    if(!TryPop(a_itemToReturnByRef)) // The queue is empty - not waiting at all
+    {
+        return false;
+    }
+    WakeParkedProducer();
+
+    return true;
+}
+
+
+template <typename T, typename DestructionPolicy>
+size_t LockFreeBoundedQueue<T,DestructionPolicy>::Size() const
+{
+    if(IsClosed())
+    {
+        return 0;
+    }
+
+    return GetSize();
+}
+
+
+template <typename T, typename DestructionPolicy>
+size_t LockFreeBoundedQueue<T,DestructionPolicy>::Capacity() const
+{
+    if(IsClosed())
+    {
+        return 0;
+    }
+
+    return m_capacity; // This value isn't changing - no race condition here (only read operations)
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::IsEmpty() const
+{
+    if(IsClosed())
+    {
+        return true;
+    }
+
+    return GetSize() == 0;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::IsFull() const
+{
+    if(IsClosed())
+    {
+        return false;
+    }
+
+    return GetSize() == m_capacity;
+}
+
+
+template <typename T, typename DestructionPolicy>
+void LockFreeBoundedQueue<T,DestructionPolicy>::ReleaseAllBlockedWaiters()
+{
+    // Notifying under the locks - a waiter that has checked IsClosed() right before the Close() is already waiting on its condition variable
+    {
+        std::lock_guard<std::mutex> lock(m_notFullMutex);
+        m_notFull.notify_all();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_notEmptyMutex);
+        m_notEmpty.notify_all();
+    }
+
+    // Waiting for the threads to exit completely (to avoid race condition at the destruction of the queue):
+    while(m_enqueueWaiters.Get() > 0 || m_dequeueWaiters.Get() > 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+
+template <typename T, typename DestructionPolicy>
+void LockFreeBoundedQueue<T,DestructionPolicy>::Close()
+{
+    m_isValid.False();
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::IsClosed() const
+{
+    return !m_isValid.Check();
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::PushOrWait(T& a_item, const TimePoint* a_deadline)
+{
+    // Spin, then yield - the queue is usually full only for a very short period
+    for(size_t i = 0; i < SPIN_ITERATIONS + YIELD_ITERATIONS; ++i)
+    {
+        if(IsClosed())
+        {
+            return false;
+        }
+
+        if(TryPush(a_item))
+        {
+            WakeParkedConsumer();
+            return true;
+        }
+
+        if(i >= SPIN_ITERATIONS)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // Park
+    bool hasPushed = false;
+    {
+        std::unique_lock<std::mutex> lock(m_notFullMutex);
+        ++m_parkedProducers; // Must be visible before the last TryPush, so a consumer that frees a slot afterwards would notify
+        while(!IsClosed() && !(hasPushed = TryPush(a_item)))
+        {
+            if(a_deadline == nullptr)
+            {
+                m_notFull.wait(lock);
+            }
+            else if(m_notFull.wait_until(lock, *a_deadline) == std::cv_status::timeout)
+            {
+                hasPushed = !IsClosed() && TryPush(a_item); // Last chance
+                break;
+            }
+        }
+        --m_parkedProducers;
+    }
+
+    if(hasPushed)
+    {
+        WakeParkedConsumer();
+    }
+
+    return hasPushed;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::PopOrWait(T& a_itemToReturnByRef)
+{
+    // Spin, then yield - the queue is usually empty only for a very short period
+    for(size_t i = 0; i < SPIN_ITERATIONS + YIELD_ITERATIONS; ++i)
+    {
+        if(IsClosed())
+        {
+            return false;
+        }
+
+        if(TryPop(a_itemToReturnByRef))
+        {
+            WakeParkedProducer();
+            return true;
+        }
+
+        if(i >= SPIN_ITERATIONS)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // Park
+    bool hasPopped = false;
+    {
+        std::unique_lock<std::mutex> lock(m_notEmptyMutex);
+        ++m_parkedConsumers; // Must be visible before the last TryPop, so a producer that fills a slot afterwards would notify
+        while(!IsClosed() && !(hasPopped = TryPop(a_itemToReturnByRef)))
+        {
+            m_notEmpty.wait(lock);
+        }
+        --m_parkedConsumers;
+    }
+
+    if(hasPopped)
+    {
+        WakeParkedProducer();
+    }
+
+    return hasPopped;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::TryPush(T& a_item)
+{
+    size_t position = m_enqueuePosition.Get();
+    while(true)
+    {
+        Slot& slot = m_slots[position & m_indexMask];
+        size_t sequence = slot.m_sequence.Get();
+        if(sequence == position) // The slot is free for this position - try to claim it
+        {
+            if(m_enqueuePosition.SetIf(position, position + 1))
+            {
+                slot.m_item = std::move(a_item); // Can't throw (a concept of T)
+                slot.m_sequence.Set(position + 1); // Publish the item to the consumer of this position
+                return true;
+            }
+            position = m_enqueuePosition.Get(); // Another producer has claimed it first
+        }
+        else if(sequence < position) // The slot still holds the item of the previous lap - the queue is full
+        {
+            return false;
+        }
+        else // Another producer has claimed this position already
+        {
+            position = m_enqueuePosition.Get();
+        }
+    }
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::TryPop(T& a_itemToReturnByRef)
+{
+    size_t position = m_dequeuePosition.Get();
+    while(true)
+    {
+        Slot& slot = m_slots[position & m_indexMask];
+        size_t sequence = slot.m_sequence.Get();
+        if(sequence == position + 1) // The slot holds the item of this position - try to claim it
+        {
+            if(m_dequeuePosition.SetIf(position, position + 1))
+            {
+                a_itemToReturnByRef = std::move(slot.m_item);
+                slot.m_sequence.Set(position + m_capacity); // Free the slot for the producer of the next lap
+                return true;
+            }
+            position = m_dequeuePosition.Get(); // Another consumer has claimed it first
+        }
+        else if(sequence < position + 1) // The item of this position has not been published yet - the queue is empty
+        {
+            return false;
+        }
+        else // Another consumer has claimed this position already
+        {
+            position = m_dequeuePosition.Get();
+        }
+    }
+}
+
+
+template <typename T, typename DestructionPolicy>
+void LockFreeBoundedQueue<T,DestructionPolicy>::WakeParkedProducer()
+{
+    if(m_parkedProducers.Get() > 0) // The common (not parked) path costs a single atomic read
+    {
+        std::lock_guard<std::mutex> lock(m_notFullMutex);
+        m_notFull.notify_one();
+    }
+}
+
+
+template <typename T, typename DestructionPolicy>
+void LockFreeBoundedQueue<T,DestructionPolicy>::WakeParkedConsumer()
+{
+    if(m_parkedConsumers.Get() > 0) // The common (not parked) path costs a single atomic read
+    {
+        std::lock_guard<std::mutex> lock(m_notEmptyMutex);
+        m_notEmpty.notify_one();
+    }
+}
+
+
+template <typename T, typename DestructionPolicy>
+size_t LockFreeBoundedQueue<T,DestructionPolicy>::RoundUpToPowerOfTwo(size_t a_value)
+{
+    size_t powerOfTwo = 1;
+    while(powerOfTwo < a_value)
+    {
+        powerOfTwo <<= 1;
+    }
+
+    return powerOfTwo;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::RemoveNext(T& a_itemToReturnByRef) noexcept
+{
+    try // Exception safety
+    {
+        return TryPop(a_itemToReturnByRef);
+    }
+    catch(...)
+    {
+        return false;
+    }
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool LockFreeBoundedQueue<T,DestructionPolicy>::Empty() const noexcept
+{
+    return GetSize() == 0;
+}
+
+
+template <typename T, typename DestructionPolicy>
+size_t LockFreeBoundedQueue<T,DestructionPolicy>::GetSize() const noexcept
+{
+    // Reading the dequeue position first - it never passes the enqueue position, so the difference can't underflow
+    size_t dequeuePosition = m_dequeuePosition.Get();
+    size_t enqueuePosition = m_enqueuePosition.Get();
+    size_t size = enqueuePosition - dequeuePosition;
+
+    return size < m_capacity ? size : m_capacity; // Both positions may advance between the reads
+}
+
+} // advcpp
+
+
+#endif // NM_LOCK_FREE_BOUNDED_QUEUE_HXX
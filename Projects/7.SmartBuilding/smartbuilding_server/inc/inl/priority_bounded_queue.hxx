@@ -0,0 +1,362 @@
+#ifndef NM_PRIORITY_BOUNDED_QUEUE_HXX
+#define NM_PRIORITY_BOUNDED_QUEUE_HXX
+
+
+#include <cstddef> // size_t
+#include <chrono> // std::chrono::nanoseconds
+#include <mutex> // std::mutex, std::unique_lock
+#include <condition_variable> // std::condition_variable
+#include <utility> // std::move, std::forward, std::move_if_noexcept
+#include <stdexcept> // std::runtime_error, std::invalid_argument
+#include "priority.hpp"
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+namespace priority_bounded_queue_details
+{
+
+// A timeout that means "wait until it is possible" (or until the queue is closed)
+inline std::chrono::nanoseconds WaitForever()
+{
+    return std::chrono::nanoseconds::max();
+}
+
+} // priority_bounded_queue_details
+
+
+template <typename T, typename DestructionPolicy>
+PriorityBoundedQueue<T,DestructionPolicy>::PriorityBoundedQueue(size_t a_laneCapacity, DestructionPolicy a_destructionPolicy, const LaneWeights& a_laneWeights)
+: m_lanes()
+, m_laneSizes()
+, m_size(0)
+, m_laneCapacity(a_laneCapacity)
+, m_laneWeights(a_laneWeights)
+, m_laneCredits(a_laneWeights)
+, m_mutex()
+, m_laneNotFull()
+, m_notEmpty()
+, m_noWaiters()
+, m_waiters(0)
+, m_isClosed(false)
+, m_destructionPolicy(a_destructionPolicy)
+{
+    if(!a_laneCapacity)
+    {
+        throw std::runtime_error("Lane capacity cannot be zero");
+    }
+
+    for(size_t lane = 0; lane < PRIORITIES_COUNT; ++lane)
+    {
+        if(!a_laneWeights[lane])
+        {
+            throw std::runtime_error("Lane weight cannot be zero");
+        }
+    }
+}
+
+
+template <typename T, typename DestructionPolicy>
+PriorityBoundedQueue<T,DestructionPolicy>::~PriorityBoundedQueue()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_isClosed = true;
+
+    // Release all the blocked waiters, and wait for them to leave before the conditions are destroyed
+    for(size_t lane = 0; lane < PRIORITIES_COUNT; ++lane)
+    {
+        m_laneNotFull[lane].notify_all();
+    }
+    m_notEmpty.notify_all();
+    m_noWaiters.wait(lock, [this]() { return m_waiters == 0; });
+
+    m_destructionPolicy(*this);
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::Enqueue(const T& a_item)
+{
+    return EnqueueItem(a_item, Priority::NORMAL, priority_bounded_queue_details::WaitForever());
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::Enqueue(T&& a_item)
+{
+    return EnqueueItem(std::move(a_item), Priority::NORMAL, priority_bounded_queue_details::WaitForever());
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::Enqueue(const T& a_item, Priority a_priority)
+{
+    return EnqueueItem(a_item, a_priority, priority_bounded_queue_details::WaitForever());
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::Enqueue(T&& a_item, Priority a_priority)
+{
+    return EnqueueItem(std::move(a_item), a_priority, priority_bounded_queue_details::WaitForever());
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::Dequeue(T& a_itemToReturnByRef)
+{
+    return DequeueItem(a_itemToReturnByRef, priority_bounded_queue_details::WaitForever());
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::TryEnqueue(const T& a_item)
+{
+    return EnqueueItem(a_item, Priority::NORMAL, std::chrono::nanoseconds(0));
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::TryEnqueue(T&& a_item)
+{
+    return EnqueueItem(std::move(a_item), Priority::NORMAL, std::chrono::nanoseconds(0));
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::TryEnqueue(T&& a_item, Priority a_priority)
+{
+    return EnqueueItem(std::move(a_item), a_priority, std::chrono::nanoseconds(0));
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::EnqueueFor(const T& a_item, std::chrono::nanoseconds a_timeout)
+{
+    return EnqueueItem(a_item, Priority::NORMAL, a_timeout);
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::EnqueueFor(T&& a_item, std::chrono::nanoseconds a_timeout)
+{
+    return EnqueueItem(std::move(a_item), Priority::NORMAL, a_timeout);
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::EnqueueFor(T&& a_item, Priority a_priority, std::chrono::nanoseconds a_timeout)
+{
+    return EnqueueItem(std::move(a_item), a_priority, a_timeout);
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::TryDequeue(T& a_itemToReturnByRef)
+{
+    return DequeueItem(a_itemToReturnByRef, std::chrono::nanoseconds(0));
+}
+
+
+template <typename T, typename DestructionPolicy>
+size_t PriorityBoundedQueue<T,DestructionPolicy>::Size() const
+{
+    return m_size.Get();
+}
+
+
+template <typename T, typename DestructionPolicy>
+size_t PriorityBoundedQueue<T,DestructionPolicy>::LaneSize(Priority a_priority) const
+{
+    return m_laneSizes[LaneOf(a_priority)].Get();
+}
+
+
+template <typename T, typename DestructionPolicy>
+size_t PriorityBoundedQueue<T,DestructionPolicy>::Capacity() const
+{
+    return m_laneCapacity * PRIORITIES_COUNT;
+}
+
+
+template <typename T, typename DestructionPolicy>
+size_t PriorityBoundedQueue<T,DestructionPolicy>::LaneCapacity() const
+{
+    return m_laneCapacity;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::IsEmpty() const
+{
+    return m_size.Get() == 0;
+}
+
+
+template <typename T, typename DestructionPolicy>
+typename PriorityBoundedQueue<T,DestructionPolicy>::LaneWeights PriorityBoundedQueue<T,DestructionPolicy>::DefaultLaneWeights()
+{
+    return LaneWeights{{8, 4, 1}};
+}
+
+
+template <typename T, typename DestructionPolicy>
+size_t PriorityBoundedQueue<T,DestructionPolicy>::LaneOf(Priority a_priority)
+{
+    size_t lane = static_cast<size_t>(a_priority);
+    if(lane >= PRIORITIES_COUNT)
+    {
+        throw std::invalid_argument("Unknown priority");
+    }
+
+    return lane;
+}
+
+
+template <typename T, typename DestructionPolicy>
+template <typename Item>
+bool PriorityBoundedQueue<T,DestructionPolicy>::EnqueueItem(Item&& a_item, Priority a_priority, std::chrono::nanoseconds a_timeout)
+{
+    size_t lane = LaneOf(a_priority);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    bool hasFreeSlot = WaitFor(lock, m_laneNotFull[lane], a_timeout, [this, lane]() { return m_isClosed || m_lanes[lane].size() < m_laneCapacity; });
+    if(!hasFreeSlot || m_isClosed)
+    {
+        return false;
+    }
+
+    m_lanes[lane].push_back(std::forward<Item>(a_item)); // Exception safety - nothing was changed if it throws
+    ++m_laneSizes[lane];
+    ++m_size;
+    lock.unlock();
+
+    m_notEmpty.notify_one();
+    return true;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::DequeueItem(T& a_itemToReturnByRef, std::chrono::nanoseconds a_timeout)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    bool hasItem = WaitFor(lock, m_notEmpty, a_timeout, [this]() { return m_isClosed || m_size.Get() > 0; });
+    if(!hasItem || m_isClosed)
+    {
+        return false;
+    }
+
+    size_t lane = NextLane();
+    PopFront(lane, a_itemToReturnByRef);
+    --m_laneCredits[lane];
+    lock.unlock();
+
+    m_laneNotFull[lane].notify_one();
+    return true;
+}
+
+
+template <typename T, typename DestructionPolicy>
+template <typename Predicate>
+bool PriorityBoundedQueue<T,DestructionPolicy>::WaitFor(std::unique_lock<std::mutex>& a_lock, std::condition_variable& a_condition, std::chrono::nanoseconds a_timeout, Predicate a_predicate)
+{
+    if(a_predicate())
+    {
+        return true;
+    }
+
+    ++m_waiters;
+    bool isSatisfied = true;
+    if(a_timeout == priority_bounded_queue_details::WaitForever())
+    {
+        a_condition.wait(a_lock, a_predicate);
+    }
+    else
+    {
+        isSatisfied = a_condition.wait_for(a_lock, a_timeout, a_predicate);
+    }
+    --m_waiters;
+
+    if(m_isClosed && !m_waiters)
+    {
+        m_noWaiters.notify_all();
+    }
+
+    return isSatisfied;
+}
+
+
+template <typename T, typename DestructionPolicy>
+size_t PriorityBoundedQueue<T,DestructionPolicy>::NextLane()
+{
+    // The first non-empty lane (most urgent first) that still has turns in the current round,
+    // if all of the non-empty lanes have used their turns - a new round begins
+    for(;;)
+    {
+        for(size_t lane = 0; lane < PRIORITIES_COUNT; ++lane)
+        {
+            if(!m_lanes[lane].empty() && m_laneCredits[lane])
+            {
+                return lane;
+            }
+        }
+
+        m_laneCredits = m_laneWeights;
+    }
+}
+
+
+template <typename T, typename DestructionPolicy>
+void PriorityBoundedQueue<T,DestructionPolicy>::PopFront(size_t a_lane, T& a_itemToReturnByRef)
+{
+    a_itemToReturnByRef = std::move_if_noexcept(m_lanes[a_lane].front()); // Exception safety - nothing was changed if it throws
+    m_lanes[a_lane].pop_front();
+    --m_laneSizes[a_lane];
+    --m_size;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::RemoveNext(T& a_itemToReturnByRef) noexcept
+{
+    for(size_t lane = 0; lane < PRIORITIES_COUNT; ++lane)
+    {
+        if(m_lanes[lane].empty())
+        {
+            continue;
+        }
+
+        try // Exception safety
+        {
+            PopFront(lane, a_itemToReturnByRef);
+        }
+        catch(...)
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+
+template <typename T, typename DestructionPolicy>
+bool PriorityBoundedQueue<T,DestructionPolicy>::Empty() const noexcept
+{
+    return m_size.Get() == 0;
+}
+
+
+template <typename T, typename DestructionPolicy>
+size_t PriorityBoundedQueue<T,DestructionPolicy>::GetSize() const noexcept
+{
+    return m_size.Get();
+}
+
+} // advcpp
+
+
+#endif // NM_PRIORITY_BOUNDED_QUEUE_HXX
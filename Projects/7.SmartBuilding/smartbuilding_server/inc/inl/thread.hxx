@@ -5,6 +5,7 @@
 #include <cstddef> // size_t
 #include <memory> // std:shared_ptr
 #include <exception> // std::current_exception
+#include <stdexcept> // std::runtime_error
 #include <pthread.h>
 #include <cxxabi.h> // abi::__forced_unwind
 #include "icallable.hpp"
@@ -145,6 +146,13 @@ bool Thread<DestructionPolicy>::HasDone()
 }
 
 
+template <typename DestructionPolicy>
+bool Thread<DestructionPolicy>::IsThread(pthread_t a_threadID) const
+{
+    return pthread_equal(m_threadID, a_threadID) != 0;
+}
+
+
 template <typename DestructionPolicy>
 int Thread<DestructionPolicy>::CallJoin()
 {
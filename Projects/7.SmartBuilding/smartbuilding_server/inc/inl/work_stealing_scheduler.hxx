@@ -0,0 +1,121 @@
+#ifndef NM_WORK_STEALING_SCHEDULER_HXX
+#define NM_WORK_STEALING_SCHEDULER_HXX
+
+
+#include <cstdint> // uintptr_t
+#include <memory> // std::shared_ptr
+#include <mutex> // std::mutex, std::lock_guard
+#include <random> // std::minstd_rand
+#include "icallable.hpp"
+#include "task.hpp"
+#include "two_way_multi_sync_handler.hpp"
+#include "latch.hpp"
+#include "workers_activity.hpp"
+#include "work_stealing_registry.hpp"
+
+
+namespace advcpp
+{
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+WorkStealingScheduler<QueueTypeDestructionPolicy,QueueType>::WorkStealingScheduler(std::shared_ptr<QueueType> a_worksQueue, std::shared_ptr<TwoWayMultiSyncHandler> a_twoWayMultiSyncHandler, std::shared_ptr<std::mutex> a_workersLock, std::shared_ptr<Latch> a_inFlightWorks, std::shared_ptr<WorkersActivity> a_workersActivity, std::shared_ptr<WorkStealingRegistry> a_registry)
+: m_worksQueue(a_worksQueue)
+, m_twoWayMultiSyncHandler(a_twoWayMultiSyncHandler)
+, m_workersLock(a_workersLock)
+, m_registry(a_registry)
+, m_inFlightWorks(a_inFlightWorks)
+, m_workersActivity(a_workersActivity)
+{
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+void WorkStealingScheduler<QueueTypeDestructionPolicy,QueueType>::operator()()
+{
+    std::shared_ptr<WorkStealingRegistry::WorksDeque> ownDeque = m_registry->Register();
+    std::minstd_rand randomGenerator(static_cast<std::minstd_rand::result_type>(reinterpret_cast<uintptr_t>(ownDeque.get()))); // Different victims order per worker
+
+    while(!HasAcceptedStopNotification())
+    {
+        Work work;
+        if(!FindWork(work, *ownDeque, randomGenerator) && !WaitForWork(work, randomGenerator))
+        {
+            break;
+        }
+        SafeExecute(work);
+    }
+
+    m_registry->Unregister();
+    if(ownDeque->Size() > 0 && m_registry->IdleWorkersCount() > 0)
+    {
+        m_worksQueue->TryEnqueue(Work()); // Wake up an idle worker to steal the remained works of this deque
+    }
+
+    m_twoWayMultiSyncHandler->SignalBack(); // Signals that the worker has finished its work and can be removed successfully
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+bool WorkStealingScheduler<QueueTypeDestructionPolicy,QueueType>::HasAcceptedStopNotification()
+{
+    if(m_twoWayMultiSyncHandler->NotificationsCount() > 0) // The thread pool notified N task to stop their execution
+    {
+        // Double check lock
+        std::lock_guard<std::mutex> guard(*m_workersLock);
+        if(m_twoWayMultiSyncHandler->NotificationsCount() > 0)
+        {
+            m_twoWayMultiSyncHandler->OneNotificationAccept();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+bool WorkStealingScheduler<QueueTypeDestructionPolicy,QueueType>::FindWork(Work& a_work, WorkStealingRegistry::WorksDeque& a_ownDeque, std::minstd_rand& a_randomGenerator)
+{
+    return a_ownDeque.Pop(a_work) || m_worksQueue->TryDequeue(a_work) || m_registry->Steal(a_work, a_randomGenerator);
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+bool WorkStealingScheduler<QueueTypeDestructionPolicy,QueueType>::WaitForWork(Work& a_work, std::minstd_rand& a_randomGenerator)
+{
+    // Announce the idleness before the last steal attempt - a worker that pushes to its own deque after this steal attempt sees the idle worker,
+    // and wakes it up through the works queue
+    m_registry->EnterIdle();
+    bool hasFoundWork = m_registry->Steal(a_work, a_randomGenerator) || m_worksQueue->Dequeue(a_work);
+    m_registry->ExitIdle();
+
+    return hasFoundWork;
+}
+
+
+template <typename QueueTypeDestructionPolicy, typename QueueType>
+void WorkStealingScheduler<QueueTypeDestructionPolicy,QueueType>::SafeExecute(Work& a_work) const
+{
+    if(!a_work) // Wake up works are empty
+    {
+        return;
+    }
+
+    m_workersActivity->WorkStarted();
+    try
+    {
+        a_work();
+    }
+    catch(...)
+    {
+        // For exception safety execution
+    }
+    m_workersActivity->WorkCompleted();
+
+    m_inFlightWorks->CountDown(); // The work has completed - lets a draining Shutdown know about it
+}
+
+} // advcpp
+
+
+#endif // NM_WORK_STEALING_SCHEDULER_HXX
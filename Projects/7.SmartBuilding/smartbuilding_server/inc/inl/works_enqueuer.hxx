@@ -2,7 +2,9 @@
 #define NM_WORKS_ENQUEUER_HXX
 
 #include <memory> // std::shared_ptr
+#include <utility> // std::move
 #include "icallable.hpp"
+#include "task.hpp"
 
 
 namespace advcpp
@@ -11,7 +13,7 @@ namespace advcpp
 template <typename QueueTypeDestructionPolicy, typename QueueType>
 WorksEnqueuer<QueueTypeDestructionPolicy,QueueType>::WorksEnqueuer(std::shared_ptr<QueueType> a_worksQueue, Work a_workToEnqueue)
 : m_worksQueue(a_worksQueue)
-, m_workToEnqueue(a_workToEnqueue)
+, m_workToEnqueue(std::move(a_workToEnqueue))
 {
 }
 
@@ -21,7 +23,7 @@ void WorksEnqueuer<QueueTypeDestructionPolicy,QueueType>::operator()()
 {
     try
     {
-        m_worksQueue->Enqueue(m_workToEnqueue);
+        m_worksQueue->Enqueue(std::move(m_workToEnqueue));
     }
     catch(...)
     {
@@ -2,31 +2,85 @@
 #define NM_INVOKER_WORK_HPP
 
 
+#include <cstddef> // size_t
 #include <memory> // std::shared_ptr
+#include <vector> // std::vector
+#include <utility> // std::pair, std::move
+#include <string> // std::string
 #include "icallable.hpp"
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
 #include "isubscriber.hpp"
 #include "event.hpp"
+#include "encoding_cache.hpp"
 
 
 namespace smartbuilding
 {
 
+// Notifies a batch of subscribers of a single event (one work per batch, and not per subscriber)
+// The subscribers' handled buffers are staged in a local vector, and moved to the handled buffers queue in bulk (one lock of the shared queue per flush)
+// Note: the flush never waits on a full queue without a drain on its way - after every flush it triggers the handled buffers sender (that drains
+// the queue without blocking), so the buffers of a large fan-out are sent while the rest of its subscribers are still notified
+// Note 2: the subscribers are notified within the event's EncodingCache - shared by all the batches of the event
+// Submitted BY VALUE to the invokers
 class InvokerWork : public advcpp::ICallable
 {
+    using HandledBuffer = std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>;
 public:
-    InvokerWork(std::shared_ptr<ISubscriber> a_toInvoke, const Event& a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue) : m_subscriber(a_toInvoke), m_event(a_event), m_handledBuffersQueue(a_handledBuffersQueue) {}
+    InvokerWork(std::vector<std::shared_ptr<ISubscriber>>&& a_toInvoke, const Event& a_event, std::shared_ptr<EncodingCache> a_encodingCache, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue, std::shared_ptr<advcpp::ICallable> a_handledBuffersSender)
+    : m_subscribers(std::move(a_toInvoke)), m_event(a_event), m_encodingCache(a_encodingCache), m_handledBuffersQueue(a_handledBuffersQueue), m_handledBuffersSender(a_handledBuffersSender) {}
 
     virtual void operator()() override
     {
-        m_subscriber->Notify(m_event, m_handledBuffersQueue);
+        std::vector<HandledBuffer> stagedBuffers;
+        stagedBuffers.reserve(m_subscribers.size()); // A controller stages (at most) a single buffer per event
+
+        {
+            EncodingCache::Scope encodingScope(*m_encodingCache);
+            for(size_t i = 0; i < m_subscribers.size(); ++i)
+            {
+                try
+                {
+                    m_subscribers[i]->Notify(m_event, stagedBuffers);
+                }
+                catch(...)
+                {
+                    // A failure of one subscriber should not drop the rest of the batch
+                }
+            }
+        }
+
+        Flush(stagedBuffers);
+    }
+
+private:
+    void Flush(std::vector<HandledBuffer>& a_stagedBuffers)
+    {
+        std::vector<HandledBuffer>::iterator toFlush = a_stagedBuffers.begin();
+        while(true)
+        {
+            toFlush += m_handledBuffersQueue->TryEnqueueBulk(toFlush, a_stagedBuffers.end());
+            (*m_handledBuffersSender)(); // After the queue was seen full - so the wait below always has a drain on its way
+            if(toFlush == a_stagedBuffers.end())
+            {
+                return;
+            }
+
+            if(!m_handledBuffersQueue->Enqueue(std::move(*toFlush))) // Waits for a single free slot - the rest are retried without waiting
+            {
+                return; // The queue is closed - the hub is shutting down
+            }
+            ++toFlush;
+        }
     }
 
 private:
-    std::shared_ptr<ISubscriber> m_subscriber;
+    std::vector<std::shared_ptr<ISubscriber>> m_subscribers;
     Event m_event;
-    std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> m_handledBuffersQueue;
+    std::shared_ptr<EncodingCache> m_encodingCache;
+    std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>> m_handledBuffersQueue;
+    std::shared_ptr<advcpp::ICallable> m_handledBuffersSender;
 };
 
 } // smartbuilding
@@ -16,7 +16,8 @@ class IPublisher
 {
 public:
     virtual ~IPublisher() = default;
-    virtual void Publish(infra::TCPSocket::BytesBufferProxy a_bytesBuffer, std::shared_ptr<advcpp::BlockingBoundedQueue<Event, advcpp::NoOperationPolicy<Event>>> a_publishedEventsQueue) = 0;
+    // Never blocks - returns false if a_publishedEventsQueue is full (the event was not published, the caller may publish it again later)
+    virtual bool Publish(infra::TCPSocket::BytesBufferProxy a_bytesBuffer, std::shared_ptr<advcpp::BlockingBoundedQueue<Event, advcpp::NoOperationPolicy<Event>>> a_publishedEventsQueue) = 0;
 };
 
 } // smartbuilding
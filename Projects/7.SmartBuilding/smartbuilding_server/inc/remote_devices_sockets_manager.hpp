@@ -2,29 +2,75 @@
 #define NM_REMOTE_DEVICES_SOCKETS_MANAGER_HPP
 
 
+#include <cstddef> // size_t
 #include <string> // std::string
-#include <memory> // std::shared_ptr
+#include <memory> // std::shared_ptr, std::unique_ptr
 #include <unordered_map>
-#include "tcp_socket.hpp"
+#include <vector> // std::vector
+#include <mutex> // std::mutex
+#include <atomic> // std::atomic
+#include <stdint.h> // uint32_t
+#include "outbound_queue.hpp"
+#include "connection_handle.hpp"
 
 
 namespace smartbuilding
 {
 
+// Multithreaded safe - the devices connect through all the hub's reactors, and are looked up by the sending workers:
+// The devices' IDs are kept in lock striped shards (connect / disconnect of devices of different shards do not contend), and each connected device
+// gets a slot in a flat array, that is read without a lock - Find by a ConnectionHandle is an index and two atomic loads
+// A device's connection is kept as its OutboundQueue - the buffers to the device are posted to the reactor that owns its connection, which sends them
 class RemoteDevicesSocketsManager
 {
 public:
-    RemoteDevicesSocketsManager() = default;
-    RemoteDevicesSocketsManager(const RemoteDevicesSocketsManager& a_other) = default;
-    RemoteDevicesSocketsManager& operator=(const RemoteDevicesSocketsManager& a_other) = default;
+    static const size_t DEFAULT_MAX_CONNECTIONS = 4096;
+
+public:
+    explicit RemoteDevicesSocketsManager(size_t a_maxConnections = DEFAULT_MAX_CONNECTIONS);
+    RemoteDevicesSocketsManager(const RemoteDevicesSocketsManager& a_other) = delete;
+    RemoteDevicesSocketsManager& operator=(const RemoteDevicesSocketsManager& a_other) = delete;
     ~RemoteDevicesSocketsManager() = default;
 
-    void Insert(const std::string& a_idAsKey, std::shared_ptr<infra::TCPSocket> a_socketAsValue);
+    // A device that connects again replaces its previous connection (and its previous handle becomes invalid)
+    // Returns INVALID_CONNECTION_HANDLE if all the connections' slots are used
+    ConnectionHandle Insert(const std::string& a_idAsKey, std::shared_ptr<infra::OutboundQueue> a_outputAsValue);
     void Remove(const std::string& a_idAsKey);
-    std::shared_ptr<infra::TCPSocket> Find(const std::string& a_idAsKey); // Returns nullptr if ID has not found
+    void Remove(const std::string& a_idAsKey, ConnectionHandle a_handle); // Only if a_handle is still the device's connection (it might have connected again meanwhile)
+    std::shared_ptr<infra::OutboundQueue> Find(const std::string& a_idAsKey); // Returns nullptr if ID has not found
+    std::shared_ptr<infra::OutboundQueue> Find(ConnectionHandle a_handle) const; // Lock-free, returns nullptr if the handle's device has disconnected (or if the handle is invalid)
+
+private:
+    static const size_t SHARDS_COUNT = 16; // Power of 2
+    static const unsigned int GENERATION_SHIFT = 32;
+    static const ConnectionHandle SLOT_INDEX_MASK = 0xFFFFFFFF;
+
+    struct Shard
+    {
+        Shard() : m_lock(), m_devicesIDsToHandles() {}
+
+        std::mutex m_lock;
+        std::unordered_map<std::string, ConnectionHandle> m_devicesIDsToHandles;
+    };
+
+    struct Slot
+    {
+        Slot() : m_output(), m_generation(0) {}
+
+        std::shared_ptr<infra::OutboundQueue> m_output; // Accessed by std::atomic_load / std::atomic_store only
+        std::atomic<uint32_t> m_generation; // Advanced when the slot is released - the handles of the previous device stop matching
+    };
+
+    Shard& ShardOf(const std::string& a_idAsKey);
+    ConnectionHandle AcquireSlot(std::shared_ptr<infra::OutboundQueue> a_output);
+    void ReleaseSlot(ConnectionHandle a_handle);
 
 private:
-    std::unordered_map<std::string, std::shared_ptr<infra::TCPSocket>> m_devicesIDsToSocketsTable;
+    Shard m_shards[SHARDS_COUNT];
+    size_t m_slotsCount;
+    std::unique_ptr<Slot[]> m_slots; // Never reallocated - the readers do not lock
+    std::mutex m_freeSlotsLock;
+    std::vector<uint32_t> m_freeSlots;
 };
 
 } // smartbuilding
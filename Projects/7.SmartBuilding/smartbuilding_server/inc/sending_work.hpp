@@ -2,11 +2,18 @@
 #define NM_SENDING_WORK_HPP
 
 
+#include <cstddef> // size_t
 #include <string> // std::string
 #include <memory> // std::shared_ptr
 #include <utility> // std::pair
+#include <vector> // std::vector
+#include <iterator> // std::back_inserter
+#include <chrono> // std::chrono::nanoseconds
 #include "icallable.hpp"
+#include "thread_pool.hpp"
+#include "thread_pool_destruction_policies.hpp"
 #include "tcp_socket.hpp"
+#include "outbound_queue.hpp"
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
 #include "remote_devices_sockets_manager.hpp"
@@ -15,31 +22,82 @@
 namespace smartbuilding
 {
 
+// The sending stage of the publish -> route -> encode -> send chain: submitted to the sending workers once the routed events were handled,
+// drains (without waiting) every handled buffer that is already in the queue in bursts of up to MAX_BATCH_SIZE, and posts each of them to the outbound queue
+// of its device's connection - the connection's reactor sends them (coalesced), so the workers never block on a socket, and never interleave their writes
+// Submitted BY VALUE to the sending workers (small enough to be held inside the pool's Task - no allocation per work)
 class SendingWork : public advcpp::ICallable
 {
 public:
-    SendingWork(std::pair<std::string,infra::TCPSocket::BytesBufferProxy> a_handledBuffer, std::shared_ptr<RemoteDevicesSocketsManager> a_devicesSocketsManager)
-    : m_handledBuffer(a_handledBuffer)
+    SendingWork(std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue, std::shared_ptr<RemoteDevicesSocketsManager> a_devicesSocketsManager)
+    : m_handledBuffersQueue(a_handledBuffersQueue)
     , m_devicesSocketsManager(a_devicesSocketsManager)
     {
     }
 
     virtual void operator()() override
     {
-        std::string deviceID = m_handledBuffer.first;
-        std::shared_ptr<infra::TCPSocket> deviceSocket = m_devicesSocketsManager->Find(deviceID);
-        if(deviceSocket)
+        std::vector<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>> handledBuffers;
+        handledBuffers.reserve(MAX_BATCH_SIZE);
+        while(m_handledBuffersQueue->DequeueBulk(std::back_inserter(handledBuffers), MAX_BATCH_SIZE, std::chrono::nanoseconds(0)) > 0) // Never waits - an empty queue means an earlier sending work took the buffers
         {
-            infra::TCPSocket::BytesBufferProxy dataBuffer = m_handledBuffer.second;
-            deviceSocket->Send(dataBuffer);
+            for(size_t i = 0; i < handledBuffers.size(); ++i)
+            {
+                try
+                {
+                    Send(handledBuffers[i]);
+                }
+                catch(...)
+                {
+                    // A failure of one buffer should not drop the rest of the batch
+                }
+            }
+            handledBuffers.clear();
         }
     }
 
 private:
-    std::pair<std::string,infra::TCPSocket::BytesBufferProxy> m_handledBuffer;
+    void Send(const std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>& a_handledBuffer)
+    {
+        std::shared_ptr<infra::OutboundQueue> deviceOutput = m_devicesSocketsManager->Find(a_handledBuffer.first); // By the device's handle - no hashing of its ID
+        if(deviceOutput)
+        {
+            deviceOutput->Post(a_handledBuffer.second); // Refused (and counted as dropped by the queue) above the connection's high-water mark - meanwhile its agent stops encoding for it (see SoftwareAgent::IsConnectionCongested)
+        }
+    }
+
+private:
+    static const size_t MAX_BATCH_SIZE = 32; // The handled buffers are dequeued in bursts of up to MAX_BATCH_SIZE buffers (one lock of the queue per burst)
+
+private:
+    std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>>> m_handledBuffersQueue;
     std::shared_ptr<RemoteDevicesSocketsManager> m_devicesSocketsManager;
 };
 
+
+
+// Triggers the sending stage without blocking: submits a SendingWork to the sending workers - if their queue is full, it already holds sending works
+// that have not started yet, and they drain the handled buffers queue anyway
+// The invokers trigger it after every flush of handled buffers (see InvokerWork), so a fan-out larger than the handled buffers queue never waits for a drain that is not on its way
+class SendingWorkTrigger : public advcpp::ICallable
+{
+public:
+    SendingWorkTrigger(std::shared_ptr<advcpp::ThreadPool<advcpp::ShutdownPolicy<>>> a_sendingWorkers, const SendingWork& a_sendingWork)
+    : m_sendingWorkers(a_sendingWorkers)
+    , m_sendingWork(a_sendingWork)
+    {
+    }
+
+    virtual void operator()() override
+    {
+        m_sendingWorkers->TrySubmit(SendingWork(m_sendingWork));
+    }
+
+private:
+    std::shared_ptr<advcpp::ThreadPool<advcpp::ShutdownPolicy<>>> m_sendingWorkers;
+    SendingWork m_sendingWork;
+};
+
 } // smartbuilding
 
 
@@ -0,0 +1,53 @@
+#ifndef NM_SO_MODULES_CACHE_HPP
+#define NM_SO_MODULES_CACHE_HPP
+
+
+#include <string> // std::string
+#include <memory> // std::unique_ptr
+#include <mutex> // std::mutex
+#include <unordered_map>
+#include "so_loader.hpp"
+
+
+namespace smartbuilding
+{
+
+// A process-wide cache of loaded .so modules, keyed by the module's path - each module is loaded once and each of its functions is fetched once,
+// no matter how many objects are made by it [Thread safety: guarded by a single lock]
+class SoModulesCache
+{
+public:
+    static SoModulesCache& Instance(); // Never destroyed - a module must stay loaded while objects that it made (and their vtables) are alive
+
+    // Concept of FunctionPtrType: FunctionPtrType must be a pointer to a function (of any type)
+    // Throws std::runtime_error if the module cannot be loaded, or if it has no such function
+    template <typename FunctionPtrType>
+    FunctionPtrType Fetch(const std::string& a_module, const std::string& a_function);
+
+private:
+    SoModulesCache();
+    SoModulesCache(const SoModulesCache& a_other) = delete;
+    SoModulesCache& operator=(const SoModulesCache& a_other) = delete;
+    ~SoModulesCache() = default;
+
+    void* FetchSymbol(const std::string& a_module, const std::string& a_function);
+
+private:
+    struct Module
+    {
+        std::unique_ptr<SoLoader> m_loader; // Held by pointer - SoLoader closes its module when it is destroyed (never, while it is cached)
+        std::unordered_map<std::string, void*> m_symbols;
+    };
+
+private:
+    std::mutex m_lock;
+    std::unordered_map<std::string, Module> m_modules;
+};
+
+} // smartbuilding
+
+
+#include "inl/so_modules_cache.hxx"
+
+
+#endif // NM_SO_MODULES_CACHE_HPP
@@ -11,6 +11,7 @@
 namespace smartbuilding
 {
 
+// The agents are added at the system's initialization - at runtime the table is only looked up (FindByID is safe to call concurrently)
 class SoftwareAgentsManager
 {
 public:
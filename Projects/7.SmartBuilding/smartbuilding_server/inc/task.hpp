@@ -0,0 +1,103 @@
+#ifndef NM_TASK_HPP
+#define NM_TASK_HPP
+
+
+#include <cstddef> // size_t, std::max_align_t
+#include <type_traits> // std::enable_if, std::decay, std::aligned_storage, std::integral_constant
+#include <utility> // std::declval
+
+
+namespace advcpp
+{
+
+class Task;
+
+namespace task_details
+{
+
+// IsTaskCallable<Func>::value is true if Func (after decay) is not a Task, and can be called as void(void)
+template <typename Func, typename = void>
+struct IsTaskCallable : std::false_type {};
+
+template <typename Func>
+struct IsTaskCallable<Func, decltype(void(std::declval<typename std::decay<Func>::type&>()()))>
+: std::integral_constant<bool, !std::is_same<typename std::decay<Func>::type, Task>::value> {};
+
+} // task_details
+
+
+// A move-only, type-erased callable [void(void)] that holds its callable object BY VALUE - the ThreadPool's work type
+// Callables that fit into INLINE_BUFFER_SIZE bytes (and whose move-constructor cannot throw) are held inside the Task itself (no heap allocation at all),
+// bigger callables are moved to the heap (a single allocation, without a reference count)
+// Concept of Func: Func must be move-constructable (or copy-constructable), and must be callable as void(void) (functors, lambdas, global functions)
+// Note: An existing std::shared_ptr<ICallable> can be wrapped by ICallableToTaskAdapter (see callable_functions_adapters.hpp)
+class Task
+{
+public:
+    Task() noexcept; // An empty task (evaluates to false)
+    template <typename Func, typename = typename std::enable_if<task_details::IsTaskCallable<Func>::value>::type>
+    Task(Func&& a_func); // Implicit - to let a plain lambda be submitted as a work
+    Task(Task&& a_other) noexcept;
+    Task& operator=(Task&& a_other) noexcept;
+    Task(const Task& a_other) = delete;
+    Task& operator=(const Task& a_other) = delete;
+    ~Task();
+
+    void operator()(); // Throws std::runtime_error if the task is empty
+    explicit operator bool() const noexcept;
+    bool IsInline() const noexcept; // True if the callable object is held inside the task's buffer
+
+public:
+    static const size_t INLINE_BUFFER_SIZE = 64;
+
+private:
+    using Buffer = std::aligned_storage<INLINE_BUFFER_SIZE, alignof(std::max_align_t)>::type;
+
+    // The operations of the held callable type (one static table per callable type, and per storage kind)
+    struct Operations
+    {
+        void (*m_invoke)(Buffer& a_buffer);
+        void (*m_moveTo)(Buffer& a_from, Buffer& a_to) noexcept; // Leaves a_from without any callable object to destroy
+        void (*m_destroy)(Buffer& a_buffer) noexcept;
+        bool m_isInline;
+    };
+
+    template <typename Func>
+    struct InlineOperations
+    {
+        static void Invoke(Buffer& a_buffer);
+        static void MoveTo(Buffer& a_from, Buffer& a_to) noexcept;
+        static void Destroy(Buffer& a_buffer) noexcept;
+        static const Operations s_operations;
+    };
+
+    template <typename Func>
+    struct HeapOperations
+    {
+        static void Invoke(Buffer& a_buffer);
+        static void MoveTo(Buffer& a_from, Buffer& a_to) noexcept;
+        static void Destroy(Buffer& a_buffer) noexcept;
+        static const Operations s_operations;
+    };
+
+    template <typename Func>
+    struct FitsInline : std::integral_constant<bool, sizeof(Func) <= INLINE_BUFFER_SIZE && alignof(Func) <= alignof(Buffer) && std::is_nothrow_move_constructible<Func>::value> {};
+
+    template <typename Func>
+    void Construct(Func&& a_func, std::true_type a_fitsInline);
+    template <typename Func>
+    void Construct(Func&& a_func, std::false_type a_fitsInline);
+    void Reset() noexcept;
+
+private:
+    Buffer m_buffer;
+    const Operations* m_operations; // nullptr for an empty task
+};
+
+} // advcpp
+
+
+#include "inl/task.hxx"
+
+
+#endif // NM_TASK_HPP
@@ -13,7 +13,7 @@ namespace infra
 class TCPListeningSocket : public TCPSocket
 {
 public:
-    TCPListeningSocket(unsigned int a_listeningPortNumber, bool a_isNoBlockingRequired = false); // The listening socket will listen to any Ip Address by default
+    TCPListeningSocket(unsigned int a_listeningPortNumber, bool a_isNoBlockingRequired = false, bool a_isPortSharingRequired = false); // The listening socket will listen to any Ip Address by default, port sharing (SO_REUSEPORT) lets several listening sockets bind the same port - the kernel balances the new connections between them
     TCPListeningSocket(const TCPListeningSocket& a_other) = delete;
     TCPListeningSocket& operator=(const TCPListeningSocket& a_other) = delete;
     virtual ~TCPListeningSocket() = default;
@@ -38,6 +38,7 @@ private:
     std::shared_ptr<TCPSocket> m_lastAcceptedClientSocket;
     SocketID m_lastAcceptedClientSocketID;
     bool m_isNoBlockingRequired;
+    bool m_isPortSharingRequired;
 };
 
 } // infra
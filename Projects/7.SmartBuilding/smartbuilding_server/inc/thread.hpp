@@ -35,6 +35,7 @@ public:
     void Cancel(bool a_ensureCompleteCancelation = false);
 
     bool HasDone();
+    bool IsThread(pthread_t a_threadID) const; // a_threadID is the ID of this thread (e.g. a pthread_self() of its task)
 
 private:
     static constexpr unsigned int BARRIER_COUNT = 2;
@@ -0,0 +1,36 @@
+#ifndef NM_THREAD_BUDGET_HPP
+#define NM_THREAD_BUDGET_HPP
+
+
+#include <cstddef> // size_t
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+// A global number of threads that several thread pools share (through their ThreadPoolAutoscalers) - a pool grows only by threads it has acquired
+// TryAcquire and Release are lock-free
+class ThreadBudget
+{
+public:
+    explicit ThreadBudget(size_t a_capacity); // Throws std::runtime_error if a_capacity is 0
+    ThreadBudget(const ThreadBudget& a_other) = delete;
+    ThreadBudget& operator=(const ThreadBudget& a_other) = delete;
+    ~ThreadBudget() = default;
+
+    bool TryAcquire(size_t a_threads = 1); // Returns false (acquires nothing) if less than a_threads are available
+    void Release(size_t a_threads = 1); // Throws std::runtime_error if more threads are released than were acquired
+
+    size_t Available() const;
+    size_t Capacity() const;
+
+private:
+    AtomicValue<size_t> m_available;
+    size_t m_capacity;
+};
+
+} // advcpp
+
+
+#endif // NM_THREAD_BUDGET_HPP
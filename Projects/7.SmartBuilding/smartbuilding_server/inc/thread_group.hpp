@@ -4,7 +4,9 @@
 
 #include <cstddef> // size_t
 #include <list>
+#include <vector> // std::vector
 #include <memory> // std::shared_ptr
+#include <pthread.h> // pthread_t
 #include "icallable.hpp"
 #include "thread.hpp"
 #include "atomic_value.hpp"
@@ -34,6 +36,7 @@ public:
 
     void Add(size_t a_threadsToAdd); // Cleans the done thread
     void Remove(size_t a_threadsToRemove); // Cleans the done thread
+    void JoinAndRemove(const std::vector<pthread_t>& a_threadsIDs); // Blocks until the given threads of the group have returned (they must be returning already), and removes them
 
     size_t Size(); // Cleans the done thread for more accuracy
 
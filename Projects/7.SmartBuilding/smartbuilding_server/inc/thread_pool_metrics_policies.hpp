@@ -0,0 +1,117 @@
+#ifndef NM_THREAD_POOL_METRICS_POLICIES_HPP
+#define NM_THREAD_POOL_METRICS_POLICIES_HPP
+
+
+#include <cstddef> // size_t
+#include <memory> // std::unique_ptr
+#include <chrono> // std::chrono::steady_clock
+#include <ostream> // std::ostream
+#include "task.hpp"
+#include "latency_histogram.hpp"
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+// What a ThreadPool is doing - returned by ThreadPool::Snapshot (the metrics fields stay empty when the pool's MetricsPolicy is NoMetricsPolicy)
+struct ThreadPoolMetricsSnapshot
+{
+    ThreadPoolMetricsSnapshot();
+
+    bool m_isEnabled; // False if the pool was compiled without metrics
+    size_t m_workers;
+    size_t m_pendingWorks;
+    size_t m_submittedWorks;
+    size_t m_executedWorks;
+    size_t m_stolenWorks; // Only a WorkStealingPolicy pool steals works
+    HistogramSnapshot m_queueWait; // From the submission of a work until a worker starts it
+    HistogramSnapshot m_runTime;
+    HistogramSnapshot m_enqueueTime; // How long the submitters were blocked by a full works queue
+};
+
+// A single log line: counters, and the p50 / p99 / max of each histogram (in microseconds)
+std::ostream& operator<<(std::ostream& a_os, const ThreadPoolMetricsSnapshot& a_snapshot);
+
+
+// Policies that define which metrics a ThreadPool collects on its hot path.
+// Each policy implements:
+// Stamp Now() const - the submission time of a work
+// Instrumented Instrument(Task& a_work, Stamp a_submitted) - replaces a_work (in place) by a work that measures its queue wait and run time
+// void Restore(Task& a_work, Instrumented a_instrumented) - gives back the original work of an instrumented work that was not submitted (e.g. a full queue)
+// void EnqueueCompleted(Stamp a_submitted) - a submitted work was inserted to the works queue
+// void Fill(ThreadPoolMetricsSnapshot& a_snapshot) const
+// Concept of MetricsPolicy: policy must be default-constructable
+
+
+// NoMetricsPolicy: Collects nothing - every call is an empty inline function, so the pool's hot path compiles to exactly the same code as without metrics [default]
+class NoMetricsPolicy
+{
+public:
+    struct Stamp {};
+    struct Instrumented {};
+
+    Stamp Now() const { return Stamp(); }
+    Instrumented Instrument(Task& a_work, Stamp a_submitted) { (void)(a_work); (void)(a_submitted); return Instrumented(); }
+    void Restore(Task& a_work, Instrumented a_instrumented) { (void)(a_work); (void)(a_instrumented); }
+    void EnqueueCompleted(Stamp a_submitted) { (void)(a_submitted); }
+    void Fill(ThreadPoolMetricsSnapshot& a_snapshot) const { (void)(a_snapshot); }
+};
+
+
+// HdrMetricsPolicy: Counts the submitted and executed works, and records the queue wait, run time and enqueue time of each work in HDR-style histograms
+// The metrics are kept in per-thread shards (each worker and submitter thread writes to its own shard, so the threads never contend on a counter),
+// that are merged only by Fill - no lock is taken at all
+// Costs two clock reads and a heap allocation per submitted work (the instrumented work holds the original one)
+class HdrMetricsPolicy
+{
+public:
+    using Stamp = std::chrono::steady_clock::time_point;
+    using Instrumented = Task*; // The original work, held by the instrumented one
+
+    HdrMetricsPolicy();
+    HdrMetricsPolicy(const HdrMetricsPolicy& a_other) = delete;
+    HdrMetricsPolicy& operator=(const HdrMetricsPolicy& a_other) = delete;
+    ~HdrMetricsPolicy() = default;
+
+    Stamp Now() const;
+    Instrumented Instrument(Task& a_work, Stamp a_submitted);
+    void Restore(Task& a_work, Instrumented a_instrumented);
+    void EnqueueCompleted(Stamp a_submitted);
+    void Fill(ThreadPoolMetricsSnapshot& a_snapshot) const;
+
+private:
+    class InstrumentedWork
+    {
+    public:
+        InstrumentedWork(std::unique_ptr<Task> a_work, Stamp a_submitted, HdrMetricsPolicy* a_metrics);
+
+        void operator()();
+
+    private:
+        std::unique_ptr<Task> m_work;
+        Stamp m_submitted;
+        HdrMetricsPolicy* m_metrics; // The pool (its policy) outlives the works it executes
+    };
+
+    struct Shard
+    {
+        LatencyHistogram m_queueWait;
+        LatencyHistogram m_runTime;
+        LatencyHistogram m_enqueueTime;
+        AtomicValue<size_t> m_submittedWorks;
+    };
+
+    Shard& CurrentShard(); // The calling thread's shard
+
+private:
+    static const size_t SHARDS_COUNT = 16;
+
+private:
+    std::unique_ptr<Shard[]> m_shards;
+};
+
+} // advcpp
+
+
+#endif // NM_THREAD_POOL_METRICS_POLICIES_HPP
@@ -0,0 +1,102 @@
+#ifndef NM_THREAD_POOL_SUBMISSION_POLICIES_HPP
+#define NM_THREAD_POOL_SUBMISSION_POLICIES_HPP
+
+
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr
+#include <vector> // std::vector
+#include <mutex> // std::mutex
+#include "icallable.hpp"
+#include "task.hpp"
+#include "thread.hpp"
+#include "thread_destruction_policies.hpp"
+#include "blocking_bounded_queue.hpp"
+#include "blocking_bounded_queue_destruction_policies.hpp"
+#include "two_way_multi_sync_handler.hpp"
+#include "latch.hpp"
+#include "workers_activity.hpp"
+#include "works_scheduler.hpp"
+#include "work_stealing_registry.hpp"
+#include "work_stealing_scheduler.hpp"
+
+
+namespace advcpp
+{
+// Policies that define how ThreadPool::SubmitWork inserts a new work to the pool's works queue.
+// Each policy is a FUNCTOR (implements operator() that gets 2 params: std::shared_ptr<QueueType> and the Work (Task) to insert), and implements:
+// std::shared_ptr<ICallable> CreateWorksScheduler(std::shared_ptr<QueueType>, std::shared_ptr<TwoWayMultiSyncHandler>, std::shared_ptr<std::mutex>, std::shared_ptr<Latch>, std::shared_ptr<WorkersActivity>) - the task
+// that all the pool's workers run (how a worker picks its next work), that must count down the given in-flight works latch once per executed (non-empty) work,
+// and must report each executed (non-empty) work to the given workers activity
+// size_t StolenWorksCount() const - the works that were executed by another worker than the one they were submitted to (0 if the policy never steals)
+// Concept of SubmissionPolicy: policy must be default-constructable
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Concept of QueueTypeDestructionPolicy: must be a destruction policy of the given Queue type, and must be a destruction policy of type T = Task
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Concept of QueueType: QueueType must implement Enqueue method (Suggestion: this method should be multithreaded-safe!),
+// and its T MUST be Task (QueueType< T = Task >)
+
+
+// DirectSubmissionPolicy: Enqueues the work from the caller's thread (blocks the caller while the works queue is full)
+template <typename QueueTypeDestructionPolicy = ClearPolicy<Task>, typename QueueType = BlockingBoundedQueue<Task, QueueTypeDestructionPolicy>>
+class DirectSubmissionPolicy
+{
+public:
+    void operator()(std::shared_ptr<QueueType> a_worksQueue, Task a_work);
+    std::shared_ptr<ICallable> CreateWorksScheduler(std::shared_ptr<QueueType> a_worksQueue, std::shared_ptr<TwoWayMultiSyncHandler> a_twoWayMultiSyncHandler, std::shared_ptr<std::mutex> a_workersLock, std::shared_ptr<Latch> a_inFlightWorks, std::shared_ptr<WorkersActivity> a_workersActivity);
+    size_t StolenWorksCount() const;
+};
+
+
+// AsyncSubmissionPolicy: Enqueues the work from a new detached thread (never blocks the caller, but costs an OS thread per submitted work)
+// The enqueuing threads that have done their job are cleaned on each new submission
+template <typename QueueTypeDestructionPolicy = ClearPolicy<Task>, typename QueueType = BlockingBoundedQueue<Task, QueueTypeDestructionPolicy>>
+class AsyncSubmissionPolicy
+{
+public:
+    AsyncSubmissionPolicy() = default;
+    AsyncSubmissionPolicy(const AsyncSubmissionPolicy& a_other) = delete;
+    AsyncSubmissionPolicy& operator=(const AsyncSubmissionPolicy& a_other) = delete;
+    ~AsyncSubmissionPolicy() = default;
+
+    void operator()(std::shared_ptr<QueueType> a_worksQueue, Task a_work);
+    std::shared_ptr<ICallable> CreateWorksScheduler(std::shared_ptr<QueueType> a_worksQueue, std::shared_ptr<TwoWayMultiSyncHandler> a_twoWayMultiSyncHandler, std::shared_ptr<std::mutex> a_workersLock, std::shared_ptr<Latch> a_inFlightWorks, std::shared_ptr<WorkersActivity> a_workersActivity);
+    size_t StolenWorksCount() const;
+
+private:
+    void CleanDoneEnqueueThreads(); // Assumes that m_lock is locked already
+
+private:
+    std::vector<std::shared_ptr<Thread<DetachPolicy>>> m_enqueueWorkThreads;
+    std::mutex m_lock;
+};
+
+
+
+// WorkStealingPolicy: Each worker owns a local deque - a work that is submitted from a worker's thread is pushed to the worker's own deque
+// (and a work that is submitted from any other thread is enqueued to the shared works queue, like DirectSubmissionPolicy).
+// Idle workers steal works from random victims' deques.
+// Note: TrySubmit and SubmitFor always insert to the shared works queue
+template <typename QueueTypeDestructionPolicy = ClearPolicy<Task>, typename QueueType = BlockingBoundedQueue<Task, QueueTypeDestructionPolicy>>
+class WorkStealingPolicy
+{
+public:
+    WorkStealingPolicy();
+    WorkStealingPolicy(const WorkStealingPolicy& a_other) = delete;
+    WorkStealingPolicy& operator=(const WorkStealingPolicy& a_other) = delete;
+    ~WorkStealingPolicy() = default;
+
+    void operator()(std::shared_ptr<QueueType> a_worksQueue, Task a_work);
+    std::shared_ptr<ICallable> CreateWorksScheduler(std::shared_ptr<QueueType> a_worksQueue, std::shared_ptr<TwoWayMultiSyncHandler> a_twoWayMultiSyncHandler, std::shared_ptr<std::mutex> a_workersLock, std::shared_ptr<Latch> a_inFlightWorks, std::shared_ptr<WorkersActivity> a_workersActivity);
+    size_t StolenWorksCount() const;
+
+private:
+    std::shared_ptr<WorkStealingRegistry> m_registry;
+};
+
+} // advcpp
+
+
+#include "inl/thread_pool_submission_policies.hxx"
+
+
+#endif // NM_THREAD_POOL_SUBMISSION_POLICIES_HPP
@@ -0,0 +1,66 @@
+#ifndef NM_WORK_STEALING_DEQUE_HPP
+#define NM_WORK_STEALING_DEQUE_HPP
+
+
+#include <cstddef> // size_t
+#include <vector> // std::vector
+#include <type_traits> // std::aligned_storage
+#include "atomic_value.hpp"
+
+
+namespace advcpp
+{
+
+// A bounded Chase-Lev deque: the owner thread pushes and pops at the bottom (LIFO), while any other thread steals from the top (FIFO)
+// Push and Pop are called ONLY by the owner thread, Steal may be called by any thread concurrently
+// Each item is kept in its slot (no allocation per push), and is touched only by the thread that has claimed its position - a stealer that loses
+// its race never reads it, and the owner never reuses a slot until the item in it was moved out (a slot that is still being emptied counts as full)
+// Concept of T: MUST be move-constructable and move-assignable (and copy-constructable, if the copying Push is used)
+// Note: The capacity is rounded up to the next power of two
+template <typename T>
+class WorkStealingDeque
+{
+public:
+    explicit WorkStealingDeque(size_t a_capacity);
+    WorkStealingDeque(const WorkStealingDeque& a_other) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque& a_other) = delete;
+    ~WorkStealingDeque(); // Destroys the remained items
+
+    bool Push(const T& a_item); // Owner only - returns false if the deque is full (or if the slot to push to is still being emptied by a stealer)
+    bool Push(T&& a_item); // Owner only - moves from a_item only if it was pushed
+    bool Pop(T& a_itemToReturnByRef); // Owner only - returns false if the deque is empty
+    bool Steal(T& a_itemToReturnByRef); // Any thread - returns false if the deque is empty, or another thread has taken the top item first
+
+    size_t Size() const;
+    size_t Capacity() const;
+
+private:
+    struct Slot
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_item;
+        AtomicFlag m_isOccupied; // Set by the owner once the item was constructed, cleared by the thread that took it - once it was moved out
+    };
+
+private:
+    template <typename Item>
+    bool PushItem(Item&& a_item);
+    void TakeItemAt(long a_position, T& a_itemToReturnByRef); // Assumes that the position was claimed by the calling thread - moves the item out, and frees its slot
+    static size_t RoundUpToPowerOfTwo(size_t a_value);
+    Slot& SlotAt(long a_position);
+    static T* ItemOf(Slot& a_slot);
+
+private:
+    size_t m_capacity;
+    size_t m_indexMask;
+    std::vector<Slot> m_slots;
+    AtomicValue<long> m_top;
+    AtomicValue<long> m_bottom;
+};
+
+} // advcpp
+
+
+#include "inl/work_stealing_deque.hxx"
+
+
+#endif // NM_WORK_STEALING_DEQUE_HPP
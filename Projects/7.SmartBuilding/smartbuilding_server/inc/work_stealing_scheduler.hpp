@@ -0,0 +1,62 @@
+#ifndef NM_WORK_STEALING_SCHEDULER_HPP
+#define NM_WORK_STEALING_SCHEDULER_HPP
+
+
+#include <memory> // std::shared_ptr
+#include <mutex> // std::mutex
+#include <random> // std::minstd_rand
+#include "icallable.hpp"
+#include "task.hpp"
+#include "blocking_bounded_queue.hpp"
+#include "blocking_bounded_queue_destruction_policies.hpp"
+#include "two_way_multi_sync_handler.hpp"
+#include "latch.hpp"
+#include "workers_activity.hpp"
+#include "work_stealing_registry.hpp"
+
+
+namespace advcpp
+{
+
+// The workers' task of a work-stealing ThreadPool (shared by all the workers, each worker registers its own deque when it starts)
+// Each worker takes works from its own deque first (LIFO), then from the pool's shared works queue, then steals from a random victim's deque (FIFO),
+// and blocks on the shared works queue only when no work was found
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Concept of QueueTypeDestructionPolicy: must be a destruction policy of the given Queue type, and must be a destruction policy of type T = Task
+// --------------------------------------------------------------------------------------------------------------------------------------------------------------------
+// Concept of QueueType: QueueType must implement Enqueue, TryEnqueue, Dequeue and TryDequeue methods (Suggestion: these methods should be multithreaded-safe!),
+// and its T MUST be Task (QueueType< T = Task >)
+template <typename QueueTypeDestructionPolicy = ClearPolicy<Task>, typename QueueType = BlockingBoundedQueue<Task, QueueTypeDestructionPolicy>>
+class WorkStealingScheduler : public ICallable
+{
+    using Work = Task;
+public:
+    WorkStealingScheduler(std::shared_ptr<QueueType> a_worksQueue, std::shared_ptr<TwoWayMultiSyncHandler> a_twoWayMultiSyncHandler, std::shared_ptr<std::mutex> a_workersLock, std::shared_ptr<Latch> a_inFlightWorks, std::shared_ptr<WorkersActivity> a_workersActivity, std::shared_ptr<WorkStealingRegistry> a_registry);
+    WorkStealingScheduler(const WorkStealingScheduler& a_other) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler& a_other) = delete;
+    ~WorkStealingScheduler() = default;
+
+    virtual void operator()() override;
+
+private:
+    bool HasAcceptedStopNotification();
+    bool FindWork(Work& a_work, WorkStealingRegistry::WorksDeque& a_ownDeque, std::minstd_rand& a_randomGenerator);
+    bool WaitForWork(Work& a_work, std::minstd_rand& a_randomGenerator); // Returns false if the works queue is not valid anymore
+    void SafeExecute(Work& a_work) const; // Wake up works are empty - they are neither executed nor counted down
+
+private:
+    std::shared_ptr<QueueType> m_worksQueue;
+    std::shared_ptr<TwoWayMultiSyncHandler> m_twoWayMultiSyncHandler;
+    std::shared_ptr<std::mutex> m_workersLock;
+    std::shared_ptr<WorkStealingRegistry> m_registry;
+    std::shared_ptr<Latch> m_inFlightWorks; // Counts down once per executed work (the pool counts up once per submitted work)
+    std::shared_ptr<WorkersActivity> m_workersActivity;
+};
+
+} // advcpp
+
+
+#include "inl/work_stealing_scheduler.hxx"
+
+
+#endif // NM_WORK_STEALING_SCHEDULER_HPP
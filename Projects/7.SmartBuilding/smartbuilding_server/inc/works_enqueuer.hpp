@@ -4,6 +4,7 @@
 
 #include <memory> // std::shared_ptr
 #include "icallable.hpp"
+#include "task.hpp"
 #include "blocking_bounded_queue.hpp"
 #include "blocking_bounded_queue_destruction_policies.hpp"
 
@@ -12,15 +13,15 @@ namespace advcpp
 {
 
 
-// Concept of QueueTypeDestructionPolicy: must be a destruction policy of the given Queue type, and must be a destruction policy of type T = std::shared_ptr<ICallable>
+// Concept of QueueTypeDestructionPolicy: must be a destruction policy of the given Queue type, and must be a destruction policy of type T = Task
 // --------------------------------------------------------------------------------------------------------------------------------------------------------------------
 // Concept of QueueType: QueueType must implement Enqueue, Dequeue, IsEmpty and Size methods (Suggestion: these methods should be multithreaded-safe!),
-// and its T MUST be std::shared_ptr of type ICallable (QueueType< T = std::shared_ptr<ICallable> >),
-// and it must implement a C'tor of: {size_t, QueueTypeDestructionPolicy<std::shared_ptr<ICallable>>}
-template <typename QueueTypeDestructionPolicy = ClearPolicy<std::shared_ptr<ICallable>>, typename QueueType = BlockingBoundedQueue<std::shared_ptr<ICallable>, QueueTypeDestructionPolicy>>
+// and its T MUST be Task (QueueType< T = Task >),
+// and it must implement a C'tor of: {size_t, QueueTypeDestructionPolicy<Task>}
+template <typename QueueTypeDestructionPolicy = ClearPolicy<Task>, typename QueueType = BlockingBoundedQueue<Task, QueueTypeDestructionPolicy>>
 class WorksEnqueuer : public ICallable
 {
-    using Work = std::shared_ptr<ICallable>;
+    using Work = Task;
 public:
     WorksEnqueuer(std::shared_ptr<QueueType> a_worksQueue, Work a_workToEnqueue);
     WorksEnqueuer(const WorksEnqueuer& a_other) = delete;
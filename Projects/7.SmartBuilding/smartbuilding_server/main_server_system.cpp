@@ -8,21 +8,23 @@
 
 
 #define SERVER_SYSTEM_ARGS_COUNT 3
+#define SERVER_SYSTEM_OPTIONAL_ARGS_COUNT 1
 
 
 using namespace smartbuilding;
 
 
-// Args: 1) server port | 2) server's max waiting clients at the same time | 3) config file path
+// Args: 1) server port | 2) server's max waiting clients at the same time | 3) config file path | 4) [optional] reactors count (default: 1)
 int main(int argc, const char** argv)
 {
     std::string configFilePath;
     unsigned int port;
     unsigned int clientsCount;
+    unsigned int reactorsCount = 1;
 
     try
     {
-        if(argc != SERVER_SYSTEM_ARGS_COUNT + 1) // +1 stands for the program name
+        if(argc != SERVER_SYSTEM_ARGS_COUNT + 1 && argc != SERVER_SYSTEM_ARGS_COUNT + SERVER_SYSTEM_OPTIONAL_ARGS_COUNT + 1) // +1 stands for the program name
         {
             throw std::invalid_argument("Wrong argc value");
         }
@@ -30,6 +32,10 @@ int main(int argc, const char** argv)
         port = std::stoul(std::string(argv[1]));
         clientsCount = std::stoul(std::string(argv[2]));
         configFilePath = std::string(argv[3]);
+        if(argc == SERVER_SYSTEM_ARGS_COUNT + SERVER_SYSTEM_OPTIONAL_ARGS_COUNT + 1)
+        {
+            reactorsCount = std::stoul(std::string(argv[4]));
+        }
     }
     catch(...)
     {
@@ -39,7 +45,7 @@ int main(int argc, const char** argv)
     std::unique_ptr<SmartBuildingNetworkProtocol> networkProtocolParser = SmartBuildingNetworkProtocol::GetNetworkProtocol();
     std::shared_ptr<IConfigReader> iniReader = std::make_shared<IniReader>();
 
-    Hub hub(std::move(networkProtocolParser), iniReader, configFilePath, port, clientsCount);
+    Hub hub(std::move(networkProtocolParser), iniReader, configFilePath, port, clientsCount, reactorsCount);
     hub.Start();
 
     return 0;
@@ -1,6 +1,9 @@
 #include "controller_agent.hpp"
 #include <memory> // std::shared_ptr
+#include <vector> // std::vector
+#include <utility> // std::pair, std::make_pair
 #include "software_agent.hpp"
+#include "encoding_cache.hpp"
 #include "event.hpp"
 #include "isubscriber.hpp"
 #include "subscription_location.hpp"
@@ -14,9 +17,14 @@ smartbuilding::ControllerAgent::ControllerAgent(std::shared_ptr<IEncoder> a_enco
 }
 
 
-void smartbuilding::ControllerAgent::Notify(Event a_event, std::shared_ptr<advcpp::BlockingBoundedQueue<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>, advcpp::NoOperationPolicy<std::pair<std::string,infra::TCPSocket::BytesBufferProxy>>>> a_handledBuffersQueue)
+void smartbuilding::ControllerAgent::Notify(Event a_event, std::vector<std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>>& a_handledBuffers)
 {
-    infra::TCPSocket::BytesBufferProxy bytesBufferToHandle = m_encoder->Encode(a_event);
-    a_handledBuffersQueue->Enqueue(std::make_pair(RemoteDeviceID(), bytesBufferToHandle));
+    if(IsConnectionCongested()) // Backpressure - the device does not drain its connection, so the event is not encoded for it
+    {
+        return;
+    }
+
+    infra::TCPSocket::BytesBufferProxy bytesBufferToHandle = EncodingCache::Encode(*m_encoder, a_event); // Shared with the other recipients of the event whose encoders have the same sharing key
+    a_handledBuffers.push_back(std::make_pair(Connection(), bytesBufferToHandle));
     // Use the logger
 }
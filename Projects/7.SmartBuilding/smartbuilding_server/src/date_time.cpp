@@ -1,5 +1,6 @@
 #include "date_time.hpp"
-#include <ctime> // struct tm
+#include <ctime> // struct tm, time_t, time
+#include <time.h> // localtime_r
 #include <string> // std::string, std::to_string
 
 
@@ -16,11 +17,11 @@ smartbuilding::DateTime::DateTime(int a_hours, int a_minutes, int a_seconds, int
 
 smartbuilding::DateTime smartbuilding::DateTime::Now()
 {
-    struct tm* datetime;
+    struct tm datetime;
     time_t timenow = time(NULL);
-    datetime = localtime(&timenow);
+    localtime_r(&timenow, &datetime); // Not localtime - its static result is shared by all the threads (the loggers call Now concurrently)
 
-    return DateTime(datetime->tm_hour, datetime->tm_min, datetime->tm_sec, datetime->tm_mday, datetime->tm_mon, datetime->tm_year + OFFSET_OF_YEARS_IN_SYSTEM);
+    return DateTime(datetime.tm_hour, datetime.tm_min, datetime.tm_sec, datetime.tm_mday, datetime.tm_mon + 1, datetime.tm_year + OFFSET_OF_YEARS_IN_SYSTEM);
 }
 
 
@@ -0,0 +1,82 @@
+#include "encoding_cache.hpp"
+#include <cstddef> // size_t
+#include <atomic> // std::atomic, std::memory_order_relaxed
+#include <mutex> // std::mutex, std::lock_guard
+#include <utility> // std::make_pair
+#include "tcp_socket.hpp"
+#include "event.hpp"
+#include "iencoder.hpp"
+
+
+namespace smartbuilding
+{
+
+thread_local EncodingCache* EncodingCache::s_currentCache = nullptr;
+std::atomic<size_t> EncodingCache::s_hitsCount(0);
+std::atomic<size_t> EncodingCache::s_missesCount(0);
+
+
+EncodingCache::Scope::Scope(EncodingCache& a_cache)
+: m_previousCache(s_currentCache)
+{
+    s_currentCache = &a_cache;
+}
+
+
+EncodingCache::Scope::~Scope()
+{
+    s_currentCache = m_previousCache;
+}
+
+
+EncodingCache::EncodingCache(Event::EventID a_eventID)
+: m_eventID(a_eventID)
+, m_lock()
+, m_encodedBuffers()
+{
+}
+
+
+infra::TCPSocket::BytesBufferProxy EncodingCache::Encode(IEncoder& a_encoder, const Event& a_event)
+{
+    if(!s_currentCache || s_currentCache->m_eventID != a_event.ID() || a_event.ID() == 0) // Not in the event's fan-out - nothing to share with
+    {
+        return a_encoder.Encode(a_event);
+    }
+
+    return s_currentCache->FindOrEncode(a_encoder, a_event);
+}
+
+
+EncodingCache::Statistics EncodingCache::ProcessStatistics()
+{
+    Statistics statistics;
+    statistics.m_hitsCount = s_hitsCount.load(std::memory_order_relaxed);
+    statistics.m_missesCount = s_missesCount.load(std::memory_order_relaxed);
+
+    return statistics;
+}
+
+
+infra::TCPSocket::BytesBufferProxy EncodingCache::FindOrEncode(IEncoder& a_encoder, const Event& a_event)
+{
+    const void* sharingKey = a_encoder.SharingKey();
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        auto encodedItr = m_encodedBuffers.find(sharingKey);
+        if(encodedItr != m_encodedBuffers.end())
+        {
+            s_hitsCount.fetch_add(1, std::memory_order_relaxed);
+            return encodedItr->second; // Shares the bytes (no copy)
+        }
+    }
+
+    // Encoded outside of the lock - the other encoders of the event are not blocked by a slow encoder
+    s_missesCount.fetch_add(1, std::memory_order_relaxed);
+    infra::TCPSocket::BytesBufferProxy encodedBuffer = a_encoder.Encode(a_event);
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    return m_encodedBuffers.insert(std::make_pair(sharingKey, encodedBuffer)).first->second; // If an invoker has encoded it concurrently - its buffer is shared
+}
+
+} // smartbuilding
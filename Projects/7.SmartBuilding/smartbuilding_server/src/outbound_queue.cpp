@@ -0,0 +1,95 @@
+#include "outbound_queue.hpp"
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr, std::weak_ptr
+#include <vector> // std::vector
+#include <deque> // std::deque
+#include <mutex> // std::mutex, std::lock_guard
+#include <sys/eventfd.h> // eventfd_write
+#include "tcp_socket.hpp"
+
+
+void infra::OutboundQueuesScheduler::Schedule(std::shared_ptr<OutboundQueue> a_queue)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        m_scheduledQueues.push_back(a_queue);
+    }
+
+    eventfd_write(m_wakeupID, 1); // Wakes up the reactor's wait
+}
+
+
+void infra::OutboundQueuesScheduler::TakeScheduled(std::vector<std::shared_ptr<OutboundQueue>>& a_queues)
+{
+    a_queues.clear();
+
+    std::lock_guard<std::mutex> guard(m_lock);
+    a_queues.swap(m_scheduledQueues);
+}
+
+
+infra::OutboundQueue::OutboundQueue(int a_clientID, std::shared_ptr<TCPSocket> a_client, std::shared_ptr<OutboundQueuesScheduler> a_scheduler, size_t a_highWaterMark)
+: m_clientID(a_clientID)
+, m_client(a_client)
+, m_scheduler(a_scheduler)
+, m_highWaterMark(a_highWaterMark)
+, m_queuedBytes(0)
+, m_droppedMessagesCount(0)
+, m_lock()
+, m_postedMessages()
+, m_isScheduled(false)
+, m_isClosed(false)
+{
+}
+
+
+bool infra::OutboundQueue::Post(const Message& a_message)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    if(m_isClosed || IsAboveHighWaterMark())
+    {
+        m_droppedMessagesCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    m_postedMessages.push_back(a_message); // Shares the message's bytes (no copy)
+    m_queuedBytes.fetch_add(a_message.Size(), std::memory_order_relaxed);
+    if(!m_isScheduled)
+    {
+        m_isScheduled = true;
+        m_scheduler->Schedule(shared_from_this()); // Under the lock - Close cannot complete (and the server cannot close its wakeup event) while a post is scheduling
+    }
+
+    return true;
+}
+
+
+bool infra::OutboundQueue::IsQueueOf(const std::shared_ptr<TCPSocket>& a_client) const
+{
+    return !m_client.owner_before(a_client) && !a_client.owner_before(m_client); // The same control block - without locking (or keeping alive) the socket
+}
+
+
+void infra::OutboundQueue::TakePosted(std::deque<Message>& a_output)
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    a_output.insert(a_output.end(), m_postedMessages.begin(), m_postedMessages.end());
+    m_postedMessages.clear();
+    m_isScheduled = false; // The next post notifies the server again
+}
+
+
+void infra::OutboundQueue::Close()
+{
+    std::lock_guard<std::mutex> guard(m_lock);
+    m_isClosed = true;
+
+    size_t droppedBytes = 0;
+    for(size_t i = 0; i < m_postedMessages.size(); ++i)
+    {
+        droppedBytes += m_postedMessages[i].Size();
+    }
+    m_droppedMessagesCount.fetch_add(m_postedMessages.size(), std::memory_order_relaxed);
+    m_queuedBytes.fetch_sub(droppedBytes, std::memory_order_relaxed); // Only the dropped bytes - a flush of the server's output still removes its own sent bytes
+    m_postedMessages.clear();
+}
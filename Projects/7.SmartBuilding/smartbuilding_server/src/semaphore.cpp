@@ -1,6 +1,9 @@
 #include "semaphore.hpp"
 #include <semaphore.h> // Linux OS semaphore functions
 #include <stdexcept> // std::runtime_error
+#include <chrono> // std::chrono::nanoseconds, std::chrono::seconds
+#include <ctime> // clock_gettime, struct timespec
+#include <errno.h> // errno
 
 
 advcpp::Semaphore::Semaphore(unsigned int a_initialValue, int a_sharedOption)
@@ -52,3 +55,35 @@ bool advcpp::Semaphore::TryDown()
 {
     return sem_trywait(&m_semaphore) == 0;
 }
+
+
+bool advcpp::Semaphore::TimedDown(std::chrono::nanoseconds a_timeout)
+{
+    // sem_timedwait expects an absolute timeout, measured against CLOCK_REALTIME
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+
+    std::chrono::seconds timeoutSeconds = std::chrono::duration_cast<std::chrono::seconds>(a_timeout);
+    deadline.tv_sec += timeoutSeconds.count();
+    deadline.tv_nsec += (a_timeout - timeoutSeconds).count();
+    if(deadline.tv_nsec >= NANOSECONDS_IN_SECOND)
+    {
+        ++deadline.tv_sec;
+        deadline.tv_nsec -= NANOSECONDS_IN_SECOND;
+    }
+
+    int statusCode;
+    while((statusCode = sem_timedwait(&m_semaphore, &deadline)) != 0 && errno == EINTR); // Restart the wait if it was interrupted by a signal handler
+
+    if(statusCode != 0)
+    {
+        if(errno == ETIMEDOUT)
+        {
+            return false;
+        }
+
+        throw std::runtime_error("Failed while tried to wait on semaphore");
+    }
+
+    return true;
+}
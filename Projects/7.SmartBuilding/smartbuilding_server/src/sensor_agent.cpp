@@ -1,5 +1,6 @@
 #include "sensor_agent.hpp"
 #include <memory> // std::shared_ptr
+#include <utility> // std::move
 #include "software_agent.hpp"
 #include "location.hpp"
 #include "idecoder.hpp"
@@ -15,9 +16,9 @@ smartbuilding::SensorAgent::SensorAgent(std::shared_ptr<IDecoder> a_decoder, con
 }
 
 
-void smartbuilding::SensorAgent::Publish(infra::TCPSocket::BytesBufferProxy a_bytesBuffer, std::shared_ptr<advcpp::BlockingBoundedQueue<Event, advcpp::NoOperationPolicy<Event>>> a_publishedEventsQueue)
+bool smartbuilding::SensorAgent::Publish(infra::TCPSocket::BytesBufferProxy a_bytesBuffer, std::shared_ptr<advcpp::BlockingBoundedQueue<Event, advcpp::NoOperationPolicy<Event>>> a_publishedEventsQueue)
 {
     Event eventToPublish = m_decoder->Decode(a_bytesBuffer);
-    a_publishedEventsQueue->Enqueue(eventToPublish);
     // Use the logger
+    return a_publishedEventsQueue->TryEnqueue(std::move(eventToPublish));
 }
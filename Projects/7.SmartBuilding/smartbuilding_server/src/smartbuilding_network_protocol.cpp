@@ -1,194 +1,322 @@
 #include "smartbuilding_network_protocol.hpp"
-#include <string> // std::string, std::stoul
-#include <memory> // std::unique_ptr, std::make_shared
-#include <sstream> // std::stringstream, std::getline
+#include <cstddef> // size_t
+#include <vector> // std::vector
+#include <memory> // std::unique_ptr
 #include <mutex> // std::mutex, std::lock_guard
-#include "subscription_location.hpp"
+#include <string.h> // memchr
 #include "tcp_socket.hpp"
-#include "event.hpp"
 #include "smartbuilding_request.hpp"
-#include "smartbuilding_connect_request.hpp"
-#include "smartbuilding_disconnect_request.hpp"
-#include "smartbuilding_subscribe_request.hpp"
-#include "smartbuilding_unsubscribe_request.hpp"
-#include "smartbuilding_event_request.hpp"
 
 
 namespace smartbuilding
 {
 
-std::unique_ptr<SmartBuildingNetworkProtocol> SmartBuildingNetworkProtocol::GetNetworkProtocol()
+// Reads a length-prefixed field (varint length, then the field's bytes), and moves a_cursor after it
+static bool ReadBinaryField(const unsigned char*& a_cursor, const unsigned char* a_end, BytesView& a_field)
 {
-    static bool hasInitializedAlready = false;
-    static std::mutex lock;
-
-    if(!hasInitializedAlready) // Used to avoid the expensive OS call while mutex is not needed at all (after the first initialization)
+    unsigned int fieldSize = 0;
+    if(!NumbersListView::ReadVarint(a_cursor, a_end, fieldSize) || fieldSize > static_cast<size_t>(a_end - a_cursor))
     {
-        std::lock_guard<std::mutex> guard(lock);
-        if(!hasInitializedAlready)
-        {
-            hasInitializedAlready = true;
-            return std::unique_ptr<SmartBuildingNetworkProtocol>(new SmartBuildingNetworkProtocol());
-        }
+        return false;
     }
 
-    return nullptr;
+    a_field = BytesView(a_cursor, fieldSize);
+    a_cursor += fieldSize;
+
+    return true;
 }
 
 
-std::shared_ptr<SmartBuildingRequest> SmartBuildingNetworkProtocol::Parse(infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const
+// Reads a counted list of varints (validating each of them), and moves a_cursor after it
+static bool ReadBinaryNumbersList(const unsigned char*& a_cursor, const unsigned char* a_end, NumbersListView& a_list)
 {
-    if(a_bytesBuffer.Size() == 0)
+    unsigned int numbersCount = 0;
+    if(!NumbersListView::ReadVarint(a_cursor, a_end, numbersCount))
     {
-        return nullptr;
+        return false;
     }
 
-    if(IsRequestType('C', a_bytesBuffer))
+    const unsigned char* listStart = a_cursor;
+    unsigned int number = 0;
+    for(unsigned int i = 0; i < numbersCount; ++i)
     {
-        return ParseConnectRequest(a_bytesBuffer);
-    }
-    else if(IsRequestType('D', a_bytesBuffer))
-    {
-        return ParseDisconnectRequest(a_bytesBuffer);
-    }
-    else if(IsRequestType('S', a_bytesBuffer))
-    {
-        return ParseSubscribeRequest(a_bytesBuffer);
-    }
-    else if(IsRequestType('U', a_bytesBuffer))
-    {
-        return ParseUnsubscribeRequest(a_bytesBuffer);
+        if(!NumbersListView::ReadVarint(a_cursor, a_end, number))
+        {
+            return false;
+        }
     }
-    else if(IsRequestType('E', a_bytesBuffer))
+
+    a_list = NumbersListView(BytesView(listStart, static_cast<size_t>(a_cursor - listStart)), NumbersListView::BINARY_VARINTS, numbersCount == 0);
+
+    return true;
+}
+
+
+// Reads the field until the next & sign (or until the end of the buffer), and moves a_cursor after its & sign - returns false if there is no field to read
+// [a_cursor is nullptr after the last field was read]
+static bool ReadTextField(const unsigned char*& a_cursor, const unsigned char* a_end, BytesView& a_field)
+{
+    if(!a_cursor)
     {
-        return ParseEventRequest(a_bytesBuffer);
+        return false;
     }
-    else // Buffer's header is not following the protocol's guidelines
+
+    const unsigned char* fieldEnd = static_cast<const unsigned char*>(memchr(a_cursor, '&', static_cast<size_t>(a_end - a_cursor)));
+    if(!fieldEnd)
     {
-        return nullptr;
+        fieldEnd = a_end;
     }
-}
 
+    a_field = BytesView(a_cursor, static_cast<size_t>(fieldEnd - a_cursor));
+    a_cursor = fieldEnd != a_end ? fieldEnd + 1 : nullptr;
 
-template <>
-infra::TCPSocket::BytesBufferProxy SmartBuildingNetworkProtocol::ExtractNext<infra::TCPSocket::BytesBufferProxy>(std::stringstream& a_ss, char a_delimiter) const
-{
-    std::string subStringContainer;
-    std::getline(a_ss, subStringContainer, a_delimiter);
-
-    return infra::TCPSocket::BytesBufferProxy(reinterpret_cast<const unsigned char*>(subStringContainer.c_str()), subStringContainer.size()); // '\n' should be ignored
+    return true;
 }
 
 
-template <>
-std::vector<unsigned int> SmartBuildingNetworkProtocol::ExtractNext<std::vector<unsigned int>>(std::stringstream& a_ss, char a_delimiter) const
+// Validates a comma separated list of decimals
+static bool ToTextNumbersList(const BytesView& a_field, NumbersListView& a_list)
 {
-    std::string subStringContainer;
-    std::getline(a_ss, subStringContainer, a_delimiter);
-
-    std::string singleNumAsString;
-    char newDelimiter = ',';
-    std::vector<unsigned int> sequence;
-    while(std::getline(a_ss, singleNumAsString, newDelimiter))
+    const unsigned char* cursor = a_field.Data();
+    const unsigned char* end = cursor + a_field.Size();
+    size_t numbersCount = 0;
+    unsigned int number = 0;
+    unsigned int firstNumber = 0;
+    while(true)
     {
-        sequence.push_back(std::stoul(singleNumAsString));
+        if(!NumbersListView::ReadDecimal(cursor, end, number))
+        {
+            return false;
+        }
+        firstNumber = numbersCount == 0 ? number : firstNumber;
+        ++numbersCount;
+
+        if(cursor == end)
+        {
+            break;
+        }
+        if(*cursor != ',')
+        {
+            return false;
+        }
+        ++cursor;
     }
 
-    return sequence;
+    a_list = NumbersListView(a_field, NumbersListView::TEXT_DECIMALS, numbersCount == 1 && firstNumber == 0); // 0 is the protocol's indicator if all rooms/floors are wanted
+
+    return true;
 }
 
 
-std::shared_ptr<SmartBuildingRequest> SmartBuildingNetworkProtocol::ParseConnectRequest(infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const
+std::unique_ptr<SmartBuildingNetworkProtocol> SmartBuildingNetworkProtocol::GetNetworkProtocol()
 {
-    std::stringstream buffer(reinterpret_cast<const char*>(a_bytesBuffer.ToBytes()));
-    char delimiter = '&';
-    ExtractNext<std::string>(buffer, delimiter); // Skip the request type indicator
+    static bool hasInitializedAlready = false;
+    static std::mutex lock;
 
-    // Extract Device ID:
-    std::string deviceID = ExtractNext<std::string>(buffer, delimiter);
+    if(!hasInitializedAlready) // Used to avoid the expensive OS call while mutex is not needed at all (after the first initialization)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if(!hasInitializedAlready)
+        {
+            hasInitializedAlready = true;
+            return std::unique_ptr<SmartBuildingNetworkProtocol>(new SmartBuildingNetworkProtocol());
+        }
+    }
 
-    return std::make_shared<SmartBuildingConnectRequest>(deviceID);
+    return nullptr;
 }
 
 
-std::shared_ptr<SmartBuildingRequest> SmartBuildingNetworkProtocol::ParseDisconnectRequest(infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const
+bool SmartBuildingNetworkProtocol::Parse(const infra::TCPSocket::BytesBufferProxy& a_bytesBuffer, SmartBuildingRequest& a_request) const
 {
-    std::stringstream buffer(reinterpret_cast<const char*>(a_bytesBuffer.ToBytes()));
-    char delimiter = '&';
-    ExtractNext<std::string>(buffer, delimiter); // Skip the request type indicator
+    if(a_bytesBuffer.Size() == 0)
+    {
+        return false;
+    }
 
-    // Extract Device ID:
-    std::string deviceID = ExtractNext<std::string>(buffer, delimiter);
+    a_request = SmartBuildingRequest(); // Clears the fields of a previous request
+
+    if(a_bytesBuffer.ToBytes()[0] == BINARY_FORMAT_MAGIC)
+    {
+        return ParseBinary(a_bytesBuffer, a_request);
+    }
 
-    return std::make_shared<SmartBuildingDisconnectRequest>(deviceID);
+    return ParseText(a_bytesBuffer, a_request); // Old devices
 }
 
 
-std::shared_ptr<SmartBuildingRequest> SmartBuildingNetworkProtocol::ParseSubscribeRequest(infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const
+bool SmartBuildingNetworkProtocol::ParseBinary(const infra::TCPSocket::BytesBufferProxy& a_bytesBuffer, SmartBuildingRequest& a_request) const
 {
-    std::stringstream buffer(reinterpret_cast<const char*>(a_bytesBuffer.ToBytes()));
-    char delimiter = '&';
-    ExtractNext<std::string>(buffer, delimiter); // Skip the request type indicator
+    const size_t HEADER_SIZE = 3; // Magic, version and request type
+    if(a_bytesBuffer.Size() < HEADER_SIZE || a_bytesBuffer.ToBytes()[1] != BINARY_FORMAT_VERSION || !ToRequestType(a_bytesBuffer.ToBytes()[2], a_request.m_type))
+    {
+        return false;
+    }
 
-    // Extract Device ID:
-    std::string deviceID = ExtractNext<std::string>(buffer, delimiter);
+    const unsigned char* cursor = a_bytesBuffer.ToBytes() + HEADER_SIZE;
+    const unsigned char* end = a_bytesBuffer.ToBytes() + a_bytesBuffer.Size();
+    if(!ReadBinaryField(cursor, end, a_request.m_requestSenderID))
+    {
+        return false;
+    }
 
-    // Extract Rooms && Floors:
-    std::vector<unsigned int> rooms = ExtractNext<std::vector<unsigned int>>(buffer, delimiter);
-    std::vector<unsigned int> floors = ExtractNext<std::vector<unsigned int>>(buffer, delimiter);
-    bool isAllRooms = HasAllIndication(rooms);
-    bool isAllFloors = HasAllIndication(floors);
+    switch(a_request.m_type)
+    {
+    case SUBSCRIBE_REQUEST:
+        return ReadBinaryNumbersList(cursor, end, a_request.m_rooms) && ReadBinaryNumbersList(cursor, end, a_request.m_floors) && ReadBinaryField(cursor, end, a_request.m_eventType);
 
-    SubscriptionLocation subscriptionLoc(isAllFloors, floors, isAllRooms, rooms);
+    case UNSUBSCRIBE_REQUEST:
+        return ReadBinaryField(cursor, end, a_request.m_eventType);
 
-    // Extract Event Type:
-    Event::EventType eventType = ExtractNext<Event::EventType>(buffer, delimiter);
+    case EVENT_REQUEST:
+        a_request.m_eventDataBuffer = a_bytesBuffer.Slice(static_cast<size_t>(cursor - a_bytesBuffer.ToBytes()), static_cast<size_t>(end - cursor));
+        return true;
 
-    return std::make_shared<SmartBuildingSubscribeRequest>(deviceID, eventType, subscriptionLoc);
+    default: // Connect / Disconnect
+        return true;
+    }
 }
 
 
-std::shared_ptr<SmartBuildingRequest> SmartBuildingNetworkProtocol::ParseUnsubscribeRequest(infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const
+bool SmartBuildingNetworkProtocol::ParseText(const infra::TCPSocket::BytesBufferProxy& a_bytesBuffer, SmartBuildingRequest& a_request) const
 {
-    std::stringstream buffer(reinterpret_cast<const char*>(a_bytesBuffer.ToBytes()));
-    char delimiter = '&';
-    ExtractNext<std::string>(buffer, delimiter); // Skip the request type indicator
+    if(!ToRequestType(a_bytesBuffer.ToBytes()[0], a_request.m_type))
+    {
+        return false; // Buffer's header is not following the protocol's guidelines
+    }
+
+    const unsigned char* cursor = a_bytesBuffer.ToBytes();
+    const unsigned char* end = a_bytesBuffer.ToBytes() + a_bytesBuffer.Size();
+    BytesView field;
+    ReadTextField(cursor, end, field); // Skip the request type indicator
 
     // Extract Device ID:
-    std::string deviceID = ExtractNext<std::string>(buffer, delimiter);
+    if(!ReadTextField(cursor, end, a_request.m_requestSenderID))
+    {
+        return false;
+    }
+
+    switch(a_request.m_type)
+    {
+    case SUBSCRIBE_REQUEST:
+    {
+        // Extract Rooms && Floors:
+        BytesView rooms;
+        BytesView floors;
+        if(!ReadTextField(cursor, end, rooms) || !ReadTextField(cursor, end, floors) || !ToTextNumbersList(rooms, a_request.m_rooms) || !ToTextNumbersList(floors, a_request.m_floors))
+        {
+            return false;
+        }
+
+        // Extract Event Type:
+        return ReadTextField(cursor, end, a_request.m_eventType);
+    }
 
-    // Extract Event Type:
-    Event::EventType eventType = ExtractNext<Event::EventType>(buffer, delimiter);
+    case UNSUBSCRIBE_REQUEST:
+        // Extract Event Type:
+        return ReadTextField(cursor, end, a_request.m_eventType);
 
-    return std::make_shared<SmartBuildingUnsubscribeRequest>(deviceID, eventType);
+    case EVENT_REQUEST:
+        // Extract Event Data Buffer:
+        if(!ReadTextField(cursor, end, field))
+        {
+            return false;
+        }
+        a_request.m_eventDataBuffer = a_bytesBuffer.Slice(static_cast<size_t>(field.Data() - a_bytesBuffer.ToBytes()), field.Size());
+        return true;
+
+    default: // Connect / Disconnect
+        return true;
+    }
 }
 
 
-std::shared_ptr<SmartBuildingRequest> SmartBuildingNetworkProtocol::ParseEventRequest(infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const
+bool SmartBuildingNetworkProtocol::ToRequestType(unsigned char a_typeIndicator, RequestType& a_type) const
 {
-    std::stringstream buffer(reinterpret_cast<const char*>(a_bytesBuffer.ToBytes()));
-    char delimiter = '&';
-    ExtractNext<std::string>(buffer, delimiter); // Skip the request type indicator
+    switch(a_typeIndicator)
+    {
+    case 'C':
+        a_type = CONNECT_REQUEST;
+        return true;
+    case 'D':
+        a_type = DISCONNECT_REQUEST;
+        return true;
+    case 'S':
+        a_type = SUBSCRIBE_REQUEST;
+        return true;
+    case 'U':
+        a_type = UNSUBSCRIBE_REQUEST;
+        return true;
+    case 'E':
+        a_type = EVENT_REQUEST;
+        return true;
+    default:
+        return false;
+    }
+}
+
 
-    // Extract Device ID:
-    std::string deviceID = ExtractNext<std::string>(buffer, delimiter);
 
-    // Extract Event Data Buffer:
-    infra::TCPSocket::BytesBufferProxy eventDataBuffer = ExtractNext<infra::TCPSocket::BytesBufferProxy>(buffer, delimiter);
+std::vector<unsigned int> NumbersListView::ToVector() const
+{
+    std::vector<unsigned int> numbers;
+    const unsigned char* cursor = m_bytes.Data();
+    const unsigned char* end = cursor + m_bytes.Size();
+    unsigned int number = 0;
+    while(cursor < end)
+    {
+        if(m_encoding == BINARY_VARINTS)
+        {
+            ReadVarint(cursor, end, number);
+        }
+        else
+        {
+            ReadDecimal(cursor, end, number);
+            ++cursor; // Skip the comma
+        }
+        numbers.push_back(number);
+    }
 
-    return std::make_shared<SmartBuildingEventRequest>(deviceID, eventDataBuffer);
+    return numbers;
 }
 
 
-bool SmartBuildingNetworkProtocol::IsRequestType(char a_type, infra::TCPSocket::BytesBufferProxy a_bytesBuffer) const
+bool NumbersListView::ReadVarint(const unsigned char*& a_cursor, const unsigned char* a_end, unsigned int& a_number)
 {
-    return a_bytesBuffer.ToBytes()[0] == static_cast<unsigned char>(a_type);
+    const unsigned int MAX_VARINT_BYTES = 5; // 32 bits, 7 bits per byte
+    unsigned int number = 0;
+    for(unsigned int i = 0; i < MAX_VARINT_BYTES && a_cursor < a_end; ++i)
+    {
+        unsigned char byte = *a_cursor++;
+        number |= static_cast<unsigned int>(byte & 0x7F) << (7 * i);
+        if(!(byte & 0x80))
+        {
+            a_number = number;
+            return true;
+        }
+    }
+
+    return false; // Truncated, or longer than 32 bits
 }
 
 
-bool SmartBuildingNetworkProtocol::HasAllIndication(const std::vector<unsigned int>& a_sequence) const
+bool NumbersListView::ReadDecimal(const unsigned char*& a_cursor, const unsigned char* a_end, unsigned int& a_number)
 {
-    return a_sequence.size() == 1 && a_sequence[0] == 0; // 0 is the protocol's indicator if all rooms/floors are wanted
+    const unsigned int MAX_DIGITS = 9; // Cannot overflow 32 bits
+    unsigned int number = 0;
+    unsigned int digits = 0;
+    while(a_cursor < a_end && *a_cursor >= '0' && *a_cursor <= '9')
+    {
+        if(++digits > MAX_DIGITS)
+        {
+            return false;
+        }
+        number = number * 10 + static_cast<unsigned int>(*a_cursor - '0');
+        ++a_cursor;
+    }
+
+    a_number = number;
+    return digits != 0;
 }
 
 } // smartbuilding
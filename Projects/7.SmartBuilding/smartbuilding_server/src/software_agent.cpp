@@ -1,7 +1,10 @@
 #include "software_agent.hpp"
-#include <memory> // std::shared_ptr
+#include <memory> // std::shared_ptr, std::atomic_load, std::atomic_store
 #include <string> // std::string
+#include <mutex> // std::mutex, std::lock_guard
 #include "ilogger.hpp"
+#include "connection_handle.hpp"
+#include "outbound_queue.hpp"
 
 
 smartbuilding::SoftwareAgent::SoftwareAgent(const std::string& a_configurations, std::shared_ptr<ILogger> a_logger, const std::string& a_remoteDeviceID, const Location& a_location)
@@ -9,6 +12,9 @@ smartbuilding::SoftwareAgent::SoftwareAgent(const std::string& a_configurations,
 , m_logger(a_logger)
 , m_remoteDeviceID(a_remoteDeviceID)
 , m_location(a_location)
+, m_connectionLock()
+, m_connection(INVALID_CONNECTION_HANDLE)
+, m_connectionOutput()
 {
 }
 
@@ -31,6 +37,38 @@ smartbuilding::Location smartbuilding::SoftwareAgent::Loc() const
 }
 
 
+smartbuilding::ConnectionHandle smartbuilding::SoftwareAgent::Connection() const
+{
+    return m_connection.load(std::memory_order_acquire);
+}
+
+
+bool smartbuilding::SoftwareAgent::IsConnectionCongested() const
+{
+    std::shared_ptr<const infra::OutboundQueue> output = std::atomic_load(&m_connectionOutput);
+    return output && output->IsAboveHighWaterMark();
+}
+
+
+void smartbuilding::SoftwareAgent::SetConnection(ConnectionHandle a_handle, std::shared_ptr<const infra::OutboundQueue> a_output)
+{
+    std::lock_guard<std::mutex> guard(m_connectionLock);
+    std::atomic_store(&m_connectionOutput, a_output);
+    m_connection.store(a_handle, std::memory_order_release);
+}
+
+
+void smartbuilding::SoftwareAgent::ClearConnection(ConnectionHandle a_handle)
+{
+    std::lock_guard<std::mutex> guard(m_connectionLock);
+    if(m_connection.load(std::memory_order_relaxed) == a_handle)
+    {
+        std::atomic_store(&m_connectionOutput, std::shared_ptr<const infra::OutboundQueue>());
+        m_connection.store(INVALID_CONNECTION_HANDLE, std::memory_order_release);
+    }
+}
+
+
 void smartbuilding::SoftwareAgent::Log(const std::string& a_message, ILogger::LogLevel a_logLevel)
 {
     m_logger->Log(a_message, a_logLevel);
@@ -0,0 +1,203 @@
+#include "tcp_server_reactor_policies.hpp"
+#include <cstddef> // size_t
+#include <vector> // std::vector
+#include <limits> // std::numeric_limits
+#include <stdint.h> // uint32_t
+#include <stdexcept> // std::runtime_error
+#include <sys/select.h> /* select, fd_set and its MACROS */
+#include <sys/epoll.h> // epoll_create1, epoll_ctl, epoll_wait
+#include <sys/resource.h> // getrlimit, RLIMIT_NOFILE
+#include <unistd.h> // close
+
+
+infra::SelectReactorPolicy::SelectReactorPolicy()
+: m_watchedSockets()
+, m_watchedForWritingSockets()
+, m_registeredSockets()
+, m_maxSocketID(-1)
+{
+    FD_ZERO(&m_watchedSockets);
+    FD_ZERO(&m_watchedForWritingSockets);
+    FD_ZERO(&m_registeredSockets);
+}
+
+
+void infra::SelectReactorPolicy::Add(int a_socketID)
+{
+    Modify(a_socketID, true, false);
+}
+
+
+void infra::SelectReactorPolicy::Modify(int a_socketID, bool a_isReadingRequired, bool a_isWritingRequired)
+{
+    if(a_socketID < 0 || a_socketID >= FD_SETSIZE)
+    {
+        throw std::runtime_error("Failed to watch the socket - its ID exceeds the select limit...");
+    }
+
+    FD_SET(a_socketID, &m_registeredSockets);
+    if(a_isReadingRequired)
+    {
+        FD_SET(a_socketID, &m_watchedSockets);
+    }
+    else
+    {
+        FD_CLR(a_socketID, &m_watchedSockets);
+    }
+    if(a_isWritingRequired)
+    {
+        FD_SET(a_socketID, &m_watchedForWritingSockets);
+    }
+    else
+    {
+        FD_CLR(a_socketID, &m_watchedForWritingSockets);
+    }
+
+    if(a_socketID > m_maxSocketID)
+    {
+        m_maxSocketID = a_socketID;
+    }
+}
+
+
+void infra::SelectReactorPolicy::Remove(int a_socketID)
+{
+    if(a_socketID < 0 || a_socketID >= FD_SETSIZE)
+    {
+        return;
+    }
+
+    FD_CLR(a_socketID, &m_watchedSockets);
+    FD_CLR(a_socketID, &m_watchedForWritingSockets);
+    FD_CLR(a_socketID, &m_registeredSockets);
+    while(m_maxSocketID >= 0 && !FD_ISSET(m_maxSocketID, &m_registeredSockets))
+    {
+        --m_maxSocketID;
+    }
+}
+
+
+int infra::SelectReactorPolicy::Wait(std::vector<ReadySocket>& a_readySockets)
+{
+    a_readySockets.clear();
+
+    // Saving the "master" fd_sets, because the select is deleting the given fd_sets' content
+    fd_set readableSocketsIndicator = m_watchedSockets;
+    fd_set writableSocketsIndicator = m_watchedForWritingSockets;
+    int readySocketsCount = select(m_maxSocketID + 1, &readableSocketsIndicator, &writableSocketsIndicator, NULL, NULL);
+    if(readySocketsCount <= 0)
+    {
+        return readySocketsCount;
+    }
+
+    for(int socketID = 0; socketID <= m_maxSocketID; ++socketID)
+    {
+        bool isReadable = FD_ISSET(socketID, &readableSocketsIndicator);
+        bool isWritable = FD_ISSET(socketID, &writableSocketsIndicator);
+        if(isReadable || isWritable)
+        {
+            a_readySockets.push_back({socketID, false, isReadable, isWritable});
+        }
+    }
+
+    return static_cast<int>(a_readySockets.size());
+}
+
+
+size_t infra::SelectReactorPolicy::MaxSockets() const
+{
+    return FD_SETSIZE - RESERVED_FILE_DESCRIPTORS;
+}
+
+
+
+infra::EpollReactorPolicy::EpollReactorPolicy()
+: m_epollID(epoll_create1(EPOLL_CLOEXEC))
+, m_events(INITIAL_EVENTS_CAPACITY)
+{
+    if(m_epollID < 0)
+    {
+        throw std::runtime_error("Failed to create an epoll instance...");
+    }
+}
+
+
+infra::EpollReactorPolicy::~EpollReactorPolicy()
+{
+    close(m_epollID);
+}
+
+
+void infra::EpollReactorPolicy::Add(int a_socketID)
+{
+    struct epoll_event event;
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    event.data.fd = a_socketID;
+
+    int statusResult = epoll_ctl(m_epollID, EPOLL_CTL_ADD, a_socketID, &event);
+    if(statusResult < 0)
+    {
+        throw std::runtime_error("Failed to watch the socket by epoll...");
+    }
+}
+
+
+void infra::EpollReactorPolicy::Modify(int a_socketID, bool a_isReadingRequired, bool a_isWritingRequired)
+{
+    struct epoll_event event;
+    event.events = EPOLLET | (a_isReadingRequired ? static_cast<uint32_t>(EPOLLIN | EPOLLRDHUP) : static_cast<uint32_t>(0)) | (a_isWritingRequired ? static_cast<uint32_t>(EPOLLOUT) : static_cast<uint32_t>(0));
+    event.data.fd = a_socketID;
+
+    int statusResult = epoll_ctl(m_epollID, EPOLL_CTL_MOD, a_socketID, &event); // Re-arms the edge - a socket that is already ready is reported by the next wait
+    if(statusResult < 0)
+    {
+        throw std::runtime_error("Failed to modify the watched socket by epoll...");
+    }
+}
+
+
+void infra::EpollReactorPolicy::Remove(int a_socketID)
+{
+    struct epoll_event event; // Ignored, but must not be NULL in old kernels
+    epoll_ctl(m_epollID, EPOLL_CTL_DEL, a_socketID, &event);
+}
+
+
+int infra::EpollReactorPolicy::Wait(std::vector<ReadySocket>& a_readySockets)
+{
+    a_readySockets.clear();
+
+    int readySocketsCount = epoll_wait(m_epollID, m_events.data(), static_cast<int>(m_events.size()), -1);
+    if(readySocketsCount <= 0)
+    {
+        return readySocketsCount;
+    }
+
+    for(int i = 0; i < readySocketsCount; ++i)
+    {
+        bool hasPeerClosed = (m_events[i].events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0;
+        bool isReadable = (m_events[i].events & EPOLLIN) != 0;
+        bool isWritable = (m_events[i].events & EPOLLOUT) != 0;
+        a_readySockets.push_back({m_events[i].data.fd, hasPeerClosed, isReadable, isWritable});
+    }
+
+    if(static_cast<size_t>(readySocketsCount) == m_events.size()) // There might be more ready sockets - get them all in the next wait
+    {
+        m_events.resize(m_events.size() * 2);
+    }
+
+    return readySocketsCount;
+}
+
+
+size_t infra::EpollReactorPolicy::MaxSockets() const
+{
+    struct rlimit openFilesLimit;
+    if(getrlimit(RLIMIT_NOFILE, &openFilesLimit) < 0 || openFilesLimit.rlim_cur == RLIM_INFINITY)
+    {
+        return std::numeric_limits<size_t>::max();
+    }
+
+    size_t openFiles = static_cast<size_t>(openFilesLimit.rlim_cur);
+    return openFiles > RESERVED_FILE_DESCRIPTORS ? openFiles - RESERVED_FILE_DESCRIPTORS : 1;
+}
@@ -2,11 +2,33 @@
 #include <cstddef> // size_t
 #include <string> // std::string, std::to_string
 #include <string.h> // memset, memcpy
-#include <sys/socket.h> // C standard socket lib
+#include <sys/socket.h> // C standard socket lib, sendmsg, struct msghdr, MSG_NOSIGNAL
 #include <arpa/inet.h> // htons, ntohs
 #include <netinet/in.h> // inet_addr, inet_ntoa
-#include <stdexcept> // std::runtime_error
+#include <stdexcept> // std::runtime_error, std::out_of_range
 #include <unistd.h> // close
+#include <poll.h> // poll
+#include <errno.h> // errno
+#include <utility> // std::move
+#include <sys/uio.h> // struct iovec
+#include "bytes_buffer_pool.hpp"
+
+
+// A non blocking socket refuses to send while its send buffer is full - returns true after waiting until it can send again
+static bool WaitUntilWritableIfBufferFull(int a_socketID)
+{
+    if(errno != EAGAIN && errno != EWOULDBLOCK) // A real error has occurred
+    {
+        return false;
+    }
+
+    struct pollfd writableIndicator;
+    writableIndicator.fd = a_socketID;
+    writableIndicator.events = POLLOUT;
+    writableIndicator.revents = 0;
+
+    return poll(&writableIndicator, 1, -1) > 0 && (writableIndicator.revents & POLLOUT);
+}
 
 
 infra::TCPSocket::TCPSocket::SocketAddressData infra::TCPSocket::CreateSocketAddressDataFromFileDescriptorSocket(SocketID a_fileDescriptorSocket)
@@ -55,69 +77,107 @@ infra::TCPSocket::TCPSocket(SocketID a_fileDescriptorSocket)
 
 infra::TCPSocket::~TCPSocket()
 {
-    close(m_socketID);
+    Close();
 }
 
 
-static unsigned char* CreateBytesBufferFromOtherBuffer(const unsigned char* a_bytesBufferToCopy, size_t a_sizeOfBuffer)
+void infra::TCPSocket::Close()
 {
-    unsigned char* newBuffer = new unsigned char[a_sizeOfBuffer];
-    memcpy(newBuffer, a_bytesBufferToCopy, a_sizeOfBuffer);
-
-    return newBuffer;
+    if(m_socketID != DETACHED_SOCKET_ID)
+    {
+        close(m_socketID);
+        m_socketID = DETACHED_SOCKET_ID;
+    }
 }
 
 
 infra::TCPSocket::BytesBufferProxy::BytesBufferProxy()
-: m_bufferOfBytes(new unsigned char[0])
+: m_block(nullptr)
+, m_bufferOfBytes(nullptr)
 , m_bufferSize(0)
 {
 }
 
 
 infra::TCPSocket::BytesBufferProxy::BytesBufferProxy(const unsigned char*  a_bufferOfBytes, size_t a_bufferSize)
-: m_bufferOfBytes(CreateBytesBufferFromOtherBuffer(a_bufferOfBytes, a_bufferSize))
-, m_bufferSize(a_bufferSize)
+: BytesBufferProxy(a_bufferSize)
+{
+    if(a_bufferSize != 0)
+    {
+        memcpy(WritableBytes(), a_bufferOfBytes, a_bufferSize);
+    }
+}
+
+
+infra::TCPSocket::BytesBufferProxy::BytesBufferProxy(size_t a_capacity)
+: m_block(a_capacity != 0 ? BytesBufferPool::Instance().Acquire(a_capacity) : nullptr)
+, m_bufferOfBytes(m_block ? m_block->Bytes() : nullptr)
+, m_bufferSize(a_capacity)
 {
 }
 
 
 infra::TCPSocket::BytesBufferProxy::BytesBufferProxy(const BytesBufferProxy& a_other)
-: m_bufferOfBytes(CreateBytesBufferFromOtherBuffer(a_other.m_bufferOfBytes, a_other.m_bufferSize))
+: m_block(a_other.m_block)
+, m_bufferOfBytes(a_other.m_bufferOfBytes)
 , m_bufferSize(a_other.m_bufferSize)
 {
+    if(m_block)
+    {
+        BytesBufferPool::AddReference(m_block);
+    }
 }
 
 
-infra::TCPSocket::BytesBufferProxy& infra::TCPSocket::BytesBufferProxy::operator=(const BytesBufferProxy& a_other) {
-    if(this != &a_other) // Saving from self copy-assignable
+infra::TCPSocket::BytesBufferProxy& infra::TCPSocket::BytesBufferProxy::operator=(const BytesBufferProxy& a_other)
+{
+    if(a_other.m_block) // Before releasing the current block - saving from self copy-assignment of the last reference
     {
-        unsigned char* newBuffer = CreateBytesBufferFromOtherBuffer(a_other.m_bufferOfBytes, a_other.m_bufferSize); // Saving for a possible thrown exception - even if it would occur, the buffer;s pointer will not be a dangling pointer
-        delete[] m_bufferOfBytes;
-
-        m_bufferOfBytes = newBuffer;
-        m_bufferSize = a_other.m_bufferSize;
+        BytesBufferPool::AddReference(a_other.m_block);
+    }
+    if(m_block)
+    {
+        BytesBufferPool::Release(m_block);
     }
 
+    m_block = a_other.m_block;
+    m_bufferOfBytes = a_other.m_bufferOfBytes;
+    m_bufferSize = a_other.m_bufferSize;
+
     return *this;
 }
 
 
 infra::TCPSocket::BytesBufferProxy::BytesBufferProxy(BytesBufferProxy&& a_rvalue) noexcept
-: m_bufferOfBytes(a_rvalue.m_bufferOfBytes)
+: m_block(a_rvalue.m_block)
+, m_bufferOfBytes(a_rvalue.m_bufferOfBytes)
 , m_bufferSize(a_rvalue.m_bufferSize)
 {
-    a_rvalue.m_bufferOfBytes = nullptr; // MUST to do in order to save from a delete[]
+    // MUST to do in order to save from a double release (the moved proxy is left empty)
+    a_rvalue.m_block = nullptr;
+    a_rvalue.m_bufferOfBytes = nullptr;
+    a_rvalue.m_bufferSize = 0;
 }
 
 
 infra::TCPSocket::BytesBufferProxy& infra::TCPSocket::BytesBufferProxy::operator=(BytesBufferProxy&& a_rvalue) noexcept
 {
-    delete[] m_bufferOfBytes;
+    if(this != &a_rvalue)
+    {
+        if(m_block)
+        {
+            BytesBufferPool::Release(m_block);
+        }
+
+        m_block = a_rvalue.m_block;
+        m_bufferOfBytes = a_rvalue.m_bufferOfBytes;
+        m_bufferSize = a_rvalue.m_bufferSize;
 
-    m_bufferOfBytes = a_rvalue.m_bufferOfBytes;
-    m_bufferSize = a_rvalue.m_bufferSize;
-    a_rvalue.m_bufferOfBytes = nullptr; // MUST to do in order to save from a delete[]
+        // MUST to do in order to save from a double release (the moved proxy is left empty)
+        a_rvalue.m_block = nullptr;
+        a_rvalue.m_bufferOfBytes = nullptr;
+        a_rvalue.m_bufferSize = 0;
+    }
 
     return *this;
 }
@@ -125,23 +185,26 @@ infra::TCPSocket::BytesBufferProxy& infra::TCPSocket::BytesBufferProxy::operator
 
 infra::TCPSocket::BytesBufferProxy::~BytesBufferProxy()
 {
-    delete[] m_bufferOfBytes;
+    if(m_block)
+    {
+        BytesBufferPool::Release(m_block);
+    }
 }
 
 
 infra::TCPSocket::BytesBufferProxy& infra::TCPSocket::BytesBufferProxy::operator+=(const BytesBufferProxy& a_other)
 {
-    size_t newBufferSize = m_bufferSize + a_other.m_bufferSize;
-    unsigned char* newBuffer = new unsigned char[newBufferSize];
-
-    memcpy(newBuffer, m_bufferOfBytes, m_bufferSize);
-    memcpy(newBuffer + m_bufferSize, a_other.m_bufferOfBytes, a_other.m_bufferSize);
-
-    delete[] m_bufferOfBytes;
-    m_bufferOfBytes = newBuffer;
-    m_bufferSize = newBufferSize;
+    BytesBufferProxy newBytesBuffer(m_bufferSize + a_other.m_bufferSize);
+    if(m_bufferSize != 0)
+    {
+        memcpy(newBytesBuffer.WritableBytes(), m_bufferOfBytes, m_bufferSize);
+    }
+    if(a_other.m_bufferSize != 0)
+    {
+        memcpy(newBytesBuffer.WritableBytes() + m_bufferSize, a_other.m_bufferOfBytes, a_other.m_bufferSize);
+    }
 
-    return *this;
+    return *this = std::move(newBytesBuffer);
 }
 
 
@@ -153,6 +216,44 @@ infra::TCPSocket::BytesBufferProxy infra::TCPSocket::BytesBufferProxy::operator+
 }
 
 
+infra::TCPSocket::BytesBufferProxy infra::TCPSocket::BytesBufferProxy::Slice(size_t a_offset, size_t a_length) const
+{
+    if(a_offset > m_bufferSize || a_length > m_bufferSize - a_offset)
+    {
+        throw std::out_of_range("Failed to slice the buffer - the slice exceeds the buffer...");
+    }
+
+    BytesBufferProxy slice(*this);
+    slice.m_bufferOfBytes += a_offset;
+    slice.m_bufferSize = a_length;
+
+    return slice;
+}
+
+
+struct iovec infra::TCPSocket::BytesBufferProxy::ToIOVec() const
+{
+    struct iovec bytesView;
+    bytesView.iov_base = const_cast<unsigned char*>(m_bufferOfBytes); // writev / sendmsg only read the bytes
+    bytesView.iov_len = m_bufferSize;
+
+    return bytesView;
+}
+
+
+void infra::TCPSocket::BytesBufferProxy::Shrink(size_t a_bufferSize)
+{
+    if(a_bufferSize == 0 && m_block) // An empty buffer should not hold a block
+    {
+        BytesBufferPool::Release(m_block);
+        m_block = nullptr;
+        m_bufferOfBytes = nullptr;
+    }
+
+    m_bufferSize = a_bufferSize;
+}
+
+
 void infra::TCPSocket::Connect()
 {
     int statusResult = connect(m_socketID, reinterpret_cast<struct sockaddr*>(&m_socketAddressData.GetInnerSocketAddress()), sizeof(m_socketAddressData.GetInnerSocketAddress()));
@@ -163,27 +264,41 @@ void infra::TCPSocket::Connect()
 }
 
 
-size_t infra::TCPSocket::Send(const unsigned char* a_message, size_t a_messageSize, bool a_provideFullMessageSending)
+size_t infra::TCPSocket::Send(const BytesBufferProxy& a_message, bool a_provideFullMessageSending)
 {
-    return Send(BytesBufferProxy(a_message, a_messageSize), a_provideFullMessageSending);
+    return Send(a_message.ToBytes(), a_message.Size(), a_provideFullMessageSending);
 }
 
 
-size_t infra::TCPSocket::Send(const BytesBufferProxy& a_message, bool a_provideFullMessageSending)
+size_t infra::TCPSocket::Send(const unsigned char* a_message, size_t a_messageSize, bool a_provideFullMessageSending)
 {
-    size_t totalSentBytes = send(GetSocketIDToSendTheMessageTo(), static_cast<const void*>(a_message.ToBytes()), a_message.Size(), 0);
+    size_t totalSentBytes = send(GetSocketIDToSendTheMessageTo(), static_cast<const void*>(a_message), a_messageSize, 0);
     if(totalSentBytes == size_t(-1)) // Representation of max size_t value
     {
-        throw std::runtime_error("Failed to send a message...");
+        if(!a_provideFullMessageSending && (errno == EAGAIN || errno == EWOULDBLOCK)) // A full send buffer of a non blocking socket - nothing was sent yet
+        {
+            return 0;
+        }
+
+        if(!a_provideFullMessageSending || !WaitUntilWritableIfBufferFull(GetSocketIDToSendTheMessageTo()))
+        {
+            throw std::runtime_error("Failed to send a message...");
+        }
+
+        totalSentBytes = 0; // A full send buffer of a non blocking socket - the whole message is sent by the following loop
     }
 
-    if(a_provideFullMessageSending && totalSentBytes < a_message.Size()) // totalSentBytes cannot be size_t(-1) [max size_t value]
+    if(a_provideFullMessageSending && totalSentBytes < a_messageSize) // totalSentBytes cannot be size_t(-1) [max size_t value]
     {
-        while(totalSentBytes < a_message.Size())
+        while(totalSentBytes < a_messageSize)
         {
-            size_t newBytesSent = send(GetSocketIDToSendTheMessageTo(), static_cast<const void*>(a_message.ToBytes() + totalSentBytes), a_message.Size() - totalSentBytes, 0);
+            size_t newBytesSent = send(GetSocketIDToSendTheMessageTo(), static_cast<const void*>(a_message + totalSentBytes), a_messageSize - totalSentBytes, 0);
             if(newBytesSent == size_t(-1)) // An internal failure while tried to send the rest of the message (the connection could have lost - cannot provide full message sending in that case...)
             {
+                if(WaitUntilWritableIfBufferFull(GetSocketIDToSendTheMessageTo()))
+                {
+                    continue;
+                }
                 break;
             }
             totalSentBytes += newBytesSent;
@@ -194,18 +309,53 @@ size_t infra::TCPSocket::Send(const BytesBufferProxy& a_message, bool a_provideF
 }
 
 
+size_t infra::TCPSocket::Send(const struct iovec* a_parts, size_t a_partsCount)
+{
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = const_cast<struct iovec*>(a_parts); // sendmsg only reads the parts
+    message.msg_iovlen = a_partsCount;
+
+    ssize_t sentBytes = sendmsg(GetSocketIDToSendTheMessageTo(), &message, MSG_NOSIGNAL); // A closed peer is reported by the result, and not by SIGPIPE
+    while(sentBytes < 0 && errno == EINTR)
+    {
+        sentBytes = sendmsg(GetSocketIDToSendTheMessageTo(), &message, MSG_NOSIGNAL);
+    }
+
+    if(sentBytes < 0)
+    {
+        if(errno == EAGAIN || errno == EWOULDBLOCK) // A full send buffer of a non blocking socket - nothing was sent
+        {
+            return 0;
+        }
+
+        throw std::runtime_error("Failed to send a message...");
+    }
+
+    return static_cast<size_t>(sentBytes);
+}
+
+
 infra::TCPSocket::BytesBufferProxy infra::TCPSocket::Receive(size_t a_bytesToReceive)
 {
-    unsigned char* buffer = new unsigned char[a_bytesToReceive];
-    size_t receivedBytes = recv(m_socketID, static_cast<void*>(buffer), a_bytesToReceive, 0);
+    BytesBufferProxy bufferProxy;
+    size_t receivedBytes = ReceiveInto(m_socketID, a_bytesToReceive, bufferProxy);
     if(receivedBytes == size_t(-1)) // Representation of max size_t value
     {
-        delete[] buffer;
         throw std::runtime_error("Failed to receive a message...");
     }
 
-    BytesBufferProxy bufferProxy(buffer, receivedBytes);
-    delete[] buffer;
-
     return bufferProxy;
 }
+
+
+size_t infra::TCPSocket::ReceiveInto(SocketID a_socketID, size_t a_bytesToReceive, BytesBufferProxy& a_receivedBuffer)
+{
+    BytesBufferProxy bufferProxy(a_bytesToReceive); // Drawn from the pool, and received into directly - no temporary buffer and no copy
+    size_t receivedBytes = recv(a_socketID, static_cast<void*>(a_bytesToReceive != 0 ? bufferProxy.WritableBytes() : nullptr), a_bytesToReceive, 0);
+
+    bufferProxy.Shrink(receivedBytes == size_t(-1) ? 0 : receivedBytes);
+    a_receivedBuffer = std::move(bufferProxy);
+
+    return receivedBytes;
+}
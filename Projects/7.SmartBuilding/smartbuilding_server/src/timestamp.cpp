@@ -0,0 +1,105 @@
+#include "timestamp.hpp"
+#include <ctime> // struct tm, time_t
+#include <string> // std::string
+#include <time.h> // clock_gettime, CLOCK_REALTIME_COARSE, localtime_r, mktime
+#include "date_time.hpp"
+
+
+namespace smartbuilding
+{
+
+static const Timestamp::Nanoseconds NANOSECONDS_IN_SECOND = 1000000000;
+static const Timestamp::Nanoseconds NANOSECONDS_IN_MICROSECOND = 1000;
+static const unsigned int MICROSECONDS_DIGITS = 6;
+
+
+// The text of the last second that was rendered by this thread - a log line / an event of the same second reuses it
+struct RenderedSecond
+{
+    RenderedSecond() : m_second(-1), m_timeText(), m_dateText() {}
+
+    time_t m_second;
+    std::string m_timeText; // "H:M:S"
+    std::string m_dateText; // "|D.M.Y"
+};
+
+
+static DateTime ToLocalDateTime(time_t a_second)
+{
+    struct tm datetime;
+    localtime_r(&a_second, &datetime);
+
+    return DateTime(datetime.tm_hour, datetime.tm_min, datetime.tm_sec, datetime.tm_mday, datetime.tm_mon + 1, datetime.tm_year + DateTime::OFFSET_OF_YEARS_IN_SYSTEM);
+}
+
+
+Timestamp Timestamp::Now()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME_COARSE, &now);
+
+    return Timestamp(static_cast<Nanoseconds>(now.tv_sec) * NANOSECONDS_IN_SECOND + static_cast<Nanoseconds>(now.tv_nsec));
+}
+
+
+Timestamp Timestamp::FromDateTime(const DateTime& a_dateTime)
+{
+    struct tm datetime = tm();
+    datetime.tm_hour = a_dateTime.Hours();
+    datetime.tm_min = a_dateTime.Minutes();
+    datetime.tm_sec = a_dateTime.Seconds();
+    datetime.tm_mday = a_dateTime.Day();
+    datetime.tm_mon = a_dateTime.Month() - 1;
+    datetime.tm_year = a_dateTime.Year() - static_cast<int>(DateTime::OFFSET_OF_YEARS_IN_SYSTEM);
+    datetime.tm_isdst = -1; // Resolved by mktime
+
+    time_t second = mktime(&datetime);
+
+    return Timestamp(second < 0 ? 0 : static_cast<Nanoseconds>(second) * NANOSECONDS_IN_SECOND);
+}
+
+
+DateTime Timestamp::ToDateTime() const
+{
+    return ToLocalDateTime(static_cast<time_t>(m_nanoseconds / NANOSECONDS_IN_SECOND));
+}
+
+
+std::string Timestamp::ToString() const
+{
+    std::string text;
+    AppendTo(text);
+
+    return text;
+}
+
+
+void Timestamp::AppendTo(std::string& a_text) const
+{
+    static thread_local RenderedSecond renderedSecond;
+
+    time_t second = static_cast<time_t>(m_nanoseconds / NANOSECONDS_IN_SECOND);
+    if(second != renderedSecond.m_second) // Once per second (per thread) - localtime_r and the integers formatting
+    {
+        DateTime dateTime = ToLocalDateTime(second);
+        renderedSecond.m_timeText = dateTime.TimeToString();
+        renderedSecond.m_dateText = "|" + dateTime.DateToString();
+        renderedSecond.m_second = second;
+    }
+
+    char microseconds[MICROSECONDS_DIGITS + 1];
+    microseconds[0] = '.';
+    Nanoseconds subSecond = (m_nanoseconds % NANOSECONDS_IN_SECOND) / NANOSECONDS_IN_MICROSECOND;
+    for(unsigned int i = MICROSECONDS_DIGITS; i > 0; --i)
+    {
+        microseconds[i] = static_cast<char>('0' + subSecond % 10);
+        subSecond /= 10;
+    }
+
+    a_text.reserve(a_text.size() + renderedSecond.m_timeText.size() + sizeof(microseconds) + renderedSecond.m_dateText.size());
+    a_text += renderedSecond.m_timeText;
+    a_text.append(microseconds, sizeof(microseconds));
+    a_text += renderedSecond.m_dateText;
+}
+
+} // smartbuilding
@@ -0,0 +1,263 @@
+#include "mu_test.h"
+#include <cstddef> // size_t
+#include <memory> // std::shared_ptr, std::make_shared
+#include <vector> // std::vector
+#include <utility> // std::pair, std::make_pair
+#include <iterator> // std::back_inserter
+#include <atomic> // std::atomic
+#include <chrono> // std::chrono::seconds, std::chrono::milliseconds, std::chrono::nanoseconds, std::chrono::steady_clock
+#include <thread> // std::this_thread::sleep_for
+#include "events_dispatcher.hpp"
+#include "isubscriber.hpp"
+#include "iencoder.hpp"
+#include "encoding_cache.hpp"
+#include "icallable.hpp"
+#include "event.hpp"
+#include "timestamp.hpp"
+#include "location.hpp"
+#include "tcp_socket.hpp"
+#include "connection_handle.hpp"
+#include "blocking_bounded_queue.hpp"
+#include "blocking_bounded_queue_destruction_policies.hpp"
+#include "thread_pool.hpp"
+#include "thread_pool_destruction_policies.hpp"
+#include "thread_budget.hpp"
+#include "future.hpp"
+
+
+using namespace smartbuilding;
+
+using HandledBuffer = std::pair<ConnectionHandle,infra::TCPSocket::BytesBufferProxy>;
+using HandledBuffersQueue = advcpp::BlockingBoundedQueue<HandledBuffer, advcpp::NoOperationPolicy<HandledBuffer>>;
+
+static const size_t HANDLED_BUFFERS_QUEUE_SIZE = 100; // As the hub's queue
+static const size_t SUBSCRIBERS_PER_BATCH = 64;
+
+
+class StagingSubscriber : public ISubscriber
+{
+public:
+    explicit StagingSubscriber(ConnectionHandle a_connection) : m_connection(a_connection) {}
+
+    virtual void Notify(Event a_event, std::vector<HandledBuffer>& a_handledBuffers) override
+    {
+        a_handledBuffers.push_back(std::make_pair(m_connection, a_event.Data()));
+    }
+
+private:
+    ConnectionHandle m_connection;
+};
+
+
+// Encodes the event through the event's encoding cache - as the controllers' agents
+class EncodingSubscriber : public ISubscriber
+{
+public:
+    EncodingSubscriber(ConnectionHandle a_connection, std::shared_ptr<IEncoder> a_encoder) : m_connection(a_connection), m_encoder(a_encoder) {}
+
+    virtual void Notify(Event a_event, std::vector<HandledBuffer>& a_handledBuffers) override
+    {
+        a_handledBuffers.push_back(std::make_pair(m_connection, EncodingCache::Encode(*m_encoder, a_event)));
+    }
+
+private:
+    ConnectionHandle m_connection;
+    std::shared_ptr<IEncoder> m_encoder;
+};
+
+
+// Its instances encode an event to the same bytes - so they opt in to share them
+class TypeEncoder : public IEncoder
+{
+public:
+    virtual infra::TCPSocket::BytesBufferProxy Encode(Event a_event) override
+    {
+        return infra::TCPSocket::BytesBufferProxy(reinterpret_cast<const unsigned char*>(a_event.Type().data()), a_event.Type().size());
+    }
+
+    virtual const void* SharingKey() const override { return &s_sharingKey; }
+
+private:
+    static const char s_sharingKey;
+};
+
+const char TypeEncoder::s_sharingKey = 0;
+
+
+// Its bytes depend on its device - so it keeps the default (unshared) key
+class DeviceTaggingEncoder : public IEncoder
+{
+public:
+    explicit DeviceTaggingEncoder(unsigned char a_deviceTag) : m_deviceTag(a_deviceTag) {}
+
+    virtual infra::TCPSocket::BytesBufferProxy Encode(Event a_event) override
+    {
+        return infra::TCPSocket::BytesBufferProxy(&m_deviceTag, 1) + a_event.Data();
+    }
+
+private:
+    unsigned char m_deviceTag;
+};
+
+
+// Drains the handled buffers queue on a workers pool - as the hub's sending stage
+class CountingSender : public advcpp::ICallable
+{
+public:
+    CountingSender(std::shared_ptr<HandledBuffersQueue> a_handledBuffersQueue)
+    : m_handledBuffersQueue(a_handledBuffersQueue)
+    , m_senders(advcpp::ShutdownPolicy<>(), 10, 1)
+    , m_sentBuffersCount(std::make_shared<std::atomic<size_t>>(0))
+    {
+    }
+
+    virtual void operator()() override
+    {
+        std::shared_ptr<HandledBuffersQueue> handledBuffersQueue = m_handledBuffersQueue;
+        std::shared_ptr<std::atomic<size_t>> sentBuffersCount = m_sentBuffersCount;
+        m_senders.TrySubmit([handledBuffersQueue, sentBuffersCount]()
+        {
+            std::vector<HandledBuffer> handledBuffers;
+            while(handledBuffersQueue->DequeueBulk(std::back_inserter(handledBuffers), 32, std::chrono::nanoseconds(0)) > 0)
+            {
+                *sentBuffersCount += handledBuffers.size();
+                handledBuffers.clear();
+            }
+        });
+    }
+
+    bool WaitForSentBuffers(size_t a_count, std::chrono::milliseconds a_timeout) const
+    {
+        std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + a_timeout;
+        while(m_sentBuffersCount->load() < a_count && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        return m_sentBuffersCount->load() == a_count;
+    }
+
+private:
+    std::shared_ptr<HandledBuffersQueue> m_handledBuffersQueue;
+    advcpp::ThreadPool<advcpp::ShutdownPolicy<>> m_senders;
+    std::shared_ptr<std::atomic<size_t>> m_sentBuffersCount;
+};
+
+
+static std::vector<std::shared_ptr<ISubscriber>> MakeSubscribers(size_t a_count)
+{
+    std::vector<std::shared_ptr<ISubscriber>> subscribers;
+    for(size_t i = 0; i < a_count; ++i)
+    {
+        subscribers.push_back(std::make_shared<StagingSubscriber>(i));
+    }
+
+    return subscribers;
+}
+
+
+template <typename Encoder, typename... Args>
+static std::vector<std::shared_ptr<ISubscriber>> MakeEncodingSubscribers(size_t a_count, Args... a_encoderArgs)
+{
+    std::vector<std::shared_ptr<ISubscriber>> subscribers;
+    for(size_t i = 0; i < a_count; ++i)
+    {
+        subscribers.push_back(std::make_shared<EncodingSubscriber>(i, std::make_shared<Encoder>(a_encoderArgs...))); // An encoder per subscriber - as each agent has its own
+    }
+
+    return subscribers;
+}
+
+
+static Event MakeEvent()
+{
+    const unsigned char data[] = "on";
+    return Event(infra::TCPSocket::BytesBufferProxy(data, sizeof(data) - 1), Timestamp::Now(), Location(), "fire");
+}
+
+
+BEGIN_TEST(dispatcher_fan_out_larger_than_handled_buffers_queue_check)
+    const size_t SUBSCRIBERS_COUNT = 10 * HANDLED_BUFFERS_QUEUE_SIZE + 7; // Never fits the queue - completes only if the queue is drained while the event is notified
+
+    std::shared_ptr<HandledBuffersQueue> handledBuffersQueue = std::make_shared<HandledBuffersQueue>(HANDLED_BUFFERS_QUEUE_SIZE, advcpp::NoOperationPolicy<HandledBuffer>());
+    std::shared_ptr<CountingSender> sender = std::make_shared<CountingSender>(handledBuffersQueue);
+    EventsDispatcher dispatcher(std::make_shared<advcpp::ThreadBudget>(4), SUBSCRIBERS_PER_BATCH);
+
+    advcpp::Future<void> notified = dispatcher.Invoke(MakeSubscribers(SUBSCRIBERS_COUNT), MakeEvent(), handledBuffersQueue, sender);
+    ASSERT_THAT(notified.WaitFor(std::chrono::seconds(5)));
+    ASSERT_THAT(sender->WaitForSentBuffers(SUBSCRIBERS_COUNT, std::chrono::milliseconds(5000)));
+    ASSERT_THAT(handledBuffersQueue->IsEmpty());
+
+    EventsDispatcher::FanOutStatistics statistics = dispatcher.Statistics();
+    ASSERT_EQUAL(statistics.m_subscribersCount, SUBSCRIBERS_COUNT);
+    ASSERT_EQUAL(statistics.m_batchesCount, (SUBSCRIBERS_COUNT + SUBSCRIBERS_PER_BATCH - 1) / SUBSCRIBERS_PER_BATCH);
+    ASSERT_EQUAL(statistics.m_droppedBatchesCount, 0);
+END_TEST
+
+
+BEGIN_TEST(dispatcher_many_large_fan_outs_at_once_check)
+    const size_t EVENTS_COUNT = 20;
+    const size_t SUBSCRIBERS_COUNT = 3 * HANDLED_BUFFERS_QUEUE_SIZE;
+
+    std::shared_ptr<HandledBuffersQueue> handledBuffersQueue = std::make_shared<HandledBuffersQueue>(HANDLED_BUFFERS_QUEUE_SIZE, advcpp::NoOperationPolicy<HandledBuffer>());
+    std::shared_ptr<CountingSender> sender = std::make_shared<CountingSender>(handledBuffersQueue);
+    EventsDispatcher dispatcher(std::make_shared<advcpp::ThreadBudget>(4), SUBSCRIBERS_PER_BATCH);
+    std::vector<std::shared_ptr<ISubscriber>> subscribers = MakeSubscribers(SUBSCRIBERS_COUNT);
+
+    std::vector<advcpp::Future<void>> notifiedEvents;
+    for(size_t i = 0; i < EVENTS_COUNT; ++i)
+    {
+        notifiedEvents.push_back(dispatcher.Invoke(subscribers, MakeEvent(), handledBuffersQueue, sender));
+    }
+    ASSERT_THAT(advcpp::WhenAll(notifiedEvents).WaitFor(std::chrono::seconds(10)));
+    ASSERT_THAT(sender->WaitForSentBuffers(EVENTS_COUNT * SUBSCRIBERS_COUNT, std::chrono::milliseconds(5000)));
+    ASSERT_EQUAL(dispatcher.Statistics().m_subscribersCount, EVENTS_COUNT * SUBSCRIBERS_COUNT);
+END_TEST
+
+
+BEGIN_TEST(dispatcher_fan_out_encodes_once_per_sharing_key_check)
+    const size_t SUBSCRIBERS_COUNT = 5 * SUBSCRIBERS_PER_BATCH;
+    const size_t BATCHES_COUNT = SUBSCRIBERS_COUNT / SUBSCRIBERS_PER_BATCH;
+
+    std::shared_ptr<HandledBuffersQueue> handledBuffersQueue = std::make_shared<HandledBuffersQueue>(HANDLED_BUFFERS_QUEUE_SIZE, advcpp::NoOperationPolicy<HandledBuffer>());
+    std::shared_ptr<CountingSender> sender = std::make_shared<CountingSender>(handledBuffersQueue);
+    EventsDispatcher dispatcher(std::make_shared<advcpp::ThreadBudget>(4), SUBSCRIBERS_PER_BATCH);
+
+    EncodingCache::Statistics before = EncodingCache::ProcessStatistics();
+    ASSERT_THAT(dispatcher.Invoke(MakeEncodingSubscribers<TypeEncoder>(SUBSCRIBERS_COUNT), MakeEvent(), handledBuffersQueue, sender).WaitFor(std::chrono::seconds(5)));
+    ASSERT_THAT(sender->WaitForSentBuffers(SUBSCRIBERS_COUNT, std::chrono::milliseconds(5000)));
+    EncodingCache::Statistics after = EncodingCache::ProcessStatistics();
+
+    size_t hitsCount = after.m_hitsCount - before.m_hitsCount;
+    size_t missesCount = after.m_missesCount - before.m_missesCount;
+    ASSERT_EQUAL(hitsCount + missesCount, SUBSCRIBERS_COUNT);
+    ASSERT_THAT(missesCount >= 1 && missesCount <= BATCHES_COUNT); // Only the batches that have encoded concurrently might miss
+    ASSERT_THAT(hitsCount >= SUBSCRIBERS_COUNT - BATCHES_COUNT);
+END_TEST
+
+
+BEGIN_TEST(dispatcher_fan_out_encoders_do_not_share_by_default_check)
+    const size_t SUBSCRIBERS_COUNT = 2 * SUBSCRIBERS_PER_BATCH;
+
+    std::shared_ptr<HandledBuffersQueue> handledBuffersQueue = std::make_shared<HandledBuffersQueue>(HANDLED_BUFFERS_QUEUE_SIZE, advcpp::NoOperationPolicy<HandledBuffer>());
+    std::shared_ptr<CountingSender> sender = std::make_shared<CountingSender>(handledBuffersQueue);
+    EventsDispatcher dispatcher(std::make_shared<advcpp::ThreadBudget>(4), SUBSCRIBERS_PER_BATCH);
+
+    EncodingCache::Statistics before = EncodingCache::ProcessStatistics();
+    ASSERT_THAT(dispatcher.Invoke(MakeEncodingSubscribers<DeviceTaggingEncoder>(SUBSCRIBERS_COUNT, 'd'), MakeEvent(), handledBuffersQueue, sender).WaitFor(std::chrono::seconds(5)));
+    ASSERT_THAT(sender->WaitForSentBuffers(SUBSCRIBERS_COUNT, std::chrono::milliseconds(5000)));
+    EncodingCache::Statistics after = EncodingCache::ProcessStatistics();
+
+    ASSERT_EQUAL(after.m_hitsCount - before.m_hitsCount, 0);
+    ASSERT_EQUAL(after.m_missesCount - before.m_missesCount, SUBSCRIBERS_COUNT);
+END_TEST
+
+
+BEGIN_SUITE(EventsDispatcherTests)
+
+    TEST(dispatcher_fan_out_larger_than_handled_buffers_queue_check)
+    TEST(dispatcher_many_large_fan_outs_at_once_check)
+    TEST(dispatcher_fan_out_encodes_once_per_sharing_key_check)
+    TEST(dispatcher_fan_out_encoders_do_not_share_by_default_check)
+
+END_SUITE
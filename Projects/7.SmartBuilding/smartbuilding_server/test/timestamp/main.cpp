@@ -0,0 +1,123 @@
+#include "mu_test.h"
+#include <cstddef> // size_t
+#include <string> // std::string
+#include <chrono> // std::chrono::steady_clock, std::chrono::duration_cast, std::chrono::nanoseconds
+#include <cstdio> // printf
+#include "timestamp.hpp"
+#include "date_time.hpp"
+
+
+using namespace smartbuilding;
+
+
+static const Timestamp::Nanoseconds NANOSECONDS_IN_SECOND = 1000000000;
+static const size_t BENCHMARK_ITERATIONS = 1000000;
+
+
+BEGIN_TEST(timestamp_to_string_matches_date_time_check)
+    Timestamp timestamp = Timestamp(1700000000 * NANOSECONDS_IN_SECOND + 123456789);
+    DateTime dateTime = timestamp.ToDateTime();
+
+    ASSERT_EQUAL(timestamp.ToString(), dateTime.TimeToString() + ".123456|" + dateTime.DateToString());
+END_TEST
+
+
+BEGIN_TEST(timestamp_same_second_renders_only_sub_second_check)
+    Timestamp first = Timestamp(1700000000 * NANOSECONDS_IN_SECOND + 5000);
+    Timestamp second = Timestamp(1700000000 * NANOSECONDS_IN_SECOND + 999999999);
+    Timestamp nextSecond = Timestamp(1700000001 * NANOSECONDS_IN_SECOND);
+
+    std::string firstText = first.ToString();
+    std::string secondText = second.ToString();
+    ASSERT_THAT(firstText.find(".000005|") != std::string::npos);
+    ASSERT_THAT(secondText.find(".999999|") != std::string::npos);
+    ASSERT_EQUAL(firstText.substr(0, firstText.find('.')), secondText.substr(0, secondText.find('.')));
+    ASSERT_EQUAL(nextSecond.ToString(), nextSecond.ToDateTime().TimeToString() + ".000000|" + nextSecond.ToDateTime().DateToString());
+END_TEST
+
+
+BEGIN_TEST(timestamp_append_to_check)
+    Timestamp timestamp = Timestamp(1700000000 * NANOSECONDS_IN_SECOND);
+    std::string text = "prefix ";
+    timestamp.AppendTo(text);
+
+    ASSERT_EQUAL(text, "prefix " + timestamp.ToString());
+END_TEST
+
+
+BEGIN_TEST(timestamp_from_date_time_check)
+    DateTime dateTime(13, 14, 15, 16, 3, 2024);
+    Timestamp timestamp = Timestamp::FromDateTime(dateTime);
+    DateTime converted = timestamp.ToDateTime();
+
+    ASSERT_EQUAL(converted.ToString(), dateTime.ToString());
+    ASSERT_EQUAL(timestamp.SinceEpoch() % NANOSECONDS_IN_SECOND, 0);
+END_TEST
+
+
+BEGIN_TEST(timestamp_now_check)
+    Timestamp before = Timestamp::Now();
+    DateTime now = DateTime::Now();
+    Timestamp after = Timestamp::Now();
+
+    ASSERT_THAT(!(after < before));
+    ASSERT_THAT(after.SinceEpoch() / NANOSECONDS_IN_SECOND - before.SinceEpoch() / NANOSECONDS_IN_SECOND <= 1);
+    ASSERT_THAT(before.ToDateTime().Year() == now.Year() || after.ToDateTime().Year() == now.Year());
+END_TEST
+
+
+// Not a pass / fail test - prints the cost of taking and formatting a timestamp per call, by the current DateTime and by Timestamp
+BEGIN_TEST(timestamp_versus_date_time_benchmark)
+    size_t textsSize = 0;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        textsSize += DateTime::Now().ToString().size();
+    }
+    std::chrono::nanoseconds dateTimeDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        textsSize += Timestamp::Now().ToString().size();
+    }
+    std::chrono::nanoseconds timestampDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    std::string text;
+    for(size_t i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        text.clear();
+        Timestamp::Now().AppendTo(text);
+        textsSize += text.size();
+    }
+    std::chrono::nanoseconds appendDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    Timestamp::Nanoseconds sum = 0;
+    for(size_t i = 0; i < BENCHMARK_ITERATIONS; ++i)
+    {
+        sum += Timestamp::Now().SinceEpoch();
+    }
+    std::chrono::nanoseconds rawDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    printf("\nDateTime::Now().ToString():      %.1f ns/call\n", static_cast<double>(dateTimeDuration.count()) / BENCHMARK_ITERATIONS);
+    printf("Timestamp::Now().ToString():     %.1f ns/call\n", static_cast<double>(timestampDuration.count()) / BENCHMARK_ITERATIONS);
+    printf("Timestamp::Now().AppendTo(text): %.1f ns/call\n", static_cast<double>(appendDuration.count()) / BENCHMARK_ITERATIONS);
+    printf("Timestamp::Now() (raw, stored):  %.1f ns/call\n", static_cast<double>(rawDuration.count()) / BENCHMARK_ITERATIONS);
+
+    ASSERT_THAT(textsSize > 0 && sum > 0);
+END_TEST
+
+
+BEGIN_SUITE(TimestampTests)
+
+    TEST(timestamp_to_string_matches_date_time_check)
+    TEST(timestamp_same_second_renders_only_sub_second_check)
+    TEST(timestamp_append_to_check)
+    TEST(timestamp_from_date_time_check)
+    TEST(timestamp_now_check)
+    TEST(timestamp_versus_date_time_benchmark)
+
+END_SUITE